@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.4 (2026/10/18)
 
 #pragma once
 
@@ -15,4 +15,8 @@
 #include <Imagics/GteImageUtility3.h>
 #include <Imagics/GteMarchingCubes.h>
 #include <Imagics/GteMarchingCubesTable.h>
+#include <Imagics/GteMinMaxPyramid3.h>
+#include <Imagics/GteMorphologyLines.h>
 #include <Imagics/GteSurfaceExtractor.h>
+#include <Imagics/GteSurfaceExtractorSlices.h>
+#include <Imagics/GteSurfaceExtractorStream.h>
@@ -17,6 +17,7 @@
 #include <LowLevel/GteMinHeap.h>
 #include <LowLevel/GteRangeIteration.h>
 #include <LowLevel/GteThreadSafeMap.h>
+#include <LowLevel/GteThreadPool.h>
 #include <LowLevel/GteThreadSafeQueue.h>
 #include <LowLevel/GteWrapper.h>
 
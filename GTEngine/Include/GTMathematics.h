@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.24 (2018/10/30)
+// File Version: 3.0.27 (2026/10/18)
 
 #pragma once
 
@@ -20,6 +20,7 @@
 #include <Mathematics/GteUIntegerALU32.h>
 #include <Mathematics/GteUIntegerAP32.h>
 #include <Mathematics/GteUIntegerFP32.h>
+#include <Mathematics/GteUIntegerSB32.h>
 #include <Mathematics/GteBSNumber.h>
 #include <Mathematics/GteBSRational.h>
 #include <Mathematics/GteBSPrecision.h>
@@ -31,6 +32,7 @@
 #include <Mathematics/GteAxisAngle.h>
 #include <Mathematics/GteBandedMatrix.h>
 #include <Mathematics/GteConvertCoordinates.h>
+#include <Mathematics/GteCSRMatrix.h>
 #include <Mathematics/GteEulerAngles.h>
 #include <Mathematics/GteGMatrix.h>
 #include <Mathematics/GteGVector.h>
@@ -82,10 +84,13 @@
 #include <Mathematics/GteDelaunay2Mesh.h>
 #include <Mathematics/GteDelaunay3.h>
 #include <Mathematics/GteDelaunay3Mesh.h>
+#include <Mathematics/GteDynamicDelaunay2.h>
 #include <Mathematics/GteEdgeKey.h>
+#include <Mathematics/GteETCompactManifoldMesh.h>
 #include <Mathematics/GteETManifoldMesh.h>
 #include <Mathematics/GteFeatureKey.h>
 #include <Mathematics/GteGenerateMeshUV.h>
+#include <Mathematics/GteIncrementalDelaunay2.h>
 #include <Mathematics/GteIsPlanarGraph.h>
 #include <Mathematics/GteMinimalCycleBasis.h>
 #include <Mathematics/GteMinimumAreaBox2.h>
@@ -94,6 +99,7 @@
 #include <Mathematics/GteMinimumVolumeSphere3.h>
 #include <Mathematics/GteNearestNeighborQuery.h>
 #include <Mathematics/GteOBBTreeOfPoints.h>
+#include <Mathematics/GteParallelDelaunay2.h>
 #include <Mathematics/GtePlanarMesh.h>
 #include <Mathematics/GtePrimalQuery2.h>
 #include <Mathematics/GtePrimalQuery3.h>
@@ -367,11 +373,14 @@
 #include <Mathematics/GteGaussNewtonMinimizer.h>
 #include <Mathematics/GteGaussianElimination.h>
 #include <Mathematics/GteIntegration.h>
+#include <Mathematics/GteLCPBatchSolver.h>
+#include <Mathematics/GteLCPProjectedGaussSeidel.h>
 #include <Mathematics/GteLCPSolver.h>
 #include <Mathematics/GteLevenbergMarquardtMinimizer.h>
 #include <Mathematics/GteLinearSystem.h>
 #include <Mathematics/GteMinimize1.h>
 #include <Mathematics/GteMinimizeN.h>
+#include <Mathematics/GteMultigridPoisson.h>
 #include <Mathematics/GteOdeEuler.h>
 #include <Mathematics/GteOdeImplicitEuler.h>
 #include <Mathematics/GteOdeMidpoint.h>
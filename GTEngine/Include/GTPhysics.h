@@ -3,13 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.4 (2026/10/18)
 
 #pragma once
 
 // Fluid2
 #include <Physics/GteFluid2.h>
 #include <Physics/GteFluid2AdjustVelocity.h>
+#include <Physics/GteFluid2CPU.h>
 #include <Physics/GteFluid2ComputeDivergence.h>
 #include <Physics/GteFluid2EnforceStateBoundary.h>
 #include <Physics/GteFluid2InitializeSource.h>
@@ -21,6 +22,7 @@
 // Fluid3
 #include <Physics/GteFluid3.h>
 #include <Physics/GteFluid3AdjustVelocity.h>
+#include <Physics/GteFluid3CPU.h>
 #include <Physics/GteFluid3ComputeDivergence.h>
 #include <Physics/GteFluid3EnforceStateBoundary.h>
 #include <Physics/GteFluid3InitializeSource.h>
@@ -30,15 +32,19 @@
 #include <Physics/GteFluid3UpdateState.h>
 
 // Intersection
+#include <Physics/GteActiveList.h>
 #include <Physics/GteBoxManager.h>
+#include <Physics/GteBoxTreeManager.h>
 #include <Physics/GteExtremalQuery3.h>
 #include <Physics/GteExtremalQuery3BSP.h>
 #include <Physics/GteExtremalQuery3PRJ.h>
+#include <Physics/GteOverlapSet.h>
 #include <Physics/GteRectangleManager.h>
 
 // ParticleSystems
 #include <Physics/GteMassSpringArbitrary.h>
 #include <Physics/GteMassSpringCurve.h>
+#include <Physics/GteMassSpringImplicitSolver.h>
 #include <Physics/GteMassSpringSurface.h>
 #include <Physics/GteMassSpringVolume.h>
 #include <Physics/GteParticleSystem.h>
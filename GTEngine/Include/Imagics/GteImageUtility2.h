@@ -3,12 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2017/02/05)
+// File Version: 3.2.0 (2026/10/18)
 
 #pragma once
 
 #include <Imagics/GteImage2.h>
+#include <LowLevel/GteComputeModel.h>
 #include <functional>
+#include <memory>
 
 namespace gte
 {
@@ -31,16 +33,23 @@ public:
     // Compute the 4-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The components
+    // are numbered in the order of their first pixels, and the indices of a
+    // component are increasing.  When the compute model has a thread pool,
+    // ranges of rows are labeled concurrently; the output does not depend
+    // on the number of threads.
     static void GetComponents4(Image2<int>& image,
-        std::vector<std::vector<size_t>>& components);
+        std::vector<std::vector<size_t>>& components,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
 
     // Compute the 8-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The ordering and
+    // the compute model are as for GetComponents4.
     static void GetComponents8(Image2<int>& image,
-        std::vector<std::vector<size_t>>& components);
+        std::vector<std::vector<size_t>>& components,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
 
     // Compute a dilation with a structuring element consisting of the
     // 4-connected neighbors of each pixel.  The input image is binary with 0
@@ -148,6 +157,51 @@ public:
         int numNeighbors, std::array<int, 2> const* neighbors,
         Image2<int>& output);
 
+    // Dilation, erosion, opening and closing with large structuring
+    // elements.  The rectangle consists of the (2*radius0+1)-by-
+    // (2*radius1+1) pixels centered at a pixel, so radius0 = radius1 = 1
+    // gives the results of Dilate8, Erode8, Open8 and Close8.  The disk of
+    // radius r is approximated by an octagon, the Minkowski sum of a square
+    // and the two diagonal segments, with extent r along the axes and
+    // approximately r along the diagonals.  The elements are decomposed
+    // into segments that are processed by MorphologyLines, so the cost per
+    // pixel does not depend on the radius.  The input image is binary with
+    // 0 for background and 1 for foreground.  The output image may be the
+    // input image.  The zeroExterior parameter is as for Erode4.  When the
+    // compute model has a thread pool, ranges of rows or of columns are
+    // processed concurrently.
+    static void DilateRectangle(Image2<int> const& input, int radius0,
+        int radius1, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void ErodeRectangle(Image2<int> const& input, bool zeroExterior,
+        int radius0, int radius1, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void OpenRectangle(Image2<int> const& input, bool zeroExterior,
+        int radius0, int radius1, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void CloseRectangle(Image2<int> const& input, bool zeroExterior,
+        int radius0, int radius1, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void DilateDisk(Image2<int> const& input, int radius,
+        Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void ErodeDisk(Image2<int> const& input, bool zeroExterior,
+        int radius, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void OpenDisk(Image2<int> const& input, bool zeroExterior,
+        int radius, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void CloseDisk(Image2<int> const& input, bool zeroExterior,
+        int radius, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
     // Locate a pixel and walk around the edge of a component.  The input
     // (x,y) is where the search starts for a nonzero pixel.  If (x,y) is
     // outside the component, the walk is around the outside the component.
@@ -225,9 +279,37 @@ public:
         std::function<PixelType(int, int)> const& getCallback);
 
 private:
-    // Connected component labeling using depth-first search.
+    // Connected component labeling using union-find.  The ranges of pixels
+    // [chunkStart[c],chunkStart[c+1]) are labeled concurrently and then
+    // merged.  The Index type stores the indices of the pixels.
     static void GetComponents(int numNeighbors, int const* delta,
-        Image2<int>& image, std::vector<std::vector<size_t>>& components);
+        std::shared_ptr<ComputeModel> const& cmodel, Image2<int>& image,
+        std::vector<std::vector<size_t>>& components);
+
+    template <typename Index>
+    static void LabelComponents(int numNeighbors, int const* delta,
+        std::shared_ptr<ThreadPool> const& threadPool,
+        std::vector<size_t> const& chunkStart, Image2<int>& image,
+        std::vector<std::vector<size_t>>& components);
+
+    // Support for the morphology with large structuring elements.  The
+    // image is dilated or eroded in place by the segment of the pixels
+    // (x+t*dx,y+t*dy) for |t| <= radius, where (dx,dy) is (1,0), (0,1),
+    // (1,1) or (1,-1).  The pixels outside the image have value 'pad'.
+    static void MorphologyLine(bool dilate, int pad, int dx, int dy,
+        int radius, std::shared_ptr<ComputeModel> const& cmodel,
+        Image2<int>& image);
+
+    // Dilate or erode by the octagon of a disk.
+    static void MorphologyDisk(bool dilate, int pad, int radius,
+        Image2<int> const& input, Image2<int>& output,
+        std::shared_ptr<ComputeModel> const& cmodel);
+
+    // The octagon of a disk of the specified radius is the Minkowski sum of
+    // the square of radius 'squareRadius' and the diagonal segments of
+    // radius 'diagonalRadius'.
+    static void GetDiskRadii(int radius, int& squareRadius,
+        int& diagonalRadius);
 
     // Support for GetL2Distance.
     static void L2Check(int x, int y, int dx, int dy, Image2<int>& xNear,
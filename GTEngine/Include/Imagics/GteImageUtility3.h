@@ -3,12 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2017/02/05)
+// File Version: 3.2.1 (2026/10/18)
 
 #pragma once
 
 #include <Imagics/GteImage3.h>
+#include <LowLevel/GteComputeModel.h>
 #include <functional>
+#include <memory>
 
 namespace gte
 {
@@ -28,23 +30,32 @@ public:
     // Compute the 6-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The components
+    // are numbered in the order of their first voxels, and the indices of a
+    // component are increasing.  When the compute model has a thread pool,
+    // ranges of slices are labeled concurrently; the output does not depend
+    // on the number of threads.
     static void GetComponents6(Image3<int>& image,
-        std::vector<std::vector<size_t>>& components);
+        std::vector<std::vector<size_t>>& components,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
 
     // Compute the 18-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The ordering
+    // and the compute model are as for GetComponents6.
     static void GetComponents18(Image3<int>& image,
-        std::vector<std::vector<size_t>>& components);
+        std::vector<std::vector<size_t>>& components,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
 
     // Compute the 26-connected components of a binary image.  The input image
     // is modified to avoid the cost of making a copy.  On output, the image
     // values are the labels for the components.  The array components[k],
-    // k >= 1, contains the indices for the k-th component.
+    // k >= 1, contains the indices for the k-th component.  The ordering
+    // and the compute model are as for GetComponents6.
     static void GetComponents26(Image3<int>& image,
-        std::vector<std::vector<size_t>>& components);
+        std::vector<std::vector<size_t>>& components,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
 
     // Dilate the image using a structuring element that contains the
     // 6-connected neighbors.
@@ -58,6 +69,34 @@ public:
     // 26-connected neighbors.
     static void Dilate26(Image3<int> const& inImage, Image3<int>& outImage);
 
+    // Dilation, erosion, opening and closing with a box structuring element
+    // of (2*radius0+1)-by-(2*radius1+1)-by-(2*radius2+1) voxels centered at a
+    // voxel.  The box is decomposed into segments along the axes that are
+    // processed by MorphologyLines, so the cost per voxel does not depend on
+    // the radii.  For a binary image, the radii 1 give the same interior
+    // voxels as Dilate26; Dilate26 does not write the boundary voxels,
+    // whereas DilateBox also dilates them.  The output image may be the
+    // input image.  If zeroExterior is true, the image exterior is assumed
+    // to consist of 0-valued voxels; otherwise, the voxels of the erosion
+    // depend only on the image voxels in their boxes.  When the compute
+    // model has a thread pool, ranges of rows or of slices are processed
+    // concurrently.
+    static void DilateBox(Image3<int> const& inImage, int radius0,
+        int radius1, int radius2, Image3<int>& outImage,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void ErodeBox(Image3<int> const& inImage, bool zeroExterior,
+        int radius0, int radius1, int radius2, Image3<int>& outImage,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void OpenBox(Image3<int> const& inImage, bool zeroExterior,
+        int radius0, int radius1, int radius2, Image3<int>& outImage,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    static void CloseBox(Image3<int> const& inImage, bool zeroExterior,
+        int radius0, int radius1, int radius2, Image3<int>& outImage,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
     // Compute coordinate-directional convex set.  For a given coordinate
     // direction (x, y, or z), identify the first and last 1-valued voxels
     // on a segment of voxels in that direction.  All voxels from first to
@@ -82,9 +121,23 @@ private:
     static void Dilate(int numNeighbors, std::array<int, 3> const* delta,
         Image3<int> const& inImage, Image3<int>& outImage);
 
-    // Connected component labeling using depth-first search.
+    // Dilate or erode the image in place by the segment of the voxels whose
+    // coordinates differ from those of a voxel by at most 'radius' along
+    // the specified axis.  The voxels outside the image have value 'pad'.
+    static void MorphologyLine(bool dilate, int pad, int axis, int radius,
+        std::shared_ptr<ComputeModel> const& cmodel, Image3<int>& image);
+
+    // Connected component labeling using union-find, as in ImageUtility2,
+    // with chunks that are ranges of slices.
     static void GetComponents(int numNeighbors, int const* delta,
-        Image3<int>& image, std::vector<std::vector<size_t>>& components);
+        std::shared_ptr<ComputeModel> const& cmodel, Image3<int>& image,
+        std::vector<std::vector<size_t>>& components);
+
+    template <typename Index>
+    static void LabelComponents(int numNeighbors, int const* delta,
+        std::shared_ptr<ThreadPool> const& threadPool,
+        std::vector<size_t> const& chunkStart, Image3<int>& image,
+        std::vector<std::vector<size_t>>& components);
 };
 
 
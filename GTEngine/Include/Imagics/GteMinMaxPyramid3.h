@@ -0,0 +1,279 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <Imagics/GteImage3.h>
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+// A pyramid of the minimum and maximum values of blocks of voxels of a 3D
+// image, used to find the voxels that a level surface can intersect
+// without visiting the others.  A block of level 0 consists of
+// blockSize^3 voxels: block (bx,by,bz) contains the voxels (x,y,z) with
+// x/blockSize = bx, y/blockSize = by and z/blockSize = bz, and its range
+// is that of the image values at the corners of its voxels.  The blocks at
+// the boundary of the image can have fewer voxels.  A block of level k+1
+// consists of 2x2x2 blocks of level k.  The pyramid is created once and
+// can then be queried for any number of levels, for example, when a user
+// interactively changes the level of SurfaceExtractor::Extract.  A block
+// is active for a level when it has a value smaller than the level and a
+// value not smaller than the level, which is the classification of the
+// image values by SurfaceExtractorSlices.
+
+namespace gte
+{
+
+template <typename Real>
+class MinMaxPyramid3
+{
+public:
+    // Construction.  The blockSize must be positive.  The image must exist
+    // during the lifetime of the pyramid, and the pyramid must be created
+    // again when the image values change.  When the compute model has a
+    // thread pool, the ranges of level 0 are computed concurrently.
+    MinMaxPyramid3(Image3<Real> const& image, int blockSize,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    // Member access.  The numbers of blocks are those of level 0.
+    inline Image3<Real> const& GetImage() const;
+    inline int GetBlockSize() const;
+    inline int GetNumBlocks(int d) const;
+    inline int GetNumLevels() const;
+
+    // Get the active blocks of level 0 for the specified image level.  The
+    // output has GetNumBlocks(0)*GetNumBlocks(1)*GetNumBlocks(2) elements,
+    // active[bx + numBlocks0*(by + numBlocks1*bz)], each 1 for an active
+    // block or 0 otherwise.  The pyramid is traversed from its coarsest
+    // level, so the blocks of inactive regions are not visited.  The return
+    // value is the number of active blocks.
+    int GetActiveBlocks(Real level, std::vector<char>& active) const;
+
+private:
+    struct Level
+    {
+        std::array<int, 3> numBlocks;
+        std::vector<Real> minimum, maximum;
+    };
+
+    void Visit(int k, int bx, int by, int bz, Real level,
+        std::vector<char>& active, int& numActive) const;
+
+    Image3<Real> const& mImage;
+    int mBlockSize;
+    std::vector<Level> mLevels;
+};
+
+
+template <typename Real>
+MinMaxPyramid3<Real>::MinMaxPyramid3(Image3<Real> const& image,
+    int blockSize, std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mImage(image),
+    mBlockSize(blockSize)
+{
+    LogAssert(blockSize > 0, "Invalid block size.");
+
+    // The blocks of level 0 cover the voxels, of which there are one fewer
+    // than the samples along each axis.
+    Level level0;
+    std::array<int, 3> bound;
+    for (int d = 0; d < 3; ++d)
+    {
+        bound[d] = image.GetDimension(d);
+        if (bound[d] < 2)
+        {
+            return;
+        }
+        level0.numBlocks[d] = (bound[d] - 1 + blockSize - 1) / blockSize;
+    }
+
+    size_t const numBlocks0 = static_cast<size_t>(level0.numBlocks[0]) *
+        level0.numBlocks[1] * level0.numBlocks[2];
+    level0.minimum.resize(numBlocks0);
+    level0.maximum.resize(numBlocks0);
+
+    // The range of block (bx,by,bz) is that of the samples (x,y,z) with
+    // bx*blockSize <= x <= min((bx+1)*blockSize, bound0-1), and similarly
+    // for y and z.  The slabs of blocks with the same bz are independent.
+    auto computeSlabs = [this, &image, &bound, &level0](int bzmin, int bzmax)
+    {
+        Real const* pixels = image.GetPixels().data();
+        int const nbx = level0.numBlocks[0], nby = level0.numBlocks[1];
+        for (int bz = bzmin; bz < bzmax; ++bz)
+        {
+            int const zmin = bz * mBlockSize;
+            int const zmax = std::min(zmin + mBlockSize, bound[2] - 1);
+            for (int by = 0; by < nby; ++by)
+            {
+                int const ymin = by * mBlockSize;
+                int const ymax = std::min(ymin + mBlockSize, bound[1] - 1);
+                for (int bx = 0; bx < nbx; ++bx)
+                {
+                    int const xmin = bx * mBlockSize;
+                    int const xmax = std::min(xmin + mBlockSize, bound[0] - 1);
+                    Real const* first = pixels + xmin + bound[0] * (ymin + static_cast<size_t>(bound[1]) * zmin);
+                    Real minimum = *first, maximum = *first;
+                    for (int z = zmin; z <= zmax; ++z)
+                    {
+                        for (int y = ymin; y <= ymax; ++y)
+                        {
+                            Real const* row = pixels + bound[0] * (y + static_cast<size_t>(bound[1]) * z);
+                            for (int x = xmin; x <= xmax; ++x)
+                            {
+                                minimum = std::min(minimum, row[x]);
+                                maximum = std::max(maximum, row[x]);
+                            }
+                        }
+                    }
+                    size_t const i = bx + nbx * (by + static_cast<size_t>(nby) * bz);
+                    level0.minimum[i] = minimum;
+                    level0.maximum[i] = maximum;
+                }
+            }
+        }
+    };
+
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    if (threadPool)
+    {
+        threadPool->ParallelFor(0, level0.numBlocks[2], 0, computeSlabs);
+    }
+    else
+    {
+        computeSlabs(0, level0.numBlocks[2]);
+    }
+    mLevels.push_back(std::move(level0));
+
+    // Each coarser level combines 2x2x2 blocks of the finer level, stopping
+    // when the level has a single block.
+    while (mLevels.back().numBlocks[0] > 1 || mLevels.back().numBlocks[1] > 1
+        || mLevels.back().numBlocks[2] > 1)
+    {
+        Level const& fine = mLevels.back();
+        Level coarse;
+        for (int d = 0; d < 3; ++d)
+        {
+            coarse.numBlocks[d] = (fine.numBlocks[d] + 1) / 2;
+        }
+        size_t const numBlocks = static_cast<size_t>(coarse.numBlocks[0]) *
+            coarse.numBlocks[1] * coarse.numBlocks[2];
+        coarse.minimum.resize(numBlocks);
+        coarse.maximum.resize(numBlocks);
+        for (int bz = 0, i = 0; bz < coarse.numBlocks[2]; ++bz)
+        {
+            for (int by = 0; by < coarse.numBlocks[1]; ++by)
+            {
+                for (int bx = 0; bx < coarse.numBlocks[0]; ++bx, ++i)
+                {
+                    bool first = true;
+                    for (int cz = 2 * bz; cz < std::min(2 * bz + 2, fine.numBlocks[2]); ++cz)
+                    {
+                        for (int cy = 2 * by; cy < std::min(2 * by + 2, fine.numBlocks[1]); ++cy)
+                        {
+                            for (int cx = 2 * bx; cx < std::min(2 * bx + 2, fine.numBlocks[0]); ++cx)
+                            {
+                                size_t j = cx + fine.numBlocks[0] * (cy + static_cast<size_t>(fine.numBlocks[1]) * cz);
+                                if (first)
+                                {
+                                    coarse.minimum[i] = fine.minimum[j];
+                                    coarse.maximum[i] = fine.maximum[j];
+                                    first = false;
+                                }
+                                else
+                                {
+                                    coarse.minimum[i] = std::min(coarse.minimum[i], fine.minimum[j]);
+                                    coarse.maximum[i] = std::max(coarse.maximum[i], fine.maximum[j]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        mLevels.push_back(std::move(coarse));
+    }
+}
+
+template <typename Real> inline
+Image3<Real> const& MinMaxPyramid3<Real>::GetImage() const
+{
+    return mImage;
+}
+
+template <typename Real> inline
+int MinMaxPyramid3<Real>::GetBlockSize() const
+{
+    return mBlockSize;
+}
+
+template <typename Real> inline
+int MinMaxPyramid3<Real>::GetNumBlocks(int d) const
+{
+    return (mLevels.size() > 0 ? mLevels[0].numBlocks[d] : 0);
+}
+
+template <typename Real> inline
+int MinMaxPyramid3<Real>::GetNumLevels() const
+{
+    return static_cast<int>(mLevels.size());
+}
+
+template <typename Real>
+int MinMaxPyramid3<Real>::GetActiveBlocks(Real level,
+    std::vector<char>& active) const
+{
+    int numActive = 0;
+    if (mLevels.size() == 0)
+    {
+        active.clear();
+        return numActive;
+    }
+
+    active.assign(static_cast<size_t>(GetNumBlocks(0)) * GetNumBlocks(1) *
+        GetNumBlocks(2), 0);
+    Visit(static_cast<int>(mLevels.size()) - 1, 0, 0, 0, level, active, numActive);
+    return numActive;
+}
+
+template <typename Real>
+void MinMaxPyramid3<Real>::Visit(int k, int bx, int by, int bz, Real level,
+    std::vector<char>& active, int& numActive) const
+{
+    Level const& current = mLevels[k];
+    size_t const i = bx + current.numBlocks[0] * (by +
+        static_cast<size_t>(current.numBlocks[1]) * bz);
+    if (!(current.minimum[i] < level) || current.maximum[i] < level)
+    {
+        return;
+    }
+
+    if (k == 0)
+    {
+        active[i] = 1;
+        ++numActive;
+        return;
+    }
+
+    Level const& fine = mLevels[k - 1];
+    for (int cz = 2 * bz; cz < std::min(2 * bz + 2, fine.numBlocks[2]); ++cz)
+    {
+        for (int cy = 2 * by; cy < std::min(2 * by + 2, fine.numBlocks[1]); ++cy)
+        {
+            for (int cx = 2 * bx; cx < std::min(2 * bx + 2, fine.numBlocks[0]); ++cx)
+            {
+                Visit(k - 1, cx, cy, cz, level, active, numActive);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,170 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteLogger.h>
+#include <algorithm>
+#include <vector>
+
+// Dilation (maximum) or erosion (minimum) of the samples of lines by a
+// segment of 2*radius+1 samples centered at each sample, using the
+// algorithm of van Herk and of Gil and Werman.  The padded line is
+// partitioned into blocks of 2*radius+1 samples.  The running extreme from
+// the start of each block (g) and the running extreme to the end of each
+// block (h) are computed.  The window [c-radius,c+radius] of the padded
+// sample c is the union of the end of one block and the start of the next,
+// so its extreme is extreme(h[c-radius], g[c+radius]).  The cost is 3
+// comparisons per sample, regardless of the radius.  Samples outside the
+// line have the value 'pad'.
+//
+// Execute processes 'numLanes' lines with the same number of samples at
+// once, for example, the columns of a range of an image, so the inner loops
+// are over lanes that are contiguous in memory and can be vectorized by the
+// compiler.  The callers provide
+//   load(i, lanes):  copy sample i of each line to lanes[0..numLanes-1]
+//   store(i, lanes): copy lanes[0..numLanes-1] to sample i of each line
+// Every sample is loaded before any sample is stored, so the output can be
+// written over the input.  An object is not thread-safe, so each thread
+// must use its own object.
+
+namespace gte
+{
+
+template <typename PixelType>
+class MorphologyLines
+{
+public:
+    // Construction.  The radius must be nonnegative.
+    MorphologyLines(bool dilate, int radius, PixelType pad);
+
+    template <typename Load, typename Store>
+    void Execute(int numSamples, int numLanes, Load const& load,
+        Store const& store);
+
+private:
+    bool mDilate;
+    int mRadius;
+    PixelType mPad;
+    std::vector<PixelType> mG, mH, mResult;
+};
+
+
+template <typename PixelType>
+MorphologyLines<PixelType>::MorphologyLines(bool dilate, int radius,
+    PixelType pad)
+    :
+    mDilate(dilate),
+    mRadius(radius),
+    mPad(pad)
+{
+    LogAssert(radius >= 0, "Invalid radius.");
+}
+
+template <typename PixelType>
+template <typename Load, typename Store>
+void MorphologyLines<PixelType>::Execute(int numSamples, int numLanes,
+    Load const& load, Store const& store)
+{
+    if (numSamples <= 0 || numLanes <= 0 || mRadius == 0)
+    {
+        return;
+    }
+
+    // The padded line has 'radius' samples of value 'pad' at each end.
+    int const window = 2 * mRadius + 1;
+    int const numPadded = numSamples + 2 * mRadius;
+    size_t const size = static_cast<size_t>(numPadded) * numLanes;
+    mG.resize(size);
+    mH.resize(size);
+    mResult.resize(numLanes);
+
+    // Load the samples into h and compute g.
+    for (int j = 0; j < numPadded; ++j)
+    {
+        PixelType* h = &mH[static_cast<size_t>(j) * numLanes];
+        int i = j - mRadius;
+        if (0 <= i && i < numSamples)
+        {
+            load(i, h);
+        }
+        else
+        {
+            std::fill(h, h + numLanes, mPad);
+        }
+
+        PixelType* g = &mG[static_cast<size_t>(j) * numLanes];
+        if (j % window == 0)
+        {
+            std::copy(h, h + numLanes, g);
+        }
+        else if (mDilate)
+        {
+            PixelType const* gPrev = g - numLanes;
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                g[lane] = std::max(gPrev[lane], h[lane]);
+            }
+        }
+        else
+        {
+            PixelType const* gPrev = g - numLanes;
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                g[lane] = std::min(gPrev[lane], h[lane]);
+            }
+        }
+    }
+
+    // Compute h from the end of each block.
+    for (int j = numPadded - 2; j >= 0; --j)
+    {
+        if ((j + 1) % window != 0)
+        {
+            PixelType* h = &mH[static_cast<size_t>(j) * numLanes];
+            PixelType const* hNext = h + numLanes;
+            if (mDilate)
+            {
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    h[lane] = std::max(h[lane], hNext[lane]);
+                }
+            }
+            else
+            {
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    h[lane] = std::min(h[lane], hNext[lane]);
+                }
+            }
+        }
+    }
+
+    // The window of sample i is [i,i+2*radius] in padded coordinates.
+    for (int i = 0; i < numSamples; ++i)
+    {
+        PixelType const* h = &mH[static_cast<size_t>(i) * numLanes];
+        PixelType const* g = &mG[static_cast<size_t>(i + 2 * mRadius) * numLanes];
+        if (mDilate)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                mResult[lane] = std::max(h[lane], g[lane]);
+            }
+        }
+        else
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                mResult[lane] = std::min(h[lane], g[lane]);
+            }
+        }
+        store(i, mResult.data());
+    }
+}
+
+}
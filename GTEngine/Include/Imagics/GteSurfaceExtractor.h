@@ -3,14 +3,21 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2018/10/05)
+// File Version: 3.2.1 (2026/10/18)
 
 #pragma once
 
 #include <Imagics/GteMarchingCubes.h>
 #include <Imagics/GteImage3.h>
+#include <Imagics/GteMinMaxPyramid3.h>
+#include <Imagics/GteSurfaceExtractorSlices.h>
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
 #include <Mathematics/GteUniqueVerticesTriangles.h>
 #include <Mathematics/GteVector3.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 
 namespace gte
 {
@@ -57,6 +64,32 @@ public:
     // indices into 'vertices'
     bool Extract(Real level, std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const;
 
+    // Extract the triangle mesh approximating F = 0 for all the voxels, as
+    // in the previous function, but with a single vertex per lattice edge
+    // that the level surface crosses, so MakeUnique is not needed.  Image
+    // values equal to the level are treated as larger than the level, so
+    // the extraction does not fail.  The vertex of an edge is computed only
+    // once, from the image values of its endpoints.  When the compute model
+    // has a thread pool, ranges of layers of voxels are processed
+    // concurrently; see SurfaceExtractorSlices.  The mesh does not depend on
+    // the number of threads.  The vertex indices are of type 'int', so the
+    // mesh can have at most 2^31-1 vertices.  The return value is 'false'
+    // when the vertices can exceed that limit, in which case the mesh is
+    // empty; each range of layers verifies before each layer that its at
+    // most 3*bound0*bound1 new vertices fit.
+    bool Extract(Real level, std::shared_ptr<ComputeModel> const& cmodel,
+        std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const;
+
+    // The same extraction as the previous function, but only the voxels of
+    // the blocks of the pyramid whose ranges contain the level are visited,
+    // so the cost is proportional to the area of the level surface rather
+    // than to the volume of the image.  The pyramid must be that of the
+    // image of this object.  It is created once and reused for all levels.
+    // The return value is that of the previous function.
+    bool Extract(Real level, MinMaxPyramid3<Real> const& pyramid,
+        std::shared_ptr<ComputeModel> const& cmodel,
+        std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const;
+
     // The extraction has duplicate vertices on edges shared by voxels.  This
     // function will eliminate the duplication.
     void MakeUnique(std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const;
@@ -81,6 +114,12 @@ public:
 protected:
     Vector3<Real> GetGradient(Vector3<Real> position) const;
 
+    // Support for the Extract functions that have a compute model.  The
+    // pyramid is null when all the voxels are visited.
+    bool ExtractSlabs(Real level, MinMaxPyramid3<Real> const* pyramid,
+        std::shared_ptr<ComputeModel> const& cmodel,
+        std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const;
+
     Image3<Real> const& mImage;
 };
 
@@ -202,6 +241,179 @@ bool SurfaceExtractor<Real>::Extract(Real level, std::vector<Vector3<Real>>& ver
     return true;
 }
 
+template <typename Real>
+bool SurfaceExtractor<Real>::Extract(Real level,
+    std::shared_ptr<ComputeModel> const& cmodel,
+    std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const
+{
+    return ExtractSlabs(level, nullptr, cmodel, vertices, indices);
+}
+
+template <typename Real>
+bool SurfaceExtractor<Real>::Extract(Real level,
+    MinMaxPyramid3<Real> const& pyramid,
+    std::shared_ptr<ComputeModel> const& cmodel,
+    std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const
+{
+    LogAssert(&pyramid.GetImage() == &mImage, "The pyramid is not that of the image.");
+    return ExtractSlabs(level, &pyramid, cmodel, vertices, indices);
+}
+
+template <typename Real>
+bool SurfaceExtractor<Real>::ExtractSlabs(Real level,
+    MinMaxPyramid3<Real> const* pyramid,
+    std::shared_ptr<ComputeModel> const& cmodel,
+    std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const
+{
+    vertices.clear();
+    indices.clear();
+
+    int const bound0 = mImage.GetDimension(0);
+    int const bound1 = mImage.GetDimension(1);
+    int const numLayers = mImage.GetDimension(2) - 1;
+    if (bound0 < 2 || bound1 < 2 || numLayers < 1)
+    {
+        return true;
+    }
+
+    // Each range of layers (slab) generates the vertices of the edges of
+    // its lower slices and the triangles of its voxels.  The vertices of
+    // the upper slice of a slab are those of the lower slice of the next
+    // slab, which are referenced by negative indices until the slabs are
+    // concatenated.
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    int const numSlabs = (threadPool ?
+        std::min(4 * static_cast<int>(threadPool->GetNumThreads()), numLayers) : 1);
+    std::vector<std::vector<Vector3<Real>>> slabVertices(numSlabs);
+    std::vector<std::vector<int>> slabIndices(numSlabs);
+    size_t const sliceSize = static_cast<size_t>(bound0) * bound1;
+    Real const* image = mImage.GetPixels().data();
+
+    // A slice has at most 2*sliceSize edges and a layer has at most
+    // sliceSize edges between its slices.  A slab stops when the indices
+    // of its next layer could exceed the range of int.
+    int64_t const maxIndex = static_cast<int64_t>(std::numeric_limits<int>::max());
+    int64_t const maxLayerVertices = 3 * static_cast<int64_t>(sliceSize);
+    if (2 * static_cast<int64_t>(sliceSize) > maxIndex)
+    {
+        LogError("The vertex indices can exceed the range of int.");
+        return false;
+    }
+    std::vector<char> overflow(numSlabs, 0);
+
+    // The layer z of voxels is processed with the active blocks of the
+    // layer z/blockSize of blocks.
+    std::vector<char> active;
+    int blockSize = 0;
+    size_t blocksPerLayer = 0;
+    if (pyramid)
+    {
+        if (pyramid->GetActiveBlocks(level, active) == 0)
+        {
+            return true;
+        }
+        blockSize = pyramid->GetBlockSize();
+        blocksPerLayer = static_cast<size_t>(pyramid->GetNumBlocks(0)) * pyramid->GetNumBlocks(1);
+    }
+    auto setActiveBlocks = [&](SurfaceExtractorSlices<Real>& slices, int z)
+    {
+        if (pyramid)
+        {
+            slices.SetActiveBlocks(blockSize, active.data() + blocksPerLayer * (z / blockSize));
+        }
+    };
+
+    auto extractSlabs = [&](int smin, int smax)
+    {
+        for (int s = smin; s < smax; ++s)
+        {
+            int const zmin = static_cast<int>(static_cast<int64_t>(numLayers) * s / numSlabs);
+            int const zmax = static_cast<int>(static_cast<int64_t>(numLayers) * (s + 1) / numSlabs);
+            SurfaceExtractorSlices<Real> slices(*this, bound0, bound1);
+            std::vector<Vector3<Real>>& sVertices = slabVertices[s];
+            std::vector<int>& sIndices = slabIndices[s];
+
+            setActiveBlocks(slices, zmin);
+            slices.AddPlane(image + sliceSize * zmin, zmin, level, true, sVertices);
+            slices.Advance();
+            for (int z = zmin; z < zmax; ++z)
+            {
+                if (slices.GetNextIndex() + maxLayerVertices > maxIndex)
+                {
+                    overflow[s] = 1;
+                    break;
+                }
+
+                Real const* slice0 = image + sliceSize * z;
+                Real const* slice1 = slice0 + sliceSize;
+                setActiveBlocks(slices, z);
+                slices.AddLayer(slice0, slice1, z, level, sVertices);
+                slices.AddPlane(slice1, z + 1, level, s + 1 == numSlabs || z + 1 < zmax,
+                    sVertices);
+                slices.AddTriangles(slice0, slice1, level, sIndices);
+                slices.Advance();
+            }
+        }
+    };
+
+    if (numSlabs > 1)
+    {
+        threadPool->ParallelFor(0, numSlabs, 1, extractSlabs);
+    }
+    else
+    {
+        extractSlabs(0, numSlabs);
+    }
+
+    // Concatenate the slabs.  The vertex r of the upper slice of slab s is
+    // the vertex r of slab s+1.  The offsets are summed in 64 bits so that
+    // a mesh with more than 2^31-1 vertices is detected.
+    std::vector<int64_t> vertexOffsets(numSlabs + 1, 0);
+    std::vector<size_t> indexOffsets(numSlabs + 1, 0);
+    bool valid = true;
+    for (int s = 0; s < numSlabs; ++s)
+    {
+        vertexOffsets[s + 1] = vertexOffsets[s] + static_cast<int64_t>(slabVertices[s].size());
+        indexOffsets[s + 1] = indexOffsets[s] + slabIndices[s].size();
+        valid = valid && overflow[s] == 0;
+    }
+    if (!valid || vertexOffsets[numSlabs] > maxIndex)
+    {
+        LogError("The vertex indices exceed the range of int.");
+        return false;
+    }
+    vertices.resize(static_cast<size_t>(vertexOffsets[numSlabs]));
+    indices.resize(indexOffsets[numSlabs]);
+
+    auto concatenateSlabs = [&](int smin, int smax)
+    {
+        for (int s = smin; s < smax; ++s)
+        {
+            int const offset = static_cast<int>(vertexOffsets[s]);
+            int const nextOffset = static_cast<int>(vertexOffsets[s + 1]);
+            std::copy(slabVertices[s].begin(), slabVertices[s].end(),
+                vertices.begin() + offset);
+            int* output = indices.data() + indexOffsets[s];
+            for (auto index : slabIndices[s])
+            {
+                *output++ = (index >= 0 ? index + offset : nextOffset - index - 1);
+            }
+            std::vector<Vector3<Real>>().swap(slabVertices[s]);
+            std::vector<int>().swap(slabIndices[s]);
+        }
+    };
+
+    if (numSlabs > 1)
+    {
+        threadPool->ParallelFor(0, numSlabs, 1, concatenateSlabs);
+    }
+    else
+    {
+        concatenateSlabs(0, numSlabs);
+    }
+    return true;
+}
+
 template <typename Real>
 void SurfaceExtractor<Real>::MakeUnique(std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const
 {
@@ -0,0 +1,357 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.2 (2026/10/18)
+
+#pragma once
+
+#include <Imagics/GteMarchingCubes.h>
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteVector3.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Support for extracting a level surface of a 3D image one layer of voxels
+// at a time, where layer z consists of the voxels between the slices z and
+// z+1 of the image.  Each edge of the lattice whose endpoints are on
+// opposite sides of the level has one vertex, and the vertex is shared by
+// the triangles of all the voxels that contain the edge, so the mesh needs
+// no welding.  Only the indices of the vertices on the edges of two slices
+// are stored.  A slice has bound0*bound1 samples stored in the order
+// x + bound0*y.  A sample is classified as below the level when its value
+// is smaller than the level and above the level otherwise, so the
+// extraction does not fail when a sample equals the level.
+//
+// The layers [zmin,zmax) are processed by
+//   slices.AddPlane(slice[zmin], zmin, level, true, vertices);
+//   slices.Advance();
+//   for (z = zmin; z < zmax; ++z)
+//   {
+//       slices.AddLayer(slice[z], slice[z+1], z, level, vertices);
+//       slices.AddPlane(slice[z+1], z+1, level, owned, vertices);
+//       slices.AddTriangles(slice[z], slice[z+1], level, indices);
+//       slices.Advance();
+//   }
+// The vertices are generated in the order of the edges of slice zmin, the
+// edges between slices zmin and zmin+1, the edges of slice zmin+1, and so
+// on, which does not depend on zmin.  When the vertices of slice zmax are
+// computed by another object, for example, for concurrent processing of
+// ranges of layers, the last AddPlane(...) is passed owned = false.  The
+// vertices of that slice are not generated and the triangles reference
+// vertex r of the slice, in the order of its edges, by the index -(r+1).
+//
+// The voxels that the level surface cannot intersect can be skipped by
+// calling SetActiveBlocks(...) before AddPlane(...) and AddLayer(...) with
+// the active blocks of MinMaxPyramid3 for the layer of blocks that contains
+// layer z.  The blocks that contain an edge crossed by the level surface
+// are active for all the layers of blocks that contain the edge, so the
+// vertices are generated in the same order as without skipping.
+//
+// The vertex indices are of type 'int'.  AddPlane(...) generates at most
+// 2*bound0*bound1 vertices and AddLayer(...) at most bound0*bound1, so the
+// caller can verify before each call that the indices cannot exceed
+// 2^31-1; SurfaceExtractor and SurfaceExtractorStream do so.  The
+// generation of an index larger than 2^31-1 is reported by LogAssert.
+
+namespace gte
+{
+
+template <typename Real>
+class SurfaceExtractorSlices
+{
+public:
+    // Construction.  The marching cubes object provides the table.  The
+    // index of the first vertex is 'firstIndex'.
+    SurfaceExtractorSlices(MarchingCubes const& marchingCubes, int bound0,
+        int bound1, int firstIndex = 0);
+
+    // The number of vertices generated so far plus firstIndex.
+    inline int GetNextIndex() const;
+
+    // Compute the vertices on the edges of slice z in the plane of the
+    // slice.
+    void AddPlane(Real const* slice, int z, Real level, bool owned,
+        std::vector<Vector3<Real>>& vertices);
+
+    // Compute the vertices on the edges between slice z and slice z+1.
+    void AddLayer(Real const* slice0, Real const* slice1, int z, Real level,
+        std::vector<Vector3<Real>>& vertices);
+
+    // Compute the triangles of the voxels between the last two slices
+    // passed to AddPlane(...).  The lower slice is slice0.
+    void AddTriangles(Real const* slice0, Real const* slice1, Real level,
+        std::vector<int>& indices);
+
+    // The upper slice becomes the lower slice.
+    void Advance();
+
+    // Process only the samples of the active blocks, where active[] has
+    // numBlocks0*numBlocks1 elements, the active flags of a layer of blocks
+    // of size blockSize stored in the order bx + numBlocks0*by.  When
+    // 'active' is null, all the samples are processed.
+    void SetActiveBlocks(int blockSize, char const* active);
+
+private:
+    // Call function(xmin,xmax) for the ranges of samples [xmin,xmax) of row
+    // y that are in active blocks, in increasing order.
+    template <typename Function>
+    void VisitRow(int y, Function const& function) const;
+
+    // Return mNextIndex and increment it.
+    inline int NewIndex();
+
+    MarchingCubes const& mMarchingCubes;
+    int mBound0, mBound1, mNextIndex;
+    int mBlockSize, mNumBlocks0, mNumBlocks1;
+    char const* mActive;
+
+    // The vertex indices of the edges of the lower (0) and upper (1) slices
+    // along the x- and y-axes and of the edges between the slices along the
+    // z-axis, indexed by the first sample of the edge.
+    std::vector<int> mXEdges[2], mYEdges[2], mZEdges;
+};
+
+
+template <typename Real>
+SurfaceExtractorSlices<Real>::SurfaceExtractorSlices(
+    MarchingCubes const& marchingCubes, int bound0, int bound1,
+    int firstIndex)
+    :
+    mMarchingCubes(marchingCubes),
+    mBound0(bound0),
+    mBound1(bound1),
+    mNextIndex(firstIndex),
+    mBlockSize(0),
+    mNumBlocks0(0),
+    mNumBlocks1(0),
+    mActive(nullptr)
+{
+    size_t const numSamples = static_cast<size_t>(bound0) * bound1;
+    for (int i = 0; i < 2; ++i)
+    {
+        mXEdges[i].resize(numSamples);
+        mYEdges[i].resize(numSamples);
+    }
+    mZEdges.resize(numSamples);
+}
+
+template <typename Real> inline
+int SurfaceExtractorSlices<Real>::GetNextIndex() const
+{
+    return mNextIndex;
+}
+
+template <typename Real> inline
+int SurfaceExtractorSlices<Real>::NewIndex()
+{
+    LogAssert(mNextIndex < std::numeric_limits<int>::max(),
+        "The vertex indices exceed the range of int.");
+    return mNextIndex++;
+}
+
+template <typename Real>
+void SurfaceExtractorSlices<Real>::AddPlane(Real const* slice, int z,
+    Real level, bool owned, std::vector<Vector3<Real>>& vertices)
+{
+    // The vertex on the edge from value f0 to value f1 is at the parameter
+    // f0/(f0 - f1) relative to the first sample, as in
+    // SurfaceExtractor::Extract.
+    int* xEdges = mXEdges[1].data();
+    int* yEdges = mYEdges[1].data();
+    Real const zReal = static_cast<Real>(z);
+    int rank = 0;
+    for (int y = 0; y < mBound1; ++y)
+    {
+        Real const yReal = static_cast<Real>(y);
+        VisitRow(y, [&](int xmin, int xmax)
+        {
+            for (int x = xmin, i = xmin + mBound0 * y; x < xmax; ++x, ++i)
+            {
+                Real f0 = slice[i] - level;
+                if (x + 1 < mBound0)
+                {
+                    Real f1 = slice[i + 1] - level;
+                    if ((f0 < (Real)0) != (f1 < (Real)0))
+                    {
+                        if (owned)
+                        {
+                            Real t = f0 * ((Real)1 / (f0 - f1));
+                            vertices.push_back({ static_cast<Real>(x) + t, yReal, zReal });
+                            xEdges[i] = NewIndex();
+                        }
+                        else
+                        {
+                            xEdges[i] = -(++rank);
+                        }
+                    }
+                }
+                if (y + 1 < mBound1)
+                {
+                    Real f1 = slice[i + mBound0] - level;
+                    if ((f0 < (Real)0) != (f1 < (Real)0))
+                    {
+                        if (owned)
+                        {
+                            Real t = f0 * ((Real)1 / (f0 - f1));
+                            vertices.push_back({ static_cast<Real>(x), yReal + t, zReal });
+                            yEdges[i] = NewIndex();
+                        }
+                        else
+                        {
+                            yEdges[i] = -(++rank);
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+template <typename Real>
+void SurfaceExtractorSlices<Real>::AddLayer(Real const* slice0,
+    Real const* slice1, int z, Real level,
+    std::vector<Vector3<Real>>& vertices)
+{
+    int* zEdges = mZEdges.data();
+    Real const zReal = static_cast<Real>(z);
+    for (int y = 0; y < mBound1; ++y)
+    {
+        Real const yReal = static_cast<Real>(y);
+        VisitRow(y, [&](int xmin, int xmax)
+        {
+            for (int x = xmin, i = xmin + mBound0 * y; x < xmax; ++x, ++i)
+            {
+                Real f0 = slice0[i] - level;
+                Real f1 = slice1[i] - level;
+                if ((f0 < (Real)0) != (f1 < (Real)0))
+                {
+                    Real t = f0 * ((Real)1 / (f0 - f1));
+                    vertices.push_back({ static_cast<Real>(x), yReal, zReal + t });
+                    zEdges[i] = NewIndex();
+                }
+            }
+        });
+    }
+}
+
+template <typename Real>
+void SurfaceExtractorSlices<Real>::AddTriangles(Real const* slice0,
+    Real const* slice1, Real level, std::vector<int>& indices)
+{
+    int const* xEdges[2] = { mXEdges[0].data(), mXEdges[1].data() };
+    int const* yEdges[2] = { mYEdges[0].data(), mYEdges[1].data() };
+    int const* zEdges = mZEdges.data();
+    for (int y = 0; y + 1 < mBound1; ++y)
+    {
+        int const i0 = mBound0 * y;
+        VisitRow(y, [&](int xmin, int xmax)
+        {
+            for (int x = xmin; x < std::min(xmax, mBound0 - 1); ++x)
+            {
+                // The corners are ordered as in SurfaceExtractor::Extract.
+                int const i = i0 + x;
+                int entry = 0;
+                entry |= (slice0[i] < level ? 0x01 : 0);
+                entry |= (slice0[i + 1] < level ? 0x02 : 0);
+                entry |= (slice0[i + mBound0] < level ? 0x04 : 0);
+                entry |= (slice0[i + mBound0 + 1] < level ? 0x08 : 0);
+                entry |= (slice1[i] < level ? 0x10 : 0);
+                entry |= (slice1[i + 1] < level ? 0x20 : 0);
+                entry |= (slice1[i + mBound0] < level ? 0x40 : 0);
+                entry |= (slice1[i + mBound0 + 1] < level ? 0x80 : 0);
+                if (entry == 0 || entry == 0xFF)
+                {
+                    continue;
+                }
+
+                // The corners j0 and j1 of a vertex differ in the bit of the
+                // axis of their edge, and the edge starts at corner j0 & j1.
+                MarchingCubes::Topology const& topology = mMarchingCubes.GetTable(entry);
+                std::array<int, MarchingCubes::MAX_VERTICES> vertexIndex;
+                for (int v = 0; v < topology.numVertices; ++v)
+                {
+                    int j0 = topology.vpair[v][0], j1 = topology.vpair[v][1];
+                    int corner = (j0 & j1);
+                    int start = i + (corner & 1) + ((corner & 2) >> 1) * mBound0;
+                    int plane = (corner & 4) >> 2;
+                    switch (j0 ^ j1)
+                    {
+                    case 1:
+                        vertexIndex[v] = xEdges[plane][start];
+                        break;
+                    case 2:
+                        vertexIndex[v] = yEdges[plane][start];
+                        break;
+                    default:
+                        vertexIndex[v] = zEdges[start];
+                        break;
+                    }
+                }
+
+                for (int t = 0; t < topology.numTriangles; ++t)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        indices.push_back(vertexIndex[topology.itriple[t][j]]);
+                    }
+                }
+            }
+        });
+    }
+}
+
+template <typename Real>
+void SurfaceExtractorSlices<Real>::Advance()
+{
+    std::swap(mXEdges[0], mXEdges[1]);
+    std::swap(mYEdges[0], mYEdges[1]);
+}
+
+template <typename Real>
+void SurfaceExtractorSlices<Real>::SetActiveBlocks(int blockSize,
+    char const* active)
+{
+    mActive = active;
+    if (active)
+    {
+        mBlockSize = blockSize;
+        mNumBlocks0 = (mBound0 - 1 + blockSize - 1) / blockSize;
+        mNumBlocks1 = (mBound1 - 1 + blockSize - 1) / blockSize;
+    }
+}
+
+template <typename Real>
+template <typename Function>
+void SurfaceExtractorSlices<Real>::VisitRow(int y, Function const& function) const
+{
+    if (!mActive)
+    {
+        function(0, mBound0);
+        return;
+    }
+
+    // A sample is in the block that contains the edges that start at it.
+    // The samples of the last row and column are in the blocks of the
+    // preceding samples.  Adjacent active blocks form a single range.
+    char const* active = mActive + mNumBlocks0 * std::min(y / mBlockSize, mNumBlocks1 - 1);
+    for (int bx = 0; bx < mNumBlocks0; ++bx)
+    {
+        if (active[bx])
+        {
+            int xmin = bx * mBlockSize;
+            while (bx + 1 < mNumBlocks0 && active[bx + 1])
+            {
+                ++bx;
+            }
+            int xmax = (bx + 1 < mNumBlocks0 ? (bx + 1) * mBlockSize : mBound0);
+            function(xmin, xmax);
+        }
+    }
+}
+
+}
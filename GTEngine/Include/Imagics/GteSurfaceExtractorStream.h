@@ -0,0 +1,201 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.1 (2026/10/18)
+
+#pragma once
+
+#include <Imagics/GteMarchingCubes.h>
+#include <Imagics/GteSurfaceExtractorSlices.h>
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteVector3.h>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Extract a level surface of a 3D image that is too large for memory.  The
+// image of bound0*bound1*bound2 samples is read one slice of bound0*bound1
+// samples at a time, in the order z = 0 through bound2-1, and only two
+// slices are resident.  After each layer of voxels is processed, its
+// vertices and triangles are passed to a writer and then discarded, so the
+// memory used does not depend on bound2 or on the size of the mesh.  The
+// mesh is the same as that of SurfaceExtractor<Real>::Extract(level, cmodel,
+// vertices, indices) for the image stored in memory: one vertex per lattice
+// edge that the level surface crosses.  The vertex indices are global, so
+// the writer can append the vertices and indices to files that together
+// form the mesh.  The indices are of type 'int', which limits the mesh to
+// 2^31-1 vertices, regardless of the size of the image.  Before each layer
+// is processed, Extract(...) verifies that the vertices it can generate,
+// 3*bound0*bound1 at most, do not exceed that limit; otherwise, the
+// extraction stops as if the next slice could not be read.
+
+namespace gte
+{
+
+template <typename Real>
+class SurfaceExtractorStream : public MarchingCubes
+{
+public:
+    // The reader copies slice z of the image to the bound0*bound1 elements
+    // of 'slice' and returns 'true', or it returns 'false' when the slice
+    // cannot be read, which terminates the extraction.  The slices are read
+    // once each and in increasing order, so the reader can stream them from
+    // a file, a memory-mapped file or a computation.
+    typedef std::function<bool(int z, Real* slice)> Reader;
+
+    // The writer receives the vertices generated for a layer of voxels and
+    // the triangles of that layer.  The first vertex has the index that
+    // follows the last vertex passed to the previous call.  Either array
+    // can be empty.
+    typedef std::function<void(std::vector<Vector3<Real>> const& vertices,
+        std::vector<int> const& indices)> Writer;
+
+    // Construction.  The bounds must be at least 2.
+    SurfaceExtractorStream(int bound0, int bound1, int bound2);
+
+    // Member access.
+    inline int GetDimension(int d) const;
+
+    // The number of vertices and triangles passed to the writer by the last
+    // call to Extract(...).
+    inline int GetNumVertices() const;
+    inline size_t GetNumTriangles() const;
+
+    // Extract the level surface.  The return value is 'false' when a slice
+    // cannot be read or when the vertex indices of the next layer could
+    // exceed 2^31-1, in which case the writer has received the mesh of the
+    // layers that precede the slice.
+    bool Extract(Real level, Reader const& reader, Writer const& writer);
+
+    // Extract the level surface from a raw file of Real values stored in
+    // the order x + bound0*(y + bound1*z), starting at the specified byte
+    // offset, for example, the size of a file header.
+    bool Extract(Real level, std::string const& filename, std::streamoff offset,
+        Writer const& writer);
+
+private:
+    int mBound[3];
+    int mNumVertices;
+    size_t mNumTriangles;
+};
+
+
+template <typename Real>
+SurfaceExtractorStream<Real>::SurfaceExtractorStream(int bound0, int bound1,
+    int bound2)
+    :
+    mNumVertices(0),
+    mNumTriangles(0)
+{
+    LogAssert(bound0 >= 2 && bound1 >= 2 && bound2 >= 2, "Invalid bounds.");
+    mBound[0] = bound0;
+    mBound[1] = bound1;
+    mBound[2] = bound2;
+}
+
+template <typename Real> inline
+int SurfaceExtractorStream<Real>::GetDimension(int d) const
+{
+    return mBound[d];
+}
+
+template <typename Real> inline
+int SurfaceExtractorStream<Real>::GetNumVertices() const
+{
+    return mNumVertices;
+}
+
+template <typename Real> inline
+size_t SurfaceExtractorStream<Real>::GetNumTriangles() const
+{
+    return mNumTriangles;
+}
+
+template <typename Real>
+bool SurfaceExtractorStream<Real>::Extract(Real level, Reader const& reader,
+    Writer const& writer)
+{
+    mNumVertices = 0;
+    mNumTriangles = 0;
+
+    size_t const sliceSize = static_cast<size_t>(mBound[0]) * mBound[1];
+
+    // A slice has at most 2*sliceSize edges and a layer has at most
+    // sliceSize edges between its slices.
+    int64_t const maxIndex = static_cast<int64_t>(std::numeric_limits<int>::max());
+    int64_t const maxLayerVertices = 3 * static_cast<int64_t>(sliceSize);
+    if (2 * static_cast<int64_t>(sliceSize) > maxIndex)
+    {
+        LogError("The vertex indices can exceed the range of int.");
+        return false;
+    }
+
+    std::vector<Real> slice0(sliceSize), slice1(sliceSize);
+    std::vector<Vector3<Real>> vertices;
+    std::vector<int> indices;
+    SurfaceExtractorSlices<Real> slices(*this, mBound[0], mBound[1]);
+
+    if (!reader(0, slice0.data()))
+    {
+        return false;
+    }
+    slices.AddPlane(slice0.data(), 0, level, true, vertices);
+    slices.Advance();
+
+    for (int z = 0; z + 1 < mBound[2]; ++z)
+    {
+        if (slices.GetNextIndex() + maxLayerVertices > maxIndex)
+        {
+            LogError("The vertex indices can exceed the range of int.");
+            return false;
+        }
+
+        if (!reader(z + 1, slice1.data()))
+        {
+            return false;
+        }
+
+        slices.AddLayer(slice0.data(), slice1.data(), z, level, vertices);
+        slices.AddPlane(slice1.data(), z + 1, level, true, vertices);
+        slices.AddTriangles(slice0.data(), slice1.data(), level, indices);
+        slices.Advance();
+
+        // The vertices of slice z+1 are written with layer z, before the
+        // triangles of layer z+1 that also reference them.
+        writer(vertices, indices);
+        mNumVertices = slices.GetNextIndex();
+        mNumTriangles += indices.size() / 3;
+        vertices.clear();
+        indices.clear();
+        std::swap(slice0, slice1);
+    }
+    return true;
+}
+
+template <typename Real>
+bool SurfaceExtractorStream<Real>::Extract(Real level,
+    std::string const& filename, std::streamoff offset, Writer const& writer)
+{
+    std::ifstream input(filename, std::ios::in | std::ios::binary);
+    if (!input || !input.seekg(offset, std::ios::beg))
+    {
+        LogError("Cannot open file " + filename + ".");
+        return false;
+    }
+
+    std::streamsize const numBytes = static_cast<std::streamsize>(mBound[0]) *
+        mBound[1] * sizeof(Real);
+    auto reader = [&input, numBytes](int, Real* slice)
+    {
+        return static_cast<bool>(input.read(reinterpret_cast<char*>(slice), numBytes));
+    };
+    return Extract(level, reader, writer);
+}
+
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.1 (2026/10/18)
 
 #pragma once
 
@@ -42,13 +42,19 @@
 //  }
 // See GenerateMeshUV<Real>::SolveSystem(...) for a concrete example.
 //
+// When numThreads > 1, the constructors create 'threadPool', a pool of
+// persistent worker threads.  Algorithms that share the compute model reuse
+// the same threads, so repeated calls do not pay for thread creation.  If
+// you modify numThreads after construction, assign a new pool to
+// threadPool, or set it to null to let the algorithms run single-threaded.
+// A pool may be shared by several compute models.
+//
 // Of course, your algorithm can interpret cmodel anyway it likes.  For
 // example, you might ignore cmodel.engine if all you care about is
 // multithreading on the CPU.
 
-#if defined(GTE_COMPUTE_MODEL_ALLOW_GPGPU)
+#include <LowLevel/GteThreadPool.h>
 #include <memory>
-#endif
 
 namespace gte
 {
@@ -76,7 +82,15 @@ public:
 
     ComputeModel(unsigned int inNumThreads)
         :
-        numThreads(inNumThreads > 0 ? inNumThreads : 1)
+        numThreads(inNumThreads > 0 ? inNumThreads : 1),
+        threadPool(numThreads > 1 ? std::make_shared<ThreadPool>(numThreads) : nullptr)
+    {
+    }
+
+    ComputeModel(std::shared_ptr<ThreadPool> const& inThreadPool)
+        :
+        numThreads(inThreadPool ? inThreadPool->GetNumThreads() : 1),
+        threadPool(inThreadPool)
     {
     }
 
@@ -86,6 +100,7 @@ public:
         std::shared_ptr<ProgramFactory> const& inFactory)
         :
         numThreads(inNumThreads > 0 ? inNumThreads : 1),
+        threadPool(numThreads > 1 ? std::make_shared<ThreadPool>(numThreads) : nullptr),
         engine(inEngine),
         factory(inFactory)
     {
@@ -93,6 +108,7 @@ public:
 #endif
 
     unsigned int numThreads;
+    std::shared_ptr<ThreadPool> threadPool;
 #if defined(GTE_COMPUTE_MODEL_ALLOW_GPGPU)
     std::shared_ptr<GraphicsEngine> engine;
     std::shared_ptr<ProgramFactory> factory;
@@ -0,0 +1,131 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <GTEngineDEF.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A persistent pool of worker threads that schedules tasks by work stealing.
+// Each thread of the pool has a double-ended queue of tasks.  A worker pushes
+// the tasks it creates onto the back of its own queue and pops tasks from the
+// back (most recently created first).  A worker whose queue is empty steals
+// from the front of the other queues.  Tasks created by threads that are not
+// workers of the pool are distributed round-robin over the queues.
+//
+// A pool for 'numThreads' threads creates numThreads-1 workers.  The thread
+// that calls ParallelFor or TaskGroup::Wait executes pending tasks while it
+// waits, so it is the remaining thread of the computation.  This also makes
+// nested parallelism safe: a task may itself call ParallelFor or use a
+// TaskGroup.  A task must not block on a std::future returned by Submit,
+// because the task that fulfills the future might be queued behind it.
+//
+// When numThreads is 1, no workers are created and all tasks are executed
+// immediately by the calling thread.
+
+namespace gte
+{
+
+class GTE_IMPEXP ThreadPool
+{
+public:
+    // Construction and destruction.  The destructor waits for the workers to
+    // finish their current tasks; tasks that are still queued are discarded.
+    ~ThreadPool();
+    ThreadPool(unsigned int numThreads);
+
+    // The number of threads that cooperate in the computations, which is the
+    // number of workers plus 1.
+    inline unsigned int GetNumThreads() const;
+
+    // Execute a function asynchronously.  The returned future provides the
+    // return value of the function.
+    template <typename Function>
+    std::future<typename std::result_of<Function()>::type>
+        Submit(Function&& function);
+
+    // Partition [begin,end) into contiguous subranges of at most 'grainSize'
+    // items and call function(imin,imax) for each subrange [imin,imax).  If
+    // grainSize is 0, the range is partitioned into 4*GetNumThreads()
+    // subranges of nearly equal size.  The subranges depend only on the
+    // inputs, so an algorithm may accumulate results per subrange and
+    // combine them in order to obtain results that do not depend on the
+    // scheduling.  The function returns when all subranges are processed.
+    void ParallelFor(int begin, int end, int grainSize,
+        std::function<void(int, int)> const& function);
+
+    // A set of tasks whose completion can be waited for.  The destructor
+    // calls Wait().
+    class GTE_IMPEXP TaskGroup
+    {
+    public:
+        ~TaskGroup();
+        TaskGroup(ThreadPool& pool);
+
+        void Run(std::function<void()> const& task);
+        void Wait();
+
+    private:
+        ThreadPool& mPool;
+        std::atomic<int> mNumPending;
+    };
+
+private:
+    typedef std::function<void()> Task;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Queue a task.  A worker of this pool queues it in its own queue.  When
+    // the pool has no workers, the task is executed immediately.
+    void Push(Task&& task);
+
+    // Execute one pending task.  The return value is 'false' when no task
+    // was found.
+    bool RunPendingTask();
+
+    void Work(unsigned int index);
+
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    std::vector<std::thread> mWorkers;
+    std::atomic<unsigned int> mNumQueued;
+    std::atomic<unsigned int> mNextQueue;
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    bool mStop;
+};
+
+inline unsigned int ThreadPool::GetNumThreads() const
+{
+    return static_cast<unsigned int>(mQueues.size());
+}
+
+template <typename Function>
+std::future<typename std::result_of<Function()>::type>
+ThreadPool::Submit(Function&& function)
+{
+    typedef typename std::result_of<Function()>::type Result;
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Function>(function));
+    std::future<Result> result = task->get_future();
+    Push([task]() { (*task)(); });
+    return result;
+}
+
+}
@@ -3,17 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.3.5 (2018/10/26)
+// File Version: 3.3.6 (2026/10/18)
 
 #pragma once
 
+#include <LowLevel/GteComputeModel.h>
 #include <Mathematics/GteCylinder3.h>
 #include <Mathematics/GteMatrix3x3.h>
 #include <Mathematics/GteSymmetricEigensolver3x3.h>
 #include <Mathematics/GteMath.h>
 #include <algorithm>
 #include <vector>
-#include <thread>
 
 // The algorithm for least-squares fitting of a point set by a cylinder is
 // described in
@@ -40,11 +40,14 @@ namespace gte
         // in the main process.  Set numThreads > 0 to run multithreaded.  If
         // either of numThetaSamples or numPhiSamples is zero, the operator() sets
         // the cylinder origin and axis to the zero vectors, the radius and height
-        // to zero, and returns std::numeric_limits<Real>::max().
+        // to zero, and returns std::numeric_limits<Real>::max().  The threads
+        // are those of a ThreadPool created by the constructor, so repeated
+        // calls to operator() reuse them.
         ApprCylinder3(unsigned int numThreads, unsigned int numThetaSamples, unsigned int numPhiSamples)
             :
             mConstructorType(FIT_BY_HEMISPHERE_SEARCH),
             mNumThreads(numThreads),
+            mThreadPool(numThreads > 0 ? std::make_shared<ThreadPool>(numThreads) : nullptr),
             mNumThetaSamples(numThetaSamples),
             mNumPhiSamples(numPhiSamples),
             mEigenIndex(0),
@@ -53,6 +56,27 @@ namespace gte
             mCylinderAxis = { (Real)0, (Real)0, (Real)0 };
         }
 
+        // The same as the previous constructor, except that the hemisphere
+        // is searched by the threads of the thread pool of the compute model,
+        // which allows the threads to be shared with other algorithms.  If
+        // cmodel or cmodel->threadPool is null, the search is single-threaded.
+        ApprCylinder3(std::shared_ptr<ComputeModel> const& cmodel, unsigned int numThetaSamples, unsigned int numPhiSamples)
+            :
+            mConstructorType(FIT_BY_HEMISPHERE_SEARCH),
+            mNumThreads(0),
+            mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+            mNumThetaSamples(numThetaSamples),
+            mNumPhiSamples(numPhiSamples),
+            mEigenIndex(0),
+            mInvNumPoints((Real)0)
+        {
+            mCylinderAxis = { (Real)0, (Real)0, (Real)0 };
+            if (mThreadPool)
+            {
+                mNumThreads = mThreadPool->GetNumThreads();
+            }
+        }
+
         // Choose one of the eigenvectors for the covariance matrix as the
         // cylinder axis direction.  If eigenIndex is 0, the eigenvector
         // associated with the smallest eigenvalue is chosen.  If eigenIndex is 2,
@@ -67,6 +91,7 @@ namespace gte
             :
             mConstructorType(FIT_USING_COVARIANCE_EIGENVECTOR),
             mNumThreads(0),
+            mThreadPool(nullptr),
             mNumThetaSamples(0),
             mNumPhiSamples(0),
             mEigenIndex(eigenIndex),
@@ -84,6 +109,7 @@ namespace gte
             :
             mConstructorType(FIT_USING_SPECIFIED_AXIS),
             mNumThreads(0),
+            mThreadPool(nullptr),
             mNumThetaSamples(0),
             mNumPhiSamples(0),
             mEigenIndex(0),
@@ -133,7 +159,7 @@ namespace gte
 
                 // Search the hemisphere for the vector that leads to minimum error
                 // and use it for the cylinder axis.
-                if (mNumThreads == 0)
+                if (!mThreadPool)
                 {
                     // Execute the algorithm in the main process.
                     minError = ComputeSingleThreaded(minPC, minW, minRSqr);
@@ -358,12 +384,10 @@ namespace gte
             }
             local[mNumThreads - 1].jmax = mNumPhiSamples + 1;
 
-            std::vector<std::thread> process(mNumThreads);
-            for (unsigned int t = 0; t < mNumThreads; ++t)
+            mThreadPool->ParallelFor(0, static_cast<int>(mNumThreads), 1,
+                [this, iMultiplier, jMultiplier, &local](int tmin, int tmax)
             {
-                process[t] = std::thread
-                (
-                    [this, t, iMultiplier, jMultiplier, &local]()
+                for (int t = tmin; t < tmax; ++t)
                 {
                     for (unsigned int j = local[t].jmin; j < local[t].jmax; ++j)
                     {
@@ -389,13 +413,10 @@ namespace gte
                         }
                     }
                 }
-                );
-            }
+            });
 
             for (unsigned int t = 0; t < mNumThreads; ++t)
             {
-                process[t].join();
-
                 if (local[t].error < minError)
                 {
                     minError = local[t].error;
@@ -435,8 +456,11 @@ namespace gte
 
         ConstructorType mConstructorType;
 
-        // Parameters for the hemisphere-search constructor.
+        // Parameters for the hemisphere-search constructor.  The search is
+        // partitioned into mNumThreads ranges of phi samples that are
+        // processed by the thread pool.
         unsigned int mNumThreads;
+        std::shared_ptr<ThreadPool> mThreadPool;
         unsigned int mNumThetaSamples;
         unsigned int mNumPhiSamples;
 
@@ -47,8 +47,9 @@
 //
 // GTEngine currently has 32-bits-per-word storage for UIntegerType.  See the
 // classes UIntegerAP32 (arbitrary precision), UIntegerFP32<N> (fixed
-// precision), and UIntegerALU32 (arithmetic logic unit shared by the previous
-// two classes).  The document at the following link describes the design,
+// precision), UIntegerSB32<N> (arbitrary precision with small-buffer and
+// thread-local arena storage), and UIntegerALU32 (arithmetic logic unit
+// shared by the previous three classes).  The document at the following link describes the design,
 // implementation, and use of BSNumber and BSRational.
 //   http://www.geometrictools.com/Documentation/ArbitraryPrecision.pdf
 //
@@ -0,0 +1,373 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteLogger.h>
+#include <LowLevel/GteThreadPool.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// A sparse matrix stored in compressed sparse row (CSR) form.  The nonzero
+// entries of row r are stored in positions k for rowOffsets[r] <= k <
+// rowOffsets[r+1] of the arrays of columns and values, and the columns of
+// a row are in increasing order.  The structure of the matrix (the
+// locations of the entries) is fixed at construction; the values may be
+// modified.  A symmetric matrix must store the entries of both triangles.
+// A matrix is created either from the arrays of its structure or by adding
+// its entries, in any order, to a CSRMatrix::Builder.
+
+namespace gte
+{
+
+template <typename Real>
+class CSRMatrix
+{
+public:
+    // Support for creating a matrix from its entries.  The entries may be
+    // added in any order, and entries with the same location are summed.
+    class Builder
+    {
+    public:
+        Builder(int numRows, int numCols);
+
+        // Allocate storage for the specified number of entries.
+        void Reserve(int numEntries);
+
+        // Add the value to entry (row,col).
+        void Add(int row, int col, Real value);
+
+        // Add the value to entries (row,col) and (col,row) of a symmetric
+        // matrix.  The value is added once when row and col are equal.
+        void AddSymmetric(int row, int col, Real value);
+
+        // Create the matrix from the entries.  The builder is unchanged.
+        CSRMatrix Create() const;
+
+    private:
+        struct Entry
+        {
+            int row, col;
+            Real value;
+        };
+
+        int mNumRows, mNumCols;
+        std::vector<Entry> mEntries;
+    };
+
+    // Construction.  The default constructor creates a 0x0 matrix.  The
+    // other constructor creates the structure from the arrays described
+    // previously, where rowOffsets has numRows+1 elements, and sets the
+    // values to zero.
+    CSRMatrix();
+    CSRMatrix(int numRows, int numCols, std::vector<int> const& rowOffsets,
+        std::vector<int> const& columns);
+
+    // Member access.
+    inline int GetNumRows() const;
+    inline int GetNumCols() const;
+    inline int GetNumElements() const;
+    inline std::vector<int> const& GetRowOffsets() const;
+    inline std::vector<int> const& GetColumns() const;
+    inline std::vector<Real>& GetValues();
+    inline std::vector<Real> const& GetValues() const;
+
+    // The position in the values array of the entry (row,col), or -1 when
+    // the entry is not stored.  The search is binary.
+    int GetIndex(int row, int col) const;
+
+    // The value of entry (row,col), which is zero when it is not stored.
+    Real operator()(int row, int col) const;
+
+    // Set all the values to zero.
+    void MakeZero();
+
+    // Compute Y = A*X, where X has numCols elements and Y has numRows
+    // elements.  When a thread pool is specified, the rows are partitioned
+    // into ranges with approximately equal numbers of entries that are
+    // processed concurrently.  Each element of Y is computed by the same
+    // operations regardless of the partition.
+    void Mul(Real const* X, Real* Y) const;
+    void Mul(Real const* X, Real* Y,
+        std::shared_ptr<ThreadPool> const& threadPool) const;
+
+    // Get the diagonal entries.  The array has min(numRows,numCols)
+    // elements.
+    void GetDiagonal(Real* D) const;
+
+private:
+    // Compute Y[row] for rowMin <= row < rowMax.
+    void MulRows(int rowMin, int rowMax, Real const* X, Real* Y) const;
+
+    int mNumRows, mNumCols;
+    std::vector<int> mRowOffsets, mColumns;
+    std::vector<Real> mValues;
+};
+
+
+template <typename Real>
+CSRMatrix<Real>::CSRMatrix()
+    :
+    mNumRows(0),
+    mNumCols(0),
+    mRowOffsets(1, 0)
+{
+}
+
+template <typename Real>
+CSRMatrix<Real>::CSRMatrix(int numRows, int numCols,
+    std::vector<int> const& rowOffsets, std::vector<int> const& columns)
+    :
+    mNumRows(numRows),
+    mNumCols(numCols),
+    mRowOffsets(rowOffsets),
+    mColumns(columns),
+    mValues(columns.size(), (Real)0)
+{
+    LogAssert(numRows >= 0 && numCols >= 0, "Invalid size.");
+    LogAssert(static_cast<int>(rowOffsets.size()) == numRows + 1
+        && rowOffsets[0] == 0
+        && rowOffsets[numRows] == static_cast<int>(columns.size()),
+        "Invalid row offsets.");
+}
+
+template <typename Real> inline
+int CSRMatrix<Real>::GetNumRows() const
+{
+    return mNumRows;
+}
+
+template <typename Real> inline
+int CSRMatrix<Real>::GetNumCols() const
+{
+    return mNumCols;
+}
+
+template <typename Real> inline
+int CSRMatrix<Real>::GetNumElements() const
+{
+    return static_cast<int>(mValues.size());
+}
+
+template <typename Real> inline
+std::vector<int> const& CSRMatrix<Real>::GetRowOffsets() const
+{
+    return mRowOffsets;
+}
+
+template <typename Real> inline
+std::vector<int> const& CSRMatrix<Real>::GetColumns() const
+{
+    return mColumns;
+}
+
+template <typename Real> inline
+std::vector<Real>& CSRMatrix<Real>::GetValues()
+{
+    return mValues;
+}
+
+template <typename Real> inline
+std::vector<Real> const& CSRMatrix<Real>::GetValues() const
+{
+    return mValues;
+}
+
+template <typename Real>
+int CSRMatrix<Real>::GetIndex(int row, int col) const
+{
+    auto first = mColumns.begin() + mRowOffsets[row];
+    auto last = mColumns.begin() + mRowOffsets[row + 1];
+    auto iter = std::lower_bound(first, last, col);
+    if (iter != last && *iter == col)
+    {
+        return static_cast<int>(iter - mColumns.begin());
+    }
+    return -1;
+}
+
+template <typename Real>
+Real CSRMatrix<Real>::operator()(int row, int col) const
+{
+    int index = GetIndex(row, col);
+    return (index >= 0 ? mValues[index] : (Real)0);
+}
+
+template <typename Real>
+void CSRMatrix<Real>::MakeZero()
+{
+    std::fill(mValues.begin(), mValues.end(), (Real)0);
+}
+
+template <typename Real>
+void CSRMatrix<Real>::Mul(Real const* X, Real* Y) const
+{
+    MulRows(0, mNumRows, X, Y);
+}
+
+template <typename Real>
+void CSRMatrix<Real>::Mul(Real const* X, Real* Y,
+    std::shared_ptr<ThreadPool> const& threadPool) const
+{
+    // The ranges have at least minRangeSize entries so that the cost of
+    // scheduling is small compared to the work.
+    int const minRangeSize = 16384;
+    int const numElements = GetNumElements();
+    if (!threadPool || threadPool->GetNumThreads() < 2
+        || numElements < 2 * minRangeSize)
+    {
+        MulRows(0, mNumRows, X, Y);
+        return;
+    }
+
+    int numRanges = std::min(4 * static_cast<int>(threadPool->GetNumThreads()),
+        numElements / minRangeSize);
+    std::vector<int> rowBound(numRanges + 1);
+    rowBound[0] = 0;
+    rowBound[numRanges] = mNumRows;
+    for (int r = 1; r < numRanges; ++r)
+    {
+        int element = static_cast<int>(
+            static_cast<int64_t>(numElements) * r / numRanges);
+        rowBound[r] = static_cast<int>(std::upper_bound(mRowOffsets.begin(),
+            mRowOffsets.end(), element) - mRowOffsets.begin()) - 1;
+    }
+
+    threadPool->ParallelFor(0, numRanges, 1, [this, &rowBound, X, Y](int rmin,
+        int rmax)
+    {
+        for (int r = rmin; r < rmax; ++r)
+        {
+            MulRows(rowBound[r], rowBound[r + 1], X, Y);
+        }
+    });
+}
+
+template <typename Real>
+void CSRMatrix<Real>::GetDiagonal(Real* D) const
+{
+    int const numDiagonal = std::min(mNumRows, mNumCols);
+    for (int i = 0; i < numDiagonal; ++i)
+    {
+        D[i] = (*this)(i, i);
+    }
+}
+
+template <typename Real>
+void CSRMatrix<Real>::MulRows(int rowMin, int rowMax, Real const* X,
+    Real* Y) const
+{
+    int const* offsets = mRowOffsets.data();
+    int const* columns = mColumns.data();
+    Real const* values = mValues.data();
+    for (int row = rowMin; row < rowMax; ++row)
+    {
+        Real sum = (Real)0;
+        for (int k = offsets[row]; k < offsets[row + 1]; ++k)
+        {
+            sum += values[k] * X[columns[k]];
+        }
+        Y[row] = sum;
+    }
+}
+
+template <typename Real>
+CSRMatrix<Real>::Builder::Builder(int numRows, int numCols)
+    :
+    mNumRows(numRows),
+    mNumCols(numCols)
+{
+    LogAssert(numRows >= 0 && numCols >= 0, "Invalid size.");
+}
+
+template <typename Real>
+void CSRMatrix<Real>::Builder::Reserve(int numEntries)
+{
+    mEntries.reserve(numEntries);
+}
+
+template <typename Real>
+void CSRMatrix<Real>::Builder::Add(int row, int col, Real value)
+{
+    LogAssert(0 <= row && row < mNumRows && 0 <= col && col < mNumCols,
+        "Invalid location.");
+    mEntries.push_back({ row, col, value });
+}
+
+template <typename Real>
+void CSRMatrix<Real>::Builder::AddSymmetric(int row, int col, Real value)
+{
+    Add(row, col, value);
+    if (row != col)
+    {
+        Add(col, row, value);
+    }
+}
+
+template <typename Real>
+CSRMatrix<Real> CSRMatrix<Real>::Builder::Create() const
+{
+    // Distribute the entries to their rows by a counting sort.
+    int const numEntries = static_cast<int>(mEntries.size());
+    std::vector<int> rowStart(mNumRows + 1, 0);
+    for (auto const& entry : mEntries)
+    {
+        ++rowStart[entry.row + 1];
+    }
+    for (int row = 0; row < mNumRows; ++row)
+    {
+        rowStart[row + 1] += rowStart[row];
+    }
+    std::vector<int> current(rowStart.begin(), rowStart.end() - 1);
+    std::vector<std::pair<int, Real>> sorted(numEntries);
+    for (auto const& entry : mEntries)
+    {
+        sorted[current[entry.row]++] = std::make_pair(entry.col, entry.value);
+    }
+
+    // Sort the entries of each row by column and sum the entries with the
+    // same column.  The sort is stable so that the sums do not depend on
+    // the sorting algorithm.
+    std::vector<int> rowOffsets(mNumRows + 1), columns;
+    std::vector<Real> values;
+    columns.reserve(numEntries);
+    values.reserve(numEntries);
+    rowOffsets[0] = 0;
+    for (int row = 0; row < mNumRows; ++row)
+    {
+        auto first = sorted.begin() + rowStart[row];
+        auto last = sorted.begin() + rowStart[row + 1];
+        std::stable_sort(first, last,
+            [](std::pair<int, Real> const& e0, std::pair<int, Real> const& e1)
+            {
+                return e0.first < e1.first;
+            });
+        for (auto iter = first; iter != last; ++iter)
+        {
+            if (static_cast<int>(columns.size()) > rowOffsets[row]
+                && columns.back() == iter->first)
+            {
+                values.back() += iter->second;
+            }
+            else
+            {
+                columns.push_back(iter->first);
+                values.push_back(iter->second);
+            }
+        }
+        rowOffsets[row + 1] = static_cast<int>(columns.size());
+    }
+
+    CSRMatrix matrix(mNumRows, mNumCols, rowOffsets, columns);
+    matrix.mValues = std::move(values);
+    return matrix;
+}
+
+}
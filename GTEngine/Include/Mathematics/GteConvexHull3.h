@@ -3,12 +3,23 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.1.1 (2026/10/18)
 
 #pragma once
 
-// Compute the convex hull of 3D points using incremental insertion.  The only
-// way to ensure a correct result for the input vertices (assumed to be exact)
+// Compute the convex hull of 3D points using the QuickHull algorithm.  Each
+// face of the current hull stores the list of unprocessed points that are
+// strictly on its positive side (its conflict list).  The point of a conflict
+// list farthest from its face is inserted, the faces visible to it are
+// replaced by the cone of triangles from the point to the horizon edges, and
+// the conflict points of the visible faces are redistributed to the new
+// faces.  Points that are not outside any face are discarded.  The
+// conversions of the input, the initial conflict assignment and large
+// redistributions are executed by a ThreadPool, either created by the
+// ConvexHull3 object or shared through a ComputeModel.  The assignment of points to faces
+// is deterministic, so the hull does not depend on the number of threads.
+//
+// The only way to ensure a correct result for the input vertices (assumed to be exact)
 // is to choose ComputeType for exact rational arithmetic.  You may use
 // BSNumber.  No divisions are performed in this computation, so you do not
 // have to use BSRational.
@@ -26,13 +37,17 @@
 //    float      | BSRational   |  2882
 //    double     | BSRational   | 21688
 
+#include <LowLevel/GteComputeModel.h>
 #include <Mathematics/GteETManifoldMesh.h>
 #include <Mathematics/GtePrimalQuery3.h>
 #include <Mathematics/GteLine.h>
 #include <Mathematics/GteHyperplane.h>
+#include <algorithm>
+#include <array>
 #include <functional>
-#include <set>
+#include <memory>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace gte
@@ -43,10 +58,16 @@ class ConvexHull3
 {
 public:
     // The class is a functor to support computing the convex hull of multiple
-    // data sets using the same class object.  For multithreading in Update,
-    // choose 'numThreads' subject to the constraints
+    // data sets using the same class object.  For multithreading, choose
+    // 'numThreads' subject to the constraints
     //     1 <= numThreads <= std::thread::hardware_concurrency().
+    // When numThreads > 1, the worker threads are created by the constructor
+    // and reused by every call to operator().  The second constructor uses
+    // the thread pool of the compute model, which allows the worker threads
+    // to be shared with other algorithms; cmodel->threadPool may be null for
+    // a single-threaded computation.
     ConvexHull3(unsigned int numThreads = 1);
+    ConvexHull3(std::shared_ptr<ComputeModel> const& cmodel);
 
     // The input is the array of points whose convex hull is required.  The
     // epsilon value is used to determine the intrinsic dimensionality of the
@@ -69,9 +90,10 @@ public:
     inline Line3<InputType> const& GetLine() const;
     inline Plane3<InputType> const& GetPlane() const;
 
-    // Member access.
+    // Member access.  The number of unique points is computed only on
+    // demand.
     inline int GetNumPoints() const;
-    inline int GetNumUniquePoints() const;
+    int GetNumUniquePoints() const;
     inline Vector3<InputType> const* GetPoints() const;
     inline PrimalQuery3<ComputeType> const& GetQuery() const;
 
@@ -80,8 +102,36 @@ public:
     ETManifoldMesh const& GetHullMesh() const;
 
 private:
-    // Support for incremental insertion.
-    void Update(int i);
+    // A face of the current hull.  The edge <V[j],V[j+1]> is shared with
+    // face adjacent[j].  The plane Dot(normal,X) = constant is computed in
+    // double precision and is used only to select the farthest conflict
+    // point; all visibility tests use the exact queries.  A face is in the
+    // free list when V[0] = -1.
+    struct Face
+    {
+        std::array<int, 3> V, adjacent;
+        Vector3<double> normal;
+        double constant;
+        std::vector<int> conflicts;
+        int farthest;
+        double farthestDistance;
+        unsigned int stamp;
+        bool visible;
+    };
+
+    // Partition [0,numItems) into contiguous ranges and call
+    // job(imin,imax) for each range.  The ranges are processed by the
+    // thread pool when there are at least minItemsPerThread items for each
+    // of two threads.
+    void ParallelFor(int numItems, int minItemsPerThread,
+        std::function<void(int, int)> const& job);
+
+    // Support for the QuickHull algorithm.
+    int CreateFace(int v0, int v1, int v2);
+    void RemoveFace(int f);
+    void AddConflict(int f, int i);
+    bool IsOutside(int i, int f) const;
+    void Update(int f);
 
     // The epsilon value is used for fuzzy determination of intrinsic
     // dimensionality.  If the dimension is 0, 1, or 2, the constructor
@@ -103,12 +153,34 @@ private:
     std::vector<Vector3<ComputeType>> mComputePoints;
     PrimalQuery3<ComputeType> mQuery;
 
+    // Double-precision copies of the input.  They are used to select the
+    // farthest conflict points.  They are also used by the floating-point
+    // filter of the queries, which is enabled when InputType is float or
+    // double and ComputeType is not a floating-point type.
+    std::vector<Vector3<double>> mFilterPoints;
+
     int mNumPoints;
-    int mNumUniquePoints;
+    mutable int mNumUniquePoints;
     Vector3<InputType> const* mPoints;
     std::vector<TriangleKey<true>> mHullUnordered;
     mutable ETManifoldMesh mHullMesh;
-    unsigned int mNumThreads;
+    std::shared_ptr<ThreadPool> mThreadPool;
+
+    // The faces of the current hull and the stack of faces whose conflict
+    // lists might be nonempty.
+    std::vector<Face> mFaces;
+    std::vector<int> mFreeFaces;
+    std::vector<int> mPending;
+    unsigned int mStamp;
+
+    // Storage for Update: the faces visible to the inserted point, the new
+    // faces, the new face whose edge <V[0],V[1]> starts at a vertex, and the
+    // conflict points to be redistributed with their new faces.
+    std::vector<int> mVisible;
+    std::vector<int> mNewFaces;
+    std::vector<int> mVertexToNewFace;
+    std::vector<int> mOrphans;
+    std::vector<int> mOrphanFaces;
 };
 
 
@@ -122,7 +194,24 @@ ConvexHull3<InputType, ComputeType>::ConvexHull3(unsigned int numThreads)
     mNumPoints(0),
     mNumUniquePoints(0),
     mPoints(nullptr),
-    mNumThreads(numThreads)
+    mThreadPool(numThreads > 1 ? std::make_shared<ThreadPool>(numThreads) : nullptr),
+    mStamp(0)
+{
+}
+
+template <typename InputType, typename ComputeType>
+ConvexHull3<InputType, ComputeType>::ConvexHull3(
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mEpsilon((InputType)0),
+    mDimension(0),
+    mLine(Vector3<InputType>::Zero(), Vector3<InputType>::Zero()),
+    mPlane(Vector3<InputType>::Zero(), (InputType)0),
+    mNumPoints(0),
+    mNumUniquePoints(0),
+    mPoints(nullptr),
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mStamp(0)
 {
 }
 
@@ -141,8 +230,11 @@ bool ConvexHull3<InputType, ComputeType>::operator()(int numPoints,
     mPoints = points;
     mHullUnordered.clear();
     mHullMesh.Clear();
+    mFaces.clear();
+    mFreeFaces.clear();
+    mPending.clear();
 
-    int i, j;
+    int i;
     if (mNumPoints < 4)
     {
         // ConvexHull3 should be called with at least four points.
@@ -175,50 +267,117 @@ bool ConvexHull3<InputType, ComputeType>::operator()(int numPoints,
 
     mDimension = 3;
 
-    // Compute the vertices for the queries.
+    // Compute the vertices for the queries.  The conversion to ComputeType
+    // is expensive for arbitrary-precision types, so it is multithreaded.
     mComputePoints.resize(mNumPoints);
-    mQuery.Set(mNumPoints, &mComputePoints[0]);
-    for (i = 0; i < mNumPoints; ++i)
+    mFilterPoints.resize(mNumPoints);
+    ParallelFor(mNumPoints, 1024, [this, points](int imin, int imax)
     {
-        for (j = 0; j < 3; ++j)
+        for (int j = imin; j < imax; ++j)
         {
-            mComputePoints[i][j] = points[i][j];
+            for (int k = 0; k < 3; ++k)
+            {
+                mComputePoints[j][k] = points[j][k];
+                mFilterPoints[j][k] = static_cast<double>(points[j][k]);
+            }
         }
+    });
+    mQuery.Set(mNumPoints, &mComputePoints[0]);
+    if ((std::is_same<InputType, float>::value || std::is_same<InputType, double>::value)
+        && !std::is_floating_point<ComputeType>::value)
+    {
+        mQuery.SetFilter(&mFilterPoints[0]);
     }
 
-    // Insert the faces of the (nondegenerate) tetrahedron constructed by the
+    // Create the faces of the (nondegenerate) tetrahedron constructed by the
     // call to GetInformation.
     if (!info.extremeCCW)
     {
         std::swap(info.extreme[2], info.extreme[3]);
     }
 
-    mHullUnordered.push_back(TriangleKey<true>(info.extreme[1],
-        info.extreme[2], info.extreme[3]));
-    mHullUnordered.push_back(TriangleKey<true>(info.extreme[0],
-        info.extreme[3], info.extreme[2]));
-    mHullUnordered.push_back(TriangleKey<true>(info.extreme[0],
-        info.extreme[1], info.extreme[3]));
-    mHullUnordered.push_back(TriangleKey<true>(info.extreme[0],
-        info.extreme[2], info.extreme[1]));
-
-    // Incrementally update the hull.  The set of processed points is
-    // maintained to eliminate duplicates, either in the original input
-    // points or in the points obtained by snap rounding.
-    std::set<Vector3<InputType>> processed;
-    for (i = 0; i < 4; ++i)
+    int const* e = info.extreme;
+    std::array<int, 4> tetra =
     {
-        processed.insert(points[info.extreme[i]]);
+        CreateFace(e[1], e[2], e[3]),
+        CreateFace(e[0], e[3], e[2]),
+        CreateFace(e[0], e[1], e[3]),
+        CreateFace(e[0], e[2], e[1])
+    };
+    for (int f0 = 0; f0 < 4; ++f0)
+    {
+        Face& face0 = mFaces[tetra[f0]];
+        for (int j0 = 0; j0 < 3; ++j0)
+        {
+            int v0 = face0.V[j0], v1 = face0.V[(j0 + 1) % 3];
+            for (int f1 = 0; f1 < 4; ++f1)
+            {
+                Face const& face1 = mFaces[tetra[f1]];
+                for (int j1 = 0; j1 < 3; ++j1)
+                {
+                    if (face1.V[j1] == v1 && face1.V[(j1 + 1) % 3] == v0)
+                    {
+                        face0.adjacent[j0] = tetra[f1];
+                    }
+                }
+            }
+        }
     }
+
+    // Assign each point to the first face of the tetrahedron that it is
+    // outside of.  The point-plane queries are multithreaded; the conflict
+    // lists are built in the order of the points.
+    std::vector<int> assignment(mNumPoints);
+    ParallelFor(mNumPoints, 1024, [this, &tetra, &assignment](int imin, int imax)
+    {
+        for (int j = imin; j < imax; ++j)
+        {
+            assignment[j] = -1;
+            for (int f = 0; f < 4; ++f)
+            {
+                if (IsOutside(j, tetra[f]))
+                {
+                    assignment[j] = tetra[f];
+                    break;
+                }
+            }
+        }
+    });
     for (i = 0; i < mNumPoints; ++i)
     {
-        if (processed.find(points[i]) == processed.end())
+        if (assignment[i] >= 0)
         {
-            Update(i);
-            processed.insert(points[i]);
+            AddConflict(assignment[i], i);
         }
     }
-    mNumUniquePoints = static_cast<int>(processed.size());
+    std::vector<int>().swap(assignment);
+
+    // Insert the points.  The extreme points and duplicates of vertices of
+    // the current hull are never outside a face, so they are not inserted a
+    // second time.
+    mVertexToNewFace.assign(mNumPoints, -1);
+    mPending.assign(tetra.begin(), tetra.end());
+    while (mPending.size() > 0)
+    {
+        int f = mPending.back();
+        mPending.pop_back();
+        if (mFaces[f].V[0] >= 0 && mFaces[f].conflicts.size() > 0)
+        {
+            Update(f);
+        }
+    }
+
+    for (auto const& face : mFaces)
+    {
+        if (face.V[0] >= 0)
+        {
+            mHullUnordered.push_back(TriangleKey<true>(face.V[0], face.V[1],
+                face.V[2]));
+        }
+    }
+    mFaces.clear();
+    mFreeFaces.clear();
+    mNumUniquePoints = -1;
     return true;
 }
 
@@ -252,9 +411,16 @@ int ConvexHull3<InputType, ComputeType>::GetNumPoints() const
     return mNumPoints;
 }
 
-template <typename InputType, typename ComputeType> inline
+template <typename InputType, typename ComputeType>
 int ConvexHull3<InputType, ComputeType>::GetNumUniquePoints() const
 {
+    if (mNumUniquePoints < 0)
+    {
+        std::vector<Vector3<InputType>> sorted(mPoints, mPoints + mNumPoints);
+        std::sort(sorted.begin(), sorted.end());
+        mNumUniquePoints = static_cast<int>(
+            std::unique(sorted.begin(), sorted.end()) - sorted.begin());
+    }
     return mNumUniquePoints;
 }
 
@@ -292,137 +458,202 @@ ETManifoldMesh const& ConvexHull3<InputType, ComputeType>::GetHullMesh() const
 }
 
 template <typename InputType, typename ComputeType>
-void ConvexHull3<InputType, ComputeType>::Update(int i)
+void ConvexHull3<InputType, ComputeType>::ParallelFor(int numItems,
+    int minItemsPerThread, std::function<void(int, int)> const& job)
 {
-    // The terminator that separates visible faces from nonvisible faces is
-    // constructed by this code.  Visible faces for the incoming hull are
-    // removed, and the boundary of that set of triangles is the terminator.
-    // New visible faces are added using the incoming point and the edges of
-    // the terminator.
-    //
-    // A simple algorithm for computing terminator edges is the following.
-    // Back-facing triangles are located and the three edges are processed.
-    // The first time an edge is visited, insert it into the terminator.  If
-    // it is visited a second time, the edge is removed because it is shared
-    // by another back-facing triangle and, therefore, cannot be a terminator
-    // edge.  After visiting all back-facing triangles, the only remaining
-    // edges in the map are the terminator edges.
-    //
-    // The order of vertices of an edge is important for adding new faces with
-    // the correct vertex winding.  However, the edge "toggle" (insert edge,
-    // remove edge) should use edges with unordered vertices, because the
-    // edge shared by one triangle has opposite ordering relative to that of
-    // the other triangle.  The map uses unordered edges as the keys but
-    // stores the ordered edge as the value.  This avoids having to look up
-    // an edge twice in a map with ordered edge keys.
-
-    unsigned int numFaces = static_cast<unsigned int>(mHullUnordered.size());
-    std::vector<int> queryResult(numFaces);
-    if (mNumThreads > 1 && numFaces >= mNumThreads)
+    if (mThreadPool && numItems >= 2 * minItemsPerThread)
     {
-        // Partition the data for multiple threads.
-        unsigned int numFacesPerThread = numFaces / mNumThreads;
-        std::vector<unsigned int> jmin(mNumThreads), jmax(mNumThreads);
-        for (unsigned int t = 0; t < mNumThreads; ++t)
+        mThreadPool->ParallelFor(0, numItems, 0, job);
+    }
+    else if (numItems > 0)
+    {
+        job(0, numItems);
+    }
+}
+
+template <typename InputType, typename ComputeType>
+int ConvexHull3<InputType, ComputeType>::CreateFace(int v0, int v1, int v2)
+{
+    int f;
+    if (mFreeFaces.size() > 0)
+    {
+        f = mFreeFaces.back();
+        mFreeFaces.pop_back();
+    }
+    else
+    {
+        f = static_cast<int>(mFaces.size());
+        mFaces.push_back(Face());
+        mFaces.back().stamp = 0;
+    }
+
+    Face& face = mFaces[f];
+    face.V = { { v0, v1, v2 } };
+    face.adjacent = { { -1, -1, -1 } };
+    Vector3<double> const& p0 = mFilterPoints[v0];
+    face.normal = Cross(mFilterPoints[v1] - p0, mFilterPoints[v2] - p0);
+    face.constant = Dot(face.normal, p0);
+    face.conflicts.clear();
+    face.farthest = -1;
+    face.farthestDistance = 0.0;
+    face.visible = false;
+    return f;
+}
+
+template <typename InputType, typename ComputeType>
+void ConvexHull3<InputType, ComputeType>::RemoveFace(int f)
+{
+    Face& face = mFaces[f];
+    face.V[0] = -1;
+    face.conflicts.clear();
+    mFreeFaces.push_back(f);
+}
+
+template <typename InputType, typename ComputeType>
+void ConvexHull3<InputType, ComputeType>::AddConflict(int f, int i)
+{
+    Face& face = mFaces[f];
+    double distance = Dot(face.normal, mFilterPoints[i]) - face.constant;
+    if (face.farthest < 0 || distance > face.farthestDistance)
+    {
+        face.farthest = i;
+        face.farthestDistance = distance;
+    }
+    face.conflicts.push_back(i);
+}
+
+template <typename InputType, typename ComputeType> inline
+bool ConvexHull3<InputType, ComputeType>::IsOutside(int i, int f) const
+{
+    Face const& face = mFaces[f];
+    return mQuery.ToPlane(i, face.V[0], face.V[1], face.V[2]) > 0;
+}
+
+template <typename InputType, typename ComputeType>
+void ConvexHull3<InputType, ComputeType>::Update(int f)
+{
+    // The point farthest from face f is inserted.  The faces visible to the
+    // point (strictly on their positive sides) form a connected set that
+    // contains f.  The boundary of that set is the horizon.  The visible
+    // faces are replaced by triangles formed by the point and the horizon
+    // edges.  Faces coplanar with the point are not visible, so points on
+    // the hull boundary do not become vertices.
+    int i = mFaces[f].farthest;
+    if (++mStamp == 0)
+    {
+        for (auto& face : mFaces)
         {
-            jmin[t] = t * numFacesPerThread;
-            jmax[t] = jmin[t] + numFacesPerThread - 1;
+            face.stamp = 0;
         }
-        jmax[mNumThreads - 1] = numFaces - 1;
+        mStamp = 1;
+    }
 
-        // Execute the point-plane queries in multiple threads.
-        std::vector<std::thread> process(mNumThreads);
-        for (unsigned int t = 0; t < mNumThreads; ++t)
+    mVisible.clear();
+    mNewFaces.clear();
+    mFaces[f].stamp = mStamp;
+    mFaces[f].visible = true;
+    mVisible.push_back(f);
+    for (size_t k = 0; k < mVisible.size(); ++k)
+    {
+        int fVisible = mVisible[k];
+        for (int j = 0; j < 3; ++j)
         {
-            process[t] = std::thread([this, i, t, &jmin, &jmax, 
-                &queryResult]()
+            int fAdj = mFaces[fVisible].adjacent[j];
+            Face& adj = mFaces[fAdj];
+            if (adj.stamp != mStamp)
             {
-                for (unsigned int j = jmin[t]; j <= jmax[t]; ++j)
+                adj.stamp = mStamp;
+                adj.visible = IsOutside(i, fAdj);
+                if (adj.visible)
                 {
-                    TriangleKey<true> const& tri = mHullUnordered[j];
-                    queryResult[j] = mQuery.ToPlane(i, tri.V[0], tri.V[1], tri.V[2]);
+                    mVisible.push_back(fAdj);
                 }
-            });
-        }
+            }
 
-        // Wait for all threads to finish.
-        for (unsigned int t = 0; t < mNumThreads; ++t)
-        {
-            process[t].join();
+            if (!adj.visible)
+            {
+                // The edge <v0,v1> is a horizon edge.  The new face has the
+                // same edge ordering as the visible face it replaces.
+                int v0 = mFaces[fVisible].V[j];
+                int v1 = mFaces[fVisible].V[(j + 1) % 3];
+                int fNew = CreateFace(v0, v1, i);
+                mFaces[fNew].adjacent[0] = fAdj;
+                for (int jAdj = 0; jAdj < 3; ++jAdj)
+                {
+                    if (mFaces[fAdj].adjacent[jAdj] == fVisible)
+                    {
+                        mFaces[fAdj].adjacent[jAdj] = fNew;
+                        break;
+                    }
+                }
+                mVertexToNewFace[v0] = fNew;
+                mNewFaces.push_back(fNew);
+            }
         }
     }
-    else
+
+    // Connect the new faces to each other.  The new face <v0,v1,i> shares
+    // edge <v1,i> with the new face that starts at v1 and shares edge <i,v0>
+    // with the new face that ends at v0.
+    for (auto fNew : mNewFaces)
     {
-        unsigned int j = 0;
-        for (auto const& tri : mHullUnordered)
+        Face& face = mFaces[fNew];
+        int fNext = mVertexToNewFace[face.V[1]];
+        face.adjacent[1] = fNext;
+        mFaces[fNext].adjacent[2] = fNew;
+    }
+    for (auto fNew : mNewFaces)
+    {
+        mVertexToNewFace[mFaces[fNew].V[0]] = -1;
+    }
+
+    // Redistribute the conflict points of the visible faces to the new
+    // faces.  The point-plane queries are multithreaded for large sets of
+    // points.
+    mOrphans.clear();
+    for (auto fVisible : mVisible)
+    {
+        for (auto j : mFaces[fVisible].conflicts)
         {
-            queryResult[j++] = mQuery.ToPlane(i, tri.V[0], tri.V[1], tri.V[2]);
+            if (j != i)
+            {
+                mOrphans.push_back(j);
+            }
         }
+        RemoveFace(fVisible);
     }
 
-    std::map<EdgeKey<false>, std::pair<int, int>> terminator;
-    std::vector<TriangleKey<true>> backFaces;
-    bool existsFrontFacingTriangle = false;
-    unsigned int j = 0;
-    for (auto const& tri : mHullUnordered)
+    int const numOrphans = static_cast<int>(mOrphans.size());
+    mOrphanFaces.resize(numOrphans);
+    ParallelFor(numOrphans, 256, [this](int imin, int imax)
     {
-        if (queryResult[j++] <= 0)
+        for (int k = imin; k < imax; ++k)
         {
-            // The triangle is back facing.  These include triangles that
-            // are coplanar with the incoming point.
-            backFaces.push_back(tri);
-
-            // The current hull is a 2-manifold watertight mesh.  The
-            // terminator edges are those shared with a front-facing triangle.
-            // The first time an edge of a back-facing triangle is visited,
-            // insert it into the terminator.  If it is visited a second time,
-            // the edge is removed because it is shared by another back-facing
-            // triangle.  After all back-facing triangles are visited, the
-            // only remaining edges are shared by a single back-facing
-            // triangle, which makes them terminator edges.
-            for (int j0 = 2, j1 = 0; j1 < 3; j0 = j1++)
+            mOrphanFaces[k] = -1;
+            for (auto fNew : mNewFaces)
             {
-                int v0 = tri.V[j0], v1 = tri.V[j1];
-                EdgeKey<false> edge(v0, v1);
-                auto iter = terminator.find(edge);
-                if (iter == terminator.end())
+                if (IsOutside(mOrphans[k], fNew))
                 {
-                    // The edge is visited for the first time.
-                    terminator.insert(std::make_pair(edge, std::make_pair(v0, v1)));
-                }
-                else
-                {
-                    // The edge is visited for the second time.
-                    terminator.erase(edge);
+                    mOrphanFaces[k] = fNew;
+                    break;
                 }
             }
         }
-        else
+    });
+    for (int k = 0; k < numOrphans; ++k)
+    {
+        if (mOrphanFaces[k] >= 0)
         {
-            // If there are no strictly front-facing triangles, then the
-            // incoming point is inside or on the convex hull.  If we get
-            // to this code, then the point is truly outside and we can
-            // update the hull.
-            existsFrontFacingTriangle = true;
+            AddConflict(mOrphanFaces[k], mOrphans[k]);
         }
     }
 
-    if (!existsFrontFacingTriangle)
+    for (auto fNew : mNewFaces)
     {
-        // The incoming point is inside or on the current hull, so no
-        // update of the hull is necessary.
-        return;
-    }
-
-    // The updated hull contains the triangles not visible to the incoming
-    // point.
-    mHullUnordered = backFaces;
-
-    // Insert the triangles formed by the incoming point and the terminator
-    // edges.
-    for (auto const& edge : terminator)
-    {
-        mHullUnordered.push_back(TriangleKey<true>(i, edge.second.second, edge.second.first));
+        if (mFaces[fNew].conflicts.size() > 0)
+        {
+            mPending.push_back(fNew);
+        }
     }
 }
 
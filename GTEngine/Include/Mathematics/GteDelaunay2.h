@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.2 (2026/10/18)
 
 #pragma once
 
@@ -11,6 +11,7 @@
 #include <Mathematics/GteETManifoldMesh.h>
 #include <Mathematics/GtePrimalQuery2.h>
 #include <Mathematics/GteLine.h>
+#include <type_traits>
 #include <vector>
 
 // Delaunay triangulation of points (intrinsic dimensionality 2).
@@ -43,6 +44,17 @@
 // use BSNumber.  No divisions are performed in this computation, so you do
 // not have to use BSRational.
 //
+// The points are inserted in the order of the input array and the triangles
+// are stored in an ETManifoldMesh.  For large data sets, IncrementalDelaunay2
+// computes a Delaunay triangulation using a spatially sorted insertion order
+// and a flat triangle storage, and ParallelDelaunay2 computes one in
+// multiple threads.  Their triangles are those of Delaunay2 only when no
+// four points are cocircular; otherwise, the Delaunay triangulation is not
+// unique and the triangulations of the cocircular subsets, for example, the
+// diagonals of the squares of a regular grid, can differ.  DynamicDelaunay2
+// supports the insertion and removal of points after the triangulation is
+// computed.
+//
 // The worst-case choices of N for Real of type BSNumber or BSRational with
 // integer storage UIntegerFP32<N> are listed in the next table.  The numerical
 // computations are encapsulated in PrimalQuery2<Real>::ToLine and
@@ -170,6 +182,11 @@ protected:
     std::vector<Vector2<ComputeType>> mComputeVertices;
     PrimalQuery2<ComputeType> mQuery;
 
+    // Double-precision copies of the input for the floating-point filter of
+    // the queries.  The filter is enabled when InputType is float or double
+    // and ComputeType is not a floating-point type.
+    std::vector<Vector2<double>> mFilterVertices;
+
     // The graph information.
     int mNumVertices;
     int mNumUniqueVertices;
@@ -280,6 +297,20 @@ bool Delaunay2<InputType, ComputeType>::operator()(int numVertices,
         }
     }
 
+    if ((std::is_same<InputType, float>::value || std::is_same<InputType, double>::value)
+        && !std::is_floating_point<ComputeType>::value)
+    {
+        mFilterVertices.resize(mNumVertices);
+        for (i = 0; i < mNumVertices; ++i)
+        {
+            for (j = 0; j < 2; ++j)
+            {
+                mFilterVertices[i][j] = static_cast<double>(vertices[i][j]);
+            }
+        }
+        mQuery.SetFilter(&mFilterVertices[0]);
+    }
+
     // Insert the (nondegenerate) triangle constructed by the call to
     // GetInformation.  This is necessary for the circumcircle-visibility
     // algorithm to work correctly.
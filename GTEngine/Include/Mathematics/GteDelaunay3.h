@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.1 (2026/10/18)
 
 #pragma once
 
@@ -12,6 +12,7 @@
 #include <Mathematics/GteTSManifoldMesh.h>
 #include <Mathematics/GteLine.h>
 #include <Mathematics/GteHyperplane.h>
+#include <type_traits>
 #include <vector>
 
 // Delaunay tetrahedralization of points (intrinsic dimensionality 3).
@@ -182,6 +183,11 @@ private:
     std::vector<Vector3<ComputeType>> mComputeVertices;
     PrimalQuery3<ComputeType> mQuery;
 
+    // Double-precision copies of the input for the floating-point filter of
+    // the queries.  The filter is enabled when InputType is float or double
+    // and ComputeType is not a floating-point type.
+    std::vector<Vector3<double>> mFilterVertices;
+
     // The graph information.
     int mNumVertices;
     int mNumUniqueVertices;
@@ -269,6 +275,20 @@ bool Delaunay3<InputType, ComputeType>::operator()(int numVertices,
         }
     }
 
+    if ((std::is_same<InputType, float>::value || std::is_same<InputType, double>::value)
+        && !std::is_floating_point<ComputeType>::value)
+    {
+        mFilterVertices.resize(mNumVertices);
+        for (i = 0; i < mNumVertices; ++i)
+        {
+            for (j = 0; j < 3; ++j)
+            {
+                mFilterVertices[i][j] = static_cast<double>(vertices[i][j]);
+            }
+        }
+        mQuery.SetFilter(&mFilterVertices[0]);
+    }
+
     // Insert the (nondegenerate) tetrahedron constructed by the call to
     // GetInformation. This is necessary for the circumsphere-visibility
     // algorithm to work correctly.
@@ -0,0 +1,628 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <Mathematics/GteIncrementalDelaunay2.h>
+
+// Delaunay triangulation of points (intrinsic dimensionality 2) that can be
+// modified after construction.  The initial triangulation is computed by
+// IncrementalDelaunay2.  Afterwards, points are inserted by the same walk
+// and Bowyer-Watson cavity construction, and vertices are removed by
+// retriangulating the polygon formed by the triangles sharing the vertex.
+// The polygon is triangulated by clipping ears whose circumcircles do not
+// contain polygon vertices, which produces Delaunay triangles.  See
+// "On deletion in Delaunay triangulations", O. Devillers, International
+// Journal of Computational Geometry and Applications, 2002.
+//
+// The index and adjacency arrays returned by GetIndices() and
+// GetAdjacencies() are updated in place.  A triangle destroyed by an update
+// is replaced by the last triangle of the arrays, so the cost of an update
+// is proportional to the number of triangles it creates and destroys rather
+// than to the number of triangles.  The consequence is that the triangle
+// indices change after an update.
+//
+// The vertices are copied by the class.  A vertex index is never reused: an
+// inserted point is appended to the vertex array, and a removed vertex i has
+// GetDuplicates()[i] = -1.  The updates require the triangulation to have
+// dimension 2; a removal that would reduce the dimension fails.
+
+namespace gte
+{
+
+template <typename InputType, typename ComputeType>
+class DynamicDelaunay2 : public IncrementalDelaunay2<InputType, ComputeType>
+{
+public:
+    // Construction and destruction.
+    virtual ~DynamicDelaunay2();
+    DynamicDelaunay2();
+
+    // The input is the array of vertices whose Delaunay triangulation is
+    // required.  See the comments in GteIncrementalDelaunay2.h.  The array
+    // is copied and need not persist after the call.
+    bool operator()(int numVertices, Vector2<InputType> const* vertices, InputType epsilon);
+
+    // Insert a point into the triangulation.  The return value is the index
+    // of the new vertex, which is GetNumVertices() before the call, or -1
+    // when the insertion fails.  If the point is already a vertex, the new
+    // vertex is recorded as its duplicate.  The walk that locates the point
+    // starts at triangle 'hint' when it is a valid triangle index (for
+    // example, the value of GetVertexTriangle for a vertex near the point)
+    // and at a triangle of the most recently inserted vertex otherwise.
+    int Insert(Vector2<InputType> const& point, int hint = -1);
+
+    // Remove vertex i from the triangulation.  If the vertex has duplicates,
+    // one of them replaces it and the triangles do not change.  The return
+    // value is 'false' when i is not a vertex of the triangulation or when
+    // the remaining vertices are collinear.
+    bool Remove(int i);
+
+    // The index of a triangle that shares vertex i, or -1 when vertex i is
+    // not in the triangulation.
+    int GetVertexTriangle(int i) const;
+
+protected:
+    // Append a point to the vertex arrays.
+    void AppendVertex(Vector2<InputType> const& point);
+
+    // Remove a vertex that has no duplicates.
+    bool RemoveVertex(int v);
+
+    // Maintenance of the output arrays.  The triangle slot t is at index
+    // mPermute[t] of the output arrays (-1 for ghost triangles and unused
+    // slots) and mSlot is the inverse mapping.  The rows of the output
+    // arrays for the slots in mDirty are recomputed by UpdateOutput.
+    void AcquireOutput(int t);
+    void ReleaseOutput(int t);
+    void UpdateOutput();
+
+    // The vertices are stored by the class.
+    std::vector<Vector2<InputType>> mPositions;
+
+    // The duplicates of a vertex are stored in a singly linked list that
+    // starts at the vertex, terminated by -1.
+    std::vector<int> mNextDuplicate;
+
+    // A finite triangle slot sharing the vertex (-1 for duplicates and
+    // removed vertices).
+    std::vector<int> mVertexTriangle;
+
+    std::vector<int> mPermute;
+    std::vector<int> mSlot;
+    std::vector<int> mDirty;
+
+    // Support for the removal.  The triangles sharing the removed vertex
+    // are mStar.  The polygon formed by them has vertices mLink, where the
+    // edge <mLink[k],mLink[k+1]> is shared with triangle mLinkOutside[k].
+    // The triangles of the polygon are stored in mFill as <v0,v1,v2,a0,a1,
+    // a2>, where aj is the triangle adjacent to edge <vj,v(j+1)>.  It is a
+    // slot when aj >= 0, mFill[-1-aj] when aj < 0, or a later triangle of
+    // mFill when aj = UNKNOWN_ADJACENT.
+    enum
+    {
+        UNKNOWN_ADJACENT = -0x7FFFFFFF
+    };
+
+    std::vector<int> mStar;
+    std::vector<int> mLink;
+    std::vector<int> mLinkOutside;
+    std::vector<std::array<int, 6>> mFill;
+    std::vector<int> mFillSlot;
+};
+
+
+template <typename InputType, typename ComputeType>
+DynamicDelaunay2<InputType, ComputeType>::~DynamicDelaunay2()
+{
+}
+
+template <typename InputType, typename ComputeType>
+DynamicDelaunay2<InputType, ComputeType>::DynamicDelaunay2()
+{
+}
+
+template <typename InputType, typename ComputeType>
+bool DynamicDelaunay2<InputType, ComputeType>::operator()(int numVertices,
+    Vector2<InputType> const* vertices, InputType epsilon)
+{
+    mPositions.assign(vertices, vertices + std::max(numVertices, 0));
+    mNextDuplicate.clear();
+    mVertexTriangle.clear();
+    mPermute.clear();
+    mSlot.clear();
+    if (!IncrementalDelaunay2<InputType, ComputeType>::operator()(
+        numVertices, mPositions.data(), epsilon))
+    {
+        return false;
+    }
+
+    // Link the duplicates to their vertices.
+    mNextDuplicate.resize(numVertices, -1);
+    for (int i = 0; i < numVertices; ++i)
+    {
+        int v = this->mDuplicates[i];
+        if (v != i)
+        {
+            mNextDuplicate[i] = mNextDuplicate[v];
+            mNextDuplicate[v] = i;
+        }
+    }
+
+    // The output triangles are the finite triangles in the order of their
+    // slots (see IncrementalDelaunay2::BuildOutput).
+    int const numSlots = static_cast<int>(this->mTriVertices.size() / 3);
+    mVertexTriangle.resize(numVertices, -1);
+    mPermute.resize(numSlots, -1);
+    mSlot.reserve(this->mNumTriangles);
+    for (int t = 0; t < numSlots; ++t)
+    {
+        if (this->mTriVertices[3 * t] != this->REMOVED_TRIANGLE && !this->IsGhost(t))
+        {
+            mPermute[t] = static_cast<int>(mSlot.size());
+            mSlot.push_back(t);
+            for (int j = 0; j < 3; ++j)
+            {
+                mVertexTriangle[this->mTriVertices[3 * t + j]] = t;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename InputType, typename ComputeType>
+int DynamicDelaunay2<InputType, ComputeType>::Insert(Vector2<InputType> const& point, int hint)
+{
+    if (this->mDimension != 2)
+    {
+        LogError("The dimension must be 2.");
+        return -1;
+    }
+
+    int i = this->mNumVertices;
+    AppendVertex(point);
+
+    int tStart = (0 <= hint && hint < this->mNumTriangles ? mSlot[hint] : this->mLastTriangle);
+    int t = this->Locate(i, tStart);
+    if (t < 0)
+    {
+        // A failure can occur if ComputeType is not an exact arithmetic
+        // type.  The vertex is not in the triangulation.
+        this->mDuplicates[i] = -1;
+        return -1;
+    }
+
+    if (!this->IsGhost(t))
+    {
+        // The point is in the triangle or on its boundary, so if it is a
+        // vertex of the triangulation, it is a vertex of the triangle.
+        int const* V = &this->mTriVertices[3 * t];
+        for (int j = 0; j < 3; ++j)
+        {
+            if (mPositions[V[j]] == point)
+            {
+                this->mDuplicates[i] = V[j];
+                mNextDuplicate[i] = mNextDuplicate[V[j]];
+                mNextDuplicate[V[j]] = i;
+                return i;
+            }
+        }
+    }
+
+    if (!IncrementalDelaunay2<InputType, ComputeType>::Insert(i, t))
+    {
+        // A failure can occur if ComputeType is not an exact arithmetic
+        // type.  The triangulation is no longer valid.
+        this->mDuplicates[i] = -1;
+        this->mDimension = 0;
+        return -1;
+    }
+    ++this->mNumUniqueVertices;
+
+    // The triangles of the cavity were destroyed and the triangles outside
+    // the cavity that share its boundary edges have new adjacents.  The new
+    // triangle for boundary edge <v0,v1> is stored in mStartTriangle[v0].
+    mPermute.resize(this->mTriVertices.size() / 3, -1);
+    mDirty.clear();
+    for (auto tCavity : this->mCavity)
+    {
+        ReleaseOutput(tCavity);
+    }
+    for (auto const& edge : this->mBoundary)
+    {
+        int v0 = edge[0], v1 = edge[1];
+        mDirty.push_back(edge[2]);
+        if (v0 != this->INFINITE_VERTEX && v1 != this->INFINITE_VERTEX)
+        {
+            int tNew = this->mStartTriangle[v0];
+            AcquireOutput(tNew);
+            mVertexTriangle[v0] = tNew;
+            mVertexTriangle[v1] = tNew;
+            mVertexTriangle[i] = tNew;
+        }
+    }
+    UpdateOutput();
+    return i;
+}
+
+template <typename InputType, typename ComputeType>
+bool DynamicDelaunay2<InputType, ComputeType>::Remove(int i)
+{
+    if (this->mDimension != 2 || i < 0 || i >= this->mNumVertices || this->mDuplicates[i] < 0)
+    {
+        LogError("Vertex " + std::to_string(i) + " is not in the triangulation.");
+        return false;
+    }
+
+    int v = this->mDuplicates[i];
+    if (v != i)
+    {
+        // Vertex i is a duplicate.  Remove it from the list of duplicates.
+        int previous = v;
+        while (mNextDuplicate[previous] != i)
+        {
+            previous = mNextDuplicate[previous];
+        }
+        mNextDuplicate[previous] = mNextDuplicate[i];
+        mNextDuplicate[i] = -1;
+        this->mDuplicates[i] = -1;
+        return true;
+    }
+
+    int w = mNextDuplicate[i];
+    if (w < 0)
+    {
+        return RemoveVertex(i);
+    }
+
+    // Replace vertex i by its first duplicate w in the triangles sharing
+    // vertex i, including the ghost triangles.
+    for (int d = w; d >= 0; d = mNextDuplicate[d])
+    {
+        this->mDuplicates[d] = w;
+    }
+    mNextDuplicate[i] = -1;
+    this->mDuplicates[i] = -1;
+
+    mDirty.clear();
+    int t0 = mVertexTriangle[i], t = t0;
+    do
+    {
+        int* V = &this->mTriVertices[3 * t];
+        int j = 0;
+        while (V[j] != i)
+        {
+            ++j;
+        }
+        V[j] = w;
+        mDirty.push_back(t);
+        t = this->mTriAdjacencies[3 * t + (j + 2) % 3];
+    }
+    while (t != t0);
+    mVertexTriangle[w] = t0;
+    mVertexTriangle[i] = -1;
+    UpdateOutput();
+    return true;
+}
+
+template <typename InputType, typename ComputeType>
+int DynamicDelaunay2<InputType, ComputeType>::GetVertexTriangle(int i) const
+{
+    if (0 <= i && i < static_cast<int>(mVertexTriangle.size()) && this->mDuplicates[i] >= 0)
+    {
+        int t = mVertexTriangle[this->mDuplicates[i]];
+        return (t >= 0 ? mPermute[t] : -1);
+    }
+    return -1;
+}
+
+template <typename InputType, typename ComputeType>
+void DynamicDelaunay2<InputType, ComputeType>::AppendVertex(Vector2<InputType> const& point)
+{
+    // The arrays can be reallocated, so the pointers stored by the query
+    // are updated.
+    int i = this->mNumVertices++;
+    mPositions.push_back(point);
+    this->mVertices = mPositions.data();
+
+    Vector2<ComputeType> computePoint;
+    for (int j = 0; j < 2; ++j)
+    {
+        computePoint[j] = point[j];
+    }
+    this->mComputeVertices.push_back(computePoint);
+    this->mQuery.Set(this->mNumVertices, &this->mComputeVertices[0]);
+
+    if ((std::is_same<InputType, float>::value || std::is_same<InputType, double>::value)
+        && !std::is_floating_point<ComputeType>::value)
+    {
+        Vector2<double> filterPoint;
+        for (int j = 0; j < 2; ++j)
+        {
+            filterPoint[j] = static_cast<double>(point[j]);
+        }
+        this->mFilterVertices.push_back(filterPoint);
+        this->mQuery.SetFilter(&this->mFilterVertices[0]);
+    }
+
+    this->mDuplicates.push_back(i);
+    mNextDuplicate.push_back(-1);
+    mVertexTriangle.push_back(-1);
+
+    // The point at infinity is mapped to mStartTriangle[mNumVertices].
+    this->mStartTriangle.resize(this->mNumVertices + 1, -1);
+}
+
+template <typename InputType, typename ComputeType>
+bool DynamicDelaunay2<InputType, ComputeType>::RemoveVertex(int v)
+{
+    int const INF = this->INFINITE_VERTEX;
+
+    // Walk counterclockwise around v to collect the triangles sharing v.
+    // For triangle <v,a,b>, the next triangle is <v,b,c>.
+    mStar.clear();
+    mLink.clear();
+    mLinkOutside.clear();
+    int t0 = mVertexTriangle[v], t = t0;
+    int numStarFinite = 0;
+    do
+    {
+        int const* V = &this->mTriVertices[3 * t];
+        int const* A = &this->mTriAdjacencies[3 * t];
+        int j = 0;
+        while (V[j] != v)
+        {
+            ++j;
+        }
+        mStar.push_back(t);
+        mLink.push_back(V[(j + 1) % 3]);
+        mLinkOutside.push_back(A[(j + 1) % 3]);
+        if (!this->IsGhost(t))
+        {
+            ++numStarFinite;
+        }
+        t = A[(j + 2) % 3];
+    }
+    while (t != t0);
+
+    // Triangulate the polygon, which is stored as a circular list.  The
+    // adjacent triangle of the edge from node n to next[n] is outside[n].
+    int const numLink = static_cast<int>(mLink.size());
+    std::vector<int> next(numLink), prev(numLink), outside(numLink);
+    int infNode = -1;
+    for (int n = 0; n < numLink; ++n)
+    {
+        next[n] = (n + 1) % numLink;
+        prev[n] = (n + numLink - 1) % numLink;
+        outside[n] = mLinkOutside[n];
+        if (mLink[n] == INF)
+        {
+            infNode = n;
+        }
+    }
+
+    mFill.clear();
+    int first = 0, numFillFinite = 0;
+    for (int remaining = numLink; remaining > 3; --remaining)
+    {
+        // Search for an ear <a,b,c> that is a counterclockwise triangle
+        // whose circumcircle does not contain a polygon vertex.
+        int ear = -1;
+        for (int k = 0, n = first; k < remaining && ear < 0; ++k, n = next[n])
+        {
+            int a = mLink[prev[n]], b = mLink[n], c = mLink[next[n]];
+            if (a == INF || b == INF || c == INF || this->mQuery.ToLine(c, a, b) >= 0)
+            {
+                continue;
+            }
+
+            ear = n;
+            for (auto u : mLink)
+            {
+                if (u != INF && u != a && u != b && u != c
+                    && this->mQuery.ToCircumcircle(u, a, b, c) < 0)
+                {
+                    ear = -1;
+                    break;
+                }
+            }
+        }
+
+        if (ear < 0)
+        {
+            if (infNode < 0)
+            {
+                // A failure can occur if ComputeType is not an exact
+                // arithmetic type.
+                LogError("Unexpected condition (ComputeType not exact?)");
+                return false;
+            }
+
+            // The vertex is on the hull and the remaining polygon edges
+            // that are not incident to the point at infinity are hull
+            // edges.  Clip the ghost triangle at the node following the
+            // point at infinity.
+            ear = next[infNode];
+        }
+        else
+        {
+            ++numFillFinite;
+        }
+
+        int p = prev[ear], n = next[ear];
+        mFill.push_back({ { mLink[p], mLink[ear], mLink[n], outside[p], outside[ear],
+            UNKNOWN_ADJACENT } });
+        next[p] = n;
+        prev[n] = p;
+        outside[p] = -1 - static_cast<int>(mFill.size() - 1);
+        if (first == ear)
+        {
+            first = n;
+        }
+    }
+
+    int n0 = first, n1 = next[n0], n2 = next[n1];
+    mFill.push_back({ { mLink[n0], mLink[n1], mLink[n2], outside[n0], outside[n1],
+        outside[n2] } });
+    if (infNode < 0)
+    {
+        ++numFillFinite;
+    }
+
+    if (this->mNumTriangles - numStarFinite + numFillFinite == 0)
+    {
+        // The remaining vertices are collinear.
+        return false;
+    }
+
+    // Replace the triangles sharing v by the triangles of the polygon.
+    mDirty.clear();
+    for (auto tStar : mStar)
+    {
+        ReleaseOutput(tStar);
+        this->mTriVertices[3 * tStar] = this->REMOVED_TRIANGLE;
+        this->mFreeTriangles.push_back(tStar);
+    }
+
+    mFillSlot.resize(mFill.size());
+    for (size_t p = 0; p < mFill.size(); ++p)
+    {
+        auto const& fill = mFill[p];
+        int tNew = this->CreateTriangle(fill[0], fill[1], fill[2]);
+        mFillSlot[p] = tNew;
+        mPermute.resize(this->mTriVertices.size() / 3, -1);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            int adj = fill[3 + j];
+            if (adj == UNKNOWN_ADJACENT)
+            {
+                continue;
+            }
+            if (adj < 0)
+            {
+                adj = mFillSlot[-1 - adj];
+            }
+
+            // The adjacent triangle shares edge <V[j+1],V[j]>.
+            this->mTriAdjacencies[3 * tNew + j] = adj;
+            int v1 = fill[(j + 1) % 3];
+            int const* adjV = &this->mTriVertices[3 * adj];
+            for (int k = 0; k < 3; ++k)
+            {
+                if (adjV[k] == v1)
+                {
+                    this->mTriAdjacencies[3 * adj + k] = tNew;
+                    break;
+                }
+            }
+            mDirty.push_back(adj);
+        }
+
+        if (!this->IsGhost(tNew))
+        {
+            AcquireOutput(tNew);
+        }
+    }
+    if (this->mMarks.size() < this->mTriVertices.size() / 3)
+    {
+        this->mMarks.resize(this->mTriVertices.size() / 3, 0);
+    }
+
+    // Update the triangles of the polygon vertices.  Each vertex shares a
+    // finite triangle adjacent to the polygon or a finite triangle of the
+    // polygon.
+    for (int k = 0; k < numLink; ++k)
+    {
+        int adj = mLinkOutside[k];
+        if (!this->IsGhost(adj))
+        {
+            mVertexTriangle[mLink[k]] = adj;
+            mVertexTriangle[mLink[(k + 1) % numLink]] = adj;
+            this->mLastTriangle = adj;
+        }
+    }
+    for (auto tNew : mFillSlot)
+    {
+        if (!this->IsGhost(tNew))
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                mVertexTriangle[this->mTriVertices[3 * tNew + j]] = tNew;
+            }
+            this->mLastTriangle = tNew;
+        }
+    }
+
+    mVertexTriangle[v] = -1;
+    this->mDuplicates[v] = -1;
+    --this->mNumUniqueVertices;
+    UpdateOutput();
+    return true;
+}
+
+template <typename InputType, typename ComputeType>
+void DynamicDelaunay2<InputType, ComputeType>::AcquireOutput(int t)
+{
+    int k = this->mNumTriangles++;
+    mPermute[t] = k;
+    mSlot.push_back(t);
+    this->mIndices.resize(3 * static_cast<size_t>(this->mNumTriangles));
+    this->mAdjacencies.resize(3 * static_cast<size_t>(this->mNumTriangles));
+    mDirty.push_back(t);
+}
+
+template <typename InputType, typename ComputeType>
+void DynamicDelaunay2<InputType, ComputeType>::ReleaseOutput(int t)
+{
+    int k = mPermute[t];
+    if (k < 0)
+    {
+        return;
+    }
+
+    // Move the last output triangle to index k.  The triangles adjacent to
+    // it must update their adjacency information.
+    int last = --this->mNumTriangles;
+    int tLast = mSlot[last];
+    mSlot[k] = tLast;
+    mPermute[tLast] = k;
+    mPermute[t] = -1;
+    mSlot.pop_back();
+    for (int j = 0; j < 3; ++j)
+    {
+        this->mIndices[3 * k + j] = this->mIndices[3 * last + j];
+        this->mAdjacencies[3 * k + j] = this->mAdjacencies[3 * last + j];
+        int adj = this->mTriAdjacencies[3 * tLast + j];
+        if (adj >= 0)
+        {
+            mDirty.push_back(adj);
+        }
+    }
+    this->mIndices.resize(3 * static_cast<size_t>(this->mNumTriangles));
+    this->mAdjacencies.resize(3 * static_cast<size_t>(this->mNumTriangles));
+}
+
+template <typename InputType, typename ComputeType>
+void DynamicDelaunay2<InputType, ComputeType>::UpdateOutput()
+{
+    for (auto t : mDirty)
+    {
+        int k = mPermute[t];
+        if (k >= 0)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                this->mIndices[3 * k + j] = this->mTriVertices[3 * t + j];
+                this->mAdjacencies[3 * k + j] = mPermute[this->mTriAdjacencies[3 * t + j]];
+            }
+        }
+    }
+    mDirty.clear();
+}
+
+}
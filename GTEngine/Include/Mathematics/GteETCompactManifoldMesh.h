@@ -0,0 +1,200 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.1 (2026/10/18)
+
+#pragma once
+
+#include <Mathematics/GteEdgeKey.h>
+#include <Mathematics/GteTriangleKey.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// An edge-triangle manifold mesh with the same Insert/Remove/GetComponents
+// semantics as ETManifoldMesh, but the edges and triangles are stored in
+// contiguous arrays and are referenced by integer handles.  The adjacency
+// information is stored as handles (-1 for "none"), so there is no
+// std::shared_ptr reference counting or std::weak_ptr locking.  Edges are
+// located using an open-addressing hash table; triangles are located
+// through the edges they contain.  The slots of removed edges and triangles
+// are reused by later insertions, so handles are stable for the lifetime of
+// the feature but can be reused after it is removed.
+//
+// The class does not support the ECreator/TCreator extension mechanism of
+// ETManifoldMesh.  Applications that need per-feature data can store it in
+// arrays indexed by the handles.
+
+namespace gte
+{
+
+class GTE_IMPEXP ETCompactManifoldMesh
+{
+public:
+    // Edge object.  The vertices are stored as V[0] < V[1].  T[0] is the
+    // handle of the first triangle sharing the edge and T[1] is the handle
+    // of the second triangle (or -1 when the edge has one triangle).  An
+    // edge slot that is not in use has V[0] = -1.
+    struct Edge
+    {
+        int V[2];
+        int T[2];
+    };
+
+    // Triangle object.  The vertices are listed in counterclockwise order
+    // (V[0],V[1],V[2]).  E[i] is the handle of the edge (V[i],V[(i+1)%3])
+    // and T[i] is the handle of the triangle adjacent to the edge E[i] (or
+    // -1 when there is no adjacent triangle).  A triangle slot that is not
+    // in use has V[0] = -1.
+    struct Triangle
+    {
+        int V[3];
+        int E[3];
+        int T[3];
+    };
+
+    // Construction and destruction.
+    ~ETCompactManifoldMesh();
+    ETCompactManifoldMesh();
+
+    // Preallocate storage for the specified number of triangles (and the
+    // corresponding number of edges, which is at most 3*numTriangles).
+    void Reserve(int numTriangles);
+
+    // Member access.  The arrays include slots that are not in use; call
+    // IsValidEdge or IsValidTriangle to test a slot.
+    inline std::vector<Edge> const& GetEdges() const;
+    inline std::vector<Triangle> const& GetTriangles() const;
+    inline int GetNumEdges() const;
+    inline int GetNumTriangles() const;
+    inline bool IsValidEdge(int e) const;
+    inline bool IsValidTriangle(int t) const;
+
+    // Get the handle of edge <v0,v1> (either ordering) or of the triangle
+    // <v0,v1,v2> (ordered as in TriangleKey<true>).  The return value is -1
+    // when the feature is not in the mesh.
+    int GetEdge(int v0, int v1) const;
+    int GetTriangle(int v0, int v1, int v2) const;
+
+    // If the insertion of a triangle fails because the mesh would become
+    // nonmanifold, the default behavior is to trigger a LogInformation
+    // message.  The return value is the previous state.
+    bool AssertOnNonmanifoldInsertion(bool doAssert);
+
+    // If <v0,v1,v2> is not in the mesh, a triangle is created and its
+    // handle is returned; otherwise, <v0,v1,v2> is in the mesh and -1 is
+    // returned.  If the insertion leads to a nonmanifold mesh, the call
+    // fails with -1 returned and the mesh is unchanged.
+    int Insert(int v0, int v1, int v2);
+
+    // If <v0,v1,v2> is in the mesh, it is removed and 'true' is returned;
+    // otherwise, <v0,v1,v2> is not in the mesh and 'false' is returned.
+    // The second function removes a triangle by handle.
+    bool Remove(int v0, int v1, int v2);
+    bool Remove(int t);
+
+    // Destroy the edges and triangles to obtain an empty mesh.  The array
+    // capacities are retained.
+    void Clear();
+
+    // See the comments in ETManifoldMesh.
+    bool IsClosed() const;
+    bool IsOriented() const;
+
+    // Compute the connected components of the edge-triangle graph.  The
+    // first function returns triangle handles, which are valid until the
+    // mesh is modified.  The second function returns triangle keys.
+    void GetComponents(std::vector<std::vector<int>>& components) const;
+    void GetComponents(std::vector<std::vector<TriangleKey<true>>>& components) const;
+
+private:
+    // Support for the edge hash table.  The keys are the unordered edge
+    // vertices packed into 64 bits.  The table uses linear probing, and
+    // removal shifts keys backward to keep the probe sequences short.
+    static uint64_t const EMPTY_KEY = 0xFFFFFFFFFFFFFFFFull;
+    static inline uint64_t GetKey(int v0, int v1);
+    static inline uint64_t Hash(uint64_t key);
+    int FindEdge(uint64_t key) const;
+    void InsertEdge(uint64_t key, int e);
+    void RemoveEdge(uint64_t key);
+    void Rehash(size_t capacity);
+
+    // Allocation of edge and triangle slots.
+    int CreateEdge(int v0, int v1);
+    int CreateTriangle(int v0, int v1, int v2);
+
+    // Depth-first search for a connected component using a preallocated
+    // stack.
+    void DepthFirstSearch(int tInitial, std::vector<int>& visited,
+        std::vector<int>& stack, std::vector<int>& component) const;
+
+    std::vector<Edge> mEdges;
+    std::vector<Triangle> mTriangles;
+    std::vector<int> mFreeEdges, mFreeTriangles;
+    int mNumEdges, mNumTriangles;
+
+    std::vector<uint64_t> mHashKeys;
+    std::vector<int> mHashValues;
+    size_t mHashMask, mHashUsed;  // mHashUsed is the number of keys
+
+    bool mAssertOnNonmanifoldInsertion;  // default: true
+};
+
+
+inline std::vector<ETCompactManifoldMesh::Edge> const&
+ETCompactManifoldMesh::GetEdges() const
+{
+    return mEdges;
+}
+
+inline std::vector<ETCompactManifoldMesh::Triangle> const&
+ETCompactManifoldMesh::GetTriangles() const
+{
+    return mTriangles;
+}
+
+inline int ETCompactManifoldMesh::GetNumEdges() const
+{
+    return mNumEdges;
+}
+
+inline int ETCompactManifoldMesh::GetNumTriangles() const
+{
+    return mNumTriangles;
+}
+
+inline bool ETCompactManifoldMesh::IsValidEdge(int e) const
+{
+    return 0 <= e && e < static_cast<int>(mEdges.size()) && mEdges[e].V[0] >= 0;
+}
+
+inline bool ETCompactManifoldMesh::IsValidTriangle(int t) const
+{
+    return 0 <= t && t < static_cast<int>(mTriangles.size()) && mTriangles[t].V[0] >= 0;
+}
+
+inline uint64_t ETCompactManifoldMesh::GetKey(int v0, int v1)
+{
+    if (v0 > v1)
+    {
+        std::swap(v0, v1);
+    }
+    return (static_cast<uint64_t>(static_cast<uint32_t>(v0)) << 32)
+        | static_cast<uint64_t>(static_cast<uint32_t>(v1));
+}
+
+inline uint64_t ETCompactManifoldMesh::Hash(uint64_t key)
+{
+    // The finalizer of the SplitMix64 generator.
+    key ^= (key >> 30);
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= (key >> 27);
+    key *= 0x94D049BB133111EBull;
+    key ^= (key >> 31);
+    return key;
+}
+
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.2 (2018/10/05)
+// File Version: 3.0.3 (2026/10/18)
 
 #pragma once
 
@@ -24,7 +24,6 @@
 #include <limits>
 #include <memory>
 #include <set>
-#include <thread>
 #include <vector>
 
 // This class is an implementation of the barycentric mapping algorithm
@@ -624,7 +623,7 @@ void GenerateMeshUV<Real>::SolveSystem(unsigned int numIterations)
     else
 #endif
     {
-        if (mCModel->numThreads > 1)
+        if (mCModel->threadPool && mCModel->threadPool->GetNumThreads() > 1)
         {
             SolveSystemCPUMultiple(numIterations);
         }
@@ -687,17 +686,6 @@ void GenerateMeshUV<Real>::SolveSystemCPUMultiple(unsigned int numIterations)
     Vector2<Real>* inTCoords = mTCoords;
     Vector2<Real>* outTCoords = &tcoords[0];
 
-    // Partition the data for multiple threads.
-    int numV = mNumVertices - mNumBoundaryEdges;
-    int numVPerThread = numV / mCModel->numThreads;
-    std::vector<int> vmin(mCModel->numThreads), vmax(mCModel->numThreads);
-    for (unsigned int t = 0; t < mCModel->numThreads; ++t)
-    {
-        vmin[t] = mNumBoundaryEdges + t * numVPerThread;
-        vmax[t] = vmin[t] + numVPerThread - 1;
-    }
-    vmax[mCModel->numThreads - 1] = mNumVertices - 1;
-
     // The value numIterations is even, so we always swap an even number
     // of times.  This ensures that on exit from the loop, outTCoords is
     // tcoords.
@@ -708,38 +696,29 @@ void GenerateMeshUV<Real>::SolveSystemCPUMultiple(unsigned int numIterations)
             (*mCModel->progress)(i);
         }
 
-        // Execute Gauss-Seidel iterations in multiple threads.
-        std::vector<std::thread> process(mCModel->numThreads);
-        for (unsigned int t = 0; t < mCModel->numThreads; ++t)
+        // Execute Gauss-Seidel iterations in the threads of the pool.  The
+        // threads persist between iterations.
+        mCModel->threadPool->ParallelFor(mNumBoundaryEdges, mNumVertices, 0,
+            [this, inTCoords, outTCoords](int jmin, int jmax)
         {
-            process[t] = std::thread([this, t, &vmin, &vmax, inTCoords,
-                outTCoords]()
+            for (int j = jmin; j < jmax; ++j)
             {
-                for (int j = vmin[t]; j <= vmax[t]; ++j)
+                int v0 = mOrderedVertices[j];
+                std::array<int, 2> range = mVertexGraph[v0].range;
+                auto const* current = &mVertexGraphData[range[0]];
+                Vector2<Real> tcoord{ (Real)0, (Real)0 };
+                Real weight, weightSum = (Real)0;
+                for (int k = 0; k < range[1]; ++k, ++current)
                 {
-                    int v0 = mOrderedVertices[j];
-                    std::array<int, 2> range = mVertexGraph[v0].range;
-                    auto const* current = &mVertexGraphData[range[0]];
-                    Vector2<Real> tcoord{ (Real)0, (Real)0 };
-                    Real weight, weightSum = (Real)0;
-                    for (int k = 0; k < range[1]; ++k, ++current)
-                    {
-                        int v1 = current->first;
-                        weight = current->second;
-                        weightSum += weight;
-                        tcoord += weight * inTCoords[v1];
-                    }
-                    tcoord /= weightSum;
-                    outTCoords[v0] = tcoord;
+                    int v1 = current->first;
+                    weight = current->second;
+                    weightSum += weight;
+                    tcoord += weight * inTCoords[v1];
                 }
-            });
-        }
-
-        // Wait for all threads to finish.
-        for (unsigned int t = 0; t < mCModel->numThreads; ++t)
-        {
-            process[t].join();
-        }
+                tcoord /= weightSum;
+                outTCoords[v0] = tcoord;
+            }
+        });
 
         std::swap(inTCoords, outTCoords);
     }
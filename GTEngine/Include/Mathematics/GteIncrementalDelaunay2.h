@@ -0,0 +1,843 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.1 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GtePrimalQuery2.h>
+#include <Mathematics/GteLine.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// Delaunay triangulation of points (intrinsic dimensionality 2) computed by
+// incremental insertion.  The output has the format of that of Delaunay2
+// (see the comments in GteDelaunay2.h for the meaning of the index and
+// adjacency arrays), but the class is designed for large data sets.  When
+// no four points are cocircular, the Delaunay triangulation is unique and
+// the triangles are those of Delaunay2.  Otherwise, the triangulation of
+// each cocircular subset depends on the insertion order, so the output is
+// a Delaunay triangulation that can differ from that of Delaunay2; for
+// example, the diagonals chosen for the squares of a regular grid differ.
+//
+// 1. The points are inserted in a biased randomized insertion order (BRIO).
+//    The unique points are randomly permuted and partitioned into rounds of
+//    geometrically increasing size.  The points of each round are sorted
+//    along a Hilbert curve, so consecutive insertions are spatially close.
+//    See "Incremental constructions con BRIO", N. Amenta, S. Choi and
+//    G. Rote, Proceedings of the 19th Annual Symposium on Computational
+//    Geometry, 2003.
+//
+// 2. The triangle containing a point is located by a remembering stochastic
+//    walk that starts at a triangle of the previously inserted point.  See
+//    "Walking in a triangulation", O. Devillers, S. Pion and M. Teillaud,
+//    International Journal of Foundations of Computer Science, 2002.
+//
+// 3. The triangles are stored in flat arrays of vertex indices and adjacent
+//    triangle indices.  Each edge of the convex hull is shared by a finite
+//    triangle and a "ghost" triangle whose third vertex is the point at
+//    infinity, so points outside the hull are handled by the same
+//    Bowyer-Watson cavity construction as points inside the hull.  The
+//    slots of triangles destroyed by an insertion are reused.
+//
+// The expected construction time is O(n log n).  The output triangles are
+// not in the order produced by Delaunay2, but the triangle vertices are
+// counterclockwise and the adjacency information has the same meaning.  The
+// comments in GteDelaunay2.h about the choice of ComputeType apply here.
+
+namespace gte
+{
+
+template <typename InputType, typename ComputeType>
+class IncrementalDelaunay2
+{
+public:
+    // The class is a functor to support computing the Delaunay triangulation
+    // of multiple data sets using the same class object.
+    virtual ~IncrementalDelaunay2();
+    IncrementalDelaunay2();
+
+    // The input is the array of vertices whose Delaunay triangulation is
+    // required.  The epsilon value is used to determine the intrinsic
+    // dimensionality of the vertices (d = 0, 1, or 2).  When epsilon is
+    // positive, the determination is fuzzy--vertices approximately the same
+    // point, approximately on a line, or planar.  The return value is 'true'
+    // if and only if the triangulation is successful.
+    bool operator()(int numVertices, Vector2<InputType> const* vertices, InputType epsilon);
+
+    // Dimensional information.  If GetDimension() returns 1, the points lie
+    // on a line P+t*D (fuzzy comparison when epsilon > 0).
+    inline InputType GetEpsilon() const;
+    inline int GetDimension() const;
+    inline Line2<InputType> const& GetLine() const;
+
+    // Member access.
+    inline int GetNumVertices() const;
+    inline int GetNumUniqueVertices() const;
+    inline int GetNumTriangles() const;
+    inline Vector2<InputType> const* GetVertices() const;
+    inline PrimalQuery2<ComputeType> const& GetQuery() const;
+    inline std::vector<int> const& GetIndices() const;
+    inline std::vector<int> const& GetAdjacencies() const;
+
+    // If 'vertices' has no duplicates, GetDuplicates()[i] = i for all i.
+    // If vertices[i] is the first occurrence of a vertex and if vertices[j]
+    // is found later, then GetDuplicates()[j] = i.
+    inline std::vector<int> const& GetDuplicates() const;
+
+    // See the comments in GteDelaunay2.h for these functions.
+    bool GetHull(std::vector<int>& hull) const;
+    bool GetIndices(int i, std::array<int, 3>& indices) const;
+    bool GetAdjacencies(int i, std::array<int, 3>& adjacencies) const;
+
+protected:
+    // The vertex index of the point at infinity and the marker for triangle
+    // slots that are not in use.
+    enum
+    {
+        INFINITE_VERTEX = -1,
+        REMOVED_TRIANGLE = -2
+    };
+
+    // Compute the order in which the unique vertices are inserted.  The
+    // vertices of the initial triangle are excluded.
+    void ComputeInsertionOrder(std::array<int, 3> const& initial,
+        InputType const* bmin, InputType const* bmax, std::vector<int>& order);
+
+    // The Hilbert-curve index of a point in a 2^16-by-2^16 grid.
+    static uint32_t GetHilbertIndex(uint32_t x, uint32_t y);
+
+    // Remembering stochastic walk from triangle t to the triangle that
+    // contains point i.  The returned triangle is either a finite triangle
+    // containing point i (possibly on its boundary) or a ghost triangle
+    // whose hull edge is visible to point i.  The return value is -1 when
+    // the walk fails, which can occur if ComputeType is not an exact
+    // arithmetic type.
+    int Locate(int i, int t);
+
+    // Test whether point i is in conflict with triangle t; that is, whether
+    // point i is strictly inside the circumcircle of a finite triangle or
+    // strictly outside the hull edge of a ghost triangle (or in the interior
+    // of that edge).
+    bool InConflict(int i, int t) const;
+
+    // Insert point i, where t is a triangle in conflict with the point.  The
+    // conflicting triangles are removed and the cavity is triangulated by
+    // connecting point i to its boundary edges.
+    bool Insert(int i, int t);
+
+    // Allocation of triangle slots.
+    int CreateTriangle(int v0, int v1, int v2);
+    inline bool IsGhost(int t) const;
+
+    // Copy the finite triangles to mIndices and mAdjacencies.
+    void BuildOutput();
+
+    InputType mEpsilon;
+    int mDimension;
+    Line2<InputType> mLine;
+
+    // The array of vertices used for geometric queries.  If you want to be
+    // certain of a correct result, choose ComputeType to be BSNumber.
+    std::vector<Vector2<ComputeType>> mComputeVertices;
+    PrimalQuery2<ComputeType> mQuery;
+
+    // Double-precision copies of the input for the floating-point filter of
+    // the queries.  The filter is enabled when InputType is float or double
+    // and ComputeType is not a floating-point type.
+    std::vector<Vector2<double>> mFilterVertices;
+
+    // The graph information.
+    int mNumVertices;
+    int mNumUniqueVertices;
+    int mNumTriangles;
+    Vector2<InputType> const* mVertices;
+    std::vector<int> mIndices;
+    std::vector<int> mAdjacencies;
+    std::vector<int> mDuplicates;
+
+    // The triangulation including the ghost triangles.  The triangle t has
+    // vertices mTriVertices[3*t+j] in counterclockwise order, where one
+    // vertex is INFINITE_VERTEX for a ghost triangle.  The triangle sharing
+    // edge <V[j],V[(j+1)%3]> is mTriAdjacencies[3*t+j].  Removed triangles
+    // have mTriVertices[3*t] = REMOVED_TRIANGLE and their slots are stored
+    // in mFreeTriangles.
+    std::vector<int> mTriVertices;
+    std::vector<int> mTriAdjacencies;
+    std::vector<int> mFreeTriangles;
+
+    // Support for the insertion.  The triangle mLastTriangle is a finite
+    // triangle sharing the most recently inserted vertex; it is the start
+    // of the next walk.  The mark array stores the conflict status of
+    // triangles visited during the current insertion: mMarkStamp for a
+    // triangle in the cavity and mMarkStamp+1 for a triangle that is not.
+    int mLastTriangle;
+    std::vector<uint32_t> mMarks;
+    uint32_t mMarkStamp;
+    std::vector<int> mCavity;
+    std::vector<std::array<int, 3>> mBoundary;
+    std::vector<int> mStartTriangle;
+    std::minstd_rand mRandom;
+};
+
+
+template <typename InputType, typename ComputeType>
+IncrementalDelaunay2<InputType, ComputeType>::~IncrementalDelaunay2()
+{
+}
+
+template <typename InputType, typename ComputeType>
+IncrementalDelaunay2<InputType, ComputeType>::IncrementalDelaunay2()
+    :
+    mEpsilon((InputType)0),
+    mDimension(0),
+    mLine(Vector2<InputType>::Zero(), Vector2<InputType>::Zero()),
+    mNumVertices(0),
+    mNumUniqueVertices(0),
+    mNumTriangles(0),
+    mVertices(nullptr),
+    mLastTriangle(-1),
+    mMarkStamp(0)
+{
+}
+
+template <typename InputType, typename ComputeType>
+bool IncrementalDelaunay2<InputType, ComputeType>::operator()(int numVertices,
+    Vector2<InputType> const* vertices, InputType epsilon)
+{
+    mEpsilon = std::max(epsilon, (InputType)0);
+    mDimension = 0;
+    mLine.origin = Vector2<InputType>::Zero();
+    mLine.direction = Vector2<InputType>::Zero();
+    mNumVertices = numVertices;
+    mNumUniqueVertices = 0;
+    mNumTriangles = 0;
+    mVertices = vertices;
+    mIndices.clear();
+    mAdjacencies.clear();
+    mTriVertices.clear();
+    mTriAdjacencies.clear();
+    mFreeTriangles.clear();
+    mMarks.clear();
+    mMarkStamp = 0;
+    mLastTriangle = -1;
+    mRandom.seed();
+    mDuplicates.resize(std::max(numVertices, 3));
+
+    int i, j;
+    if (mNumVertices < 3)
+    {
+        // IncrementalDelaunay2 should be called with at least three points.
+        return false;
+    }
+
+    IntrinsicsVector2<InputType> info(mNumVertices, vertices, mEpsilon);
+    if (info.dimension == 0)
+    {
+        // mDimension is 0; mIndices and mAdjacencies are empty
+        return false;
+    }
+
+    if (info.dimension == 1)
+    {
+        // The set is (nearly) collinear.
+        mDimension = 1;
+        mLine = Line2<InputType>(info.origin, info.direction[0]);
+        return false;
+    }
+
+    mDimension = 2;
+
+    // Compute the vertices for the queries.
+    mComputeVertices.resize(mNumVertices);
+    mQuery.Set(mNumVertices, &mComputeVertices[0]);
+    for (i = 0; i < mNumVertices; ++i)
+    {
+        for (j = 0; j < 2; ++j)
+        {
+            mComputeVertices[i][j] = vertices[i][j];
+        }
+    }
+
+    if ((std::is_same<InputType, float>::value || std::is_same<InputType, double>::value)
+        && !std::is_floating_point<ComputeType>::value)
+    {
+        mFilterVertices.resize(mNumVertices);
+        for (i = 0; i < mNumVertices; ++i)
+        {
+            for (j = 0; j < 2; ++j)
+            {
+                mFilterVertices[i][j] = static_cast<double>(vertices[i][j]);
+            }
+        }
+        mQuery.SetFilter(&mFilterVertices[0]);
+    }
+
+    // Identify the duplicate vertices.  The vertices are sorted
+    // lexicographically, with ties broken by index, so the first occurrence
+    // of a vertex is at the beginning of its run of duplicates.
+    std::vector<int> sorted(mNumVertices);
+    for (i = 0; i < mNumVertices; ++i)
+    {
+        sorted[i] = i;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [vertices](int i0, int i1)
+        {
+            if (vertices[i0] < vertices[i1]) { return true; }
+            if (vertices[i1] < vertices[i0]) { return false; }
+            return i0 < i1;
+        });
+    for (i = 0; i < mNumVertices; i = j)
+    {
+        int first = sorted[i];
+        for (j = i; j < mNumVertices && vertices[sorted[j]] == vertices[first]; ++j)
+        {
+            mDuplicates[sorted[j]] = first;
+        }
+        ++mNumUniqueVertices;
+    }
+
+    // Create the (nondegenerate) triangle constructed by IntrinsicsVector2
+    // and its three ghost triangles.  The orientation is determined by the
+    // query rather than by info.extremeCCW so that it is exact.
+    std::array<int, 3> initial;
+    for (i = 0; i < 3; ++i)
+    {
+        initial[i] = mDuplicates[info.extreme[i]];
+    }
+    int orientation = mQuery.ToLine(initial[2], initial[0], initial[1]);
+    if (orientation == 0)
+    {
+        // A failure can occur if ComputeType is not an exact arithmetic
+        // type.
+        return false;
+    }
+    if (orientation > 0)
+    {
+        std::swap(initial[1], initial[2]);
+    }
+
+    mTriVertices.reserve(6 * static_cast<size_t>(mNumUniqueVertices));
+    mTriAdjacencies.reserve(6 * static_cast<size_t>(mNumUniqueVertices));
+    int t0 = CreateTriangle(initial[0], initial[1], initial[2]);
+    for (j = 0; j < 3; ++j)
+    {
+        int j1 = (j + 1) % 3;
+        int g = CreateTriangle(initial[j1], initial[j], INFINITE_VERTEX);
+        mTriAdjacencies[3 * t0 + j] = g;
+        mTriAdjacencies[3 * g] = t0;
+    }
+    for (j = 0; j < 3; ++j)
+    {
+        // Ghost 1+j has edges <V[j+1],V[j]>, <V[j],inf>, <inf,V[j+1]>.  The
+        // edge <V[j],inf> is shared with ghost 1+(j+2)%3.
+        int g = 1 + j;
+        int gPrev = 1 + (j + 2) % 3;
+        mTriAdjacencies[3 * g + 1] = gPrev;
+        mTriAdjacencies[3 * gPrev + 2] = g;
+    }
+    mLastTriangle = t0;
+
+    std::vector<int> order;
+    ComputeInsertionOrder(initial, info.min, info.max, order);
+
+    mMarks.resize(mTriVertices.size() / 3, 0);
+    mStartTriangle.resize(mNumVertices + 1, -1);
+    for (auto v : order)
+    {
+        int t = Locate(v, mLastTriangle);
+        if (t < 0 || !Insert(v, t))
+        {
+            // A failure can occur if ComputeType is not an exact arithmetic
+            // type.
+            return false;
+        }
+    }
+
+    BuildOutput();
+    return true;
+}
+
+template <typename InputType, typename ComputeType> inline
+InputType IncrementalDelaunay2<InputType, ComputeType>::GetEpsilon() const
+{
+    return mEpsilon;
+}
+
+template <typename InputType, typename ComputeType> inline
+int IncrementalDelaunay2<InputType, ComputeType>::GetDimension() const
+{
+    return mDimension;
+}
+
+template <typename InputType, typename ComputeType> inline
+Line2<InputType> const& IncrementalDelaunay2<InputType, ComputeType>::GetLine() const
+{
+    return mLine;
+}
+
+template <typename InputType, typename ComputeType> inline
+int IncrementalDelaunay2<InputType, ComputeType>::GetNumVertices() const
+{
+    return mNumVertices;
+}
+
+template <typename InputType, typename ComputeType> inline
+int IncrementalDelaunay2<InputType, ComputeType>::GetNumUniqueVertices() const
+{
+    return mNumUniqueVertices;
+}
+
+template <typename InputType, typename ComputeType> inline
+int IncrementalDelaunay2<InputType, ComputeType>::GetNumTriangles() const
+{
+    return mNumTriangles;
+}
+
+template <typename InputType, typename ComputeType> inline
+Vector2<InputType> const* IncrementalDelaunay2<InputType, ComputeType>::GetVertices() const
+{
+    return mVertices;
+}
+
+template <typename InputType, typename ComputeType> inline
+PrimalQuery2<ComputeType> const& IncrementalDelaunay2<InputType, ComputeType>::GetQuery() const
+{
+    return mQuery;
+}
+
+template <typename InputType, typename ComputeType> inline
+std::vector<int> const& IncrementalDelaunay2<InputType, ComputeType>::GetIndices() const
+{
+    return mIndices;
+}
+
+template <typename InputType, typename ComputeType> inline
+std::vector<int> const& IncrementalDelaunay2<InputType, ComputeType>::GetAdjacencies() const
+{
+    return mAdjacencies;
+}
+
+template <typename InputType, typename ComputeType> inline
+std::vector<int> const& IncrementalDelaunay2<InputType, ComputeType>::GetDuplicates() const
+{
+    return mDuplicates;
+}
+
+template <typename InputType, typename ComputeType>
+bool IncrementalDelaunay2<InputType, ComputeType>::GetHull(std::vector<int>& hull) const
+{
+    if (mDimension == 2)
+    {
+        // Count the number of edges that are not shared by two triangles.
+        int numEdges = 0;
+        for (auto adj : mAdjacencies)
+        {
+            if (adj == -1)
+            {
+                ++numEdges;
+            }
+        }
+
+        if (numEdges > 0)
+        {
+            // Enumerate the edges.
+            hull.resize(2 * numEdges);
+            int current = 0, i = 0;
+            for (auto adj : mAdjacencies)
+            {
+                if (adj == -1)
+                {
+                    int tri = i / 3, j = i % 3;
+                    hull[current++] = mIndices[3 * tri + j];
+                    hull[current++] = mIndices[3 * tri + ((j + 1) % 3)];
+                }
+                ++i;
+            }
+            return true;
+        }
+        else
+        {
+            LogError("Unexpected.  There must be at least one triangle.");
+        }
+    }
+    else
+    {
+        LogError("The dimension must be 2.");
+    }
+    return false;
+}
+
+template <typename InputType, typename ComputeType>
+bool IncrementalDelaunay2<InputType, ComputeType>::GetIndices(int i, std::array<int, 3>& indices) const
+{
+    if (mDimension == 2)
+    {
+        int numTriangles = static_cast<int>(mIndices.size() / 3);
+        if (0 <= i && i < numTriangles)
+        {
+            indices[0] = mIndices[3 * i];
+            indices[1] = mIndices[3 * i + 1];
+            indices[2] = mIndices[3 * i + 2];
+            return true;
+        }
+    }
+    else
+    {
+        LogError("The dimension must be 2.");
+    }
+    return false;
+}
+
+template <typename InputType, typename ComputeType>
+bool IncrementalDelaunay2<InputType, ComputeType>::GetAdjacencies(int i, std::array<int, 3>& adjacencies) const
+{
+    if (mDimension == 2)
+    {
+        int numTriangles = static_cast<int>(mIndices.size() / 3);
+        if (0 <= i && i < numTriangles)
+        {
+            adjacencies[0] = mAdjacencies[3 * i];
+            adjacencies[1] = mAdjacencies[3 * i + 1];
+            adjacencies[2] = mAdjacencies[3 * i + 2];
+            return true;
+        }
+    }
+    else
+    {
+        LogError("The dimension must be 2.");
+    }
+    return false;
+}
+
+template <typename InputType, typename ComputeType>
+void IncrementalDelaunay2<InputType, ComputeType>::ComputeInsertionOrder(
+    std::array<int, 3> const& initial, InputType const* bmin,
+    InputType const* bmax, std::vector<int>& order)
+{
+    order.reserve(mNumUniqueVertices);
+    for (int i = 0; i < mNumVertices; ++i)
+    {
+        if (mDuplicates[i] == i && i != initial[0] && i != initial[1] && i != initial[2])
+        {
+            order.push_back(i);
+        }
+    }
+
+    // Quantize the vertices to a 2^16-by-2^16 grid over the bounding box
+    // and compute their Hilbert indices.
+    double origin[2], scale[2];
+    for (int j = 0; j < 2; ++j)
+    {
+        origin[j] = static_cast<double>(bmin[j]);
+        double range = static_cast<double>(bmax[j]) - origin[j];
+        scale[j] = (range > 0.0 ? 65535.0 / range : 0.0);
+    }
+    std::vector<uint32_t> key(mNumVertices);
+    for (auto i : order)
+    {
+        uint32_t q[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            double u = (static_cast<double>(mVertices[i][j]) - origin[j]) * scale[j];
+            q[j] = static_cast<uint32_t>(std::min(std::max(u, 0.0), 65535.0));
+        }
+        key[i] = GetHilbertIndex(q[0], q[1]);
+    }
+
+    // Randomly permute the vertices and partition them into rounds.  The
+    // last round contains (about) half of the vertices, the round before it
+    // half of the remaining vertices, and so on.  The rounds of fewer than
+    // 64 vertices are merged into one.  Each round is sorted along the
+    // Hilbert curve.
+    std::mt19937 mte;
+    std::shuffle(order.begin(), order.end(), mte);
+    auto hilbertLess = [&key](int i0, int i1) { return key[i0] < key[i1]; };
+    size_t end = order.size();
+    while (end > 0)
+    {
+        size_t begin = (end >= 128 ? end / 2 : 0);
+        std::sort(order.begin() + begin, order.begin() + end, hilbertLess);
+        end = begin;
+    }
+}
+
+template <typename InputType, typename ComputeType>
+uint32_t IncrementalDelaunay2<InputType, ComputeType>::GetHilbertIndex(uint32_t x, uint32_t y)
+{
+    uint32_t const n = 65536;
+    uint32_t index = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        uint32_t rx = ((x & s) > 0 ? 1 : 0);
+        uint32_t ry = ((y & s) > 0 ? 1 : 0);
+        index += s * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+template <typename InputType, typename ComputeType>
+int IncrementalDelaunay2<InputType, ComputeType>::Locate(int i, int t)
+{
+    int previous = -1;
+    size_t const maxSteps = mTriVertices.size() / 3;
+    for (size_t step = 0; step <= maxSteps; ++step)
+    {
+        if (IsGhost(t))
+        {
+            // The walk crossed a hull edge visible to point i.
+            return t;
+        }
+
+        // Visit the edges starting at a random one.  The edge shared with
+        // the previous triangle of the walk is not visited because point i
+        // is known to be on the side of it that contains the triangle.
+        int const* V = &mTriVertices[3 * t];
+        int const* A = &mTriAdjacencies[3 * t];
+        int j0 = static_cast<int>(mRandom() % 3), k;
+        for (k = 0; k < 3; ++k)
+        {
+            int j = (j0 + k) % 3;
+            if (A[j] != previous && mQuery.ToLine(i, V[j], V[(j + 1) % 3]) > 0)
+            {
+                // Point i sees edge <V[j],V[j+1]> from outside the triangle.
+                previous = t;
+                t = A[j];
+                break;
+            }
+        }
+
+        if (k == 3)
+        {
+            // The point is inside the triangle or on its boundary.
+            return t;
+        }
+    }
+
+    LogError("Unexpected termination of Locate.");
+    return -1;
+}
+
+template <typename InputType, typename ComputeType>
+bool IncrementalDelaunay2<InputType, ComputeType>::InConflict(int i, int t) const
+{
+    int const* V = &mTriVertices[3 * t];
+    for (int j = 0; j < 3; ++j)
+    {
+        if (V[j] == INFINITE_VERTEX)
+        {
+            // The hull edge of the ghost triangle is <v0,v1>, and the finite
+            // triangles are to the right of the directed edge.
+            int j1 = (j + 1) % 3;
+            int v0 = V[j1];
+            int v1 = V[(j + 2) % 3];
+            int sign = mQuery.ToLine(i, v0, v1);
+            if (sign != 0)
+            {
+                return sign < 0;
+            }
+
+            // Point i is on the line of the hull edge.  It is in the interior
+            // of the edge if and only if it is strictly inside the
+            // circumcircle of the finite triangle sharing the edge.
+            int adj = mTriAdjacencies[3 * t + j1];
+            int const* adjV = &mTriVertices[3 * adj];
+            return mQuery.ToCircumcircle(i, adjV[0], adjV[1], adjV[2]) < 0;
+        }
+    }
+    return mQuery.ToCircumcircle(i, V[0], V[1], V[2]) < 0;
+}
+
+template <typename InputType, typename ComputeType>
+bool IncrementalDelaunay2<InputType, ComputeType>::Insert(int i, int t)
+{
+    // Use a depth-first search for the triangles in conflict with point i.
+    // The boundary edges of the cavity are stored with the outside triangle
+    // as <v0,v1,outside>, where <v0,v1> is counterclockwise with respect to
+    // the cavity.
+    mMarkStamp += 2;
+    if (mMarkStamp < 2)
+    {
+        // The stamp wrapped around.
+        std::fill(mMarks.begin(), mMarks.end(), 0);
+        mMarkStamp = 2;
+    }
+    uint32_t const inside = mMarkStamp, outside = mMarkStamp + 1;
+
+    mCavity.clear();
+    mBoundary.clear();
+    mCavity.push_back(t);
+    mMarks[t] = inside;
+    for (size_t c = 0; c < mCavity.size(); ++c)
+    {
+        int tCavity = mCavity[c];
+        for (int j = 0; j < 3; ++j)
+        {
+            int adj = mTriAdjacencies[3 * tCavity + j];
+            if (mMarks[adj] != inside)
+            {
+                if (mMarks[adj] != outside && InConflict(i, adj))
+                {
+                    mMarks[adj] = inside;
+                    mCavity.push_back(adj);
+                }
+                else
+                {
+                    mMarks[adj] = outside;
+                    mBoundary.push_back({ {
+                        mTriVertices[3 * tCavity + j],
+                        mTriVertices[3 * tCavity + (j + 1) % 3],
+                        adj } });
+                }
+            }
+        }
+    }
+
+    // The triangles of the cavity are removed.  Their slots are reused by
+    // the new triangles.
+    for (auto tCavity : mCavity)
+    {
+        mTriVertices[3 * tCavity] = REMOVED_TRIANGLE;
+        mFreeTriangles.push_back(tCavity);
+    }
+
+    // Connect point i to the boundary edges.  The triangle <v0,v1,i> is
+    // adjacent to the outside triangle across <v0,v1>.
+    for (auto const& edge : mBoundary)
+    {
+        int v0 = edge[0], v1 = edge[1], adj = edge[2];
+        if (v0 != INFINITE_VERTEX && v1 != INFINITE_VERTEX
+            && mQuery.ToLine(i, v0, v1) >= 0)
+        {
+            // The cavity is not star-shaped with respect to point i.  This
+            // can occur if ComputeType is not an exact arithmetic type.
+            LogError("Unexpected condition (ComputeType not exact?)");
+            return false;
+        }
+
+        // The outside triangle shares edge <v1,v0>.  It is located by its
+        // vertices rather than by tCavity, because the slot of tCavity can
+        // be reused by a new triangle before all boundary edges are
+        // processed.
+        int tNew = CreateTriangle(v0, v1, i);
+        mTriAdjacencies[3 * tNew] = adj;
+        int const* V = &mTriVertices[3 * adj];
+        for (int j = 0; j < 3; ++j)
+        {
+            if (V[j] == v1)
+            {
+                mTriAdjacencies[3 * adj + j] = tNew;
+                break;
+            }
+        }
+        mStartTriangle[v0 == INFINITE_VERTEX ? mNumVertices : v0] = tNew;
+    }
+
+    // The new triangles form a fan around point i.  The triangle <v0,v1,i>
+    // shares edge <v1,i> with the triangle <v1,v2,i>.
+    if (mMarks.size() < mTriVertices.size() / 3)
+    {
+        mMarks.resize(mTriVertices.size() / 3, 0);
+    }
+    int tFinite = -1;
+    for (auto const& edge : mBoundary)
+    {
+        int v0 = edge[0], v1 = edge[1];
+        int tNew = mStartTriangle[v0 == INFINITE_VERTEX ? mNumVertices : v0];
+        int tNext = mStartTriangle[v1 == INFINITE_VERTEX ? mNumVertices : v1];
+        mTriAdjacencies[3 * tNew + 1] = tNext;
+        mTriAdjacencies[3 * tNext + 2] = tNew;
+        if (v0 != INFINITE_VERTEX && v1 != INFINITE_VERTEX)
+        {
+            tFinite = tNew;
+        }
+    }
+    mLastTriangle = tFinite;
+    return tFinite >= 0;
+}
+
+template <typename InputType, typename ComputeType>
+int IncrementalDelaunay2<InputType, ComputeType>::CreateTriangle(int v0, int v1, int v2)
+{
+    int t;
+    if (mFreeTriangles.size() > 0)
+    {
+        t = mFreeTriangles.back();
+        mFreeTriangles.pop_back();
+    }
+    else
+    {
+        t = static_cast<int>(mTriVertices.size() / 3);
+        mTriVertices.resize(mTriVertices.size() + 3);
+        mTriAdjacencies.resize(mTriAdjacencies.size() + 3);
+    }
+
+    int* V = &mTriVertices[3 * t];
+    int* A = &mTriAdjacencies[3 * t];
+    V[0] = v0;
+    V[1] = v1;
+    V[2] = v2;
+    A[0] = -1;
+    A[1] = -1;
+    A[2] = -1;
+    return t;
+}
+
+template <typename InputType, typename ComputeType> inline
+bool IncrementalDelaunay2<InputType, ComputeType>::IsGhost(int t) const
+{
+    int const* V = &mTriVertices[3 * t];
+    return V[0] == INFINITE_VERTEX || V[1] == INFINITE_VERTEX || V[2] == INFINITE_VERTEX;
+}
+
+template <typename InputType, typename ComputeType>
+void IncrementalDelaunay2<InputType, ComputeType>::BuildOutput()
+{
+    // Assign integer values to the finite triangles for use by the caller.
+    int const numSlots = static_cast<int>(mTriVertices.size() / 3);
+    std::vector<int> permute(numSlots, -1);
+    mNumTriangles = 0;
+    for (int t = 0; t < numSlots; ++t)
+    {
+        if (mTriVertices[3 * t] != REMOVED_TRIANGLE && !IsGhost(t))
+        {
+            permute[t] = mNumTriangles++;
+        }
+    }
+
+    // Put Delaunay triangles into an array (vertices and adjacency info).
+    mIndices.resize(3 * static_cast<size_t>(mNumTriangles));
+    mAdjacencies.resize(3 * static_cast<size_t>(mNumTriangles));
+    for (int t = 0, i = 0; t < numSlots; ++t)
+    {
+        if (permute[t] >= 0)
+        {
+            for (int j = 0; j < 3; ++j, ++i)
+            {
+                mIndices[i] = mTriVertices[3 * t + j];
+                mAdjacencies[i] = permute[mTriAdjacencies[3 * t + j]];
+            }
+        }
+    }
+}
+
+}
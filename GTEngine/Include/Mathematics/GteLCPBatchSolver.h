@@ -0,0 +1,153 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteLCPSolver.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Solve many independent LCPs of the same dimension n, for example, those
+// of the contacts of pairs of rigid bodies.  Each problem is solved by
+// LCPSolver<Real>, so its solution is the same as that of a single call to
+// LCPSolver<Real>::Solve.  The problems are stored contiguously: problem p
+// has q[n*p..n*p+n-1] and the n-by-n matrix M[n*n*p..n*n*p+n*n-1] stored in
+// row-major order, and its outputs are w[n*p..n*p+n-1] and
+// z[n*p..n*p+n-1].  When the compute model has a thread pool, ranges of
+// problems are solved concurrently, each range by its own LCPSolver.
+
+namespace gte
+{
+
+template <typename Real>
+class LCPBatchSolver
+{
+public:
+    // Construction.  The dimension n must be positive.  The compute model
+    // may be null, in which case the problems are solved sequentially.
+    LCPBatchSolver(int n, std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    // Member access.  The maximum number of iterations applies to each
+    // problem and has the default value n*n of LCPSolver.
+    inline int GetDimension() const;
+    inline void SetMaxIterations(int maxIterations);
+    inline int GetMaxIterations() const;
+
+    // Solve the problems.  When 'results' is not null, it must have
+    // numProblems elements and receives the Result of each problem.  The
+    // return value is the number of problems that have a solution; the
+    // outputs w and z of the other problems are invalid.
+    int Solve(int numProblems, Real const* q, Real const* M, Real* w, Real* z,
+        typename LCPSolverShared<Real>::Result* results = nullptr);
+
+private:
+    int mDimension;
+    std::shared_ptr<ThreadPool> mThreadPool;
+
+    // The solvers of the ranges of problems.  LCPSolver<Real> stores
+    // pointers to its own arrays, so the solvers are not stored by value.
+    std::vector<std::unique_ptr<LCPSolver<Real>>> mSolvers;
+};
+
+
+template <typename Real>
+LCPBatchSolver<Real>::LCPBatchSolver(int n,
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mDimension(n),
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr)
+{
+    LogAssert(n > 0, "Invalid dimension.");
+
+    // Several ranges per thread balance the load when the numbers of
+    // iterations of the problems vary.
+    size_t numSolvers = (mThreadPool ? 4 * mThreadPool->GetNumThreads() : 1);
+    mSolvers.resize(numSolvers);
+    for (auto& solver : mSolvers)
+    {
+        solver = std::make_unique<LCPSolver<Real>>(n);
+    }
+}
+
+template <typename Real> inline
+int LCPBatchSolver<Real>::GetDimension() const
+{
+    return mDimension;
+}
+
+template <typename Real> inline
+void LCPBatchSolver<Real>::SetMaxIterations(int maxIterations)
+{
+    for (auto& solver : mSolvers)
+    {
+        solver->SetMaxIterations(maxIterations);
+    }
+}
+
+template <typename Real> inline
+int LCPBatchSolver<Real>::GetMaxIterations() const
+{
+    return mSolvers[0]->GetMaxIterations();
+}
+
+template <typename Real>
+int LCPBatchSolver<Real>::Solve(int numProblems, Real const* q,
+    Real const* M, Real* w, Real* z,
+    typename LCPSolverShared<Real>::Result* results)
+{
+    if (numProblems <= 0)
+    {
+        return 0;
+    }
+
+    // Range i consists of the problems [i*grainSize,(i+1)*grainSize), so
+    // the solver of a range is determined by its first problem.
+    int const numRanges = std::min(static_cast<int>(mSolvers.size()), numProblems);
+    int const grainSize = (numProblems + numRanges - 1) / numRanges;
+    std::vector<int> numSolved(numRanges, 0);
+    auto solveRange = [this, q, M, w, z, results, grainSize, &numSolved](int pmin, int pmax)
+    {
+        int const n = mDimension;
+        int const range = pmin / grainSize;
+        LCPSolver<Real>& solver = *mSolvers[range];
+        typename LCPSolverShared<Real>::Result result;
+        for (int p = pmin; p < pmax; ++p)
+        {
+            size_t const vOffset = static_cast<size_t>(n) * p;
+            size_t const mOffset = vOffset * n;
+            if (solver.Solve(q + vOffset, M + mOffset, w + vOffset, z + vOffset, &result))
+            {
+                ++numSolved[range];
+            }
+            if (results)
+            {
+                results[p] = result;
+            }
+        }
+    };
+
+    if (mThreadPool && numRanges > 1)
+    {
+        mThreadPool->ParallelFor(0, numProblems, grainSize, solveRange);
+    }
+    else
+    {
+        solveRange(0, numProblems);
+    }
+
+    int total = 0;
+    for (auto count : numSolved)
+    {
+        total += count;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,229 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteCSRMatrix.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// An iterative solver for the LCP w = q + M*z, w^T*z = 0, w >= 0, z >= 0,
+// where M is a sparse n-by-n matrix with positive diagonal entries, for
+// example, the symmetric positive semidefinite matrices of the contact
+// constraints of rigid-body systems with a small positive regularization
+// on the diagonal.  Unlike the Lemke pivoting of LCPSolver, whose cost is
+// O(n^3) in a dense matrix, each iteration of projected Gauss-Seidel is a
+// sweep over the nonzero entries of M:
+//   z[i] = max(0, z[i] - relaxation * (q[i] + sum_j M[i][j]*z[j]) / M[i][i])
+// for i = 0 through n-1.  The iterations converge for symmetric positive
+// definite M and 0 < relaxation < 2, and they stop when the largest change
+// of z in a sweep is at most the tolerance.  The solution is approximate,
+// but the solver is usually warm-started with the z of the previous time
+// step, in which case few iterations are required.
+//
+// The box-constrained variant replaces the projection onto z[i] >= 0 by
+// the projection onto lower[i] <= z[i] <= upper[i], which supports the
+// friction constraints of contacts.  Its solution satisfies w[i] >= 0 when
+// z[i] = lower[i], w[i] <= 0 when z[i] = upper[i] and w[i] = 0 otherwise.
+//
+// The sweeps are sequential, because each z[i] depends on the values that
+// precede it.  When a thread pool is available, it is used to compute w.
+
+namespace gte
+{
+
+template <typename Real>
+class LCPProjectedGaussSeidel
+{
+public:
+    // Construction.  The default parameters are at most 100 iterations, a
+    // tolerance of 1e-06f for 'float' or 1e-10 for 'double', and a
+    // relaxation of 1 (Gauss-Seidel).  The compute model may be null.
+    LCPProjectedGaussSeidel(std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    // Member access.
+    inline void SetMaxIterations(unsigned int maxIterations);
+    inline unsigned int GetMaxIterations() const;
+    inline void SetTolerance(Real tolerance);
+    inline Real GetTolerance() const;
+    inline void SetRelaxation(Real relaxation);
+    inline Real GetRelaxation() const;
+
+    // The number of iterations and the largest change of z in the last
+    // iteration of the last call to Solve(...).
+    inline unsigned int GetNumIterations() const;
+    inline Real GetLastChange() const;
+
+    // Solve the LCP.  The arrays have n elements, where n is the number of
+    // rows of M.  On input, z is the initial guess, which is projected onto
+    // the constraints; use zero when no guess is available.  On output, z
+    // is the solution and w = q + M*z.  The return value is 'true' when the
+    // tolerance is reached within the maximum number of iterations.
+    bool Solve(CSRMatrix<Real> const& M, Real const* q, Real* z, Real* w);
+
+    // Solve the box-constrained problem.  Use -max() or max() for the
+    // bounds of unbounded variables.
+    bool Solve(CSRMatrix<Real> const& M, Real const* q, Real const* lower,
+        Real const* upper, Real* z, Real* w);
+
+private:
+    bool DoSolve(CSRMatrix<Real> const& M, Real const* q, Real const* lower,
+        Real const* upper, Real* z, Real* w);
+
+    std::shared_ptr<ThreadPool> mThreadPool;
+    unsigned int mMaxIterations;
+    Real mTolerance;
+    Real mRelaxation;
+    unsigned int mNumIterations;
+    Real mLastChange;
+
+    // The positions of the diagonal entries of M in its values.
+    std::vector<int> mDiagonalIndices;
+};
+
+
+template <typename Real>
+LCPProjectedGaussSeidel<Real>::LCPProjectedGaussSeidel(
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mMaxIterations(100),
+    mTolerance(sizeof(Real) == sizeof(float) ? (Real)1e-06 : (Real)1e-10),
+    mRelaxation((Real)1),
+    mNumIterations(0),
+    mLastChange((Real)0)
+{
+}
+
+template <typename Real> inline
+void LCPProjectedGaussSeidel<Real>::SetMaxIterations(unsigned int maxIterations)
+{
+    mMaxIterations = maxIterations;
+}
+
+template <typename Real> inline
+unsigned int LCPProjectedGaussSeidel<Real>::GetMaxIterations() const
+{
+    return mMaxIterations;
+}
+
+template <typename Real> inline
+void LCPProjectedGaussSeidel<Real>::SetTolerance(Real tolerance)
+{
+    mTolerance = tolerance;
+}
+
+template <typename Real> inline
+Real LCPProjectedGaussSeidel<Real>::GetTolerance() const
+{
+    return mTolerance;
+}
+
+template <typename Real> inline
+void LCPProjectedGaussSeidel<Real>::SetRelaxation(Real relaxation)
+{
+    LogAssert(relaxation > (Real)0 && relaxation < (Real)2, "Invalid relaxation.");
+    mRelaxation = relaxation;
+}
+
+template <typename Real> inline
+Real LCPProjectedGaussSeidel<Real>::GetRelaxation() const
+{
+    return mRelaxation;
+}
+
+template <typename Real> inline
+unsigned int LCPProjectedGaussSeidel<Real>::GetNumIterations() const
+{
+    return mNumIterations;
+}
+
+template <typename Real> inline
+Real LCPProjectedGaussSeidel<Real>::GetLastChange() const
+{
+    return mLastChange;
+}
+
+template <typename Real>
+bool LCPProjectedGaussSeidel<Real>::Solve(CSRMatrix<Real> const& M,
+    Real const* q, Real* z, Real* w)
+{
+    return DoSolve(M, q, nullptr, nullptr, z, w);
+}
+
+template <typename Real>
+bool LCPProjectedGaussSeidel<Real>::Solve(CSRMatrix<Real> const& M,
+    Real const* q, Real const* lower, Real const* upper, Real* z, Real* w)
+{
+    return DoSolve(M, q, lower, upper, z, w);
+}
+
+template <typename Real>
+bool LCPProjectedGaussSeidel<Real>::DoSolve(CSRMatrix<Real> const& M,
+    Real const* q, Real const* lower, Real const* upper, Real* z, Real* w)
+{
+    int const n = M.GetNumRows();
+    LogAssert(M.GetNumCols() == n, "The matrix must be square.");
+
+    // The bounds are lower = 0 and upper = infinity when none are given.
+    auto project = [lower, upper](int i, Real value)
+    {
+        if (lower)
+        {
+            return std::min(std::max(value, lower[i]), upper[i]);
+        }
+        return std::max(value, (Real)0);
+    };
+
+    mDiagonalIndices.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        mDiagonalIndices[i] = M.GetIndex(i, i);
+        LogAssert(mDiagonalIndices[i] >= 0 && M.GetValues()[mDiagonalIndices[i]] > (Real)0,
+            "The diagonal entries must be positive.");
+        z[i] = project(i, z[i]);
+    }
+
+    int const* offsets = M.GetRowOffsets().data();
+    int const* columns = M.GetColumns().data();
+    Real const* values = M.GetValues().data();
+    mNumIterations = 0;
+    mLastChange = (Real)0;
+    bool converged = (n == 0);
+    while (!converged && mNumIterations < mMaxIterations)
+    {
+        Real maxChange = (Real)0;
+        for (int i = 0; i < n; ++i)
+        {
+            Real sum = q[i];
+            for (int k = offsets[i]; k < offsets[i + 1]; ++k)
+            {
+                sum += values[k] * z[columns[k]];
+            }
+            Real zNew = project(i, z[i] - mRelaxation * sum / values[mDiagonalIndices[i]]);
+            maxChange = std::max(maxChange, std::fabs(zNew - z[i]));
+            z[i] = zNew;
+        }
+
+        ++mNumIterations;
+        mLastChange = maxChange;
+        converged = (maxChange <= mTolerance);
+    }
+
+    M.Mul(z, w, mThreadPool);
+    for (int i = 0; i < n; ++i)
+    {
+        w[i] += q[i];
+    }
+    return converged;
+}
+
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.4.2 (2016/11/24)
+// File Version: 3.5.0 (2026/10/18)
 
 #pragma once
 
@@ -170,6 +170,12 @@ public:
         std::vector<Real>& w, std::vector<Real>& z,
         typename LCPSolverShared<Real>::Result* result = nullptr);
 
+    // The same as the previous function but for arrays, which must have the
+    // numbers of elements described previously.  This avoids copying the
+    // inputs when the problems are stored contiguously; see LCPBatchSolver.
+    bool Solve(Real const* q, Real const* M, Real* w, Real* z,
+        typename LCPSolverShared<Real>::Result* result = nullptr);
+
 private:
     std::vector<typename LCPSolverShared<Real>::Variable> mVectorVarBasic;
     std::vector<typename LCPSolverShared<Real>::Variable> mVectorVarNonbasic;
@@ -294,28 +300,29 @@ bool LCPSolverShared<Real>::Solve(Real const* q, Real const* M,
     // pivoting.  The equation 'basic' is the one to solve for z[n] and
     // pivoting with w[basic].  The last column of M remains all 1-values
     // for this initial step, so no algebraic computations occur for M[r][n].
+    // The row operations are applied to all the columns and the column n is
+    // restored afterwards, so the loops have no branches and the compiler
+    // can vectorize them.
     int driving = mDimension;
+    Real* basicRow = &Augmented(basic, 0);
     for (int r = 0; r < mDimension; ++r)
     {
         if (r != basic)
         {
+            Real* row = &Augmented(r, 0);
             for (int c = 0; c < mNumCols; ++c)
             {
-                if (c != mDimension)
-                {
-                    Augmented(r, c) -= Augmented(basic, c);
-                }
+                row[c] -= basicRow[c];
             }
+            row[mDimension] = (Real)1;
         }
     }
 
     for (int c = 0; c < mNumCols; ++c)
     {
-        if (c != mDimension)
-        {
-            Augmented(basic, c) = -Augmented(basic, c);
-        }
+        basicRow[c] = -basicRow[c];
     }
+    basicRow[mDimension] = (Real)1;
 
     mNumIterations = 0;
     for (int i = 0; i < mMaxIterations; ++i, ++mNumIterations)
@@ -385,38 +392,29 @@ bool LCPSolverShared<Real>::Solve(Real const* q, Real const* M,
         }
 
         // Solve the basic equation so that z[driving] enters the dictionary
-        // and w[basic] exits the dictionary.
-        Real invDenom = (Real)1 / Augmented(basic, driving);
+        // and w[basic] exits the dictionary.  As in the initial step, the
+        // column 'driving' is overwritten after the branchless row updates.
+        basicRow = &Augmented(basic, 0);
+        Real invDenom = (Real)1 / basicRow[driving];
         for (int r = 0; r < mDimension; ++r)
         {
-            if (r != basic && Augmented(r, driving) != (Real)0)
+            Real* row = &Augmented(r, 0);
+            if (r != basic && row[driving] != (Real)0)
             {
-                Real multiplier = Augmented(r, driving) * invDenom;
+                Real multiplier = row[driving] * invDenom;
                 for (int c = 0; c < mNumCols; ++c)
                 {
-                    if (c != driving)
-                    {
-                        Augmented(r, c) -= Augmented(basic, c) * multiplier;
-                    }
-                    else
-                    {
-                        Augmented(r, driving) = multiplier;
-                    }
+                    row[c] -= basicRow[c] * multiplier;
                 }
+                row[driving] = multiplier;
             }
         }
 
         for (int c = 0; c < mNumCols; ++c)
         {
-            if (c != driving)
-            {
-                Augmented(basic, c) = -Augmented(basic, c) * invDenom;
-            }
-            else
-            {
-                Augmented(basic, driving) = invDenom;
-            }
+            basicRow[c] = -basicRow[c] * invDenom;
         }
+        basicRow[driving] = invDenom;
     }
 
     // Numerical round-off errors can cause the Lemke algorithm not to
@@ -613,4 +611,20 @@ bool LCPSolver<Real>::Solve(
     return LCPSolverShared<Real>::Solve(q.data(), M.data(), w.data(), z.data(), result);
 }
 
+template <typename Real>
+bool LCPSolver<Real>::Solve(Real const* q, Real const* M, Real* w, Real* z,
+    typename LCPSolverShared<Real>::Result* result)
+{
+    if (this->mDimension == 0)
+    {
+        if (result)
+        {
+            *result = this->INVALID_INPUT;
+        }
+        return false;
+    }
+
+    return LCPSolverShared<Real>::Solve(q, M, w, z, result);
+}
+
 }
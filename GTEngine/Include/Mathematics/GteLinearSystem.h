@@ -3,14 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2018/10/05)
+// File Version: 3.2.2 (2026/10/18)
 
 #pragma once
 
+#include <LowLevel/GteComputeModel.h>
 #include <LowLevel/GteWrapper.h>
 #include <Mathematics/GteMatrix2x2.h>
 #include <Mathematics/GteMatrix3x3.h>
 #include <Mathematics/GteMatrix4x4.h>
+#include <Mathematics/GteCSRMatrix.h>
 #include <Mathematics/GteGaussianElimination.h>
 #include <map>
 
@@ -24,7 +26,8 @@
 // The linear solvers that use the conjugate gradient algorithm are based
 // on the discussion in "Matrix Computations, 2nd edition" by G. H. Golub
 // and Charles F. Van Loan, The Johns Hopkins Press, Baltimore MD, Fourth
-// Printing 1993.
+// Printing 1993.  The incomplete Cholesky preconditioner is discussed in
+// Section 10.3 of that book.
 
 namespace gte
 {
@@ -80,19 +83,65 @@ public:
     // The column vector B is stored as an array of contiguous values.  You
     // must specify the maximum number of iterations and a tolerance for
     // terminating the iterations.  Reasonable choices for tolerance are
-    // 1e-06f for 'float' or 1e-08 for 'double'.
+    // 1e-06f for 'float' or 1e-08 for 'double'.  The map is converted to a
+    // CSRMatrix and the system is solved without preconditioning by the
+    // next function; for repeated solves, create the CSRMatrix once.  The
+    // algorithm and the return value are those of the map-based solver of
+    // previous versions, but the products A*P sum their terms in the order
+    // of the CSR rows rather than that of the map, so the iterates can
+    // differ from those of previous versions in the last bits.
     typedef std::map<std::array<int, 2>, Real> SparseMatrix;
     static unsigned int SolveSymmetricCG(int N, SparseMatrix const& A,
         Real const* B, Real* X, unsigned int maxIterations, Real tolerance);
 
+    // Solve A*X = B using the preconditioned conjugate gradient method,
+    // where A is sparse, symmetric and positive definite.  The matrix must
+    // store the entries of both triangles.  The preconditioner is
+    //   NONE:  the identity, which is the unpreconditioned method;
+    //   JACOBI:  the diagonal of A, which reduces the number of iterations
+    //     when the diagonal entries vary greatly in magnitude;
+    //   INCOMPLETE_CHOLESKY:  the factorization L*L^T of A, where L has the
+    //     structure of the lower triangle of A, which usually requires many
+    //     fewer iterations than JACOBI but is more expensive to create and
+    //     to apply.  When the factorization breaks down, it is repeated for
+    //     A with its diagonal scaled by 1+s for increasing s > 0.
+    // The iterations terminate when |B-A*X| <= tolerance*|B| or when the
+    // maximum number of iterations is reached.  As for the other
+    // SolveSymmetricCG functions, the return value is the number of
+    // iterations when the tolerance is met and maxIterations+1 when it is
+    // not, so a return value larger than maxIterations means that X is not
+    // a solution within the tolerance.  When cmodel has a thread pool, the
+    // products of A with vectors are computed concurrently; the solution
+    // does not depend on the number of threads.
+    enum class Preconditioner
+    {
+        NONE,
+        JACOBI,
+        INCOMPLETE_CHOLESKY
+    };
+
+    static unsigned int SolveSymmetricCG(CSRMatrix<Real> const& A,
+        Real const* B, Real* X, unsigned int maxIterations, Real tolerance,
+        Preconditioner preconditioner = Preconditioner::JACOBI,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
 private:
     // Support for the conjugate gradient method.
     static Real Dot(int N, Real const* U, Real const* V);
     static void Mul(int N, Real const* A, Real const* X, Real* P);
-    static void Mul(int N, SparseMatrix const& A, Real const* X, Real* P);
     static void UpdateX(int N, Real* X, Real alpha, Real const* P);
     static void UpdateR(int N, Real* R, Real alpha, Real const* W);
     static void UpdateP(int N, Real* P, Real beta, Real const* R);
+
+    // Support for the incomplete Cholesky preconditioner.  The factor L is
+    // computed for A with its diagonal scaled by 1+shift.  The return value
+    // is 'false' when the factorization breaks down.
+    static bool FactorIncompleteCholesky(CSRMatrix<Real> const& A, Real shift,
+        CSRMatrix<Real>& L);
+
+    // Solve L*L^T*Z = R.
+    static void SolveIncompleteCholesky(CSRMatrix<Real> const& L,
+        Real const* R, Real* Z);
 };
 
 
@@ -282,42 +331,113 @@ unsigned int LinearSystem<Real>::SolveSymmetricCG(int N,
     SparseMatrix const& A, Real const* B, Real* X, unsigned int maxIterations,
     Real tolerance)
 {
-    // The first iteration.
-    std::vector<Real> tmpR(N), tmpP(N), tmpW(N);
+    typename CSRMatrix<Real>::Builder builder(N, N);
+    builder.Reserve(2 * static_cast<int>(A.size()));
+    for (auto const& element : A)
+    {
+        builder.AddSymmetric(element.first[0], element.first[1],
+            element.second);
+    }
+    return SolveSymmetricCG(builder.Create(), B, X, maxIterations, tolerance,
+        Preconditioner::NONE);
+}
+
+template <typename Real>
+unsigned int LinearSystem<Real>::SolveSymmetricCG(CSRMatrix<Real> const& A,
+    Real const* B, Real* X, unsigned int maxIterations, Real tolerance,
+    Preconditioner preconditioner, std::shared_ptr<ComputeModel> const& cmodel)
+{
+    int const N = A.GetNumRows();
+    size_t numBytes = N * sizeof(Real);
+    memset(X, 0, numBytes);
+    Real normB = std::sqrt(Dot(N, B, B));
+    if (normB == (Real)0)
+    {
+        return 0;
+    }
+
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    std::vector<Real> tmpR(N), tmpZ(N), tmpP(N), tmpW(N), invD;
     Real* R = &tmpR[0];
+    Real* Z = &tmpZ[0];
     Real* P = &tmpP[0];
     Real* W = &tmpW[0];
-    size_t numBytes = N * sizeof(Real);
-    memset(X, 0, numBytes);
+
+    CSRMatrix<Real> L;
+    if (preconditioner == Preconditioner::INCOMPLETE_CHOLESKY)
+    {
+        Real shift = (Real)0;
+        int const maxAttempts = 16;
+        int attempt;
+        for (attempt = 0; attempt < maxAttempts; ++attempt)
+        {
+            if (FactorIncompleteCholesky(A, shift, L))
+            {
+                break;
+            }
+            shift = (shift > (Real)0 ? (Real)2 * shift : (Real)0.001);
+        }
+        if (attempt == maxAttempts)
+        {
+            preconditioner = Preconditioner::JACOBI;
+        }
+    }
+
+    if (preconditioner == Preconditioner::JACOBI)
+    {
+        // The inverses of the diagonal entries.  A nonpositive diagonal
+        // entry occurs only when A is not positive definite; the identity
+        // is used for its row.
+        invD.resize(N);
+        A.GetDiagonal(invD.data());
+        for (int i = 0; i < N; ++i)
+        {
+            invD[i] = (invD[i] > (Real)0 ? (Real)1 / invD[i] : (Real)1);
+        }
+    }
+
+    auto Precondition = [N, numBytes, preconditioner, &L, &invD](
+        Real const* R, Real* Z)
+    {
+        if (preconditioner == Preconditioner::JACOBI)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                Z[i] = invD[i] * R[i];
+            }
+        }
+        else if (preconditioner == Preconditioner::INCOMPLETE_CHOLESKY)
+        {
+            SolveIncompleteCholesky(L, R, Z);
+        }
+        else
+        {
+            Memcpy(Z, R, numBytes);
+        }
+    };
+
+    // The initial residual is R = B - A*0 = B.
     Memcpy(R, B, numBytes);
-    Real rho0 = Dot(N, R, R);
-    Memcpy(P, R, numBytes);
-    Mul(N, A, P, W);
-    Real alpha = rho0 / Dot(N, P, W);
-    UpdateX(N, X, alpha, P);
-    UpdateR(N, R, alpha, W);
-    Real rho1 = Dot(N, R, R);
+    Precondition(R, Z);
+    Memcpy(P, Z, numBytes);
+    Real rho = Dot(N, R, Z);
 
-    // The remaining iterations.
     unsigned int iteration;
     for (iteration = 1; iteration <= maxIterations; ++iteration)
     {
-        Real root0 = std::sqrt(rho1);
-        Real norm = Dot(N, B, B);
-        Real root1 = std::sqrt(norm);
-        if (root0 <= tolerance*root1)
+        A.Mul(P, W, threadPool);
+        Real alpha = rho / Dot(N, P, W);
+        UpdateX(N, X, alpha, P);
+        UpdateR(N, R, alpha, W);
+        if (std::sqrt(Dot(N, R, R)) <= tolerance * normB)
         {
             break;
         }
 
-        Real beta = rho1 / rho0;
-        UpdateP(N, P, beta, R);
-        Mul(N, A, P, W);
-        alpha = rho1 / Dot(N, P, W);
-        UpdateX(N, X, alpha, P);
-        UpdateR(N, R, alpha, W);
-        rho0 = rho1;
-        rho1 = Dot(N, R, R);
+        Precondition(R, Z);
+        Real rhoNext = Dot(N, R, Z);
+        UpdateP(N, P, rhoNext / rho, Z);
+        rho = rhoNext;
     }
     return iteration;
 }
@@ -352,24 +472,6 @@ void LinearSystem<Real>::Mul(int N, Real const* A, Real const* X, Real* P)
     }
 }
 
-template <typename Real>
-void LinearSystem<Real>::Mul(int N, SparseMatrix const& A, Real const* X,
-    Real* P)
-{
-    memset(P, 0, N * sizeof(Real));
-    for (auto const& element : A)
-    {
-        int i = element.first[0];
-        int j = element.first[1];
-        Real value = element.second;
-        P[i] += value * X[j];
-        if (i != j)
-        {
-            P[j] += value * X[i];
-        }
-    }
-}
-
 template <typename Real>
 void LinearSystem<Real>::UpdateX(int N, Real* X, Real alpha, Real const* P)
 {
@@ -398,4 +500,111 @@ void LinearSystem<Real>::UpdateP(int N, Real* P, Real beta, Real const* R)
 }
 
 
+template <typename Real>
+bool LinearSystem<Real>::FactorIncompleteCholesky(CSRMatrix<Real> const& A,
+    Real shift, CSRMatrix<Real>& L)
+{
+    // L has the structure of the lower triangle of A, so the diagonal entry
+    // of a row is its last entry.
+    int const N = A.GetNumRows();
+    std::vector<int> const& aOffsets = A.GetRowOffsets();
+    std::vector<int> const& aColumns = A.GetColumns();
+    std::vector<Real> const& aValues = A.GetValues();
+    std::vector<int> rowOffsets(N + 1), columns;
+    std::vector<Real> values;
+    rowOffsets[0] = 0;
+    for (int row = 0; row < N; ++row)
+    {
+        for (int k = aOffsets[row]; k < aOffsets[row + 1] && aColumns[k] <= row; ++k)
+        {
+            columns.push_back(aColumns[k]);
+            values.push_back(aValues[k]);
+        }
+        if (columns.size() == 0 || columns.back() != row)
+        {
+            return false;
+        }
+        values.back() *= (Real)1 + shift;
+        rowOffsets[row + 1] = static_cast<int>(columns.size());
+    }
+
+    // L[i][j] = (A[i][j] - sum_{k<j} L[i][k]*L[j][k])/L[j][j] for j < i and
+    // L[i][i] = sqrt(A[i][i] - sum_{k<i} L[i][k]^2), where the sums are over
+    // the entries of the structure.
+    for (int i = 0; i < N; ++i)
+    {
+        int const iBegin = rowOffsets[i], iEnd = rowOffsets[i + 1] - 1;
+        for (int ki = iBegin; ki < iEnd; ++ki)
+        {
+            int j = columns[ki];
+            int const jEnd = rowOffsets[j + 1] - 1;
+            Real sum = values[ki];
+            for (int mi = iBegin, mj = rowOffsets[j]; mi < ki && mj < jEnd; )
+            {
+                if (columns[mi] < columns[mj])
+                {
+                    ++mi;
+                }
+                else if (columns[mj] < columns[mi])
+                {
+                    ++mj;
+                }
+                else
+                {
+                    sum -= values[mi++] * values[mj++];
+                }
+            }
+            values[ki] = sum / values[jEnd];
+        }
+
+        Real diagonal = values[iEnd];
+        for (int ki = iBegin; ki < iEnd; ++ki)
+        {
+            diagonal -= values[ki] * values[ki];
+        }
+        if (!(diagonal > (Real)0))
+        {
+            return false;
+        }
+        values[iEnd] = std::sqrt(diagonal);
+    }
+
+    L = CSRMatrix<Real>(N, N, rowOffsets, columns);
+    L.GetValues() = std::move(values);
+    return true;
+}
+
+template <typename Real>
+void LinearSystem<Real>::SolveIncompleteCholesky(CSRMatrix<Real> const& L,
+    Real const* R, Real* Z)
+{
+    int const N = L.GetNumRows();
+    int const* offsets = L.GetRowOffsets().data();
+    int const* columns = L.GetColumns().data();
+    Real const* values = L.GetValues().data();
+
+    // Solve L*Y = R, storing Y in Z.
+    for (int i = 0; i < N; ++i)
+    {
+        int const iEnd = offsets[i + 1] - 1;
+        Real sum = R[i];
+        for (int k = offsets[i]; k < iEnd; ++k)
+        {
+            sum -= values[k] * Z[columns[k]];
+        }
+        Z[i] = sum / values[iEnd];
+    }
+
+    // Solve L^T*Z = Y.  The columns of L^T are the rows of L.
+    for (int i = N - 1; i >= 0; --i)
+    {
+        int const iEnd = offsets[i + 1] - 1;
+        Z[i] /= values[iEnd];
+        for (int k = offsets[i]; k < iEnd; ++k)
+        {
+            Z[columns[k]] -= values[k] * Z[i];
+        }
+    }
+}
+
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2018/10/05)
+// File Version: 3.0.3 (2026/10/18)
 
 #pragma once
 
@@ -11,7 +11,6 @@
 #include <Mathematics/GteEdgeKey.h>
 #include <Mathematics/GteMinimumAreaBox2.h>
 #include <Mathematics/GteOrientedBox.h>
-#include <thread>
 #include <type_traits>
 
 // Compute a minimum-volume oriented box containing the specified points.  The
@@ -52,8 +51,15 @@ public:
     // in ProcessFaces, choose 'numThreads' subject to the constraints
     //     1 <= numThreads <= std::thread::hardware_concurrency()
     // To execute ProcessEdges in a thread separate from the main thrad,
-    // choose 'threadProcessEdges' to 'true'.
+    // choose 'threadProcessEdges' to 'true'.  The constructor creates a
+    // ThreadPool of 'numThreads' threads for the convex hull and for
+    // ProcessFaces and, when threadProcessEdges is 'true', a pool with one
+    // worker for ProcessEdges, so repeated calls reuse the threads.  The
+    // second constructor uses the thread pool of the compute model for all
+    // the stages instead, which allows the threads to be shared with other
+    // algorithms.
     MinimumVolumeBox3(unsigned int numThreads = 1, bool threadProcessEdges = false);
+    MinimumVolumeBox3(std::shared_ptr<ComputeModel> const& cmodel, bool threadProcessEdges = false);
 
     // The points are arbitrary, so we must compute the convex hull from
     // them in order to compute the minimum-area box.  The input parameters
@@ -138,12 +144,17 @@ private:
     void ConvertTo(Box const& minBox, OrientedBox3<InputType>& itMinBox);
 
     // The code is multithreaded, both for convex hull computation and
-    // computing minimum-volume extruded boxes for the hull faces.  The
-    // default value is 1, which implies a single-threaded computation (on
-    // the main thread).
-    unsigned int mNumThreads;
+    // computing minimum-volume extruded boxes for the hull faces.  A null
+    // thread pool implies a single-threaded computation (on the main
+    // thread).
+    std::shared_ptr<ComputeModel> mCModel;
     bool mThreadProcessEdges;
 
+    // The thread pool that executes ProcessEdges concurrently with
+    // ProcessFaces, or null when ProcessEdges is executed on the main
+    // thread.
+    std::shared_ptr<ThreadPool> mEdgeThreadPool;
+
     // The input points to be bound.
     int mNumPoints;
     Vector3<InputType> const* mPoints;
@@ -180,8 +191,27 @@ private:
 template <typename InputType, typename ComputeType>
 MinimumVolumeBox3<InputType, ComputeType>::MinimumVolumeBox3(unsigned int numThreads, bool threadProcessEdges)
     :
-    mNumThreads(numThreads),
+    mCModel(std::make_shared<ComputeModel>(numThreads)),
+    mThreadProcessEdges(threadProcessEdges),
+    mEdgeThreadPool(threadProcessEdges ? std::make_shared<ThreadPool>(2) : nullptr),
+    mNumPoints(0),
+    mPoints(nullptr),
+    mComputePoints(nullptr),
+    mUseRotatingCalipers(true),
+    mVolume((InputType)0),
+    mZero(0),
+    mOne(1),
+    mNegOne(-1),
+    mHalf((InputType)0.5)
+{
+}
+
+template <typename InputType, typename ComputeType>
+MinimumVolumeBox3<InputType, ComputeType>::MinimumVolumeBox3(std::shared_ptr<ComputeModel> const& cmodel, bool threadProcessEdges)
+    :
+    mCModel(cmodel ? cmodel : std::make_shared<ComputeModel>()),
     mThreadProcessEdges(threadProcessEdges),
+    mEdgeThreadPool(threadProcessEdges ? mCModel->threadPool : nullptr),
     mNumPoints(0),
     mPoints(nullptr),
     mComputePoints(nullptr),
@@ -205,7 +235,7 @@ OrientedBox3<InputType> MinimumVolumeBox3<InputType, ComputeType>::operator()(
     mUniqueIndices.clear();
 
     // Get the convex hull of the points.
-    ConvexHull3<InputType, ComputeType> ch3;
+    ConvexHull3<InputType, ComputeType> ch3(mCModel);
     ch3(mNumPoints, mPoints, (InputType)0);
     int dimension = ch3.GetDimension();
 
@@ -323,14 +353,15 @@ OrientedBox3<InputType> MinimumVolumeBox3<InputType, ComputeType>::operator()(
     minBox.volume = mNegOne;
     minBoxEdges.volume = mNegOne;
 
-    if (mThreadProcessEdges)
+    if (mEdgeThreadPool)
     {
-        std::thread doEdges([this, &mesh, &minBoxEdges]()
+        ThreadPool::TaskGroup doEdges(*mEdgeThreadPool);
+        doEdges.Run([this, &mesh, &minBoxEdges]()
         {
             ProcessEdges(mesh, minBoxEdges);
         });
         ProcessFaces(mesh, minBox);
-        doEdges.join();
+        doEdges.Wait();
     }
     else
     {
@@ -402,14 +433,15 @@ OrientedBox3<InputType> MinimumVolumeBox3<InputType, ComputeType>::operator()(
     minBox.volume = mNegOne;
     minBoxEdges.volume = mNegOne;
 
-    if (mThreadProcessEdges)
+    if (mEdgeThreadPool)
     {
-        std::thread doEdges([this, &mesh, &minBoxEdges]()
+        ThreadPool::TaskGroup doEdges(*mEdgeThreadPool);
+        doEdges.Run([this, &mesh, &minBoxEdges]()
         {
             ProcessEdges(mesh, minBoxEdges);
         });
         ProcessFaces(mesh, minBox);
-        doEdges.join();
+        doEdges.Wait();
     }
     else
     {
@@ -484,8 +516,10 @@ void MinimumVolumeBox3<InputType, ComputeType>::ProcessFaces(ETManifoldMesh cons
     // triangle face.  The projection of the polyline onto the plane of the
     // triangle face is a convex polygon, so we can use the method of rotating
     // calipers to compute its minimum-area box efficiently.
+    ThreadPool* pool = mCModel->threadPool.get();
+    unsigned int numThreads = (pool ? pool->GetNumThreads() : 1);
     unsigned int numFaces = static_cast<unsigned int>(tmap.size());
-    if (mNumThreads > 1 && numFaces >= mNumThreads)
+    if (numThreads > 1 && numFaces >= numThreads)
     {
         // Repackage the triangle pointers to support the partitioning of
         // faces for multithreaded face processing.
@@ -497,38 +531,35 @@ void MinimumVolumeBox3<InputType, ComputeType>::ProcessFaces(ETManifoldMesh cons
         }
 
         // Partition the data for multiple threads.
-        unsigned int numFacesPerThread = numFaces / mNumThreads;
-        std::vector<unsigned int> imin(mNumThreads), imax(mNumThreads);
-        std::vector<Box> localMinBox(mNumThreads);
-        for (unsigned int t = 0; t < mNumThreads; ++t)
+        unsigned int numFacesPerThread = numFaces / numThreads;
+        std::vector<unsigned int> imin(numThreads), imax(numThreads);
+        std::vector<Box> localMinBox(numThreads);
+        for (unsigned int t = 0; t < numThreads; ++t)
         {
             imin[t] = t * numFacesPerThread;
             imax[t] = imin[t] + numFacesPerThread - 1;
             localMinBox[t].volume = mNegOne;
         }
-        imax[mNumThreads - 1] = numFaces - 1;
+        imax[numThreads - 1] = numFaces - 1;
 
-        // Execute the face processing in multiple threads.
-        std::vector<std::thread> process(mNumThreads);
-        for (unsigned int t = 0; t < mNumThreads; ++t)
+        // Execute the face processing in the threads of the pool.
+        pool->ParallelFor(0, static_cast<int>(numThreads), 1,
+            [this, &imin, &imax, &triangles, &normal, &triNormalMap, &emap,
+            &localMinBox](int tmin, int tmax)
         {
-            process[t] = std::thread([this, t, &imin, &imax, &triangles,
-                &normal, &triNormalMap, &emap, &localMinBox]()
+            for (int t = tmin; t < tmax; ++t)
             {
                 for (unsigned int i = imin[t]; i <= imax[t]; ++i)
                 {
                     auto const& supportTri = triangles[i];
                     ProcessFace(supportTri, normal, triNormalMap, emap, localMinBox[t]);
                 }
-            });
-        }
+            }
+        });
 
-        // Wait for all threads to finish.
-        for (unsigned int t = 0; t < mNumThreads; ++t)
+        // Update the minimum-volume box candidate.
+        for (unsigned int t = 0; t < numThreads; ++t)
         {
-            process[t].join();
-
-            // Update the minimum-volume box candidate.
             if (minBox.volume == mNegOne || localMinBox[t].volume < minBox.volume)
             {
                 minBox = localMinBox[t];
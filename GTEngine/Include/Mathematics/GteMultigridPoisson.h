@@ -0,0 +1,839 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.1 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// A geometric multigrid solver for the Poisson equation -Laplacian(u) = f
+// on a regular grid in 2D or 3D with u = 0 on the boundary of the grid.
+// The grid has size[d] samples along axis d, the samples are spaced by
+// spacing[d], and the boundary samples are those with index 0 or size[d]-1
+// along some axis.  The Laplacian is approximated by central differences,
+// so at an interior sample the equation is
+//   sum_d (2*u[i] - u[i-e_d] - u[i+e_d])/spacing[d]^2 = f[i]
+// where e_d is the offset to the next sample along axis d.  This is the
+// equation whose Jacobi iterations are computed by the Poisson solvers of
+// the fluid simulations, where f is the divergence of the velocity.
+//
+// Each V-cycle smooths the error with red-black Gauss-Seidel sweeps,
+// restricts the residual to a coarser grid, solves for the error there
+// recursively and corrects the solution by the linear interpolation of the
+// error.  The samples of a coarse grid along an axis are the even-indexed
+// samples of the finer grid and its last sample, so the grid sizes need not
+// be of the form 2^k+1; when the last interval of a coarse grid is shorter
+// than the others, the equation is discretized on the nonuniform grid.  The
+// restriction is the transpose of the interpolation weighted by the lengths
+// of the intervals, which is full weighting on uniform grids.  An axis with
+// fewer than 3 interior samples is not coarsened, and the coarsening stops
+// when no axis can be coarsened.
+//
+// The point smoother does not reduce the errors that are smooth along the
+// axes of small spacing, where the coupling of the samples is strong, and
+// oscillatory along the others, so a grid whose spacings differ is
+// semi-coarsened:  among the axes that can be coarsened, only those whose
+// spacing is at most twice the smallest spacing are coarsened.  The spacing
+// of a coarsened axis doubles, so the spacings of the coarse grids become
+// similar and the coarsening is then along all axes.  For example, the grid
+// 512x32 with spacings 1/512 and 1/32 is coarsened along x only until x has
+// 33 samples.  The number of V-cycles is then about the same as for a grid
+// with equal spacings.
+//
+// The V-cycles are repeated until the L2 norm of the residual is at most
+// the tolerance times the L2 norm of f.  The residual cannot be reduced
+// below the rounding errors of its computation, which for 'float' values on
+// large grids can exceed the tolerance, so the V-cycles also stop when a
+// cycle reduces the norm of the residual by less than 10 percent.
+//
+// When a thread pool is available, the rows of the grids are processed
+// concurrently.  The red (black) samples of a sweep depend only on the black
+// (red) samples, and the norms are accumulated per row and summed in order,
+// so the results do not depend on the number of threads.
+
+namespace gte
+{
+
+template <int N, typename Real>
+class MultigridPoisson
+{
+public:
+    // Construction.  Each size[d] must be at least 3 and each spacing[d]
+    // must be positive.  The compute model may be null, in which case the
+    // solver is single-threaded.  The default parameters are at most 32
+    // V-cycles, a relative tolerance of 1e-04f for 'float' or 1e-08 for
+    // 'double', and 2 smoothing sweeps before and after the coarse-grid
+    // correction.
+    MultigridPoisson(std::array<int, N> const& size,
+        std::array<Real, N> const& spacing,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+    // Member access.
+    inline std::array<int, N> const& GetSize() const;
+    inline int GetNumLevels() const;
+    inline void SetMaxCycles(unsigned int maxCycles);
+    inline unsigned int GetMaxCycles() const;
+    inline void SetTolerance(Real tolerance);
+    inline Real GetTolerance() const;
+    inline void SetNumSmoothingSweeps(unsigned int numSweeps);
+    inline unsigned int GetNumSmoothingSweeps() const;
+
+    // The number of V-cycles and the relative L2 norm of the residual of
+    // the last call to Solve(...).
+    inline unsigned int GetNumCycles() const;
+    inline Real GetResidualNorm() const;
+
+    // Solve the equation.  The arrays have size[0]*...*size[N-1] elements
+    // stored in lexicographical order, index = x + size[0]*(y + size[1]*z).
+    // On input, u is the initial guess; for a sequence of similar problems,
+    // the previous solution is a good guess.  The boundary values of f are
+    // ignored and those of u are set to zero.  The return value is 'true'
+    // when the tolerance is reached within the maximum number of cycles and
+    // 'false' when the cycles stop for another reason.
+    bool Solve(Real const* f, Real* u);
+
+private:
+    // The samples of a grid along one axis.  At an interior sample i, the
+    // second difference is minus[i]*(u[i]-u[i-1]) + plus[i]*(u[i]-u[i+1])
+    // and diagonal[i] = minus[i] + plus[i].  When the axis is coarsened, the
+    // interpolation from the coarse samples to an odd sample i is
+    // left[i]*coarse[i/2] + right[i]*coarse[i/2+1], and the restriction to
+    // the coarse sample k is the sum of restriction[j][k]*fine[2*k+j-1] for
+    // 0 <= j <= 2.  The axis z of a 2D grid has 1 sample.
+    struct Axis
+    {
+        int size;
+        bool coarsen;
+        std::vector<Real> position, minus, plus, diagonal;
+        std::vector<Real> left, right;
+        std::array<std::vector<Real>, 3> restriction;
+    };
+
+    // The row r of a grid has y = r % size[1] and z = r / size[1].
+    struct Level
+    {
+        std::array<Axis, 3> axis;
+        std::array<int, 3> size;
+        Real* u;
+        Real const* f;
+        std::vector<Real> uStorage, fStorage, residual;
+    };
+
+    static inline int GetNumCells(std::array<int, 3> const& size);
+    static inline bool IsInteriorRow(std::array<int, 3> const& size, int r);
+
+    // Compute the coefficients of the second differences of the axis from
+    // the positions of its samples.
+    static void ComputeDifferences(Axis& axis);
+
+    // Compute the interpolation and restriction weights of the fine axis
+    // for the coarse axis.
+    static void ComputeTransfer(Axis& fine, Axis const& coarse);
+
+    // Compute a V-cycle for mLevels[i], starting from its current u.
+    void VCycle(int i);
+
+    // A Gauss-Seidel sweep of the samples with (x + y + z) % 2 == color.
+    void Smooth(Level& level, int color);
+
+    // Compute the residual f - A*u, which is zero on the boundary.  When
+    // rowNorms is not null, the squared L2 norms of the rows of the residual
+    // are stored in it.
+    void ComputeResidual(Level& level, double* rowNorms);
+
+    // Restrict mLevels[i].residual to mLevels[i+1].f.
+    void Restrict(int i);
+
+    // Add the interpolation of mLevels[i+1].u to mLevels[i].u.
+    void Prolong(int i);
+
+    // The restriction and interpolation along axis d, computed for all
+    // samples of the output grid.  The interpolation adds to the output
+    // when 'add' is true.
+    void RestrictAxis(int d, Axis const& fine, std::array<int, 3> const& inSize,
+        Real const* in, std::array<int, 3> const& outSize, Real* out);
+    void ProlongAxis(int d, Axis const& fine, std::array<int, 3> const& inSize,
+        Real const* in, std::array<int, 3> const& outSize, Real* out, bool add);
+
+    // The sum of the squared row norms of the fine grid in the order of the
+    // rows.
+    double GetNorm() const;
+
+    // Call function(rmin,rmax) for subranges of the rows of a grid,
+    // concurrently when a thread pool is available.
+    void ParallelFor(std::array<int, 3> const& size,
+        std::function<void(int, int)> const& function);
+
+    std::array<int, N> mSize;
+    std::shared_ptr<ThreadPool> mThreadPool;
+    unsigned int mMaxCycles;
+    Real mTolerance;
+    unsigned int mNumSmoothingSweeps;
+    unsigned int mNumCycles;
+    Real mResidualNorm;
+
+    std::vector<Level> mLevels;
+
+    // Temporary storage for the separable restriction and interpolation
+    // and for the row norms of the fine grid.
+    std::vector<Real> mTemp0, mTemp1;
+    std::vector<double> mRowNorms;
+};
+
+
+template <int N, typename Real>
+MultigridPoisson<N, Real>::MultigridPoisson(std::array<int, N> const& size,
+    std::array<Real, N> const& spacing,
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mSize(size),
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mMaxCycles(32),
+    mTolerance(sizeof(Real) == sizeof(float) ? (Real)1e-04 : (Real)1e-08),
+    mNumSmoothingSweeps(2),
+    mNumCycles(0),
+    mResidualNorm((Real)0)
+{
+    static_assert(N == 2 || N == 3, "Dimension must be 2 or 3.");
+
+    // Create the fine grid.  It uses the arrays passed to Solve(...).
+    mLevels.push_back(Level());
+    for (int d = 0; d < 3; ++d)
+    {
+        Axis& axis = mLevels[0].axis[d];
+        if (d < N)
+        {
+            LogAssert(size[d] >= 3 && spacing[d] > (Real)0, "Invalid grid.");
+            axis.size = size[d];
+            axis.position.resize(axis.size);
+            for (int i = 0; i < axis.size; ++i)
+            {
+                axis.position[i] = spacing[d] * static_cast<Real>(i);
+            }
+        }
+        else
+        {
+            axis.size = 1;
+            axis.position.assign(1, (Real)0);
+        }
+        ComputeDifferences(axis);
+    }
+
+    // Create the coarse grids.  The temporary arrays are large enough for
+    // the intermediate grids of the separable operations of the fine grid,
+    // which are the largest.
+    size_t maxTempSize = 0;
+    for (;;)
+    {
+        // The spacing of an axis is that of its first interval; only the
+        // last interval of a coarse axis can differ from the others.
+        Level& level = mLevels.back();
+        Real minSpacing = (Real)0;
+        for (int d = 0; d < 3; ++d)
+        {
+            Axis& axis = level.axis[d];
+            level.size[d] = axis.size;
+            if (axis.size - 2 >= 3)
+            {
+                Real axisSpacing = axis.position[1] - axis.position[0];
+                if (minSpacing == (Real)0 || axisSpacing < minSpacing)
+                {
+                    minSpacing = axisSpacing;
+                }
+            }
+        }
+        bool coarsen = false;
+        for (int d = 0; d < 3; ++d)
+        {
+            Axis& axis = level.axis[d];
+            axis.coarsen = (axis.size - 2 >= 3 &&
+                axis.position[1] - axis.position[0] <= (Real)2 * minSpacing);
+            coarsen = coarsen || axis.coarsen;
+        }
+        level.residual.resize(GetNumCells(level.size));
+        if (!coarsen)
+        {
+            break;
+        }
+
+        Level next;
+        for (int d = 0; d < 3; ++d)
+        {
+            Axis& fine = level.axis[d];
+            Axis& coarse = next.axis[d];
+            if (fine.coarsen)
+            {
+                coarse.size = fine.size / 2 + 1;
+                coarse.position.resize(coarse.size);
+                for (int k = 0; k < coarse.size; ++k)
+                {
+                    coarse.position[k] = fine.position[std::min(2 * k, fine.size - 1)];
+                }
+                ComputeDifferences(coarse);
+                ComputeTransfer(fine, coarse);
+            }
+            else
+            {
+                coarse.size = fine.size;
+                coarse.position = fine.position;
+                coarse.minus = fine.minus;
+                coarse.plus = fine.plus;
+                coarse.diagonal = fine.diagonal;
+            }
+            next.size[d] = coarse.size;
+        }
+        next.uStorage.resize(GetNumCells(next.size));
+        next.fStorage.resize(GetNumCells(next.size));
+
+        // The intermediate grids of the restriction have the coarse sizes
+        // along the first axes and the fine sizes along the others; those of
+        // the interpolation have the fine sizes along the first axes and the
+        // coarse sizes along the others.
+        for (int d = 0; d < 3; ++d)
+        {
+            std::array<int, 3> restrictSize, prolongSize;
+            for (int j = 0; j < 3; ++j)
+            {
+                restrictSize[j] = (j <= d ? next.size[j] : level.size[j]);
+                prolongSize[j] = (j <= d ? level.size[j] : next.size[j]);
+            }
+            maxTempSize = std::max(maxTempSize, static_cast<size_t>(
+                std::max(GetNumCells(restrictSize), GetNumCells(prolongSize))));
+        }
+        mLevels.push_back(std::move(next));
+    }
+
+    mTemp0.resize(maxTempSize);
+    mTemp1.resize(maxTempSize);
+    mRowNorms.resize(mLevels[0].size[1] * mLevels[0].size[2]);
+}
+
+template <int N, typename Real> inline
+std::array<int, N> const& MultigridPoisson<N, Real>::GetSize() const
+{
+    return mSize;
+}
+
+template <int N, typename Real> inline
+int MultigridPoisson<N, Real>::GetNumLevels() const
+{
+    return static_cast<int>(mLevels.size());
+}
+
+template <int N, typename Real> inline
+void MultigridPoisson<N, Real>::SetMaxCycles(unsigned int maxCycles)
+{
+    mMaxCycles = maxCycles;
+}
+
+template <int N, typename Real> inline
+unsigned int MultigridPoisson<N, Real>::GetMaxCycles() const
+{
+    return mMaxCycles;
+}
+
+template <int N, typename Real> inline
+void MultigridPoisson<N, Real>::SetTolerance(Real tolerance)
+{
+    mTolerance = tolerance;
+}
+
+template <int N, typename Real> inline
+Real MultigridPoisson<N, Real>::GetTolerance() const
+{
+    return mTolerance;
+}
+
+template <int N, typename Real> inline
+void MultigridPoisson<N, Real>::SetNumSmoothingSweeps(unsigned int numSweeps)
+{
+    mNumSmoothingSweeps = numSweeps;
+}
+
+template <int N, typename Real> inline
+unsigned int MultigridPoisson<N, Real>::GetNumSmoothingSweeps() const
+{
+    return mNumSmoothingSweeps;
+}
+
+template <int N, typename Real> inline
+unsigned int MultigridPoisson<N, Real>::GetNumCycles() const
+{
+    return mNumCycles;
+}
+
+template <int N, typename Real> inline
+Real MultigridPoisson<N, Real>::GetResidualNorm() const
+{
+    return mResidualNorm;
+}
+
+template <int N, typename Real>
+bool MultigridPoisson<N, Real>::Solve(Real const* f, Real* u)
+{
+    // The pointers of the coarse levels are set here rather than at
+    // construction so that they are valid for a copy of the solver.
+    Level& fine = mLevels[0];
+    fine.u = u;
+    fine.f = f;
+    for (size_t i = 1; i < mLevels.size(); ++i)
+    {
+        mLevels[i].u = mLevels[i].uStorage.data();
+        mLevels[i].f = mLevels[i].fStorage.data();
+    }
+    mNumCycles = 0;
+
+    // Set the boundary values of u to zero and compute the norm of f.
+    ParallelFor(fine.size, [this, &fine](int rmin, int rmax)
+    {
+        int const sx = fine.size[0];
+        for (int r = rmin; r < rmax; ++r)
+        {
+            Real* uRow = fine.u + sx * r;
+            Real const* fRow = fine.f + sx * r;
+            double norm = 0.0;
+            if (IsInteriorRow(fine.size, r))
+            {
+                uRow[0] = (Real)0;
+                uRow[sx - 1] = (Real)0;
+                for (int x = 1; x < sx - 1; ++x)
+                {
+                    norm += static_cast<double>(fRow[x]) * static_cast<double>(fRow[x]);
+                }
+            }
+            else
+            {
+                std::fill(uRow, uRow + sx, (Real)0);
+            }
+            mRowNorms[r] = norm;
+        }
+    });
+
+    double fNorm = std::sqrt(GetNorm());
+    if (fNorm == 0.0)
+    {
+        std::fill(u, u + GetNumCells(fine.size), (Real)0);
+        mResidualNorm = (Real)0;
+        return true;
+    }
+
+    ComputeResidual(fine, mRowNorms.data());
+    double rNorm = std::sqrt(GetNorm()) / fNorm;
+    while (rNorm > static_cast<double>(mTolerance) && mNumCycles < mMaxCycles)
+    {
+        VCycle(0);
+        ComputeResidual(fine, mRowNorms.data());
+        double previousNorm = rNorm;
+        rNorm = std::sqrt(GetNorm()) / fNorm;
+        ++mNumCycles;
+        if (rNorm > 0.9 * previousNorm)
+        {
+            break;
+        }
+    }
+
+    mResidualNorm = static_cast<Real>(rNorm);
+    return rNorm <= static_cast<double>(mTolerance);
+}
+
+template <int N, typename Real> inline
+int MultigridPoisson<N, Real>::GetNumCells(std::array<int, 3> const& size)
+{
+    return size[0] * size[1] * size[2];
+}
+
+template <int N, typename Real> inline
+bool MultigridPoisson<N, Real>::IsInteriorRow(std::array<int, 3> const& size,
+    int r)
+{
+    int y = r % size[1], z = r / size[1];
+    return 0 < y && y < size[1] - 1 && (N == 2 || (0 < z && z < size[2] - 1));
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::ComputeDifferences(Axis& axis)
+{
+    // The second difference at sample i is the difference of the first
+    // differences on the adjacent intervals divided by the average length
+    // of the intervals.  On a uniform grid with spacing h, minus[i] and
+    // plus[i] are 1/h^2.
+    axis.minus.assign(axis.size, (Real)0);
+    axis.plus.assign(axis.size, (Real)0);
+    axis.diagonal.assign(axis.size, (Real)0);
+    for (int i = 1; i < axis.size - 1; ++i)
+    {
+        Real hMinus = axis.position[i] - axis.position[i - 1];
+        Real hPlus = axis.position[i + 1] - axis.position[i];
+        Real length = (Real)0.5 * (hMinus + hPlus);
+        axis.minus[i] = (Real)1 / (length * hMinus);
+        axis.plus[i] = (Real)1 / (length * hPlus);
+        axis.diagonal[i] = axis.minus[i] + axis.plus[i];
+    }
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::ComputeTransfer(Axis& fine, Axis const& coarse)
+{
+    // The even samples 2*k < size-1 of the fine axis are the coarse samples
+    // k, and each odd sample is between two coarse samples.
+    std::vector<Real> const& x = fine.position;
+    fine.left.assign(fine.size, (Real)0);
+    fine.right.assign(fine.size, (Real)0);
+    for (int i = 1; i < fine.size - 1; i += 2)
+    {
+        fine.left[i] = (x[i + 1] - x[i]) / (x[i + 1] - x[i - 1]);
+        fine.right[i] = (x[i] - x[i - 1]) / (x[i + 1] - x[i - 1]);
+    }
+
+    // The restriction to coarse sample k is the sum of the fine values
+    // weighted by their interpolation weights from k and by the lengths of
+    // their control intervals, divided by the length of the control interval
+    // of k.  The fine samples 2*k-1 and 2*k+1 are interior samples except
+    // when 2*k+1 is the last sample.
+    std::vector<Real> const& X = coarse.position;
+    for (int j = 0; j < 3; ++j)
+    {
+        fine.restriction[j].assign(coarse.size, (Real)0);
+    }
+    for (int k = 1; k < coarse.size - 1; ++k)
+    {
+        int i = 2 * k;
+        Real coarseLength = (Real)0.5 * (X[k + 1] - X[k - 1]);
+        fine.restriction[0][k] = fine.right[i - 1] * (Real)0.5 * (x[i] - x[i - 2]) / coarseLength;
+        fine.restriction[1][k] = (Real)0.5 * (x[i + 1] - x[i - 1]) / coarseLength;
+        if (i + 1 < fine.size - 1)
+        {
+            fine.restriction[2][k] = fine.left[i + 1] * (Real)0.5 * (x[i + 2] - x[i]) / coarseLength;
+        }
+    }
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::VCycle(int i)
+{
+    Level& level = mLevels[i];
+    if (i + 1 == static_cast<int>(mLevels.size()))
+    {
+        // The coarsest grid has at most 2 interior samples along each axis,
+        // so the Gauss-Seidel sweeps converge quickly.
+        for (int sweep = 0; sweep < 32; ++sweep)
+        {
+            Smooth(level, 0);
+            Smooth(level, 1);
+        }
+        return;
+    }
+
+    for (unsigned int sweep = 0; sweep < mNumSmoothingSweeps; ++sweep)
+    {
+        Smooth(level, 0);
+        Smooth(level, 1);
+    }
+
+    ComputeResidual(level, nullptr);
+    Restrict(i);
+    Level& coarse = mLevels[i + 1];
+    std::fill(coarse.uStorage.begin(), coarse.uStorage.end(), (Real)0);
+    VCycle(i + 1);
+    Prolong(i);
+
+    for (unsigned int sweep = 0; sweep < mNumSmoothingSweeps; ++sweep)
+    {
+        Smooth(level, 1);
+        Smooth(level, 0);
+    }
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::Smooth(Level& level, int color)
+{
+    ParallelFor(level.size, [&level, color](int rmin, int rmax)
+    {
+        int const sx = level.size[0], sy = level.size[1];
+        int const yStride = sx, zStride = sx * sy;
+        Axis const& ax = level.axis[0];
+        Axis const& ay = level.axis[1];
+        Axis const& az = level.axis[2];
+        for (int r = rmin; r < rmax; ++r)
+        {
+            if (IsInteriorRow(level.size, r))
+            {
+                int const y = r % sy, z = r / sy;
+                Real const yzDiagonal = ay.diagonal[y] + az.diagonal[z];
+                Real* u = level.u + sx * r;
+                Real const* f = level.f + sx * r;
+                for (int x = 1 + ((1 + y + z + color) & 1); x < sx - 1; x += 2)
+                {
+                    Real sum = f[x] + ax.minus[x] * u[x - 1] + ax.plus[x] * u[x + 1] +
+                        ay.minus[y] * u[x - yStride] + ay.plus[y] * u[x + yStride];
+                    if (N == 3)
+                    {
+                        sum += az.minus[z] * u[x - zStride] + az.plus[z] * u[x + zStride];
+                    }
+                    u[x] = sum / (ax.diagonal[x] + yzDiagonal);
+                }
+            }
+        }
+    });
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::ComputeResidual(Level& level,
+    double* rowNorms)
+{
+    ParallelFor(level.size, [&level, rowNorms](int rmin, int rmax)
+    {
+        int const sx = level.size[0], sy = level.size[1];
+        int const yStride = sx, zStride = sx * sy;
+        Axis const& ax = level.axis[0];
+        Axis const& ay = level.axis[1];
+        Axis const& az = level.axis[2];
+        for (int r = rmin; r < rmax; ++r)
+        {
+            Real* residual = level.residual.data() + sx * r;
+            double norm = 0.0;
+            if (IsInteriorRow(level.size, r))
+            {
+                int const y = r % sy, z = r / sy;
+                Real const yzDiagonal = ay.diagonal[y] + az.diagonal[z];
+                Real const* u = level.u + sx * r;
+                Real const* f = level.f + sx * r;
+                residual[0] = (Real)0;
+                residual[sx - 1] = (Real)0;
+                for (int x = 1; x < sx - 1; ++x)
+                {
+                    Real sum = ax.minus[x] * u[x - 1] + ax.plus[x] * u[x + 1] +
+                        ay.minus[y] * u[x - yStride] + ay.plus[y] * u[x + yStride];
+                    if (N == 3)
+                    {
+                        sum += az.minus[z] * u[x - zStride] + az.plus[z] * u[x + zStride];
+                    }
+                    residual[x] = f[x] - ((ax.diagonal[x] + yzDiagonal) * u[x] - sum);
+                    norm += static_cast<double>(residual[x]) * static_cast<double>(residual[x]);
+                }
+            }
+            else
+            {
+                std::fill(residual, residual + sx, (Real)0);
+            }
+            if (rowNorms)
+            {
+                rowNorms[r] = norm;
+            }
+        }
+    });
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::Restrict(int i)
+{
+    // Restrict along each coarsened axis.  The last pass writes the f of
+    // the coarse level.
+    Level const& fine = mLevels[i];
+    Level& coarse = mLevels[i + 1];
+    int last = 2;
+    while (!fine.axis[last].coarsen)
+    {
+        --last;
+    }
+
+    std::array<int, 3> inSize = fine.size;
+    Real const* in = fine.residual.data();
+    Real* temp[2] = { mTemp0.data(), mTemp1.data() };
+    for (int d = 0, t = 0; d <= last; ++d)
+    {
+        if (fine.axis[d].coarsen)
+        {
+            std::array<int, 3> outSize = inSize;
+            outSize[d] = coarse.size[d];
+            Real* out = (d == last ? coarse.fStorage.data() : temp[t]);
+            RestrictAxis(d, fine.axis[d], inSize, in, outSize, out);
+            inSize = outSize;
+            in = out;
+            t = 1 - t;
+        }
+    }
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::Prolong(int i)
+{
+    // Interpolate along each coarsened axis.  The last pass adds the error
+    // to the u of the fine level.
+    Level& fine = mLevels[i];
+    Level const& coarse = mLevels[i + 1];
+    int last = 2;
+    while (!fine.axis[last].coarsen)
+    {
+        --last;
+    }
+
+    std::array<int, 3> inSize = coarse.size;
+    Real const* in = coarse.u;
+    Real* temp[2] = { mTemp0.data(), mTemp1.data() };
+    for (int d = 0, t = 0; d <= last; ++d)
+    {
+        if (fine.axis[d].coarsen)
+        {
+            std::array<int, 3> outSize = inSize;
+            outSize[d] = fine.size[d];
+            Real* out = (d == last ? fine.u : temp[t]);
+            ProlongAxis(d, fine.axis[d], inSize, in, outSize, out, d == last);
+            inSize = outSize;
+            in = out;
+            t = 1 - t;
+        }
+    }
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::RestrictAxis(int d, Axis const& fine,
+    std::array<int, 3> const& inSize, Real const* in,
+    std::array<int, 3> const& outSize, Real* out)
+{
+    // The index 2*k+1 is at most the last index of the input along axis d,
+    // where the input is zero, so it need not be clamped.
+    ParallelFor(outSize, [d, &fine, &inSize, in, &outSize, out](int rmin, int rmax)
+    {
+        Real const* w0 = fine.restriction[0].data();
+        Real const* w1 = fine.restriction[1].data();
+        Real const* w2 = fine.restriction[2].data();
+        int const sx = outSize[0], sy = outSize[1], sd = outSize[d];
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % sy, z = r / sy;
+            Real* outRow = out + sx * r;
+            if (d == 0)
+            {
+                Real const* inRow = in + inSize[0] * r;
+                outRow[0] = (Real)0;
+                for (int k = 1; k < sx - 1; ++k)
+                {
+                    outRow[k] = w0[k] * inRow[2 * k - 1] + w1[k] * inRow[2 * k] + w2[k] * inRow[2 * k + 1];
+                }
+                outRow[sx - 1] = (Real)0;
+            }
+            else
+            {
+                int const k = (d == 1 ? y : z);
+                if (0 < k && k < sd - 1)
+                {
+                    // The input rows 2*k-1, 2*k and 2*k+1 along axis d.
+                    int const stride = (d == 1 ? sx : sx * inSize[1]);
+                    Real const* inRow = in + sx * (d == 1 ?
+                        2 * k + inSize[1] * z : y + inSize[1] * (2 * k));
+                    for (int x = 0; x < sx; ++x)
+                    {
+                        outRow[x] = w0[k] * inRow[x - stride] + w1[k] * inRow[x] + w2[k] * inRow[x + stride];
+                    }
+                }
+                else
+                {
+                    std::fill(outRow, outRow + sx, (Real)0);
+                }
+            }
+        }
+    });
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::ProlongAxis(int d, Axis const& fine,
+    std::array<int, 3> const& inSize, Real const* in,
+    std::array<int, 3> const& outSize, Real* out, bool add)
+{
+    // The fine sample 2*k is the coarse sample k and the fine sample 2*k+1
+    // is interpolated from the coarse samples k and k+1.  The boundary
+    // samples of the output are zero.
+    ParallelFor(outSize, [d, &fine, &inSize, in, &outSize, out, add](int rmin, int rmax)
+    {
+        Real const* left = fine.left.data();
+        Real const* right = fine.right.data();
+        int const sx = outSize[0], sy = outSize[1], sd = outSize[d];
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % sy, z = r / sy;
+            Real* outRow = out + sx * r;
+            if (d == 0)
+            {
+                Real const* inRow = in + inSize[0] * r;
+                for (int x = 1; x < sx - 1; ++x)
+                {
+                    Real value = ((x & 1) == 0 ? inRow[x / 2] :
+                        left[x] * inRow[x / 2] + right[x] * inRow[x / 2 + 1]);
+                    outRow[x] = (add ? outRow[x] + value : value);
+                }
+                if (!add)
+                {
+                    outRow[0] = (Real)0;
+                    outRow[sx - 1] = (Real)0;
+                }
+            }
+            else
+            {
+                int const i = (d == 1 ? y : z);
+                if (0 < i && i < sd - 1)
+                {
+                    int const stride = (d == 1 ? sx : sx * inSize[1]);
+                    Real const* inRow = in + sx * (d == 1 ?
+                        i / 2 + inSize[1] * z : y + inSize[1] * (i / 2));
+                    Real const wLeft = ((i & 1) == 0 ? (Real)1 : left[i]);
+                    Real const wRight = ((i & 1) == 0 ? (Real)0 : right[i]);
+                    for (int x = 0; x < sx; ++x)
+                    {
+                        Real value = wLeft * inRow[x] + wRight * inRow[x + stride];
+                        outRow[x] = (add ? outRow[x] + value : value);
+                    }
+                }
+                else if (!add)
+                {
+                    std::fill(outRow, outRow + sx, (Real)0);
+                }
+            }
+        }
+    });
+}
+
+template <int N, typename Real>
+double MultigridPoisson<N, Real>::GetNorm() const
+{
+    double norm = 0.0;
+    for (auto rowNorm : mRowNorms)
+    {
+        norm += rowNorm;
+    }
+    return norm;
+}
+
+template <int N, typename Real>
+void MultigridPoisson<N, Real>::ParallelFor(std::array<int, 3> const& size,
+    std::function<void(int, int)> const& function)
+{
+    // The ranges have at least minRangeSize samples so that the cost of
+    // scheduling is small compared to the work.
+    int const minRangeSize = 4096;
+    int const numRows = size[1] * size[2];
+    int const numCells = size[0] * numRows;
+    if (mThreadPool && numCells >= 2 * minRangeSize)
+    {
+        int numRanges = std::min(4 * static_cast<int>(mThreadPool->GetNumThreads()),
+            numCells / minRangeSize);
+        int grainSize = (numRows + numRanges - 1) / numRanges;
+        mThreadPool->ParallelFor(0, numRows, grainSize, function);
+    }
+    else
+    {
+        function(0, numRows);
+    }
+}
+
+}
@@ -3,19 +3,97 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2017/07/26)
+// File Version: 3.1.2 (2026/10/18)
 
 #pragma once
 
+#include <LowLevel/GteComputeModel.h>
 #include <LowLevel/GteLogger.h>
 #include <Mathematics/GteVector.h>
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
+// The squared distances from a query point to the sites of a leaf are
+// computed several sites at a time using SIMD instructions when Real is
+// float and the compiler targets AVX-512 (16 sites), AVX (8 sites) or SSE2
+// (4 sites).  Otherwise, or when GTE_NO_NEARESTNEIGHBOR_SIMD is defined,
+// the distances are computed one site at a time.  When the compiler
+// targets FMA or AVX-512, it may contract a*b+c to a fused multiply-add, so
+// both kernels then use fused multiply-adds explicitly; otherwise, both use
+// a multiply followed by an add.  The kernels therefore produce the same
+// squared distances.
+//#define GTE_NO_NEARESTNEIGHBOR_SIMD
+
+#if defined(__FMA__) || defined(__AVX512F__)
+#define GTE_NEARESTNEIGHBOR_FMA
+#endif
+
+#if !defined(GTE_NO_NEARESTNEIGHBOR_SIMD)
+#if defined(__AVX512F__)
+#define GTE_NEARESTNEIGHBOR_AVX512
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define GTE_NEARESTNEIGHBOR_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GTE_NEARESTNEIGHBOR_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
 namespace gte
 {
 
+// Compute sqrDistances[i-imin] = |site[i] - point|^2 for imin <= i < imax,
+// where the site coordinates are stored in structure-of-arrays form:
+// component d of site i is coordinates[d][i].  The scalar kernel is the
+// fallback for all types.  NearestNeighborKernel is the kernel used by
+// NearestNeighborQuery; WIDTH is the number of sites per instruction.
+template <int N, typename Real>
+class NearestNeighborScalarKernel
+{
+public:
+    enum { WIDTH = 1 };
+
+    static void GetSqrDistances(Real const* const* coordinates, int imin,
+        int imax, Real const* point, Real* sqrDistances);
+
+private:
+    // Compute x*x+y, fused for float and double when the target has FMA.
+    template <typename T>
+    inline static T SquareAdd(T const& x, T const& y);
+    inline static float SquareAdd(float x, float y);
+    inline static double SquareAdd(double x, double y);
+};
+
+template <int N, typename Real>
+class NearestNeighborKernel : public NearestNeighborScalarKernel<N, Real>
+{
+};
+
+#if defined(GTE_NEARESTNEIGHBOR_AVX512) || defined(GTE_NEARESTNEIGHBOR_AVX) || defined(GTE_NEARESTNEIGHBOR_SSE2)
+template <int N>
+class NearestNeighborKernel<N, float>
+{
+public:
+#if defined(GTE_NEARESTNEIGHBOR_AVX512)
+    enum { WIDTH = 16 };
+#elif defined(GTE_NEARESTNEIGHBOR_AVX)
+    enum { WIDTH = 8 };
+#else
+    enum { WIDTH = 4 };
+#endif
+
+    static void GetSqrDistances(float const* const* coordinates, int imin,
+        int imax, float const* point, float* sqrDistances);
+};
+#endif
+
 // Use a kd-tree for sorting used in a query for finding nearest neighbors
 // of a point in a space of the specified dimension N.  The split order is
 // always 0,1,2,...,N-1.  The number of sites at a leaf node is controlled
@@ -25,6 +103,14 @@ namespace gte
 // 'Vector<N,Real> GetPosition () const'.  The Site template parameter
 // allows the query to be applied even when it has more local information
 // than just point location.
+//
+// The tree is complete: every leaf is at the same level D, where D is the
+// smallest level for which the leaves have at most maxLeafSize sites (but
+// not larger than maxLevel+1).  The nodes are stored implicitly in
+// breadth-first order, so the children of node i are nodes 2*i+1 and
+// 2*i+2, and only the split values are stored.  The sites are sorted so that
+// the sites of a leaf are contiguous, and their coordinates are stored in
+// structure-of-arrays form (one array per dimension).
 template <int N, typename Real, typename Site>
 class NearestNeighborQuery
 {
@@ -39,32 +125,75 @@ public:
     // Compute up to MaxNeighbors nearest neighbors within the specified
     // radius of the point.  The returned integer is the number of neighbors
     // found, possibly zero.  The neighbors array stores indices into the
-    // array passed to the constructor.
+    // array passed to the constructor, sorted by increasing distance.
     template <int MaxNeighbors>
     int FindNeighbors(Vector<N,Real> const& point, Real radius,
         std::array<int, MaxNeighbors>& neighbors) const;
 
+    // Compute the k nearest neighbors of the point within the specified
+    // radius.  Pass std::numeric_limits<Real>::max() for the radius to
+    // search all the sites.  The arrays must have at least k elements.  The
+    // returned integer is the number of neighbors found, which is k unless
+    // the radius excludes sites or there are fewer than k sites.  The
+    // neighbors are sorted by increasing distance, and sqrDistances[i] is
+    // the squared distance from the point to the site neighbors[i].
+    int FindNearest(Vector<N,Real> const& point, Real radius, int k,
+        int* neighbors, Real* sqrDistances) const;
+
+    // Batch queries for an array of points, partitioned among the threads
+    // of the compute model (the calling thread when cmodel is null).  The
+    // results for points[i] are numNeighbors[i] and neighbors[i] for the
+    // first function.  The results for the second function are stored in
+    // numNeighbors[i] and in neighbors[k*i+j] and sqrDistances[k*i+j] for
+    // 0 <= j < numNeighbors[i].  The output arrays are resized as needed.
+    template <int MaxNeighbors>
+    void FindNeighbors(std::vector<Vector<N, Real>> const& points, Real radius,
+        std::vector<int>& numNeighbors,
+        std::vector<std::array<int, MaxNeighbors>>& neighbors,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr) const;
+
+    void FindNearest(std::vector<Vector<N, Real>> const& points, Real radius, int k,
+        std::vector<int>& numNeighbors, std::vector<int>& neighbors,
+        std::vector<Real>& sqrDistances,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr) const;
+
 private:
+    // The sites of a leaf are processed in blocks of this size.
+    enum { LEAF_BLOCK_SIZE = 64 };
+
+    // Populate the subtree at the node by splitting the sites along the
+    // coordinate axes.
     typedef std::pair<Vector<N, Real>, int> SortedPoint;
 
-    struct Node
-    {
-        Real split;
-        int axis;
-        int numSites;
-        int siteOffset;
-        int left;
-        int right;
-    };
+    void Build(std::vector<SortedPoint>& sortedPoints, int numSites,
+        int siteOffset, int nodeIndex, int level);
 
-    // Populate the node so that it contains the points split along the
-    // coordinate axes.
-    void Build(int numSites, int siteOffset, int nodeIndex, int level);
+    // Execute query(i) for 0 <= i < numQueries using the thread pool of
+    // cmodel.  The threads process blocks of consecutive queries.
+    template <typename Query>
+    static void Execute(int numQueries, std::shared_ptr<ComputeModel> const& cmodel,
+        Query const& query);
+
+    // The neighbors are maintained as a max-heap on the squared distances.
+    static void HeapPush(int numNeighbors, int* neighbors, Real* sqrDistances);
+    static void HeapReplaceTop(int numNeighbors, int* neighbors, Real* sqrDistances);
+    static void HeapSort(int numNeighbors, int* neighbors, Real* sqrDistances);
 
     int mMaxLeafSize;
     int mMaxLevel;
-    std::vector<SortedPoint> mSortedPoints;
-    std::vector<Node> mNodes;
+
+    // The level of the leaves, the split values of the interior nodes (in
+    // breadth-first order) and the offsets of the sites of the leaves into
+    // the sorted site arrays.  The sites of leaf j, which is node
+    // 2^D-1+j, are mLeafOffsets[j] through mLeafOffsets[j+1]-1.
+    int mLeafLevel;
+    std::vector<Real> mSplits;
+    std::vector<int> mLeafOffsets;
+
+    // The sorted sites: the index into the array passed to the constructor
+    // and the coordinates, mCoordinates[d][i] being component d of site i.
+    std::vector<int> mSiteIndices;
+    std::array<std::vector<Real>, N> mCoordinates;
 };
 
 
@@ -72,18 +201,46 @@ template <int N, typename Real, typename Site>
 NearestNeighborQuery<N, Real, Site>::NearestNeighborQuery(
     std::vector<Site> const& sites, int maxLeafSize, int maxLevel)
     :
-    mMaxLeafSize(maxLeafSize),
+    mMaxLeafSize(std::max(maxLeafSize, 1)),
     mMaxLevel(maxLevel),
-    mSortedPoints(sites.size())
+    mLeafLevel(0)
 {
     int const numSites = static_cast<int>(sites.size());
+    std::vector<SortedPoint> sortedPoints(numSites);
     for (int i = 0; i < numSites; ++i)
     {
-        mSortedPoints[i] = std::make_pair(sites[i].GetPosition(), i);
+        sortedPoints[i] = std::make_pair(sites[i].GetPosition(), i);
     }
 
-    mNodes.push_back(Node());
-    Build(numSites, 0, 0, 0);
+    // Choose the level of the leaves.  The sites of a node at level L are
+    // split into halves, so a leaf has at most ceil(numSites/2^D) sites.
+    // The level is limited to 30 so that the node indices are 32-bit.
+    int const maxLeafLevel = std::min(std::max(mMaxLevel + 1, 0), 30);
+    while (mLeafLevel < maxLeafLevel
+        && ((numSites - 1) >> mLeafLevel) + 1 > mMaxLeafSize)
+    {
+        ++mLeafLevel;
+    }
+
+    int const numLeaves = (1 << mLeafLevel);
+    mSplits.resize(static_cast<size_t>(numLeaves) - 1);
+    mLeafOffsets.resize(static_cast<size_t>(numLeaves) + 1);
+    mLeafOffsets[numLeaves] = numSites;
+    Build(sortedPoints, numSites, 0, 0, 0);
+
+    mSiteIndices.resize(numSites);
+    for (int d = 0; d < N; ++d)
+    {
+        mCoordinates[d].resize(numSites);
+    }
+    for (int i = 0; i < numSites; ++i)
+    {
+        mSiteIndices[i] = sortedPoints[i].second;
+        for (int d = 0; d < N; ++d)
+        {
+            mCoordinates[d][i] = sortedPoints[i].first[d];
+        }
+    }
 }
 
 template <int N, typename Real, typename Site>
@@ -103,136 +260,403 @@ template <int MaxNeighbors>
 int NearestNeighborQuery<N, Real, Site>::FindNeighbors(Vector<N, Real> const& point,
     Real radius, std::array<int, MaxNeighbors>& neighbors) const
 {
-    Real sqrRadius = radius * radius;
+    std::array<Real, MaxNeighbors> sqrDistances;
+    return FindNearest(point, radius, MaxNeighbors, neighbors.data(), sqrDistances.data());
+}
+
+template <int N, typename Real, typename Site>
+int NearestNeighborQuery<N, Real, Site>::FindNearest(Vector<N, Real> const& point,
+    Real radius, int k, int* neighbors, Real* sqrDistances) const
+{
+    Real const maxReal = std::numeric_limits<Real>::max();
+    Real const sqrRadius = (radius < maxReal ? radius * radius : maxReal);
     int numNeighbors = 0;
-    std::array<int, MaxNeighbors + 1> localNeighbors;
-    std::array<Real, MaxNeighbors + 1> neighborSqrLength;
-    for (int i = 0; i <= MaxNeighbors; ++i)
+    if (k <= 0)
     {
-        localNeighbors[i] = -1;
-        neighborSqrLength[i] = std::numeric_limits<Real>::max();
+        return 0;
     }
 
-    // The kd-tree construction is recursive, simulated here by using a stack.
-    // The maximum depth is limited to 32, because the number of sites is
-    // limited to 2^{32} (the number of 32-bit integer indices).
-    std::array<int, 32> stack;
+    // The kd-tree construction is recursive, simulated here by using a
+    // stack.  The stack stores the node, its level and a lower bound on the
+    // squared distance from the point to the sites of the node.  A node is
+    // skipped when its bound is larger than the squared distance to the
+    // farthest neighbor (when k neighbors are known) or than the squared
+    // radius.  The near child is visited before the far child.
+    struct Entry
+    {
+        int node, level;
+        Real bound;
+    };
+    std::array<Entry, 32> stack;
     int top = 0;
-    stack[0] = 0;
+    stack[0] = { 0, 0, (Real)0 };
+
+    std::array<Real const*, N> coordinates;
+    for (int d = 0; d < N; ++d)
+    {
+        coordinates[d] = mCoordinates[d].data();
+    }
+    std::array<Real, LEAF_BLOCK_SIZE> sqrLengths;
 
+    int const firstLeaf = (1 << mLeafLevel) - 1;
     while (top >= 0)
     {
-        Node node = mNodes[stack[top--]];
+        Entry entry = stack[top--];
+        Real maxSqrDistance = (numNeighbors < k ? sqrRadius : sqrDistances[0]);
+        if (entry.bound > maxSqrDistance)
+        {
+            continue;
+        }
 
-        if (node.siteOffset != -1)
+        if (entry.level == mLeafLevel)
         {
-            for (int i = 0, j = node.siteOffset; i < node.numSites; ++i, ++j)
+            // Compute the squared distances to the sites of the leaf in
+            // blocks, and then update the neighbors.
+            int const leaf = entry.node - firstLeaf;
+            int const jmax = mLeafOffsets[leaf + 1];
+            for (int jmin = mLeafOffsets[leaf]; jmin < jmax; jmin += LEAF_BLOCK_SIZE)
             {
-                Vector<N, Real> diff = mSortedPoints[j].first - point;
-                Real sqrLength = Dot(diff, diff);
-                if (sqrLength <= sqrRadius)
+                int const jend = std::min(jmin + LEAF_BLOCK_SIZE, jmax);
+                NearestNeighborKernel<N, Real>::GetSqrDistances(coordinates.data(),
+                    jmin, jend, &point[0], sqrLengths.data());
+
+                for (int j = jmin; j < jend; ++j)
                 {
-                    // Maintain the nearest neighbors.
-                    int k;
-                    for (k = 0; k < numNeighbors; ++k)
+                    Real sqrLength = sqrLengths[j - jmin];
+                    if (numNeighbors < k)
                     {
-                        if (sqrLength <= neighborSqrLength[k])
+                        if (sqrLength <= sqrRadius)
                         {
-                            for (int n = numNeighbors; n > k; --n)
-                            {
-                                localNeighbors[n] = localNeighbors[n - 1];
-                                neighborSqrLength[n] = neighborSqrLength[n - 1];
-                            }
-                            break;
+                            neighbors[numNeighbors] = mSiteIndices[j];
+                            sqrDistances[numNeighbors] = sqrLength;
+                            HeapPush(++numNeighbors, neighbors, sqrDistances);
                         }
                     }
-                    if (k < MaxNeighbors)
+                    else if (sqrLength < sqrDistances[0])
                     {
-                        localNeighbors[k] = mSortedPoints[j].second;
-                        neighborSqrLength[k] = sqrLength;
-                    }
-                    if (numNeighbors < MaxNeighbors)
-                    {
-                        ++numNeighbors;
+                        neighbors[0] = mSiteIndices[j];
+                        sqrDistances[0] = sqrLength;
+                        HeapReplaceTop(numNeighbors, neighbors, sqrDistances);
                     }
                 }
             }
         }
-
-        if (node.left != -1 && point[node.axis] - radius <= node.split)
-        {
-            stack[++top] = node.left;
-        }
-
-        if (node.right != -1 && point[node.axis] + radius >= node.split)
+        else
         {
-            stack[++top] = node.right;
+            int const axis = entry.level % N;
+            Real diff = point[axis] - mSplits[entry.node];
+            int left = 2 * entry.node + 1, right = left + 1;
+            int nextLevel = entry.level + 1;
+            Real farBound = std::max(entry.bound, diff * diff);
+            if (diff <= (Real)0)
+            {
+                stack[++top] = { right, nextLevel, farBound };
+                stack[++top] = { left, nextLevel, entry.bound };
+            }
+            else
+            {
+                stack[++top] = { left, nextLevel, farBound };
+                stack[++top] = { right, nextLevel, entry.bound };
+            }
         }
     }
 
-    for (int i = 0; i < numNeighbors; ++i)
-    {
-        neighbors[i] = localNeighbors[i];
-    }
-
+    HeapSort(numNeighbors, neighbors, sqrDistances);
     return numNeighbors;
 }
 
 template <int N, typename Real, typename Site>
-void NearestNeighborQuery<N, Real, Site>::Build(int numSites, int siteOffset,
-    int nodeIndex, int level)
+template <int MaxNeighbors>
+void NearestNeighborQuery<N, Real, Site>::FindNeighbors(
+    std::vector<Vector<N, Real>> const& points, Real radius,
+    std::vector<int>& numNeighbors,
+    std::vector<std::array<int, MaxNeighbors>>& neighbors,
+    std::shared_ptr<ComputeModel> const& cmodel) const
 {
-    LogAssert(siteOffset != -1, "Invalid site offset.");
-    LogAssert(nodeIndex != -1, "Invalid node index.");
-    LogAssert(numSites > 0, "Empty point list.");
+    int const numPoints = static_cast<int>(points.size());
+    numNeighbors.resize(numPoints);
+    neighbors.resize(numPoints);
+    Execute(numPoints, cmodel, [this, &points, radius, &numNeighbors, &neighbors](int i)
+    {
+        numNeighbors[i] = this->template FindNeighbors<MaxNeighbors>(points[i], radius, neighbors[i]);
+    });
+}
 
-    Node& node = mNodes[nodeIndex];
-    node.numSites = numSites;
+template <int N, typename Real, typename Site>
+void NearestNeighborQuery<N, Real, Site>::FindNearest(
+    std::vector<Vector<N, Real>> const& points, Real radius, int k,
+    std::vector<int>& numNeighbors, std::vector<int>& neighbors,
+    std::vector<Real>& sqrDistances, std::shared_ptr<ComputeModel> const& cmodel) const
+{
+    int const numPoints = static_cast<int>(points.size());
+    k = std::max(k, 0);
+    numNeighbors.resize(numPoints);
+    neighbors.resize(static_cast<size_t>(numPoints) * k);
+    sqrDistances.resize(static_cast<size_t>(numPoints) * k);
+    Execute(numPoints, cmodel, [this, &points, radius, k, &numNeighbors, &neighbors, &sqrDistances](int i)
+    {
+        size_t offset = static_cast<size_t>(i) * k;
+        numNeighbors[i] = FindNearest(points[i], radius, k,
+            neighbors.data() + offset, sqrDistances.data() + offset);
+    });
+}
 
-    if (numSites > mMaxLeafSize && level <= mMaxLevel)
+template <int N, typename Real, typename Site>
+void NearestNeighborQuery<N, Real, Site>::Build(
+    std::vector<SortedPoint>& sortedPoints, int numSites, int siteOffset,
+    int nodeIndex, int level)
+{
+    if (level < mLeafLevel)
     {
         int halfNumSites = numSites / 2;
 
-        // The point set is too large for a leaf node, so split it at the
-        // median.  The O(m log m) sort is not needed; rather, we locate the
-        // median using an order statistic construction that is expected
-        // time O(m).
+        // Split the sites at the median.  The O(m log m) sort is not needed;
+        // rather, we locate the median using an order statistic construction
+        // that is expected time O(m).
         int const axis = level % N;
         auto sorter = [axis](SortedPoint const& p0, SortedPoint const& p1)
         {
             return p0.first[axis] < p1.first[axis];
         };
 
-        auto begin = mSortedPoints.begin() + siteOffset;
-        auto mid = mSortedPoints.begin() + siteOffset + halfNumSites;
-        auto end = mSortedPoints.begin() + siteOffset + numSites;
-        std::nth_element(begin, mid, end, sorter);
+        auto begin = sortedPoints.begin() + siteOffset;
+        auto mid = begin + halfNumSites;
+        auto end = begin + numSites;
+        if (numSites > 0)
+        {
+            std::nth_element(begin, mid, end, sorter);
+        }
 
-        // Get the median position.
-        node.split = mSortedPoints[siteOffset + halfNumSites].first[axis];
-        node.axis = axis;
-        node.siteOffset = -1;
+        // Get the median position.  The sites of the left subtree have
+        // coordinates not larger than the split value and the sites of the
+        // right subtree have coordinates not smaller than the split value.
+        mSplits[nodeIndex] = (halfNumSites < numSites ?
+            mid->first[axis] : std::numeric_limits<Real>::max());
 
         // Apply a divide-and-conquer step.
-        int left = (int)mNodes.size(), right = left + 1;
-        node.left = left;
-        node.right = right;
-        mNodes.push_back(Node());
-        mNodes.push_back(Node());
-
         int nextLevel = level + 1;
-        Build(halfNumSites, siteOffset, left, nextLevel);
-        Build(numSites - halfNumSites, siteOffset + halfNumSites, right, nextLevel);
+        Build(sortedPoints, halfNumSites, siteOffset, 2 * nodeIndex + 1, nextLevel);
+        Build(sortedPoints, numSites - halfNumSites, siteOffset + halfNumSites,
+            2 * nodeIndex + 2, nextLevel);
     }
     else
     {
-        // The number of points is small enough, so make this node a leaf.
-        node.split = std::numeric_limits<Real>::max();
-        node.axis = -1;
-        node.siteOffset = siteOffset;
-        node.left = -1;
-        node.right = -1;
+        // The node is a leaf.
+        mLeafOffsets[nodeIndex - ((1 << mLeafLevel) - 1)] = siteOffset;
     }
 }
 
+template <int N, typename Real, typename Site>
+template <typename Query>
+void NearestNeighborQuery<N, Real, Site>::Execute(int numQueries,
+    std::shared_ptr<ComputeModel> const& cmodel, Query const& query)
+{
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    if (threadPool && numQueries > 1)
+    {
+        // The pool balances the load over blocks of queries when the query
+        // times differ.
+        int const blockSize = 64;
+        threadPool->ParallelFor(0, numQueries, blockSize,
+            [&query](int imin, int imax)
+            {
+                for (int i = imin; i < imax; ++i)
+                {
+                    query(i);
+                }
+            });
+    }
+    else
+    {
+        for (int i = 0; i < numQueries; ++i)
+        {
+            query(i);
+        }
+    }
+}
+
+template <int N, typename Real, typename Site>
+void NearestNeighborQuery<N, Real, Site>::HeapPush(int numNeighbors,
+    int* neighbors, Real* sqrDistances)
+{
+    // The new element is at the end of the arrays.  Move it toward the root
+    // while it is larger than its parent.
+    int child = numNeighbors - 1;
+    int neighbor = neighbors[child];
+    Real sqrDistance = sqrDistances[child];
+    while (child > 0)
+    {
+        int parent = (child - 1) / 2;
+        if (sqrDistances[parent] >= sqrDistance)
+        {
+            break;
+        }
+        neighbors[child] = neighbors[parent];
+        sqrDistances[child] = sqrDistances[parent];
+        child = parent;
+    }
+    neighbors[child] = neighbor;
+    sqrDistances[child] = sqrDistance;
+}
+
+template <int N, typename Real, typename Site>
+void NearestNeighborQuery<N, Real, Site>::HeapReplaceTop(int numNeighbors,
+    int* neighbors, Real* sqrDistances)
+{
+    // The new element is at the root.  Move it toward the leaves while it is
+    // smaller than its larger child.
+    int parent = 0;
+    int neighbor = neighbors[0];
+    Real sqrDistance = sqrDistances[0];
+    for (;;)
+    {
+        int child = 2 * parent + 1;
+        if (child >= numNeighbors)
+        {
+            break;
+        }
+        if (child + 1 < numNeighbors && sqrDistances[child + 1] > sqrDistances[child])
+        {
+            ++child;
+        }
+        if (sqrDistances[child] <= sqrDistance)
+        {
+            break;
+        }
+        neighbors[parent] = neighbors[child];
+        sqrDistances[parent] = sqrDistances[child];
+        parent = child;
+    }
+    neighbors[parent] = neighbor;
+    sqrDistances[parent] = sqrDistance;
+}
+
+template <int N, typename Real, typename Site>
+void NearestNeighborQuery<N, Real, Site>::HeapSort(int numNeighbors,
+    int* neighbors, Real* sqrDistances)
+{
+    // Repeatedly swap the largest element with the last element of the
+    // heap, which sorts the arrays by increasing distance.
+    for (int last = numNeighbors - 1; last > 0; --last)
+    {
+        std::swap(neighbors[0], neighbors[last]);
+        std::swap(sqrDistances[0], sqrDistances[last]);
+        HeapReplaceTop(last, neighbors, sqrDistances);
+    }
+}
+
+template <int N, typename Real>
+void NearestNeighborScalarKernel<N, Real>::GetSqrDistances(
+    Real const* const* coordinates, int imin, int imax, Real const* point,
+    Real* sqrDistances)
+{
+    for (int i = imin; i < imax; ++i)
+    {
+        Real sqrLength = (Real)0;
+        for (int d = 0; d < N; ++d)
+        {
+            Real diff = coordinates[d][i] - point[d];
+            sqrLength = SquareAdd(diff, sqrLength);
+        }
+        sqrDistances[i - imin] = sqrLength;
+    }
+}
+
+template <int N, typename Real>
+template <typename T> inline
+T NearestNeighborScalarKernel<N, Real>::SquareAdd(T const& x, T const& y)
+{
+    return x * x + y;
+}
+
+template <int N, typename Real> inline
+float NearestNeighborScalarKernel<N, Real>::SquareAdd(float x, float y)
+{
+#if defined(GTE_NEARESTNEIGHBOR_FMA)
+    return std::fma(x, x, y);
+#else
+    return x * x + y;
+#endif
+}
+
+template <int N, typename Real> inline
+double NearestNeighborScalarKernel<N, Real>::SquareAdd(double x, double y)
+{
+#if defined(GTE_NEARESTNEIGHBOR_FMA)
+    return std::fma(x, x, y);
+#else
+    return x * x + y;
+#endif
+}
+
+#if defined(GTE_NEARESTNEIGHBOR_AVX512) || defined(GTE_NEARESTNEIGHBOR_AVX) || defined(GTE_NEARESTNEIGHBOR_SSE2)
+template <int N>
+void NearestNeighborKernel<N, float>::GetSqrDistances(
+    float const* const* coordinates, int imin, int imax, float const* point,
+    float* sqrDistances)
+{
+    // The sums are accumulated in the same order and with the same
+    // (fused or unfused) operations as in the scalar kernel, so the results
+    // are the same.
+    int i = imin;
+#if defined(GTE_NEARESTNEIGHBOR_AVX512)
+    __m512 p[N];
+    for (int d = 0; d < N; ++d)
+    {
+        p[d] = _mm512_set1_ps(point[d]);
+    }
+    for (; i + WIDTH <= imax; i += WIDTH)
+    {
+        __m512 sqrLength = _mm512_setzero_ps();
+        for (int d = 0; d < N; ++d)
+        {
+            __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(coordinates[d] + i), p[d]);
+            sqrLength = _mm512_fmadd_ps(diff, diff, sqrLength);
+        }
+        _mm512_storeu_ps(sqrDistances + (i - imin), sqrLength);
+    }
+#elif defined(GTE_NEARESTNEIGHBOR_AVX)
+    __m256 p[N];
+    for (int d = 0; d < N; ++d)
+    {
+        p[d] = _mm256_set1_ps(point[d]);
+    }
+    for (; i + WIDTH <= imax; i += WIDTH)
+    {
+        __m256 sqrLength = _mm256_setzero_ps();
+        for (int d = 0; d < N; ++d)
+        {
+            __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(coordinates[d] + i), p[d]);
+#if defined(GTE_NEARESTNEIGHBOR_FMA)
+            sqrLength = _mm256_fmadd_ps(diff, diff, sqrLength);
+#else
+            sqrLength = _mm256_add_ps(sqrLength, _mm256_mul_ps(diff, diff));
+#endif
+        }
+        _mm256_storeu_ps(sqrDistances + (i - imin), sqrLength);
+    }
+#else
+    __m128 p[N];
+    for (int d = 0; d < N; ++d)
+    {
+        p[d] = _mm_set1_ps(point[d]);
+    }
+    for (; i + WIDTH <= imax; i += WIDTH)
+    {
+        __m128 sqrLength = _mm_setzero_ps();
+        for (int d = 0; d < N; ++d)
+        {
+            __m128 diff = _mm_sub_ps(_mm_loadu_ps(coordinates[d] + i), p[d]);
+            sqrLength = _mm_add_ps(sqrLength, _mm_mul_ps(diff, diff));
+        }
+        _mm_storeu_ps(sqrDistances + (i - imin), sqrLength);
+    }
+#endif
+
+    // Process the remaining sites one at a time.
+    NearestNeighborScalarKernel<N, float>::GetSqrDistances(coordinates, i, imax,
+        point, sqrDistances + (i - imin));
+}
+#endif
+
 }
@@ -0,0 +1,1060 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.1 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GtePrimalQuery2.h>
+#include <Mathematics/GteLine.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Delaunay triangulation of points (intrinsic dimensionality 2) computed by
+// the divide-and-conquer algorithm of L. Guibas and J. Stolfi, "Primitives
+// for the manipulation of general subdivisions and the computation of
+// Voronoi diagrams", ACM Transactions on Graphics, vol. 4, no. 2, 1985.
+//
+// The unique points are sorted lexicographically and partitioned into
+// vertical strips, one per thread of the ComputeModel thread pool (rounded
+// down to a power of two).  The strips are triangulated concurrently and
+// then merged pairwise, the merges of each level also executed
+// concurrently.  The
+// subdivision is stored as arrays of half-edges, where the half-edges 2*k
+// and 2*k+1 are the two directions of edge k.  The edges of a strip are
+// allocated from a range of the arrays reserved for that strip, so the
+// threads never write to the same array elements.
+//
+// The output is the same as that of Delaunay2 (see the comments in
+// GteDelaunay2.h for the meaning of the index and adjacency arrays).  The
+// triangles are listed in the order of their TriangleKey<true> values, as
+// they are in Delaunay2, and the vertices of a triangle are listed starting
+// with the smallest index.  When the points have cocircular subsets, the
+// Delaunay triangulation is not unique and the triangles can differ from
+// those of Delaunay2.  The triangulations of those subsets computed by the
+// merges depend on the partition into strips, so a final pass flips the
+// edges of cocircular quadrilaterals until each quadrilateral has the
+// diagonal that contains its smallest vertex index.  That rule is the
+// Delaunay criterion for a symbolic perturbation of the points, so the
+// result is unique and the output does not depend on the number of threads.
+// The comments in GteDelaunay2.h about the choice of ComputeType apply here.
+
+namespace gte
+{
+
+template <typename InputType, typename ComputeType>
+class ParallelDelaunay2
+{
+public:
+    // The class is a functor to support computing the Delaunay triangulation
+    // of multiple data sets using the same class object.  The computations
+    // are executed by cmodel->threadPool.  If cmodel or its thread pool is
+    // null, the triangulation is computed on the calling thread.
+    virtual ~ParallelDelaunay2();
+    ParallelDelaunay2(std::shared_ptr<ComputeModel> const& cmodel);
+
+    // The input is the array of vertices whose Delaunay triangulation is
+    // required.  The epsilon value is used to determine the intrinsic
+    // dimensionality of the vertices (d = 0, 1, or 2).  When epsilon is
+    // positive, the determination is fuzzy--vertices approximately the same
+    // point, approximately on a line, or planar.  The return value is 'true'
+    // if and only if the triangulation is successful.
+    bool operator()(int numVertices, Vector2<InputType> const* vertices, InputType epsilon);
+
+    // Dimensional information.  If GetDimension() returns 1, the points lie
+    // on a line P+t*D (fuzzy comparison when epsilon > 0).
+    inline InputType GetEpsilon() const;
+    inline int GetDimension() const;
+    inline Line2<InputType> const& GetLine() const;
+
+    // Member access.
+    inline int GetNumVertices() const;
+    inline int GetNumUniqueVertices() const;
+    inline int GetNumTriangles() const;
+    inline Vector2<InputType> const* GetVertices() const;
+    inline PrimalQuery2<ComputeType> const& GetQuery() const;
+    inline std::vector<int> const& GetIndices() const;
+    inline std::vector<int> const& GetAdjacencies() const;
+
+    // If 'vertices' has no duplicates, GetDuplicates()[i] = i for all i.
+    // If vertices[i] is the first occurrence of a vertex and if vertices[j]
+    // is found later, then GetDuplicates()[j] = i.
+    inline std::vector<int> const& GetDuplicates() const;
+
+    // See the comments in GteDelaunay2.h for these functions.
+    bool GetHull(std::vector<int>& hull) const;
+    bool GetIndices(int i, std::array<int, 3>& indices) const;
+    bool GetAdjacencies(int i, std::array<int, 3>& adjacencies) const;
+
+protected:
+    // The edges of a subset of points are allocated from the range
+    // [next,end) of edge indices.  Deleted edges are reused.
+    struct Allocator
+    {
+        int next, end;
+        std::vector<int> freeEdges;
+    };
+
+    // The triangulation of a subset of points is represented by the
+    // counterclockwise hull edge out of the leftmost vertex (ldo) and the
+    // clockwise hull edge out of the rightmost vertex (rdo).
+    struct Hull
+    {
+        int ldo, rdo;
+    };
+
+    // Sort the vertex indices lexicographically, with ties broken by index.
+    void SortVertices(std::shared_ptr<ThreadPool> const& threadPool,
+        std::vector<int>& sorted) const;
+
+    // The divide-and-conquer triangulation of mSorted[imin..imax-1].
+    Hull Triangulate(int imin, int imax, Allocator& allocator);
+    Hull Merge(Hull const& left, Hull const& right, Allocator& allocator);
+
+    // Half-edge operations.  The Onext ring of a half-edge is the list of
+    // half-edges with the same origin in counterclockwise order.
+    inline int Sym(int e) const;
+    inline int Org(int e) const;
+    inline int Dest(int e) const;
+    inline int Onext(int e) const;
+    inline int Oprev(int e) const;
+    inline int Lnext(int e) const;
+    inline int Rprev(int e) const;
+    int MakeEdge(int v0, int v1, Allocator& allocator);
+    void Splice(int a, int b);
+    int Connect(int a, int b, Allocator& allocator);
+    void DeleteEdge(int e, Allocator& allocator);
+
+    // Replace the edge e, the diagonal of the quadrilateral formed by its
+    // two triangles, by the other diagonal.
+    void Flip(int e);
+
+    // Flip the diagonals of cocircular quadrilaterals to those that contain
+    // the smallest vertex index of the quadrilateral.  The face to the
+    // right of the half-edge 'outer' is the unbounded face.
+    void ResolveCocircular(int outer,
+        std::shared_ptr<ThreadPool> const& threadPool);
+    bool NeedsFlip(int e, std::vector<char> const& isOuter) const;
+
+    // Predicates.  CCW is true when <v0,v1,v2> is counterclockwise.
+    // InCircle is true when v3 is strictly inside the circumcircle of the
+    // counterclockwise triangle <v0,v1,v2>.
+    inline bool CCW(int v0, int v1, int v2) const;
+    inline bool RightOf(int v, int e) const;
+    inline bool LeftOf(int v, int e) const;
+    inline bool InCircle(int v0, int v1, int v2, int v3) const;
+
+    // Copy the triangles to mIndices and mAdjacencies.  The face to the
+    // right of the half-edge 'outer' is the unbounded face.
+    void BuildOutput(int outer);
+
+    std::shared_ptr<ComputeModel> mCModel;
+
+    InputType mEpsilon;
+    int mDimension;
+    Line2<InputType> mLine;
+
+    // The array of vertices used for geometric queries.  If you want to be
+    // certain of a correct result, choose ComputeType to be BSNumber.
+    std::vector<Vector2<ComputeType>> mComputeVertices;
+    PrimalQuery2<ComputeType> mQuery;
+
+    // Double-precision copies of the input for the floating-point filter of
+    // the queries.  The filter is enabled when InputType is float or double
+    // and ComputeType is not a floating-point type.
+    std::vector<Vector2<double>> mFilterVertices;
+
+    // The graph information.
+    int mNumVertices;
+    int mNumUniqueVertices;
+    int mNumTriangles;
+    Vector2<InputType> const* mVertices;
+    std::vector<int> mIndices;
+    std::vector<int> mAdjacencies;
+    std::vector<int> mDuplicates;
+
+    // The unique vertex indices in lexicographical order of the vertices
+    // and the half-edge arrays.  A deleted edge k has mOrigin[2*k] = -1.
+    std::vector<int> mSorted;
+    std::vector<int> mOrigin;
+    std::vector<int> mONext;
+    std::vector<int> mOPrev;
+};
+
+
+template <typename InputType, typename ComputeType>
+ParallelDelaunay2<InputType, ComputeType>::~ParallelDelaunay2()
+{
+}
+
+template <typename InputType, typename ComputeType>
+ParallelDelaunay2<InputType, ComputeType>::ParallelDelaunay2(
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mCModel(cmodel),
+    mEpsilon((InputType)0),
+    mDimension(0),
+    mLine(Vector2<InputType>::Zero(), Vector2<InputType>::Zero()),
+    mNumVertices(0),
+    mNumUniqueVertices(0),
+    mNumTriangles(0),
+    mVertices(nullptr)
+{
+}
+
+template <typename InputType, typename ComputeType>
+bool ParallelDelaunay2<InputType, ComputeType>::operator()(int numVertices,
+    Vector2<InputType> const* vertices, InputType epsilon)
+{
+    mEpsilon = std::max(epsilon, (InputType)0);
+    mDimension = 0;
+    mLine.origin = Vector2<InputType>::Zero();
+    mLine.direction = Vector2<InputType>::Zero();
+    mNumVertices = numVertices;
+    mNumUniqueVertices = 0;
+    mNumTriangles = 0;
+    mVertices = vertices;
+    mIndices.clear();
+    mAdjacencies.clear();
+    mSorted.clear();
+    mOrigin.clear();
+    mONext.clear();
+    mOPrev.clear();
+    mDuplicates.resize(std::max(numVertices, 3));
+
+    int i, j;
+    if (mNumVertices < 3)
+    {
+        // ParallelDelaunay2 should be called with at least three points.
+        return false;
+    }
+
+    IntrinsicsVector2<InputType> info(mNumVertices, vertices, mEpsilon);
+    if (info.dimension == 0)
+    {
+        // mDimension is 0; mIndices and mAdjacencies are empty
+        return false;
+    }
+
+    if (info.dimension == 1)
+    {
+        // The set is (nearly) collinear.
+        mDimension = 1;
+        mLine = Line2<InputType>(info.origin, info.direction[0]);
+        return false;
+    }
+
+    mDimension = 2;
+
+    // Compute the vertices for the queries.  The conversion to ComputeType
+    // is expensive for arbitrary-precision types, so it is executed in
+    // multiple threads.
+    std::shared_ptr<ThreadPool> threadPool = (mCModel ? mCModel->threadPool : nullptr);
+    unsigned int numThreads = (threadPool ? threadPool->GetNumThreads() : 1);
+    bool useFilter =
+        (std::is_same<InputType, float>::value || std::is_same<InputType, double>::value)
+        && !std::is_floating_point<ComputeType>::value;
+    mComputeVertices.resize(mNumVertices);
+    mQuery.Set(mNumVertices, &mComputeVertices[0]);
+    if (useFilter)
+    {
+        mFilterVertices.resize(mNumVertices);
+        mQuery.SetFilter(&mFilterVertices[0]);
+    }
+
+    auto convert = [this, vertices, useFilter](int imin, int imax)
+    {
+        for (int k = imin; k < imax; ++k)
+        {
+            for (int c = 0; c < 2; ++c)
+            {
+                mComputeVertices[k][c] = vertices[k][c];
+                if (useFilter)
+                {
+                    mFilterVertices[k][c] = static_cast<double>(vertices[k][c]);
+                }
+            }
+        }
+    };
+
+    if (threadPool)
+    {
+        threadPool->ParallelFor(0, mNumVertices, 0, convert);
+    }
+    else
+    {
+        convert(0, mNumVertices);
+    }
+
+    // Sort the vertices and identify the duplicates.  The first occurrence
+    // of a vertex is at the beginning of its run of duplicates.
+    std::vector<int> sorted(mNumVertices);
+    SortVertices(threadPool, sorted);
+    mSorted.reserve(mNumVertices);
+    for (i = 0; i < mNumVertices; i = j)
+    {
+        int first = sorted[i];
+        for (j = i; j < mNumVertices && vertices[sorted[j]] == vertices[first]; ++j)
+        {
+            mDuplicates[sorted[j]] = first;
+        }
+        mSorted.push_back(first);
+    }
+    mNumUniqueVertices = static_cast<int>(mSorted.size());
+
+    // Partition the sorted vertices into strips.  The number of strips is a
+    // power of two and each strip has at least 64 vertices.
+    int numStrips = 1;
+    while (2 * static_cast<unsigned int>(numStrips) <= numThreads
+        && 2 * 64 * numStrips <= mNumUniqueVertices)
+    {
+        numStrips *= 2;
+    }
+
+    // Each strip with m vertices is assigned 3*m+3 edges.  A planar graph
+    // with m >= 3 vertices has at most 3*m-6 edges, so the assigned edges
+    // suffice for the triangulation of the strip and, after combining the
+    // ranges of two strips, for the triangulation of their union.
+    std::vector<int> stripMin(numStrips + 1);
+    std::vector<Allocator> allocators(numStrips);
+    int numEdges = 0;
+    for (int s = 0; s <= numStrips; ++s)
+    {
+        stripMin[s] = static_cast<int>(
+            (static_cast<int64_t>(mNumUniqueVertices) * s) / numStrips);
+    }
+    for (int s = 0; s < numStrips; ++s)
+    {
+        int numStripEdges = 3 * (stripMin[s + 1] - stripMin[s]) + 3;
+        allocators[s].next = numEdges;
+        allocators[s].end = numEdges + numStripEdges;
+        numEdges += numStripEdges;
+    }
+    mOrigin.resize(2 * static_cast<size_t>(numEdges), -1);
+    mONext.resize(2 * static_cast<size_t>(numEdges), -1);
+    mOPrev.resize(2 * static_cast<size_t>(numEdges), -1);
+
+    std::vector<Hull> hulls(numStrips);
+    if (numStrips > 1)
+    {
+        // Triangulate the strips in multiple threads.
+        threadPool->ParallelFor(0, numStrips, 1,
+            [this, &stripMin, &allocators, &hulls](int smin, int smax)
+            {
+                for (int s = smin; s < smax; ++s)
+                {
+                    hulls[s] = Triangulate(stripMin[s], stripMin[s + 1], allocators[s]);
+                }
+            });
+
+        // Merge adjacent strips in multiple threads until one strip remains.
+        // The triangulation of strips s and s+step is stored in strip s.
+        for (int step = 1; step < numStrips; step *= 2)
+        {
+            int numMerges = numStrips / (2 * step);
+            threadPool->ParallelFor(0, numMerges, 1,
+                [this, step, &allocators, &hulls](int mmin, int mmax)
+                {
+                    for (int m = mmin; m < mmax; ++m)
+                    {
+                        int s0 = 2 * step * m, s1 = s0 + step;
+                        Allocator& a0 = allocators[s0];
+                        Allocator& a1 = allocators[s1];
+                        for (int e = a0.next; e < a0.end; ++e)
+                        {
+                            a0.freeEdges.push_back(e);
+                        }
+                        a0.freeEdges.insert(a0.freeEdges.end(),
+                            a1.freeEdges.begin(), a1.freeEdges.end());
+                        a0.next = a1.next;
+                        a0.end = a1.end;
+                        hulls[s0] = Merge(hulls[s0], hulls[s1], a0);
+                    }
+                });
+        }
+    }
+    else
+    {
+        hulls[0] = Triangulate(0, mNumUniqueVertices, allocators[0]);
+    }
+
+    // The face to the right of the counterclockwise hull edge ldo is the
+    // unbounded face.
+    ResolveCocircular(hulls[0].ldo, threadPool);
+    BuildOutput(hulls[0].ldo);
+    return true;
+}
+
+template <typename InputType, typename ComputeType> inline
+InputType ParallelDelaunay2<InputType, ComputeType>::GetEpsilon() const
+{
+    return mEpsilon;
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::GetDimension() const
+{
+    return mDimension;
+}
+
+template <typename InputType, typename ComputeType> inline
+Line2<InputType> const& ParallelDelaunay2<InputType, ComputeType>::GetLine() const
+{
+    return mLine;
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::GetNumVertices() const
+{
+    return mNumVertices;
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::GetNumUniqueVertices() const
+{
+    return mNumUniqueVertices;
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::GetNumTriangles() const
+{
+    return mNumTriangles;
+}
+
+template <typename InputType, typename ComputeType> inline
+Vector2<InputType> const* ParallelDelaunay2<InputType, ComputeType>::GetVertices() const
+{
+    return mVertices;
+}
+
+template <typename InputType, typename ComputeType> inline
+PrimalQuery2<ComputeType> const& ParallelDelaunay2<InputType, ComputeType>::GetQuery() const
+{
+    return mQuery;
+}
+
+template <typename InputType, typename ComputeType> inline
+std::vector<int> const& ParallelDelaunay2<InputType, ComputeType>::GetIndices() const
+{
+    return mIndices;
+}
+
+template <typename InputType, typename ComputeType> inline
+std::vector<int> const& ParallelDelaunay2<InputType, ComputeType>::GetAdjacencies() const
+{
+    return mAdjacencies;
+}
+
+template <typename InputType, typename ComputeType> inline
+std::vector<int> const& ParallelDelaunay2<InputType, ComputeType>::GetDuplicates() const
+{
+    return mDuplicates;
+}
+
+template <typename InputType, typename ComputeType>
+bool ParallelDelaunay2<InputType, ComputeType>::GetHull(std::vector<int>& hull) const
+{
+    if (mDimension == 2)
+    {
+        // Count the number of edges that are not shared by two triangles.
+        int numEdges = 0;
+        for (auto adj : mAdjacencies)
+        {
+            if (adj == -1)
+            {
+                ++numEdges;
+            }
+        }
+
+        if (numEdges > 0)
+        {
+            // Enumerate the edges.
+            hull.resize(2 * numEdges);
+            int current = 0, i = 0;
+            for (auto adj : mAdjacencies)
+            {
+                if (adj == -1)
+                {
+                    int tri = i / 3, j = i % 3;
+                    hull[current++] = mIndices[3 * tri + j];
+                    hull[current++] = mIndices[3 * tri + ((j + 1) % 3)];
+                }
+                ++i;
+            }
+            return true;
+        }
+        else
+        {
+            LogError("Unexpected.  There must be at least one triangle.");
+        }
+    }
+    else
+    {
+        LogError("The dimension must be 2.");
+    }
+    return false;
+}
+
+template <typename InputType, typename ComputeType>
+bool ParallelDelaunay2<InputType, ComputeType>::GetIndices(int i, std::array<int, 3>& indices) const
+{
+    if (mDimension == 2)
+    {
+        int numTriangles = static_cast<int>(mIndices.size() / 3);
+        if (0 <= i && i < numTriangles)
+        {
+            indices[0] = mIndices[3 * i];
+            indices[1] = mIndices[3 * i + 1];
+            indices[2] = mIndices[3 * i + 2];
+            return true;
+        }
+    }
+    else
+    {
+        LogError("The dimension must be 2.");
+    }
+    return false;
+}
+
+template <typename InputType, typename ComputeType>
+bool ParallelDelaunay2<InputType, ComputeType>::GetAdjacencies(int i, std::array<int, 3>& adjacencies) const
+{
+    if (mDimension == 2)
+    {
+        int numTriangles = static_cast<int>(mIndices.size() / 3);
+        if (0 <= i && i < numTriangles)
+        {
+            adjacencies[0] = mAdjacencies[3 * i];
+            adjacencies[1] = mAdjacencies[3 * i + 1];
+            adjacencies[2] = mAdjacencies[3 * i + 2];
+            return true;
+        }
+    }
+    else
+    {
+        LogError("The dimension must be 2.");
+    }
+    return false;
+}
+
+template <typename InputType, typename ComputeType>
+void ParallelDelaunay2<InputType, ComputeType>::SortVertices(
+    std::shared_ptr<ThreadPool> const& threadPool,
+    std::vector<int>& sorted) const
+{
+    Vector2<InputType> const* vertices = mVertices;
+    auto lessThan = [vertices](int i0, int i1)
+    {
+        if (vertices[i0] < vertices[i1]) { return true; }
+        if (vertices[i1] < vertices[i0]) { return false; }
+        return i0 < i1;
+    };
+
+    for (int i = 0; i < mNumVertices; ++i)
+    {
+        sorted[i] = i;
+    }
+
+    // Sort blocks of the array in multiple threads and then merge adjacent
+    // blocks in multiple threads.
+    unsigned int numThreads = (threadPool ? threadPool->GetNumThreads() : 1);
+    int numBlocks = 1;
+    while (2 * static_cast<unsigned int>(numBlocks) <= numThreads
+        && 2 * 1024 * numBlocks <= mNumVertices)
+    {
+        numBlocks *= 2;
+    }
+
+    std::vector<int> blockMin(numBlocks + 1);
+    for (int b = 0; b <= numBlocks; ++b)
+    {
+        blockMin[b] = static_cast<int>(
+            (static_cast<int64_t>(mNumVertices) * b) / numBlocks);
+    }
+
+    if (numBlocks > 1)
+    {
+        threadPool->ParallelFor(0, numBlocks, 1,
+            [&sorted, &blockMin, &lessThan](int bmin, int bmax)
+            {
+                for (int b = bmin; b < bmax; ++b)
+                {
+                    std::sort(sorted.begin() + blockMin[b],
+                        sorted.begin() + blockMin[b + 1], lessThan);
+                }
+            });
+
+        for (int step = 1; step < numBlocks; step *= 2)
+        {
+            int numMerges = numBlocks / (2 * step);
+            threadPool->ParallelFor(0, numMerges, 1,
+                [step, &sorted, &blockMin, &lessThan](int mmin, int mmax)
+                {
+                    for (int m = mmin; m < mmax; ++m)
+                    {
+                        int b0 = 2 * step * m;
+                        std::inplace_merge(sorted.begin() + blockMin[b0],
+                            sorted.begin() + blockMin[b0 + step],
+                            sorted.begin() + blockMin[b0 + 2 * step], lessThan);
+                    }
+                });
+        }
+    }
+    else
+    {
+        std::sort(sorted.begin(), sorted.end(), lessThan);
+    }
+}
+
+template <typename InputType, typename ComputeType>
+typename ParallelDelaunay2<InputType, ComputeType>::Hull
+ParallelDelaunay2<InputType, ComputeType>::Triangulate(int imin, int imax,
+    Allocator& allocator)
+{
+    int const numPoints = imax - imin;
+    if (numPoints == 2)
+    {
+        int a = MakeEdge(mSorted[imin], mSorted[imin + 1], allocator);
+        return Hull{ a, Sym(a) };
+    }
+
+    if (numPoints == 3)
+    {
+        int v0 = mSorted[imin], v1 = mSorted[imin + 1], v2 = mSorted[imin + 2];
+        int a = MakeEdge(v0, v1, allocator);
+        int b = MakeEdge(v1, v2, allocator);
+        Splice(Sym(a), b);
+
+        if (CCW(v0, v1, v2))
+        {
+            Connect(b, a, allocator);
+            return Hull{ a, Sym(b) };
+        }
+        else if (CCW(v0, v2, v1))
+        {
+            int c = Connect(b, a, allocator);
+            return Hull{ Sym(c), c };
+        }
+        else
+        {
+            // The points are collinear.
+            return Hull{ a, Sym(b) };
+        }
+    }
+
+    int imid = imin + numPoints / 2;
+    Hull left = Triangulate(imin, imid, allocator);
+    Hull right = Triangulate(imid, imax, allocator);
+    return Merge(left, right, allocator);
+}
+
+template <typename InputType, typename ComputeType>
+typename ParallelDelaunay2<InputType, ComputeType>::Hull
+ParallelDelaunay2<InputType, ComputeType>::Merge(Hull const& left,
+    Hull const& right, Allocator& allocator)
+{
+    int ldo = left.ldo, ldi = left.rdo, rdi = right.ldo, rdo = right.rdo;
+
+    // Compute the lower common tangent of the two hulls.
+    for (;;)
+    {
+        if (LeftOf(Org(rdi), ldi))
+        {
+            ldi = Lnext(ldi);
+        }
+        else if (RightOf(Org(ldi), rdi))
+        {
+            rdi = Rprev(rdi);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // Create the first cross edge, basel, from Org(rdi) to Org(ldi).
+    int basel = Connect(Sym(rdi), ldi, allocator);
+    if (Org(ldi) == Org(ldo))
+    {
+        ldo = Sym(basel);
+    }
+    if (Org(rdi) == Org(rdo))
+    {
+        rdo = basel;
+    }
+
+    // Move up the seam between the triangulations.  A candidate edge is
+    // valid when its destination is above basel.
+    for (;;)
+    {
+        // Locate the first left candidate, deleting the edges of the left
+        // triangulation that fail the circle test.
+        int lcand = Onext(Sym(basel));
+        bool lvalid = RightOf(Dest(lcand), basel);
+        if (lvalid)
+        {
+            while (InCircle(Dest(basel), Org(basel), Dest(lcand), Dest(Onext(lcand))))
+            {
+                int next = Onext(lcand);
+                DeleteEdge(lcand, allocator);
+                lcand = next;
+            }
+        }
+
+        // Symmetrically, locate the first right candidate.
+        int rcand = Oprev(basel);
+        bool rvalid = RightOf(Dest(rcand), basel);
+        if (rvalid)
+        {
+            while (InCircle(Dest(basel), Org(basel), Dest(rcand), Dest(Oprev(rcand))))
+            {
+                int next = Oprev(rcand);
+                DeleteEdge(rcand, allocator);
+                rcand = next;
+            }
+        }
+
+        if (!lvalid && !rvalid)
+        {
+            // basel is the upper common tangent.
+            break;
+        }
+
+        // Connect to the candidate whose circumcircle with basel does not
+        // contain the other candidate.
+        if (!lvalid || (rvalid && InCircle(Dest(lcand), Org(lcand), Org(rcand), Dest(rcand))))
+        {
+            basel = Connect(rcand, Sym(basel), allocator);
+        }
+        else
+        {
+            basel = Connect(Sym(basel), Sym(lcand), allocator);
+        }
+    }
+
+    return Hull{ ldo, rdo };
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Sym(int e) const
+{
+    return e ^ 1;
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Org(int e) const
+{
+    return mOrigin[e];
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Dest(int e) const
+{
+    return mOrigin[e ^ 1];
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Onext(int e) const
+{
+    return mONext[e];
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Oprev(int e) const
+{
+    return mOPrev[e];
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Lnext(int e) const
+{
+    // The next counterclockwise edge around the left face.
+    return mOPrev[e ^ 1];
+}
+
+template <typename InputType, typename ComputeType> inline
+int ParallelDelaunay2<InputType, ComputeType>::Rprev(int e) const
+{
+    // The previous edge around the right face.
+    return mONext[e ^ 1];
+}
+
+template <typename InputType, typename ComputeType>
+int ParallelDelaunay2<InputType, ComputeType>::MakeEdge(int v0, int v1,
+    Allocator& allocator)
+{
+    int k;
+    if (allocator.freeEdges.size() > 0)
+    {
+        k = allocator.freeEdges.back();
+        allocator.freeEdges.pop_back();
+    }
+    else
+    {
+        k = allocator.next++;
+        LogAssert(k < allocator.end, "Edge allocation exceeded its range.");
+    }
+
+    int e = 2 * k, eSym = e + 1;
+    mOrigin[e] = v0;
+    mOrigin[eSym] = v1;
+    mONext[e] = e;
+    mOPrev[e] = e;
+    mONext[eSym] = eSym;
+    mOPrev[eSym] = eSym;
+    return e;
+}
+
+template <typename InputType, typename ComputeType>
+void ParallelDelaunay2<InputType, ComputeType>::Splice(int a, int b)
+{
+    // Exchange the successors of a and b in their Onext rings.  This
+    // merges the rings when they are different and splits the ring when
+    // they are the same.
+    int aNext = mONext[a], bNext = mONext[b];
+    mONext[a] = bNext;
+    mONext[b] = aNext;
+    mOPrev[bNext] = a;
+    mOPrev[aNext] = b;
+}
+
+template <typename InputType, typename ComputeType>
+int ParallelDelaunay2<InputType, ComputeType>::Connect(int a, int b,
+    Allocator& allocator)
+{
+    // Add an edge from Dest(a) to Org(b) so that the left faces of a, the
+    // new edge and b are the same.
+    int e = MakeEdge(Dest(a), Org(b), allocator);
+    Splice(e, Lnext(a));
+    Splice(Sym(e), b);
+    return e;
+}
+
+template <typename InputType, typename ComputeType>
+void ParallelDelaunay2<InputType, ComputeType>::DeleteEdge(int e,
+    Allocator& allocator)
+{
+    int eSym = Sym(e);
+    Splice(e, Oprev(e));
+    Splice(eSym, Oprev(eSym));
+    mOrigin[e] = -1;
+    mOrigin[eSym] = -1;
+    allocator.freeEdges.push_back(e / 2);
+}
+
+template <typename InputType, typename ComputeType>
+void ParallelDelaunay2<InputType, ComputeType>::Flip(int e)
+{
+    // The edge is detached from its origin and destination and then
+    // attached to the third vertices of its left and right triangles.
+    int a = Oprev(e), b = Oprev(Sym(e));
+    Splice(e, a);
+    Splice(Sym(e), b);
+    Splice(e, Lnext(a));
+    Splice(Sym(e), Lnext(b));
+    mOrigin[e] = Dest(a);
+    mOrigin[Sym(e)] = Dest(b);
+}
+
+template <typename InputType, typename ComputeType>
+void ParallelDelaunay2<InputType, ComputeType>::ResolveCocircular(int outer,
+    std::shared_ptr<ThreadPool> const& threadPool)
+{
+    // Mark the half-edges of the unbounded face.  The flips do not change
+    // the hull edges.
+    int const numHalfEdges = static_cast<int>(mOrigin.size());
+    std::vector<char> isOuter(numHalfEdges, 0);
+    int e = Sym(outer);
+    do
+    {
+        isOuter[e] = 1;
+        e = Lnext(e);
+    }
+    while (e != Sym(outer));
+
+    // Find the edges to flip, which requires a circle test only for the
+    // quadrilaterals whose smallest vertex index is not on the diagonal.
+    int const numEdges = numHalfEdges / 2;
+    std::vector<char> needsFlip(numEdges, 0);
+    auto findEdges = [this, &isOuter, &needsFlip](int kmin, int kmax)
+    {
+        for (int k = kmin; k < kmax; ++k)
+        {
+            needsFlip[k] = (NeedsFlip(2 * k, isOuter) ? 1 : 0);
+        }
+    };
+    if (threadPool)
+    {
+        threadPool->ParallelFor(0, numEdges, 0, findEdges);
+    }
+    else
+    {
+        findEdges(0, numEdges);
+    }
+
+    // A flip can make the edges of the quadrilateral need flips.  Each flip
+    // lowers the lifted triangulation of the perturbed points, so the flips
+    // terminate.
+    std::vector<int> stack;
+    for (int k = 0; k < numEdges; ++k)
+    {
+        if (needsFlip[k])
+        {
+            stack.push_back(2 * k);
+        }
+    }
+    while (stack.size() > 0)
+    {
+        e = stack.back();
+        stack.pop_back();
+        if (NeedsFlip(e, isOuter))
+        {
+            Flip(e);
+            stack.push_back(Lnext(e));
+            stack.push_back(Lnext(Lnext(e)));
+            stack.push_back(Lnext(Sym(e)));
+            stack.push_back(Lnext(Lnext(Sym(e))));
+        }
+    }
+}
+
+template <typename InputType, typename ComputeType>
+bool ParallelDelaunay2<InputType, ComputeType>::NeedsFlip(int e,
+    std::vector<char> const& isOuter) const
+{
+    if (mOrigin[e] < 0 || isOuter[e] || isOuter[Sym(e)])
+    {
+        return false;
+    }
+
+    // The triangles <v0,v1,v2> and <v1,v0,v3> are counterclockwise.
+    int v0 = Org(e), v1 = Dest(e);
+    int v2 = Dest(Lnext(e)), v3 = Dest(Lnext(Sym(e)));
+    return std::min(v2, v3) < std::min(v0, v1)
+        && mQuery.ToCircumcircle(v3, v0, v1, v2) == 0;
+}
+
+template <typename InputType, typename ComputeType> inline
+bool ParallelDelaunay2<InputType, ComputeType>::CCW(int v0, int v1, int v2) const
+{
+    return mQuery.ToLine(v2, v0, v1) < 0;
+}
+
+template <typename InputType, typename ComputeType> inline
+bool ParallelDelaunay2<InputType, ComputeType>::RightOf(int v, int e) const
+{
+    return CCW(v, Dest(e), Org(e));
+}
+
+template <typename InputType, typename ComputeType> inline
+bool ParallelDelaunay2<InputType, ComputeType>::LeftOf(int v, int e) const
+{
+    return CCW(v, Org(e), Dest(e));
+}
+
+template <typename InputType, typename ComputeType> inline
+bool ParallelDelaunay2<InputType, ComputeType>::InCircle(int v0, int v1, int v2, int v3) const
+{
+    return mQuery.ToCircumcircle(v3, v0, v1, v2) < 0;
+}
+
+template <typename InputType, typename ComputeType>
+void ParallelDelaunay2<InputType, ComputeType>::BuildOutput(int outer)
+{
+    // Mark the half-edges of the unbounded face, which is the left face of
+    // Sym(outer).  Every other face is a triangle.  The triangle of a
+    // half-edge is its left face.
+    int const numHalfEdges = static_cast<int>(mOrigin.size());
+    std::vector<int> face(numHalfEdges, -1);
+    int e = Sym(outer);
+    do
+    {
+        face[e] = -2;
+        e = Lnext(e);
+    }
+    while (e != Sym(outer));
+
+    // Enumerate the triangles with the smallest vertex index first, which
+    // is the vertex order of TriangleKey<true>.
+    std::vector<std::array<int, 3>> triangles;
+    triangles.reserve(2 * static_cast<size_t>(mNumUniqueVertices));
+    for (e = 0; e < numHalfEdges; ++e)
+    {
+        if (mOrigin[e] >= 0 && face[e] == -1)
+        {
+            int e1 = Lnext(e), e2 = Lnext(e1);
+            if (Org(e) < Org(e1) && Org(e) < Org(e2))
+            {
+                triangles.push_back({ { e, e1, e2 } });
+            }
+        }
+    }
+    mNumTriangles = static_cast<int>(triangles.size());
+
+    // Sort the triangles in the order of their TriangleKey<true> values,
+    // which compare V[2] first, then V[1], then V[0].  A counting sort on
+    // V[2] is followed by sorting each (small) bucket.
+    std::vector<int> bucket(mNumVertices + 1, 0);
+    for (auto const& tri : triangles)
+    {
+        ++bucket[Org(tri[2]) + 1];
+    }
+    for (int v = 0; v < mNumVertices; ++v)
+    {
+        bucket[v + 1] += bucket[v];
+    }
+    std::vector<int> order(mNumTriangles);
+    std::vector<int> position(bucket.begin(), bucket.end() - 1);
+    for (int t = 0; t < mNumTriangles; ++t)
+    {
+        order[position[Org(triangles[t][2])]++] = t;
+    }
+    for (int v = 0; v < mNumVertices; ++v)
+    {
+        if (bucket[v + 1] - bucket[v] > 1)
+        {
+            std::sort(order.begin() + bucket[v], order.begin() + bucket[v + 1],
+                [this, &triangles](int t0, int t1)
+                {
+                    int a1 = Org(triangles[t0][1]), b1 = Org(triangles[t1][1]);
+                    if (a1 != b1)
+                    {
+                        return a1 < b1;
+                    }
+                    return Org(triangles[t0][0]) < Org(triangles[t1][0]);
+                });
+        }
+    }
+
+    // Put Delaunay triangles into an array (vertices and adjacency info).
+    for (int t = 0; t < mNumTriangles; ++t)
+    {
+        auto const& tri = triangles[order[t]];
+        for (int j = 0; j < 3; ++j)
+        {
+            face[tri[j]] = t;
+        }
+    }
+    mIndices.resize(3 * static_cast<size_t>(mNumTriangles));
+    mAdjacencies.resize(3 * static_cast<size_t>(mNumTriangles));
+    for (int t = 0, i = 0; t < mNumTriangles; ++t)
+    {
+        auto const& tri = triangles[order[t]];
+        for (int j = 0; j < 3; ++j, ++i)
+        {
+            mIndices[i] = Org(tri[j]);
+            int adj = face[Sym(tri[j])];
+            mAdjacencies[i] = (adj >= 0 ? adj : -1);
+        }
+    }
+}
+
+}
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.1 (2026/10/18)
 
 #pragma once
 
 #include <Mathematics/GteVector2.h>
+#include <limits>
 
 // Queries about the relation of a point to various geometric objects.  The
 // choices for N when using UIntegerFP32<N> for either BSNumber of BSRational
@@ -15,6 +16,29 @@
 // N-values are worst case scenarios. Your specific input data might require
 // much smaller N, in which case you can modify PrecisionCalculator to use the
 // BSPrecision(int32_t,int32_t,int32_t,bool) constructors.
+//
+// When Real is an exact arithmetic type (BSNumber or BSRational) and the
+// vertices were converted from float or double inputs, most of the queries
+// can be decided by a floating-point filter.  The determinants are computed
+// in double precision together with an error bound (Shewchuk's "A" bounds
+// from "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates").  If the magnitude of the determinant exceeds the
+// bound, its sign is the correct sign; otherwise, the query falls back to
+// the Real-valued computation.  Call SetFilter with the double-precision
+// copies of the vertices to enable the filter.  The filter assumes that
+// the double-precision computations do not underflow.
+
+// Uncomment this to collect statistics on how many filtered queries were
+// decided by the double-precision filter and how many fell back to the
+// Real-valued computation.  The counters are per query object and are
+// updated atomically, so they are valid when the queries are executed by
+// multiple threads.
+//
+//#define GTE_COLLECT_PRIMALQUERY_STATISTICS
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+#include <atomic>
+#endif
 
 namespace gte
 {
@@ -34,6 +58,24 @@ public:
     inline int GetNumVertices() const;
     inline Vector2<Real> const* GetVertices() const;
 
+    // Enable the floating-point filter by passing an array of numVertices
+    // elements, where filterVertices[i] is the exact double-precision
+    // representation of vertices[i].  Pass nullptr to disable the filter.
+    // Only the queries whose point P is specified by an index i are
+    // filtered; a 'test' point of type Real is not necessarily representable
+    // as a double.
+    inline void SetFilter(Vector2<double> const* filterVertices);
+    inline Vector2<double> const* GetFilter() const;
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    // The number of filtered queries and the number of those for which the
+    // filter was inconclusive, in which case the query was computed using
+    // Real arithmetic.
+    inline size_t GetNumFilterQueries() const;
+    inline size_t GetNumFilterFailures() const;
+    inline void ResetFilterStatistics();
+#endif
+
     // In the following, point P refers to vertices[i] or 'test' and Vi refers
     // to vertices[vi].
 
@@ -144,8 +186,50 @@ public:
     OrderType ToLineExtended(Vector2<Real> const& P, Vector2<Real> const& Q0, Vector2<Real> const& Q1) const;
 
 private:
+    // The filtered determinants.  The functions return the sign (+1 or -1)
+    // of the determinant when the floating-point evaluation certifies it.
+    // The return value is 0 when the sign is uncertain, in which case the
+    // caller must evaluate the query using Real arithmetic.
+    int FilterToLine(int i, int v0, int v1) const;
+    int FilterToCircumcircle(int i, int v0, int v1, int v2) const;
+
     int mNumVertices;
     Vector2<Real> const* mVertices;
+    Vector2<double> const* mFilterVertices;
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    struct FilterStatistics
+    {
+        FilterStatistics() : numQueries(0), numFailures(0) {}
+
+        FilterStatistics(FilterStatistics const& other)
+            :
+            numQueries(other.numQueries.load()),
+            numFailures(other.numFailures.load())
+        {
+        }
+
+        FilterStatistics& operator=(FilterStatistics const& other)
+        {
+            numQueries = other.numQueries.load();
+            numFailures = other.numFailures.load();
+            return *this;
+        }
+
+        void Update(int sign)
+        {
+            numQueries.fetch_add(1, std::memory_order_relaxed);
+            if (sign == 0)
+            {
+                numFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<size_t> numQueries, numFailures;
+    };
+
+    mutable FilterStatistics mFilterStatistics;
+#endif
 };
 
 
@@ -153,7 +237,8 @@ template <typename Real>
 PrimalQuery2<Real>::PrimalQuery2()
     :
     mNumVertices(0),
-    mVertices(nullptr)
+    mVertices(nullptr),
+    mFilterVertices(nullptr)
 {
 }
 
@@ -162,7 +247,8 @@ PrimalQuery2<Real>::PrimalQuery2(int numVertices,
     Vector2<Real> const* vertices)
     :
     mNumVertices(numVertices),
-    mVertices(vertices)
+    mVertices(vertices),
+    mFilterVertices(nullptr)
 {
 }
 
@@ -171,6 +257,7 @@ void PrimalQuery2<Real>::Set(int numVertices, Vector2<Real> const* vertices)
 {
     mNumVertices = numVertices;
     mVertices = vertices;
+    mFilterVertices = nullptr;
 }
 
 template <typename Real> inline
@@ -185,9 +272,50 @@ Vector2<Real> const* PrimalQuery2<Real>::GetVertices() const
     return mVertices;
 }
 
+template <typename Real> inline
+void PrimalQuery2<Real>::SetFilter(Vector2<double> const* filterVertices)
+{
+    mFilterVertices = filterVertices;
+}
+
+template <typename Real> inline
+Vector2<double> const* PrimalQuery2<Real>::GetFilter() const
+{
+    return mFilterVertices;
+}
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+template <typename Real> inline
+size_t PrimalQuery2<Real>::GetNumFilterQueries() const
+{
+    return mFilterStatistics.numQueries;
+}
+
+template <typename Real> inline
+size_t PrimalQuery2<Real>::GetNumFilterFailures() const
+{
+    return mFilterStatistics.numFailures;
+}
+
+template <typename Real> inline
+void PrimalQuery2<Real>::ResetFilterStatistics()
+{
+    mFilterStatistics.numQueries = 0;
+    mFilterStatistics.numFailures = 0;
+}
+#endif
+
 template <typename Real>
 int PrimalQuery2<Real>::ToLine(int i, int v0, int v1) const
 {
+    if (mFilterVertices)
+    {
+        int sign = FilterToLine(i, v0, v1);
+        if (sign != 0)
+        {
+            return sign;
+        }
+    }
     return ToLine(mVertices[i], v0, v1);
 }
 
@@ -212,6 +340,15 @@ int PrimalQuery2<Real>::ToLine(Vector2<Real> const& test, int v0, int v1) const
 template <typename Real>
 int PrimalQuery2<Real>::ToLine(int i, int v0, int v1, int& order) const
 {
+    if (mFilterVertices)
+    {
+        int sign = FilterToLine(i, v0, v1);
+        if (sign != 0)
+        {
+            order = 3 * sign;
+            return sign;
+        }
+    }
     return ToLine(mVertices[i], v0, v1, order);
 }
 
@@ -278,7 +415,31 @@ int PrimalQuery2<Real>::ToLine(Vector2<Real> const& test, int v0, int v1, int& o
 template <typename Real>
 int PrimalQuery2<Real>::ToTriangle(int i, int v0, int v1, int v2) const
 {
-    return ToTriangle(mVertices[i], v0, v1, v2);
+    if (!mFilterVertices)
+    {
+        return ToTriangle(mVertices[i], v0, v1, v2);
+    }
+
+    // Use the index-based ToLine queries so that they are filtered.
+    int sign0 = ToLine(i, v1, v2);
+    if (sign0 > 0)
+    {
+        return +1;
+    }
+
+    int sign1 = ToLine(i, v0, v2);
+    if (sign1 < 0)
+    {
+        return +1;
+    }
+
+    int sign2 = ToLine(i, v0, v1);
+    if (sign2 > 0)
+    {
+        return +1;
+    }
+
+    return ((sign0 && sign1 && sign2) ? -1 : 0);
 }
 
 template <typename Real>
@@ -308,6 +469,15 @@ int PrimalQuery2<Real>::ToTriangle(Vector2<Real> const& test, int v0, int v1, in
 template <typename Real>
 int PrimalQuery2<Real>::ToCircumcircle(int i, int v0, int v1, int v2) const
 {
+    if (mFilterVertices)
+    {
+        // The determinant is negative when P is outside the circumcircle.
+        int sign = FilterToCircumcircle(i, v0, v1, v2);
+        if (sign != 0)
+        {
+            return -sign;
+        }
+    }
     return ToCircumcircle(mVertices[i], v0, v1, v2);
 }
 
@@ -434,4 +604,86 @@ typename PrimalQuery2<Real>::OrderType PrimalQuery2<Real>::ToLineExtended(
 }
 
 
+template <typename Real>
+int PrimalQuery2<Real>::FilterToLine(int i, int v0, int v1) const
+{
+    // The determinant is the same as that of ToLine, evaluated in the order
+    // of Shewchuk's orient2d with the error bound ccwerrboundA.
+    double const epsilon = 0.5 * std::numeric_limits<double>::epsilon();
+    double const errorBoundCoefficient = (3.0 + 16.0 * epsilon) * epsilon;
+
+    Vector2<double> const& test = mFilterVertices[i];
+    Vector2<double> const& vec0 = mFilterVertices[v0];
+    Vector2<double> const& vec1 = mFilterVertices[v1];
+
+    double x0 = test[0] - vec0[0];
+    double y0 = test[1] - vec0[1];
+    double x1 = vec1[0] - vec0[0];
+    double y1 = vec1[1] - vec0[1];
+    double x0y1 = x0 * y1;
+    double x1y0 = x1 * y0;
+    double det = x0y1 - x1y0;
+    double permanent = std::fabs(x0y1) + std::fabs(x1y0);
+    double errorBound = errorBoundCoefficient * permanent;
+
+    // The comparisons are false when the computations overflow (infinities
+    // or NaNs), so the query falls back to Real arithmetic.
+    int sign = (det > errorBound ? +1 : (-det > errorBound ? -1 : 0));
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    mFilterStatistics.Update(sign);
+#endif
+    return sign;
+}
+
+template <typename Real>
+int PrimalQuery2<Real>::FilterToCircumcircle(int i, int v0, int v1, int v2) const
+{
+    // The determinant of ToCircumcircle uses z = |V|^2 - |P|^2, which
+    // differs from the lifted value |V-P|^2 by a linear combination of the
+    // x- and y-columns; the determinants are therefore equal.  The lifted
+    // form is evaluated in the order of Shewchuk's incircle with the error
+    // bound iccerrboundA.
+    double const epsilon = 0.5 * std::numeric_limits<double>::epsilon();
+    double const errorBoundCoefficient = (10.0 + 96.0 * epsilon) * epsilon;
+
+    Vector2<double> const& test = mFilterVertices[i];
+    Vector2<double> const& vec0 = mFilterVertices[v0];
+    Vector2<double> const& vec1 = mFilterVertices[v1];
+    Vector2<double> const& vec2 = mFilterVertices[v2];
+
+    double x0 = vec0[0] - test[0];
+    double y0 = vec0[1] - test[1];
+    double x1 = vec1[0] - test[0];
+    double y1 = vec1[1] - test[1];
+    double x2 = vec2[0] - test[0];
+    double y2 = vec2[1] - test[1];
+
+    double x1y2 = x1 * y2;
+    double x2y1 = x2 * y1;
+    double lift0 = x0 * x0 + y0 * y0;
+
+    double x2y0 = x2 * y0;
+    double x0y2 = x0 * y2;
+    double lift1 = x1 * x1 + y1 * y1;
+
+    double x0y1 = x0 * y1;
+    double x1y0 = x1 * y0;
+    double lift2 = x2 * x2 + y2 * y2;
+
+    double det = lift0 * (x1y2 - x2y1) + lift1 * (x2y0 - x0y2)
+        + lift2 * (x0y1 - x1y0);
+
+    double permanent = (std::fabs(x1y2) + std::fabs(x2y1)) * lift0
+        + (std::fabs(x2y0) + std::fabs(x0y2)) * lift1
+        + (std::fabs(x0y1) + std::fabs(x1y0)) * lift2;
+    double errorBound = errorBoundCoefficient * permanent;
+
+    int sign = (det > errorBound ? +1 : (-det > errorBound ? -1 : 0));
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    mFilterStatistics.Update(sign);
+#endif
+    return sign;
+}
+
+
 }
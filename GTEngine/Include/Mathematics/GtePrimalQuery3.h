@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.0.1 (2026/10/18)
 
 #pragma once
 
 #include <Mathematics/GteVector3.h>
+#include <limits>
 
 // Queries about the relation of a point to various geometric objects.  The
 // choices for N when using UIntegerFP32<N> for either BSNumber of BSRational
@@ -15,6 +16,20 @@
 // N-values are worst case scenarios. Your specific input data might require
 // much smaller N, in which case you can modify PrecisionCalculator to use the
 // BSPrecision(int32_t,int32_t,int32_t,bool) constructors.
+//
+// The floating-point filter for exact Real types is the same as that of
+// PrimalQuery2; see the comments in GtePrimalQuery2.h.  The filtered
+// determinants use Shewchuk's orient3d and insphere error bounds.
+
+// Uncomment this to collect statistics on how many filtered queries were
+// decided by the double-precision filter and how many fell back to the
+// Real-valued computation.
+//
+//#define GTE_COLLECT_PRIMALQUERY_STATISTICS
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+#include <atomic>
+#endif
 
 namespace gte
 {
@@ -34,6 +49,23 @@ public:
     inline int GetNumVertices() const;
     inline Vector3<Real> const* GetVertices() const;
 
+    // Enable the floating-point filter by passing an array of numVertices
+    // elements, where filterVertices[i] is the exact double-precision
+    // representation of vertices[i].  Pass nullptr to disable the filter.
+    // Only the queries whose point P is specified by an index i are
+    // filtered.
+    inline void SetFilter(Vector3<double> const* filterVertices);
+    inline Vector3<double> const* GetFilter() const;
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    // The number of filtered queries and the number of those for which the
+    // filter was inconclusive, in which case the query was computed using
+    // Real arithmetic.
+    inline size_t GetNumFilterQueries() const;
+    inline size_t GetNumFilterFailures() const;
+    inline void ResetFilterStatistics();
+#endif
+
     // In the following, point P refers to vertices[i] or 'test' and Vi refers
     // to vertices[vi].
 
@@ -88,8 +120,50 @@ public:
     int ToCircumsphere(Vector3<Real> const& test, int v0, int v1, int v2, int v3) const;
 
 private:
+    // The filtered determinants.  The functions return the sign (+1 or -1)
+    // of the determinant when the floating-point evaluation certifies it.
+    // The return value is 0 when the sign is uncertain, in which case the
+    // caller must evaluate the query using Real arithmetic.
+    int FilterToPlane(int i, int v0, int v1, int v2) const;
+    int FilterToCircumsphere(int i, int v0, int v1, int v2, int v3) const;
+
     int mNumVertices;
     Vector3<Real> const* mVertices;
+    Vector3<double> const* mFilterVertices;
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    struct FilterStatistics
+    {
+        FilterStatistics() : numQueries(0), numFailures(0) {}
+
+        FilterStatistics(FilterStatistics const& other)
+            :
+            numQueries(other.numQueries.load()),
+            numFailures(other.numFailures.load())
+        {
+        }
+
+        FilterStatistics& operator=(FilterStatistics const& other)
+        {
+            numQueries = other.numQueries.load();
+            numFailures = other.numFailures.load();
+            return *this;
+        }
+
+        void Update(int sign)
+        {
+            numQueries.fetch_add(1, std::memory_order_relaxed);
+            if (sign == 0)
+            {
+                numFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<size_t> numQueries, numFailures;
+    };
+
+    mutable FilterStatistics mFilterStatistics;
+#endif
 };
 
 
@@ -97,7 +171,8 @@ template <typename Real>
 PrimalQuery3<Real>::PrimalQuery3()
     :
     mNumVertices(0),
-    mVertices(nullptr)
+    mVertices(nullptr),
+    mFilterVertices(nullptr)
 {
 }
 
@@ -106,7 +181,8 @@ PrimalQuery3<Real>::PrimalQuery3(int numVertices,
     Vector3<Real> const* vertices)
     :
     mNumVertices(numVertices),
-    mVertices(vertices)
+    mVertices(vertices),
+    mFilterVertices(nullptr)
 {
 }
 
@@ -115,6 +191,7 @@ void PrimalQuery3<Real>::Set(int numVertices, Vector3<Real> const* vertices)
 {
     mNumVertices = numVertices;
     mVertices = vertices;
+    mFilterVertices = nullptr;
 }
 
 template <typename Real> inline
@@ -129,9 +206,50 @@ Vector3<Real> const* PrimalQuery3<Real>::GetVertices() const
     return mVertices;
 }
 
+template <typename Real> inline
+void PrimalQuery3<Real>::SetFilter(Vector3<double> const* filterVertices)
+{
+    mFilterVertices = filterVertices;
+}
+
+template <typename Real> inline
+Vector3<double> const* PrimalQuery3<Real>::GetFilter() const
+{
+    return mFilterVertices;
+}
+
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+template <typename Real> inline
+size_t PrimalQuery3<Real>::GetNumFilterQueries() const
+{
+    return mFilterStatistics.numQueries;
+}
+
+template <typename Real> inline
+size_t PrimalQuery3<Real>::GetNumFilterFailures() const
+{
+    return mFilterStatistics.numFailures;
+}
+
+template <typename Real> inline
+void PrimalQuery3<Real>::ResetFilterStatistics()
+{
+    mFilterStatistics.numQueries = 0;
+    mFilterStatistics.numFailures = 0;
+}
+#endif
+
 template <typename Real>
 int PrimalQuery3<Real>::ToPlane(int i, int v0, int v1, int v2) const
 {
+    if (mFilterVertices)
+    {
+        int sign = FilterToPlane(i, v0, v1, v2);
+        if (sign != 0)
+        {
+            return sign;
+        }
+    }
     return ToPlane(mVertices[i], v0, v1, v2);
 }
 
@@ -175,7 +293,37 @@ template <typename Real>
 int PrimalQuery3<Real>::ToTetrahedron(int i, int v0, int v1, int v2, int v3)
     const
 {
-    return ToTetrahedron(mVertices[i], v0, v1, v2, v3);
+    if (!mFilterVertices)
+    {
+        return ToTetrahedron(mVertices[i], v0, v1, v2, v3);
+    }
+
+    // Use the index-based ToPlane queries so that they are filtered.
+    int sign0 = ToPlane(i, v1, v2, v3);
+    if (sign0 > 0)
+    {
+        return +1;
+    }
+
+    int sign1 = ToPlane(i, v0, v2, v3);
+    if (sign1 < 0)
+    {
+        return +1;
+    }
+
+    int sign2 = ToPlane(i, v0, v1, v3);
+    if (sign2 > 0)
+    {
+        return +1;
+    }
+
+    int sign3 = ToPlane(i, v0, v1, v2);
+    if (sign3 < 0)
+    {
+        return +1;
+    }
+
+    return ((sign0 && sign1 && sign2 && sign3) ? -1 : 0);
 }
 
 template <typename Real>
@@ -213,6 +361,14 @@ template <typename Real>
 int PrimalQuery3<Real>::ToCircumsphere(int i, int v0, int v1, int v2, int v3)
 const
 {
+    if (mFilterVertices)
+    {
+        int sign = FilterToCircumsphere(i, v0, v1, v2, v3);
+        if (sign != 0)
+        {
+            return sign;
+        }
+    }
     return ToCircumsphere(mVertices[i], v0, v1, v2, v3);
 }
 
@@ -327,4 +483,137 @@ int PrimalQuery3<Real>::ToCircumsphere(Vector3<Real> const& test, int v0,
 }
 
 
+template <typename Real>
+int PrimalQuery3<Real>::FilterToPlane(int i, int v0, int v1, int v2) const
+{
+    // The determinant is the same as that of ToPlane, evaluated in the order
+    // of Shewchuk's orient3d with the error bound o3derrboundA.
+    double const epsilon = 0.5 * std::numeric_limits<double>::epsilon();
+    double const errorBoundCoefficient = (7.0 + 56.0 * epsilon) * epsilon;
+
+    Vector3<double> const& test = mFilterVertices[i];
+    Vector3<double> const& vec0 = mFilterVertices[v0];
+    Vector3<double> const& vec1 = mFilterVertices[v1];
+    Vector3<double> const& vec2 = mFilterVertices[v2];
+
+    double x0 = test[0] - vec0[0];
+    double y0 = test[1] - vec0[1];
+    double z0 = test[2] - vec0[2];
+    double x1 = vec1[0] - vec0[0];
+    double y1 = vec1[1] - vec0[1];
+    double z1 = vec1[2] - vec0[2];
+    double x2 = vec2[0] - vec0[0];
+    double y2 = vec2[1] - vec0[1];
+    double z2 = vec2[2] - vec0[2];
+
+    double x1y2 = x1 * y2;
+    double x2y1 = x2 * y1;
+    double x2y0 = x2 * y0;
+    double x0y2 = x0 * y2;
+    double x0y1 = x0 * y1;
+    double x1y0 = x1 * y0;
+
+    double det = z0 * (x1y2 - x2y1) + z1 * (x2y0 - x0y2) + z2 * (x0y1 - x1y0);
+
+    double permanent = (std::fabs(x1y2) + std::fabs(x2y1)) * std::fabs(z0)
+        + (std::fabs(x2y0) + std::fabs(x0y2)) * std::fabs(z1)
+        + (std::fabs(x0y1) + std::fabs(x1y0)) * std::fabs(z2);
+    double errorBound = errorBoundCoefficient * permanent;
+
+    // The comparisons are false when the computations overflow (infinities
+    // or NaNs), so the query falls back to Real arithmetic.
+    int sign = (det > errorBound ? +1 : (-det > errorBound ? -1 : 0));
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    mFilterStatistics.Update(sign);
+#endif
+    return sign;
+}
+
+template <typename Real>
+int PrimalQuery3<Real>::FilterToCircumsphere(int i, int v0, int v1, int v2,
+    int v3) const
+{
+    // The determinant of ToCircumsphere uses w = |V|^2 - |P|^2, which
+    // differs from the lifted value |V-P|^2 by a linear combination of the
+    // x-, y-, and z-columns; the determinants are therefore equal.  The
+    // lifted form is evaluated in the order of Shewchuk's insphere with the
+    // error bound isperrboundA.
+    double const epsilon = 0.5 * std::numeric_limits<double>::epsilon();
+    double const errorBoundCoefficient = (16.0 + 224.0 * epsilon) * epsilon;
+
+    Vector3<double> const& test = mFilterVertices[i];
+    Vector3<double> const& vec0 = mFilterVertices[v0];
+    Vector3<double> const& vec1 = mFilterVertices[v1];
+    Vector3<double> const& vec2 = mFilterVertices[v2];
+    Vector3<double> const& vec3 = mFilterVertices[v3];
+
+    double x0 = vec0[0] - test[0];
+    double y0 = vec0[1] - test[1];
+    double z0 = vec0[2] - test[2];
+    double x1 = vec1[0] - test[0];
+    double y1 = vec1[1] - test[1];
+    double z1 = vec1[2] - test[2];
+    double x2 = vec2[0] - test[0];
+    double y2 = vec2[1] - test[1];
+    double z2 = vec2[2] - test[2];
+    double x3 = vec3[0] - test[0];
+    double y3 = vec3[1] - test[1];
+    double z3 = vec3[2] - test[2];
+
+    double x0y1 = x0 * y1;
+    double x1y0 = x1 * y0;
+    double x0y2 = x0 * y2;
+    double x2y0 = x2 * y0;
+    double x0y3 = x0 * y3;
+    double x3y0 = x3 * y0;
+    double x1y2 = x1 * y2;
+    double x2y1 = x2 * y1;
+    double x1y3 = x1 * y3;
+    double x3y1 = x3 * y1;
+    double x2y3 = x2 * y3;
+    double x3y2 = x3 * y2;
+    double a0 = x0y1 - x1y0;
+    double a1 = x0y2 - x2y0;
+    double a2 = x0y3 - x3y0;
+    double a3 = x1y2 - x2y1;
+    double a4 = x1y3 - x3y1;
+    double a5 = x2y3 - x3y2;
+
+    // The 3x3 minors of the first three columns, each the determinant of
+    // the rows indicated by the suffix.
+    double m012 = z0 * a3 - z1 * a1 + z2 * a0;
+    double m123 = z1 * a5 - z2 * a4 + z3 * a3;
+    double m230 = z0 * a5 - z2 * a2 + z3 * a1;
+    double m301 = z3 * a0 + z0 * a4 - z1 * a2;
+
+    double w0 = x0 * x0 + y0 * y0 + z0 * z0;
+    double w1 = x1 * x1 + y1 * y1 + z1 * z1;
+    double w2 = x2 * x2 + y2 * y2 + z2 * z2;
+    double w3 = x3 * x3 + y3 * y3 + z3 * z3;
+
+    double det = (w3 * m012 - w2 * m301) + (w1 * m230 - w0 * m123);
+
+    double absZ0 = std::fabs(z0), absZ1 = std::fabs(z1);
+    double absZ2 = std::fabs(z2), absZ3 = std::fabs(z3);
+    double p01 = std::fabs(x0y1) + std::fabs(x1y0);
+    double p02 = std::fabs(x0y2) + std::fabs(x2y0);
+    double p03 = std::fabs(x0y3) + std::fabs(x3y0);
+    double p12 = std::fabs(x1y2) + std::fabs(x2y1);
+    double p13 = std::fabs(x1y3) + std::fabs(x3y1);
+    double p23 = std::fabs(x2y3) + std::fabs(x3y2);
+    double permanent =
+        (p23 * absZ1 + p13 * absZ2 + p12 * absZ3) * w0 +
+        (p23 * absZ0 + p03 * absZ2 + p02 * absZ3) * w1 +
+        (p13 * absZ0 + p03 * absZ1 + p01 * absZ3) * w2 +
+        (p12 * absZ0 + p02 * absZ1 + p01 * absZ2) * w3;
+    double errorBound = errorBoundCoefficient * permanent;
+
+    int sign = (det > errorBound ? +1 : (-det > errorBound ? -1 : 0));
+#if defined(GTE_COLLECT_PRIMALQUERY_STATISTICS)
+    mFilterStatistics.Update(sign);
+#endif
+    return sign;
+}
+
+
 }
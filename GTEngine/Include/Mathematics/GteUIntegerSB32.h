@@ -0,0 +1,455 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <Mathematics/GteUIntegerALU32.h>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Class UIntegerSB32 is designed to support arbitrary precision arithmetic
+// using BSNumber and BSRational.  It is not a general-purpose class for
+// arithmetic of unsigned integers.  The template parameter N is the number
+// of 32-bit words stored in a small buffer inside the object.  Numbers that
+// fit in N words do not use dynamic memory.  Larger numbers are stored in
+// blocks obtained from a thread-local arena.  Released blocks are cached by
+// the arena of the thread that releases them, so after a warm-up phase the
+// BSNumber temporaries created in a sequence of computations (for example,
+// the determinants of PrimalQuery2 and PrimalQuery3) no longer allocate or
+// free memory from the global heap.  This avoids the cost of the
+// std::vector<uint32_t> allocations of UIntegerAP32 while not requiring the
+// worst-case bound N of UIntegerFP32<N>.
+//
+// The choice of N is a trade-off between the size of the BSNumber objects
+// and the number of arena requests.  Use GTE_COLLECT_UINTEGERAP32_STATISTICS
+// with UIntegerAP32 to measure typical storage sizes for your data.
+
+namespace gte
+{
+
+// The thread-local storage manager for UIntegerSB32.  The block capacities
+// are powers of two (in 32-bit words).  Each thread caches at most
+// MAX_CACHED blocks per capacity; additional blocks are returned to the
+// global heap.
+class UIntegerSB32Arena
+{
+public:
+    // Get a block with at least 'numWords' elements.  The actual capacity
+    // of the block is returned in 'capacity'.
+    static uint32_t* Acquire(int32_t numWords, int32_t& capacity);
+
+    // Return a block obtained from Acquire.
+    static void Release(uint32_t* block, int32_t capacity);
+
+    // Free the cached blocks of the calling thread.
+    static void Clear();
+
+private:
+    enum { MAX_CACHED = 64, NUM_CLASSES = 32 };
+
+    UIntegerSB32Arena();
+    ~UIntegerSB32Arena();
+
+    // The arena of the calling thread.  The return value is nullptr when the
+    // thread is being terminated and the arena has already been destroyed.
+    static UIntegerSB32Arena* Get();
+    static int& State();
+
+    std::array<std::vector<uint32_t*>, NUM_CLASSES> mCached;
+};
+
+template <int N>
+class UIntegerSB32 : public UIntegerALU32<UIntegerSB32<N>>
+{
+public:
+    // Construction and destruction.
+    ~UIntegerSB32();
+    UIntegerSB32();
+    UIntegerSB32(UIntegerSB32 const& number);
+    UIntegerSB32(uint32_t number);
+    UIntegerSB32(uint64_t number);
+    UIntegerSB32(int numBits);
+
+    // Assignment.
+    UIntegerSB32& operator=(UIntegerSB32 const& number);
+
+    // Support for std::move.  When 'number' uses arena storage, the storage
+    // is stolen; otherwise, the small-buffer bits are copied.
+    UIntegerSB32(UIntegerSB32&& number);
+    UIntegerSB32& operator=(UIntegerSB32&& number);
+
+    // Member access.  The nonconstant GetBits returns a reference so that
+    // the pointer remains valid when SetNumBits changes the storage.
+    void SetNumBits(uint32_t numBits);
+    inline int32_t GetNumBits() const;
+    inline uint32_t const* GetBits() const;
+    inline uint32_t* const& GetBits();
+    inline void SetBack(uint32_t value);
+    inline uint32_t GetBack() const;
+    inline int32_t GetSize() const;
+
+    // Disk input/output.  The fstream objects should be created using
+    // std::ios::binary.  The return value is 'true' iff the operation
+    // was successful.
+    bool Write(std::ofstream& output) const;
+    bool Read(std::ifstream& input);
+
+private:
+    // Ensure the storage has at least 'numWords' elements.  The first mSize
+    // elements are preserved.
+    void Reserve(int32_t numWords);
+
+    int32_t mNumBits, mSize, mCapacity;
+    uint32_t* mBits;
+    std::array<uint32_t, N> mSmall;
+
+    friend class UnitTestBSNumber;
+};
+
+
+inline uint32_t* UIntegerSB32Arena::Acquire(int32_t numWords,
+    int32_t& capacity)
+{
+    int32_t c = 0;
+    while ((int32_t(1) << c) < numWords)
+    {
+        ++c;
+    }
+    capacity = (int32_t(1) << c);
+
+    UIntegerSB32Arena* arena = Get();
+    if (arena)
+    {
+        auto& cached = arena->mCached[c];
+        if (cached.size() > 0)
+        {
+            uint32_t* block = cached.back();
+            cached.pop_back();
+            return block;
+        }
+    }
+    return new uint32_t[capacity];
+}
+
+inline void UIntegerSB32Arena::Release(uint32_t* block, int32_t capacity)
+{
+    int32_t c = GetLeadingBit(capacity);
+    UIntegerSB32Arena* arena = Get();
+    if (arena && arena->mCached[c].size() < MAX_CACHED)
+    {
+        arena->mCached[c].push_back(block);
+    }
+    else
+    {
+        delete[] block;
+    }
+}
+
+inline void UIntegerSB32Arena::Clear()
+{
+    UIntegerSB32Arena* arena = Get();
+    if (arena)
+    {
+        for (auto& cached : arena->mCached)
+        {
+            for (auto block : cached)
+            {
+                delete[] block;
+            }
+            cached.clear();
+        }
+    }
+}
+
+inline UIntegerSB32Arena::UIntegerSB32Arena()
+{
+    State() = 1;
+}
+
+inline UIntegerSB32Arena::~UIntegerSB32Arena()
+{
+    for (auto& cached : mCached)
+    {
+        for (auto block : cached)
+        {
+            delete[] block;
+        }
+    }
+    State() = 2;
+}
+
+inline UIntegerSB32Arena* UIntegerSB32Arena::Get()
+{
+    // The state is 0 before the arena is created, 1 while it exists, and 2
+    // after it is destroyed.  Objects with thread storage duration are
+    // destroyed before those with static storage duration, so a global
+    // UIntegerSB32 object can release its storage after the arena of the
+    // main thread is gone.
+    if (State() == 2)
+    {
+        return nullptr;
+    }
+    static thread_local UIntegerSB32Arena arena;
+    return &arena;
+}
+
+inline int& UIntegerSB32Arena::State()
+{
+    static thread_local int state = 0;
+    return state;
+}
+
+
+template <int N>
+UIntegerSB32<N>::~UIntegerSB32()
+{
+    if (mBits != &mSmall[0])
+    {
+        UIntegerSB32Arena::Release(mBits, mCapacity);
+    }
+}
+
+template <int N>
+UIntegerSB32<N>::UIntegerSB32()
+    :
+    mNumBits(0),
+    mSize(0),
+    mCapacity(N),
+    mBits(&mSmall[0])
+{
+    static_assert(N >= 2, "N not large enough to store 64-bit integers.");
+}
+
+template <int N>
+UIntegerSB32<N>::UIntegerSB32(UIntegerSB32 const& number)
+    :
+    mNumBits(0),
+    mSize(0),
+    mCapacity(N),
+    mBits(&mSmall[0])
+{
+    static_assert(N >= 2, "N not large enough to store 64-bit integers.");
+
+    *this = number;
+}
+
+template <int N>
+UIntegerSB32<N>::UIntegerSB32(uint32_t number)
+    :
+    mNumBits(0),
+    mSize(0),
+    mCapacity(N),
+    mBits(&mSmall[0])
+{
+    static_assert(N >= 2, "N not large enough to store 64-bit integers.");
+
+    if (number > 0)
+    {
+        int32_t first = GetLeadingBit(number);
+        int32_t last = GetTrailingBit(number);
+        mNumBits = first - last + 1;
+        mSize = 1;
+        mBits[0] = (number >> last);
+    }
+}
+
+template <int N>
+UIntegerSB32<N>::UIntegerSB32(uint64_t number)
+    :
+    mNumBits(0),
+    mSize(0),
+    mCapacity(N),
+    mBits(&mSmall[0])
+{
+    static_assert(N >= 2, "N not large enough to store 64-bit integers.");
+
+    if (number > 0)
+    {
+        int32_t first = GetLeadingBit(number);
+        int32_t last = GetTrailingBit(number);
+        number >>= last;
+        mNumBits = first - last + 1;
+        mSize = 1 + (mNumBits - 1) / 32;
+        mBits[0] = (uint32_t)(number & 0x00000000FFFFFFFFull);
+        if (mSize > 1)
+        {
+            mBits[1] = (uint32_t)((number >> 32) & 0x00000000FFFFFFFFull);
+        }
+    }
+}
+
+template <int N>
+UIntegerSB32<N>::UIntegerSB32(int numBits)
+    :
+    mNumBits(0),
+    mSize(0),
+    mCapacity(N),
+    mBits(&mSmall[0])
+{
+    static_assert(N >= 2, "N not large enough to store 64-bit integers.");
+
+    SetNumBits(numBits);
+}
+
+template <int N>
+UIntegerSB32<N>& UIntegerSB32<N>::operator=(UIntegerSB32 const& number)
+{
+    if (this != &number)
+    {
+        mSize = 0;
+        Reserve(number.mSize);
+        mNumBits = number.mNumBits;
+        mSize = number.mSize;
+        std::copy(number.mBits, number.mBits + mSize, mBits);
+    }
+    return *this;
+}
+
+template <int N>
+UIntegerSB32<N>::UIntegerSB32(UIntegerSB32&& number)
+    :
+    mNumBits(0),
+    mSize(0),
+    mCapacity(N),
+    mBits(&mSmall[0])
+{
+    *this = std::move(number);
+}
+
+template <int N>
+UIntegerSB32<N>& UIntegerSB32<N>::operator=(UIntegerSB32&& number)
+{
+    if (this != &number)
+    {
+        if (number.mBits != &number.mSmall[0])
+        {
+            // Steal the arena storage of 'number'.
+            if (mBits != &mSmall[0])
+            {
+                UIntegerSB32Arena::Release(mBits, mCapacity);
+            }
+            mBits = number.mBits;
+            mCapacity = number.mCapacity;
+            number.mBits = &number.mSmall[0];
+            number.mCapacity = N;
+        }
+        else
+        {
+            // The bits of 'number' fit in the small buffer, so they fit in
+            // the storage of 'this' object.
+            std::copy(number.mBits, number.mBits + number.mSize, mBits);
+        }
+        mNumBits = number.mNumBits;
+        mSize = number.mSize;
+        number.mNumBits = 0;
+        number.mSize = 0;
+    }
+    return *this;
+}
+
+template <int N>
+void UIntegerSB32<N>::SetNumBits(uint32_t numBits)
+{
+    int32_t size = (numBits > 0 ? 1 + (int32_t)(numBits - 1) / 32 : 0);
+    Reserve(size);
+    mNumBits = numBits;
+    mSize = size;
+}
+
+template <int N> inline
+int32_t UIntegerSB32<N>::GetNumBits() const
+{
+    return mNumBits;
+}
+
+template <int N> inline
+uint32_t const* UIntegerSB32<N>::GetBits() const
+{
+    return mBits;
+}
+
+template <int N> inline
+uint32_t* const& UIntegerSB32<N>::GetBits()
+{
+    return mBits;
+}
+
+template <int N> inline
+void UIntegerSB32<N>::SetBack(uint32_t value)
+{
+    mBits[mSize - 1] = value;
+}
+
+template <int N> inline
+uint32_t UIntegerSB32<N>::GetBack() const
+{
+    return mBits[mSize - 1];
+}
+
+template <int N> inline
+int32_t UIntegerSB32<N>::GetSize() const
+{
+    return mSize;
+}
+
+template <int N>
+bool UIntegerSB32<N>::Write(std::ofstream& output) const
+{
+    if (output.write((char const*)&mNumBits, sizeof(mNumBits)).bad())
+    {
+        return false;
+    }
+
+    if (output.write((char const*)&mSize, sizeof(mSize)).bad())
+    {
+        return false;
+    }
+
+    return output.write((char const*)mBits, mSize*sizeof(mBits[0])).good();
+}
+
+template <int N>
+bool UIntegerSB32<N>::Read(std::ifstream& input)
+{
+    if (input.read((char*)&mNumBits, sizeof(mNumBits)).bad())
+    {
+        return false;
+    }
+
+    int32_t size;
+    if (input.read((char*)&size, sizeof(size)).bad())
+    {
+        return false;
+    }
+
+    mSize = 0;
+    Reserve(size);
+    mSize = size;
+    return input.read((char*)mBits, mSize*sizeof(mBits[0])).good();
+}
+
+template <int N>
+void UIntegerSB32<N>::Reserve(int32_t numWords)
+{
+    if (numWords > mCapacity)
+    {
+        int32_t capacity;
+        uint32_t* bits = UIntegerSB32Arena::Acquire(numWords, capacity);
+        std::copy(mBits, mBits + mSize, bits);
+        if (mBits != &mSmall[0])
+        {
+            UIntegerSB32Arena::Release(mBits, mCapacity);
+        }
+        mBits = bits;
+        mCapacity = capacity;
+    }
+}
+
+
+}
@@ -0,0 +1,291 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+// The active intervals are tested against a query several at a time using
+// SIMD instructions when Real is float and the compiler targets AVX-512 (16
+// intervals), AVX (8 intervals) or SSE2 (4 intervals).  Otherwise, or when
+// GTE_NO_ACTIVELIST_SIMD is defined, the intervals are tested one at a time.
+//#define GTE_NO_ACTIVELIST_SIMD
+
+#if !defined(GTE_NO_ACTIVELIST_SIMD)
+#if defined(__AVX512F__)
+#define GTE_ACTIVELIST_AVX512
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define GTE_ACTIVELIST_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GTE_ACTIVELIST_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace gte
+{
+
+// Append to 'overlaps' the indices[i] for imin <= i < imax for which the
+// intervals [activeMin[d][i],activeMax[d][i]] and [min[d],max[d]] overlap
+// for all 0 <= d < N.  Intervals that share only an endpoint overlap.  The
+// indices are appended in increasing order of i.  The scalar kernel is the
+// fallback for all types.  ActiveListKernel is the kernel used by
+// ActiveList; WIDTH is the number of intervals per instruction.
+template <int N, typename Real>
+class ActiveListScalarKernel
+{
+public:
+    enum { WIDTH = 1 };
+
+    static void FindOverlaps(Real const* const* activeMin,
+        Real const* const* activeMax, int const* indices, int imin, int imax,
+        Real const* min, Real const* max, std::vector<int>& overlaps);
+};
+
+template <int N, typename Real>
+class ActiveListKernel : public ActiveListScalarKernel<N, Real>
+{
+};
+
+#if defined(GTE_ACTIVELIST_AVX512) || defined(GTE_ACTIVELIST_AVX) || defined(GTE_ACTIVELIST_SSE2)
+template <int N>
+class ActiveListKernel<N, float>
+{
+public:
+#if defined(GTE_ACTIVELIST_AVX512)
+    enum { WIDTH = 16 };
+#elif defined(GTE_ACTIVELIST_AVX)
+    enum { WIDTH = 8 };
+#else
+    enum { WIDTH = 4 };
+#endif
+
+    static void FindOverlaps(float const* const* activeMin,
+        float const* const* activeMax, int const* indices, int imin, int imax,
+        float const* min, float const* max, std::vector<int>& overlaps);
+};
+#endif
+
+// The active set of a sweep-and-prune algorithm.  The sweep is along one
+// axis of the objects; the active set contains the objects whose intervals
+// on that axis contain the current sweep position.  Each active object has
+// N additional intervals, one for each of the other axes, and a new object
+// overlaps an active object when the intervals overlap on all N axes.  The
+// intervals are stored in contiguous arrays (structure-of-arrays form) so
+// that the active objects are tested without pointer chasing.  Removal
+// moves the last active object into the hole, so the order of the active
+// objects depends on the order of the insertions and removals.
+template <int N, typename Real>
+class ActiveList
+{
+public:
+    // Construction.  The list is empty.
+    ActiveList();
+
+    // Remove all objects and allow the indices 0 <= index < numIndices to
+    // be inserted.
+    void Reset(int numIndices);
+
+    // The number of active objects.
+    inline int GetSize() const;
+
+    // Insert an object that is not active.  The arrays min[] and max[] have
+    // N elements.
+    void Insert(int index, Real const* min, Real const* max);
+
+    // Remove an active object.
+    void Remove(int index);
+
+    // Append to 'overlaps' the indices of the active objects whose intervals
+    // overlap [min[d],max[d]] for all 0 <= d < N.
+    void FindOverlaps(Real const* min, Real const* max,
+        std::vector<int>& overlaps) const;
+
+private:
+    std::vector<int> mIndices;
+    std::array<std::vector<Real>, N> mMin, mMax;
+
+    // The position in mIndices of each active object, -1 for inactive ones.
+    std::vector<int> mPosition;
+};
+
+
+template <int N, typename Real>
+ActiveList<N, Real>::ActiveList()
+{
+}
+
+template <int N, typename Real>
+void ActiveList<N, Real>::Reset(int numIndices)
+{
+    mIndices.clear();
+    for (int d = 0; d < N; ++d)
+    {
+        mMin[d].clear();
+        mMax[d].clear();
+    }
+    mPosition.assign(numIndices, -1);
+}
+
+template <int N, typename Real>
+inline int ActiveList<N, Real>::GetSize() const
+{
+    return static_cast<int>(mIndices.size());
+}
+
+template <int N, typename Real>
+void ActiveList<N, Real>::Insert(int index, Real const* min, Real const* max)
+{
+    mPosition[index] = static_cast<int>(mIndices.size());
+    mIndices.push_back(index);
+    for (int d = 0; d < N; ++d)
+    {
+        mMin[d].push_back(min[d]);
+        mMax[d].push_back(max[d]);
+    }
+}
+
+template <int N, typename Real>
+void ActiveList<N, Real>::Remove(int index)
+{
+    int position = mPosition[index];
+    int last = static_cast<int>(mIndices.size()) - 1;
+    if (position < last)
+    {
+        int lastIndex = mIndices[last];
+        mIndices[position] = lastIndex;
+        mPosition[lastIndex] = position;
+        for (int d = 0; d < N; ++d)
+        {
+            mMin[d][position] = mMin[d][last];
+            mMax[d][position] = mMax[d][last];
+        }
+    }
+    mIndices.pop_back();
+    for (int d = 0; d < N; ++d)
+    {
+        mMin[d].pop_back();
+        mMax[d].pop_back();
+    }
+    mPosition[index] = -1;
+}
+
+template <int N, typename Real>
+void ActiveList<N, Real>::FindOverlaps(Real const* min, Real const* max,
+    std::vector<int>& overlaps) const
+{
+    if (mIndices.size() > 0)
+    {
+        Real const* activeMin[N];
+        Real const* activeMax[N];
+        for (int d = 0; d < N; ++d)
+        {
+            activeMin[d] = mMin[d].data();
+            activeMax[d] = mMax[d].data();
+        }
+        ActiveListKernel<N, Real>::FindOverlaps(activeMin, activeMax,
+            mIndices.data(), 0, GetSize(), min, max, overlaps);
+    }
+}
+
+template <int N, typename Real>
+void ActiveListScalarKernel<N, Real>::FindOverlaps(
+    Real const* const* activeMin, Real const* const* activeMax,
+    int const* indices, int imin, int imax, Real const* min, Real const* max,
+    std::vector<int>& overlaps)
+{
+    for (int i = imin; i < imax; ++i)
+    {
+        int d = 0;
+        while (d < N && activeMax[d][i] >= min[d] && activeMin[d][i] <= max[d])
+        {
+            ++d;
+        }
+        if (d == N)
+        {
+            overlaps.push_back(indices[i]);
+        }
+    }
+}
+
+#if defined(GTE_ACTIVELIST_AVX512) || defined(GTE_ACTIVELIST_AVX) || defined(GTE_ACTIVELIST_SSE2)
+template <int N>
+void ActiveListKernel<N, float>::FindOverlaps(float const* const* activeMin,
+    float const* const* activeMax, int const* indices, int imin, int imax,
+    float const* min, float const* max, std::vector<int>& overlaps)
+{
+    // The bits of 'mask' are set for the intervals that overlap on all
+    // axes.  The indices are appended in increasing order, as in the scalar
+    // kernel.
+    int i = imin;
+#if defined(GTE_ACTIVELIST_AVX512)
+    __m512 qmin[N], qmax[N];
+    for (int d = 0; d < N; ++d)
+    {
+        qmin[d] = _mm512_set1_ps(min[d]);
+        qmax[d] = _mm512_set1_ps(max[d]);
+    }
+    for (; i + WIDTH <= imax; i += WIDTH)
+    {
+        __mmask16 mask = 0xFFFF;
+        for (int d = 0; d < N; ++d)
+        {
+            mask &= _mm512_cmp_ps_mask(_mm512_loadu_ps(activeMax[d] + i), qmin[d], _CMP_GE_OQ);
+            mask &= _mm512_cmp_ps_mask(_mm512_loadu_ps(activeMin[d] + i), qmax[d], _CMP_LE_OQ);
+        }
+#elif defined(GTE_ACTIVELIST_AVX)
+    __m256 qmin[N], qmax[N];
+    for (int d = 0; d < N; ++d)
+    {
+        qmin[d] = _mm256_set1_ps(min[d]);
+        qmax[d] = _mm256_set1_ps(max[d]);
+    }
+    for (; i + WIDTH <= imax; i += WIDTH)
+    {
+        __m256 overlap = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int d = 0; d < N; ++d)
+        {
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(activeMax[d] + i), qmin[d], _CMP_GE_OQ));
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(activeMin[d] + i), qmax[d], _CMP_LE_OQ));
+        }
+        int mask = _mm256_movemask_ps(overlap);
+#else
+    __m128 qmin[N], qmax[N];
+    for (int d = 0; d < N; ++d)
+    {
+        qmin[d] = _mm_set1_ps(min[d]);
+        qmax[d] = _mm_set1_ps(max[d]);
+    }
+    for (; i + WIDTH <= imax; i += WIDTH)
+    {
+        __m128 overlap = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int d = 0; d < N; ++d)
+        {
+            overlap = _mm_and_ps(overlap, _mm_cmpge_ps(_mm_loadu_ps(activeMax[d] + i), qmin[d]));
+            overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(activeMin[d] + i), qmax[d]));
+        }
+        int mask = _mm_movemask_ps(overlap);
+#endif
+        for (int k = 0; mask != 0; ++k, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                overlaps.push_back(indices[i + k]);
+            }
+        }
+    }
+
+    // Process the remaining intervals one at a time.
+    ActiveListScalarKernel<N, float>::FindOverlaps(activeMin, activeMax,
+        indices, i, imax, min, max, overlaps);
+}
+#endif
+
+}
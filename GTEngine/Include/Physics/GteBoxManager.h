@@ -3,16 +3,38 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.2.0 (2026/10/18)
 
 #pragma once
 
+#include <LowLevel/GteComputeModel.h>
 #include <Mathematics/GteIntrAlignedBox3AlignedBox3.h>
-#include <Mathematics/GteEdgeKey.h>
+#include <Physics/GteActiveList.h>
+#include <Physics/GteOverlapSet.h>
 #include <algorithm>
-#include <set>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+// The sweep of Initialize() is along the axis for which the box centers have
+// the largest variance, which minimizes the number of boxes that overlap on
+// the sweep axis but not on the other axes.  When the manager is constructed
+// with a compute model that has a thread pool, the work is partitioned among
+// the threads.
+//   1. Initialize() sorts the endpoints of the three axes concurrently.  The
+//      sorted endpoints of the sweep axis are partitioned into contiguous
+//      ranges that are swept concurrently.  The sweep of a range starts with
+//      the boxes whose intervals contain the first endpoint of the range.
+//      Each pair is found in exactly one range, namely, the one containing
+//      the 'begin' endpoint that is larger, so the pairs of the ranges are
+//      merged without locks or duplicate removal.
+//   2. Update() applies the insertion sorts of the three axes concurrently.
+//      Each sort records the changes to the overlap set; the changes are
+//      applied in the order of the single-threaded algorithm.
+// The overlapping pairs and the added and removed pairs are identical to
+// those of the single-threaded manager, including their order in the arrays.
+
 namespace gte
 {
 
@@ -20,8 +42,11 @@ template <typename Real>
 class BoxManager
 {
 public:
-    // Construction.
+    // Construction.  The second constructor uses the thread pool of the
+    // compute model, if it has one.
     BoxManager(std::vector<AlignedBox3<Real>>& boxes);
+    BoxManager(std::vector<AlignedBox3<Real>>& boxes,
+        std::shared_ptr<ComputeModel> const& cmodel);
 
     // No default construction, copy construction, or assignment are allowed.
     BoxManager() = delete;
@@ -32,7 +57,8 @@ public:
     // to initialize the update system.  However, if you add or remove items
     // from the array of boxes after the constructor call, you will need
     // to call this function once before you start the multiple calls of the
-    // update function.
+    // update function.  All the overlapping pairs are reported by GetAdded()
+    // and none by GetRemoved().
     void Initialize();
 
     // After the system is initialized, you can move the boxes using this
@@ -47,10 +73,15 @@ public:
     // the new set of overlapping boxes.
     void Update();
 
-    // If (i,j) is in the overlap set, then box i and box j are
+    // If (i,j) is in the overlap array, then box i and box j are
     // overlapping.  The indices are those for the the input array.  The
-    // set elements (i,j) are stored so that i < j.
-    std::set<EdgeKey<false>> const& GetOverlap() const;
+    // elements (i,j) are stored so that i < j, but the array is not sorted.
+    inline std::vector<EdgeKey<false>> const& GetOverlap() const;
+
+    // The pairs that started overlapping and the pairs that stopped
+    // overlapping during the last call to Initialize() or Update().
+    inline std::vector<EdgeKey<false>> const& GetAdded() const;
+    inline std::vector<EdgeKey<false>> const& GetRemoved() const;
 
 private:
     class Endpoint
@@ -64,11 +95,44 @@ private:
         bool operator<(Endpoint const& endpoint) const;
     };
 
-    void InsertionSort(std::vector<Endpoint>& endPoint, std::vector<int>& lookup);
+    // A change of the overlap status of the pair (i0,i1) detected by the
+    // insertion sort of an axis.
+    struct Change
+    {
+        int i0, i1;
+        bool insert;
+    };
+
+    // The state of the sweep of a range of endpoints.  The active boxes
+    // store their intervals on the two axes other than the sweep axis.
+    struct Sweep
+    {
+        ActiveList<2, Real> active;
+        std::vector<int> overlaps;
+        std::vector<EdgeKey<false>> pairs;
+    };
+
+    // Create the sorted endpoints and the lookup table of axis d.
+    void InitializeAxis(int d);
+
+    // Find the pairs whose larger 'begin' endpoint on the sweep axis is one
+    // of mEndpoints[mSweepAxis][jmin..jmax-1].
+    void SweepRange(int jmin, int jmax, Sweep& sweep);
+
+    void InsertionSort(std::vector<Endpoint>& endPoint, std::vector<int>& lookup,
+        std::vector<Change>& changes);
+
+    // The boxes i and j overlap when their intervals overlap on all axes.
+    inline bool Overlaps(int i, int j) const;
 
     std::vector<AlignedBox3<Real>>& mBoxes;
-    std::vector<Endpoint> mXEndpoints, mYEndpoints, mZEndpoints;
-    std::set<EdgeKey<false>> mOverlap;
+    std::shared_ptr<ThreadPool> mThreadPool;
+    std::array<std::vector<Endpoint>, 3> mEndpoints;
+    OverlapSet mOverlap;
+
+    // The box extents in structure-of-arrays form: the interval of box i on
+    // axis d is [mMin[d][i],mMax[d][i]].
+    std::array<std::vector<Real>, 3> mMin, mMax;
 
     // The intervals are indexed 0 <= i < n.  The endpoint array has 2*n
     // entries.  The original 2*n interval values are ordered as b[0], e[0],
@@ -79,13 +143,34 @@ private:
     // table of 2*n entries.  The value mLookup[2*i] is the index of b[i]
     // in the endpoint array.  The value mLookup[2*i+1] is the index of
     // e[i] in the endpoint array.
-    std::vector<int> mXLookup, mYLookup, mZLookup;
+    std::array<std::vector<int>, 3> mLookup;
+
+    // Support for the sweep.  mVariance[d] is the variance of the box
+    // centers on axis d (times 4n).
+    std::array<Real, 3> mVariance;
+    int mSweepAxis;
+    std::vector<Sweep> mSweeps;
+
+    // Support for the update.
+    std::array<std::vector<Change>, 3> mChanges;
 };
 
 template <typename Real>
 BoxManager<Real>::BoxManager(std::vector<AlignedBox3<Real> >& boxes)
     :
-    mBoxes(boxes)
+    mBoxes(boxes),
+    mSweepAxis(0)
+{
+    Initialize();
+}
+
+template <typename Real>
+BoxManager<Real>::BoxManager(std::vector<AlignedBox3<Real>>& boxes,
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mBoxes(boxes),
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mSweepAxis(0)
 {
     Initialize();
 }
@@ -93,107 +178,89 @@ BoxManager<Real>::BoxManager(std::vector<AlignedBox3<Real> >& boxes)
 template <typename Real>
 void BoxManager<Real>::Initialize()
 {
-    // Get the box endpoints.
-    int intrSize = static_cast<int>(mBoxes.size()), endpSize = 2 * intrSize;
-    mXEndpoints.resize(endpSize);
-    mYEndpoints.resize(endpSize);
-    mZEndpoints.resize(endpSize);
-    for (int i = 0, j = 0; i < intrSize; ++i)
+    if (mThreadPool)
     {
-        mXEndpoints[j].type = 0;
-        mXEndpoints[j].value = mBoxes[i].min[0];
-        mXEndpoints[j].index = i;
-        mYEndpoints[j].type = 0;
-        mYEndpoints[j].value = mBoxes[i].min[1];
-        mYEndpoints[j].index = i;
-        mZEndpoints[j].type = 0;
-        mZEndpoints[j].value = mBoxes[i].min[2];
-        mZEndpoints[j].index = i;
-        ++j;
-
-        mXEndpoints[j].type = 1;
-        mXEndpoints[j].value = mBoxes[i].max[0];
-        mXEndpoints[j].index = i;
-        mYEndpoints[j].type = 1;
-        mYEndpoints[j].value = mBoxes[i].max[1];
-        mYEndpoints[j].index = i;
-        mZEndpoints[j].type = 1;
-        mZEndpoints[j].value = mBoxes[i].max[2];
-        mZEndpoints[j].index = i;
-        ++j;
+        ThreadPool::TaskGroup group(*mThreadPool);
+        group.Run([this]() { InitializeAxis(1); });
+        group.Run([this]() { InitializeAxis(2); });
+        InitializeAxis(0);
+        group.Wait();
+    }
+    else
+    {
+        for (int d = 0; d < 3; ++d)
+        {
+            InitializeAxis(d);
+        }
     }
 
-    // Sort the rectangle endpoints.
-    std::sort(mXEndpoints.begin(), mXEndpoints.end());
-    std::sort(mYEndpoints.begin(), mYEndpoints.end());
-    std::sort(mZEndpoints.begin(), mZEndpoints.end());
-
-    // Create the interval-to-endpoint lookup tables.
-    mXLookup.resize(endpSize);
-    mYLookup.resize(endpSize);
-    mZLookup.resize(endpSize);
-    for (int j = 0; j < endpSize; ++j)
+    mSweepAxis = 0;
+    for (int d = 1; d < 3; ++d)
     {
-        mXLookup[2 * mXEndpoints[j].index + mXEndpoints[j].type] = j;
-        mYLookup[2 * mYEndpoints[j].index + mYEndpoints[j].type] = j;
-        mZLookup[2 * mZEndpoints[j].index + mZEndpoints[j].type] = j;
+        if (mVariance[d] > mVariance[mSweepAxis])
+        {
+            mSweepAxis = d;
+        }
     }
 
-    // Active set of rectangles (stored by index in array).
-    std::set<int> active;
+    // Partition the endpoints of the sweep axis into ranges of at least
+    // minRangeSize endpoints.
+    int const minRangeSize = 4096;
+    int endpSize = 2 * static_cast<int>(mBoxes.size());
+    int numRanges = 1;
+    if (mThreadPool)
+    {
+        numRanges = 4 * static_cast<int>(mThreadPool->GetNumThreads());
+        numRanges = std::max(std::min(numRanges, endpSize / minRangeSize), 1);
+    }
+    mSweeps.resize(numRanges);
 
-    // set of overlapping rectangles (stored by pairs of indices in array)
-    mOverlap.clear();
+    auto sweepRange = [this, endpSize, numRanges](int r)
+    {
+        int jmin = static_cast<int>(static_cast<int64_t>(endpSize) * r / numRanges);
+        int jmax = static_cast<int>(static_cast<int64_t>(endpSize) * (r + 1) / numRanges);
+        SweepRange(jmin, jmax, mSweeps[r]);
+    };
 
-    // Sweep through the endpoints to determine overlapping x-intervals.
-    for (int i = 0; i < endpSize; ++i)
+    if (numRanges > 1)
     {
-        Endpoint& endpoint = mXEndpoints[i];
-        int index = endpoint.index;
-        if (endpoint.type == 0)  // an interval 'begin' value
+        mThreadPool->ParallelFor(0, numRanges, 1, [&sweepRange](int rmin, int rmax)
         {
-            // In the 1D problem, the current interval overlaps with all the
-            // active intervals.  In 3D we also need to check for y-overlap
-            // and z-overlap.
-            for (auto activeIndex : active)
+            for (int r = rmin; r < rmax; ++r)
             {
-                // Rectangles activeIndex and index overlap in the
-                // x-dimension.  Test for overlap in the y-dimension and
-                // z-dimension.
-                AlignedBox3<Real> const& b0 = mBoxes[activeIndex];
-                AlignedBox3<Real> const& b1 = mBoxes[index];
-                if (b0.max[1] >= b1.min[1] && b0.min[1] <= b1.max[1]
-                    && b0.max[2] >= b1.min[2] && b0.min[2] <= b1.max[2])
-                {
-                    if (activeIndex < index)
-                    {
-                        mOverlap.insert(EdgeKey<false>(activeIndex, index));
-                    }
-                    else
-                    {
-                        mOverlap.insert(EdgeKey<false>(index, activeIndex));
-                    }
-                }
+                sweepRange(r);
             }
-            active.insert(index);
-        }
-        else  // an interval 'end' value
+        });
+    }
+    else
+    {
+        sweepRange(0);
+    }
+
+    // The pairs of the ranges are disjoint.
+    mOverlap.Clear();
+    mOverlap.BeginUpdate();
+    for (auto const& sweep : mSweeps)
+    {
+        for (auto const& pair : sweep.pairs)
         {
-            active.erase(index);
+            mOverlap.Insert(pair.V[0], pair.V[1]);
         }
     }
+    mOverlap.EndUpdate();
 }
 
 template <typename Real>
 void BoxManager<Real>::SetBox(int i, AlignedBox3<Real> const& box)
 {
     mBoxes[i] = box;
-    mXEndpoints[mXLookup[2 * i]].value = box.min[0];
-    mXEndpoints[mXLookup[2 * i + 1]].value = box.max[0];
-    mYEndpoints[mYLookup[2 * i]].value = box.min[1];
-    mYEndpoints[mYLookup[2 * i + 1]].value = box.max[1];
-    mZEndpoints[mZLookup[2 * i]].value = box.min[2];
-    mZEndpoints[mZLookup[2 * i + 1]].value = box.max[2];
+    for (int d = 0; d < 3; ++d)
+    {
+        mMin[d][i] = box.min[d];
+        mMax[d][i] = box.max[d];
+        mEndpoints[d][mLookup[d][2 * i]].value = box.min[d];
+        mEndpoints[d][mLookup[d][2 * i + 1]].value = box.max[d];
+    }
 }
 
 template <typename Real>
@@ -203,13 +270,187 @@ void BoxManager<Real>::GetBox(int i, AlignedBox3<Real>& box) const
 }
 
 template <typename Real>
-void BoxManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std::vector<int>& lookup)
+void BoxManager<Real>::Update()
+{
+    if (mThreadPool)
+    {
+        ThreadPool::TaskGroup group(*mThreadPool);
+        for (int d = 1; d < 3; ++d)
+        {
+            group.Run([this, d]()
+            {
+                InsertionSort(mEndpoints[d], mLookup[d], mChanges[d]);
+            });
+        }
+        InsertionSort(mEndpoints[0], mLookup[0], mChanges[0]);
+        group.Wait();
+    }
+    else
+    {
+        for (int d = 0; d < 3; ++d)
+        {
+            InsertionSort(mEndpoints[d], mLookup[d], mChanges[d]);
+        }
+    }
+
+    mOverlap.BeginUpdate();
+    for (int d = 0; d < 3; ++d)
+    {
+        for (auto const& change : mChanges[d])
+        {
+            if (change.insert)
+            {
+                mOverlap.Insert(change.i0, change.i1);
+            }
+            else
+            {
+                mOverlap.Remove(change.i0, change.i1);
+            }
+        }
+    }
+    mOverlap.EndUpdate();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& BoxManager<Real>::GetOverlap() const
+{
+    return mOverlap.GetPairs();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& BoxManager<Real>::GetAdded() const
+{
+    return mOverlap.GetAdded();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& BoxManager<Real>::GetRemoved() const
+{
+    return mOverlap.GetRemoved();
+}
+
+template <typename Real>
+void BoxManager<Real>::InitializeAxis(int d)
+{
+    // Get the box extents and endpoints.
+    int intrSize = static_cast<int>(mBoxes.size()), endpSize = 2 * intrSize;
+    std::vector<Real>& min = mMin[d];
+    std::vector<Real>& max = mMax[d];
+    std::vector<Endpoint>& endpoints = mEndpoints[d];
+    min.resize(intrSize);
+    max.resize(intrSize);
+    endpoints.resize(endpSize);
+    for (int i = 0, j = 0; i < intrSize; ++i)
+    {
+        min[i] = mBoxes[i].min[d];
+        max[i] = mBoxes[i].max[d];
+
+        endpoints[j].type = 0;
+        endpoints[j].value = min[i];
+        endpoints[j].index = i;
+        ++j;
+
+        endpoints[j].type = 1;
+        endpoints[j].value = max[i];
+        endpoints[j].index = i;
+        ++j;
+    }
+
+    // Sort the box endpoints.
+    std::sort(endpoints.begin(), endpoints.end());
+
+    // Create the interval-to-endpoint lookup table.
+    std::vector<int>& lookup = mLookup[d];
+    lookup.resize(endpSize);
+    for (int j = 0; j < endpSize; ++j)
+    {
+        lookup[2 * endpoints[j].index + endpoints[j].type] = j;
+    }
+
+    // Compute the variance of the centers (times 4n) without overflow in
+    // the sums.  The centers are min[i]+max[i], which is twice the actual
+    // center; the scaling does not affect the choice of sweep axis.
+    Real mean = (Real)0, variance = (Real)0;
+    if (intrSize > 0)
+    {
+        for (int i = 0; i < intrSize; ++i)
+        {
+            mean += min[i] + max[i];
+        }
+        mean /= (Real)intrSize;
+        for (int i = 0; i < intrSize; ++i)
+        {
+            Real diff = min[i] + max[i] - mean;
+            variance += diff * diff;
+        }
+    }
+    mVariance[d] = variance;
+}
+
+template <typename Real>
+void BoxManager<Real>::SweepRange(int jmin, int jmax, Sweep& sweep)
+{
+    int const d0 = mSweepAxis, d1 = (d0 + 1) % 3, d2 = (d0 + 2) % 3;
+    std::vector<Endpoint> const& endpoints = mEndpoints[d0];
+    std::vector<int> const& lookup = mLookup[d0];
+    int intrSize = static_cast<int>(mBoxes.size());
+
+    sweep.active.Reset(intrSize);
+    sweep.pairs.clear();
+
+    // The boxes whose intervals on the sweep axis contain endpoint jmin
+    // are active at the start of the range.
+    if (jmin > 0)
+    {
+        for (int i = 0; i < intrSize; ++i)
+        {
+            if (lookup[2 * i] < jmin && lookup[2 * i + 1] >= jmin)
+            {
+                Real const min[2] = { mMin[d1][i], mMin[d2][i] };
+                Real const max[2] = { mMax[d1][i], mMax[d2][i] };
+                sweep.active.Insert(i, min, max);
+            }
+        }
+    }
+
+    for (int j = jmin; j < jmax; ++j)
+    {
+        Endpoint const& endpoint = endpoints[j];
+        int index = endpoint.index;
+        if (endpoint.type == 0)  // an interval 'begin' value
+        {
+            // In the 1D problem, the current interval overlaps with all the
+            // active intervals.  In 3D we also need to check for overlap on
+            // the other two axes.  The order of the active boxes depends on
+            // the range, so the overlapping boxes are sorted to obtain pairs
+            // in an order that does not depend on the partition.
+            Real const min[2] = { mMin[d1][index], mMin[d2][index] };
+            Real const max[2] = { mMax[d1][index], mMax[d2][index] };
+            sweep.overlaps.clear();
+            sweep.active.FindOverlaps(min, max, sweep.overlaps);
+            std::sort(sweep.overlaps.begin(), sweep.overlaps.end());
+            for (auto activeIndex : sweep.overlaps)
+            {
+                sweep.pairs.push_back(EdgeKey<false>(activeIndex, index));
+            }
+            sweep.active.Insert(index, min, max);
+        }
+        else  // an interval 'end' value
+        {
+            sweep.active.Remove(index);
+        }
+    }
+}
+
+template <typename Real>
+void BoxManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint,
+    std::vector<int>& lookup, std::vector<Change>& changes)
 {
     // Apply an insertion sort.  Under the assumption that the rectangles
     // have not changed much since the last call, the endpoints are nearly
     // sorted.  The insertion sort should be very fast in this case.
 
-    TIQuery<Real, AlignedBox3<Real>, AlignedBox3<Real>> query;
+    changes.clear();
     int endpSize = static_cast<int>(endpoint.size());
     for (int j = 1; j < endpSize; ++j)
     {
@@ -229,12 +470,8 @@ void BoxManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std::vecto
                     // of interval E1.mIndex, and the intervals *might have
                     // been* overlapping.  Now 'b' and 'e' are swapped, and
                     // the intervals cannot overlap.  Remove the pair from
-                    // the overlap set.  The removal operation needs to find
-                    // the pair and erase it if it exists.  Finding the pair
-                    // is the expensive part of the operation, so there is no
-                    // real time savings in testing for existence first, then
-                    // deleting if it does.
-                    mOverlap.erase(EdgeKey<false>(e0.index, e1.index));
+                    // the overlap set if it is there.
+                    changes.push_back({ e0.index, e1.index, false });
                 }
             }
             else
@@ -246,9 +483,9 @@ void BoxManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std::vecto
                     // overlapping.  Now 'b' and 'e' are swapped, and the
                     // intervals *might be* overlapping.  Determine if they
                     // are overlapping and then insert.
-                    if (query(mBoxes[e0.index], mBoxes[e1.index]).intersect)
+                    if (Overlaps(e0.index, e1.index))
                     {
-                        mOverlap.insert(EdgeKey<false>(e0.index, e1.index));
+                        changes.push_back({ e0.index, e1.index, true });
                     }
                 }
             }
@@ -266,17 +503,16 @@ void BoxManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std::vecto
 }
 
 template <typename Real>
-void BoxManager<Real>::Update()
-{
-    InsertionSort(mXEndpoints, mXLookup);
-    InsertionSort(mYEndpoints, mYLookup);
-    InsertionSort(mZEndpoints, mZLookup);
-}
-
-template <typename Real>
-const std::set<EdgeKey<false>>& BoxManager<Real>::GetOverlap() const
+inline bool BoxManager<Real>::Overlaps(int i, int j) const
 {
-    return mOverlap;
+    for (int d = 0; d < 3; ++d)
+    {
+        if (mMax[d][i] < mMin[d][j] || mMin[d][i] > mMax[d][j])
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 template <typename Real>
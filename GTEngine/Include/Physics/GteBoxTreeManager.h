@@ -0,0 +1,659 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteIntrAlignedBox3AlignedBox3.h>
+#include <Mathematics/GteIntrRay3AlignedBox3.h>
+#include <Physics/GteOverlapSet.h>
+#include <algorithm>
+#include <vector>
+
+// A broad-phase collision culler for axis-aligned boxes that stores the
+// boxes in a dynamic bounding volume hierarchy.  It has the same interface
+// as BoxManager, so an application may use whichever structure is better
+// for the motion of its boxes.  BoxManager is preferable when the boxes move
+// coherently, because the insertion sorts of its endpoints then do little
+// work.  BoxTreeManager is preferable when many boxes move large distances
+// or are created while the system is running.
+//
+// Each box is a leaf of a binary tree.  The leaf stores a "fat" box, which
+// is the box enlarged by a margin on all sides.  An interior node stores the
+// smallest box containing the boxes of its children.  When SetBox moves a
+// box outside its fat box, the leaf is removed and reinserted with a new fat
+// box; otherwise, the tree does not change.  Insertion chooses the sibling
+// that minimizes the increase in surface area of the tree, and the boxes of
+// the ancestors of a modified node are refit on the way to the root.  Tree
+// rotations keep the heights of the children of each node within 1 of each
+// other, so the tree is balanced regardless of the order of insertions.
+//
+// Update() finds the overlapping pairs of the boxes that were modified since
+// the previous update by querying the tree.  The pairs that no longer
+// overlap are found by a pass over the overlap array.
+
+namespace gte
+{
+
+template <typename Real>
+class BoxTreeManager
+{
+public:
+    // Construction.  The margin is the distance by which a box is enlarged
+    // to obtain its fat box; it must be nonnegative.  Larger margins reduce
+    // the number of tree modifications of moving boxes but increase the
+    // number of tree nodes visited by the queries.
+    BoxTreeManager(std::vector<AlignedBox3<Real>>& boxes, Real margin);
+
+    // No default construction, copy construction, or assignment are allowed.
+    BoxTreeManager() = delete;
+    BoxTreeManager(BoxTreeManager const&) = delete;
+    BoxTreeManager& operator=(BoxTreeManager const&) = delete;
+
+    // This function is called by the constructor and builds the tree and the
+    // overlap set from the array of boxes.  If you remove boxes from the
+    // array after the constructor call, you will need to call this function
+    // once before you start the multiple calls of the update function.  All
+    // the overlapping pairs are reported by GetAdded() and none by
+    // GetRemoved().
+    void Initialize();
+
+    // After the system is initialized, you can move the boxes using this
+    // function.  It is not enough to modify the input array of boxes since
+    // the tree must also change.  You can also retrieve the current box
+    // information.
+    void SetBox(int i, AlignedBox3<Real> const& box);
+    void GetBox(int i, AlignedBox3<Real>& box) const;
+
+    // Append a box to the input array and insert it into the tree.  The
+    // return value is the index of the box in the array.  The overlaps of
+    // the box are determined by the next call to Update().
+    int AddBox(AlignedBox3<Real> const& box);
+
+    // When you are finished moving boxes, call this function to determine
+    // the overlapping boxes.
+    void Update();
+
+    // If (i,j) is in the overlap array, then box i and box j are
+    // overlapping.  The indices are those for the the input array.  The
+    // elements (i,j) are stored so that i < j, but the array is not sorted.
+    inline std::vector<EdgeKey<false>> const& GetOverlap() const;
+
+    // The pairs that started overlapping and the pairs that stopped
+    // overlapping during the last call to Initialize() or Update().
+    inline std::vector<EdgeKey<false>> const& GetAdded() const;
+    inline std::vector<EdgeKey<false>> const& GetRemoved() const;
+
+    // Queries against the current boxes, including those moved since the
+    // last call to Update().  The indices of the boxes that overlap the
+    // query box or that are intersected by the ray are appended to the
+    // output array.
+    void FindOverlaps(AlignedBox3<Real> const& box,
+        std::vector<int>& overlaps) const;
+
+    void FindIntersections(Ray3<Real> const& ray,
+        std::vector<int>& intersections) const;
+
+    // Support for diagnostics.  The height of a tree with a single node is
+    // 0 and the height of an empty tree is -1.
+    inline int GetHeight() const;
+
+private:
+    struct Node
+    {
+        // The fat box of a leaf or the bounding box of the children of an
+        // interior node.
+        AlignedBox3<Real> box;
+
+        // The parent is the next node of the free list when the node is
+        // not in use.
+        int parent;
+        int child[2];
+
+        // The height is 0 for a leaf and -1 for a node not in use.  The
+        // index is the box index for a leaf and -1 for an interior node.
+        int height;
+        int index;
+    };
+
+    int AllocateNode();
+    void FreeNode(int n);
+
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+
+    // Recompute the boxes and heights of the node and its ancestors,
+    // rebalancing the tree on the way to the root.
+    void Refit(int n);
+
+    // Apply a rotation at node a if its subtrees are unbalanced.  The
+    // return value is the node that replaces a in the tree.
+    int Balance(int a);
+
+    // Replace the child 'oldChild' of the parent of 'oldChild' by
+    // 'newChild'.  If oldChild is the root, newChild becomes the root.
+    void ReplaceChild(int oldChild, int newChild);
+
+    inline void SetUnion(AlignedBox3<Real> const& box0,
+        AlignedBox3<Real> const& box1, AlignedBox3<Real>& result) const;
+    inline Real GetArea(AlignedBox3<Real> const& box) const;
+    inline bool Contains(AlignedBox3<Real> const& outer,
+        AlignedBox3<Real> const& inner) const;
+    inline bool Overlaps(AlignedBox3<Real> const& box0,
+        AlignedBox3<Real> const& box1) const;
+    void GetFatBox(AlignedBox3<Real> const& box, AlignedBox3<Real>& fatBox) const;
+
+    std::vector<AlignedBox3<Real>>& mBoxes;
+    Real mMargin;
+    OverlapSet mOverlap;
+
+    // The tree nodes.  The unused nodes form a list starting at mFree.
+    std::vector<Node> mNodes;
+    int mRoot, mFree;
+
+    // The leaf node of each box.
+    std::vector<int> mLeaves;
+
+    // The boxes modified since the last update.
+    std::vector<int> mModified;
+    std::vector<char> mIsModified;
+
+    // Support for the update.
+    std::vector<EdgeKey<false>> mRemovals;
+    std::vector<int> mOverlaps;
+};
+
+
+template <typename Real>
+BoxTreeManager<Real>::BoxTreeManager(std::vector<AlignedBox3<Real>>& boxes,
+    Real margin)
+    :
+    mBoxes(boxes),
+    mMargin(margin),
+    mRoot(-1),
+    mFree(-1)
+{
+    LogAssert(margin >= (Real)0, "Invalid margin.");
+    Initialize();
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::Initialize()
+{
+    int const numBoxes = static_cast<int>(mBoxes.size());
+    mNodes.clear();
+    mNodes.reserve(2 * numBoxes);
+    mRoot = -1;
+    mFree = -1;
+    mLeaves.resize(numBoxes);
+    mModified.resize(numBoxes);
+    mIsModified.resize(numBoxes);
+    for (int i = 0; i < numBoxes; ++i)
+    {
+        int leaf = AllocateNode();
+        GetFatBox(mBoxes[i], mNodes[leaf].box);
+        mNodes[leaf].height = 0;
+        mNodes[leaf].index = i;
+        InsertLeaf(leaf);
+        mLeaves[i] = leaf;
+        mModified[i] = i;
+        mIsModified[i] = 1;
+    }
+
+    mOverlap.Clear();
+    Update();
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::SetBox(int i, AlignedBox3<Real> const& box)
+{
+    mBoxes[i] = box;
+    if (!mIsModified[i])
+    {
+        mIsModified[i] = 1;
+        mModified.push_back(i);
+    }
+
+    int leaf = mLeaves[i];
+    if (!Contains(mNodes[leaf].box, box))
+    {
+        RemoveLeaf(leaf);
+        GetFatBox(box, mNodes[leaf].box);
+        InsertLeaf(leaf);
+    }
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::GetBox(int i, AlignedBox3<Real>& box) const
+{
+    box = mBoxes[i];
+}
+
+template <typename Real>
+int BoxTreeManager<Real>::AddBox(AlignedBox3<Real> const& box)
+{
+    int i = static_cast<int>(mBoxes.size());
+    mBoxes.push_back(box);
+
+    int leaf = AllocateNode();
+    GetFatBox(box, mNodes[leaf].box);
+    mNodes[leaf].height = 0;
+    mNodes[leaf].index = i;
+    InsertLeaf(leaf);
+    mLeaves.push_back(leaf);
+    mIsModified.push_back(1);
+    mModified.push_back(i);
+    return i;
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::Update()
+{
+    mOverlap.BeginUpdate();
+    if (mModified.size() > 0)
+    {
+        // Remove the pairs that contain a modified box and no longer
+        // overlap.  The removals are deferred because they reorder the
+        // overlap array.
+        mRemovals.clear();
+        for (auto const& pair : mOverlap.GetPairs())
+        {
+            int i0 = pair.V[0], i1 = pair.V[1];
+            if ((mIsModified[i0] || mIsModified[i1])
+                && !Overlaps(mBoxes[i0], mBoxes[i1]))
+            {
+                mRemovals.push_back(pair);
+            }
+        }
+        for (auto const& pair : mRemovals)
+        {
+            mOverlap.Remove(pair.V[0], pair.V[1]);
+        }
+
+        // Insert the pairs that contain a modified box.  The insertion
+        // fails for pairs that are already in the set.
+        for (auto i : mModified)
+        {
+            mOverlaps.clear();
+            FindOverlaps(mBoxes[i], mOverlaps);
+            for (auto j : mOverlaps)
+            {
+                if (j != i)
+                {
+                    mOverlap.Insert(i, j);
+                }
+            }
+            mIsModified[i] = 0;
+        }
+        mModified.clear();
+    }
+    mOverlap.EndUpdate();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& BoxTreeManager<Real>::GetOverlap() const
+{
+    return mOverlap.GetPairs();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& BoxTreeManager<Real>::GetAdded() const
+{
+    return mOverlap.GetAdded();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& BoxTreeManager<Real>::GetRemoved() const
+{
+    return mOverlap.GetRemoved();
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::FindOverlaps(AlignedBox3<Real> const& box,
+    std::vector<int>& overlaps) const
+{
+    if (mRoot == -1)
+    {
+        return;
+    }
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(mRoot);
+    while (stack.size() > 0)
+    {
+        Node const& node = mNodes[stack.back()];
+        stack.pop_back();
+        if (Overlaps(node.box, box))
+        {
+            if (node.index >= 0)
+            {
+                if (Overlaps(mBoxes[node.index], box))
+                {
+                    overlaps.push_back(node.index);
+                }
+            }
+            else
+            {
+                stack.push_back(node.child[1]);
+                stack.push_back(node.child[0]);
+            }
+        }
+    }
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::FindIntersections(Ray3<Real> const& ray,
+    std::vector<int>& intersections) const
+{
+    if (mRoot == -1)
+    {
+        return;
+    }
+
+    TIQuery<Real, Ray3<Real>, AlignedBox3<Real>> query;
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(mRoot);
+    while (stack.size() > 0)
+    {
+        Node const& node = mNodes[stack.back()];
+        stack.pop_back();
+        if (query(ray, node.box).intersect)
+        {
+            if (node.index >= 0)
+            {
+                if (query(ray, mBoxes[node.index]).intersect)
+                {
+                    intersections.push_back(node.index);
+                }
+            }
+            else
+            {
+                stack.push_back(node.child[1]);
+                stack.push_back(node.child[0]);
+            }
+        }
+    }
+}
+
+template <typename Real>
+inline int BoxTreeManager<Real>::GetHeight() const
+{
+    return (mRoot != -1 ? mNodes[mRoot].height : -1);
+}
+
+template <typename Real>
+int BoxTreeManager<Real>::AllocateNode()
+{
+    int n;
+    if (mFree != -1)
+    {
+        n = mFree;
+        mFree = mNodes[n].parent;
+    }
+    else
+    {
+        n = static_cast<int>(mNodes.size());
+        mNodes.push_back(Node());
+    }
+
+    Node& node = mNodes[n];
+    node.parent = -1;
+    node.child[0] = -1;
+    node.child[1] = -1;
+    node.height = 0;
+    node.index = -1;
+    return n;
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::FreeNode(int n)
+{
+    mNodes[n].parent = mFree;
+    mNodes[n].height = -1;
+    mFree = n;
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::InsertLeaf(int leaf)
+{
+    if (mRoot == -1)
+    {
+        mRoot = leaf;
+        mNodes[leaf].parent = -1;
+        return;
+    }
+
+    // Descend the tree to find the best sibling for the leaf.  The cost of
+    // making node n the sibling is the area of the new parent plus the
+    // increase in area of the ancestors of n.
+    AlignedBox3<Real> const leafBox = mNodes[leaf].box;
+    AlignedBox3<Real> combined;
+    int sibling = mRoot;
+    while (mNodes[sibling].index < 0)
+    {
+        Node const& node = mNodes[sibling];
+        Real area = GetArea(node.box);
+        SetUnion(node.box, leafBox, combined);
+        Real combinedArea = GetArea(combined);
+
+        // The cost of creating a new parent for this node and the leaf.
+        Real cost = (Real)2 * combinedArea;
+
+        // The minimum cost of pushing the leaf further down the tree.
+        Real inheritanceCost = (Real)2 * (combinedArea - area);
+
+        Real childCost[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            Node const& child = mNodes[node.child[k]];
+            SetUnion(child.box, leafBox, combined);
+            childCost[k] = GetArea(combined) + inheritanceCost;
+            if (child.index < 0)
+            {
+                childCost[k] -= GetArea(child.box);
+            }
+        }
+
+        if (cost < childCost[0] && cost < childCost[1])
+        {
+            break;
+        }
+        sibling = node.child[childCost[0] <= childCost[1] ? 0 : 1];
+    }
+
+    // Create a new parent for the sibling and the leaf.
+    int oldParent = mNodes[sibling].parent;
+    int newParent = AllocateNode();
+    Node& parentNode = mNodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.child[0] = sibling;
+    parentNode.child[1] = leaf;
+    parentNode.height = mNodes[sibling].height + 1;
+    SetUnion(leafBox, mNodes[sibling].box, parentNode.box);
+    if (oldParent != -1)
+    {
+        Node& oldParentNode = mNodes[oldParent];
+        oldParentNode.child[oldParentNode.child[0] == sibling ? 0 : 1] = newParent;
+    }
+    else
+    {
+        mRoot = newParent;
+    }
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    Refit(newParent);
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::RemoveLeaf(int leaf)
+{
+    if (leaf == mRoot)
+    {
+        mRoot = -1;
+        return;
+    }
+
+    // The sibling of the leaf replaces their parent.
+    int parent = mNodes[leaf].parent;
+    Node const& parentNode = mNodes[parent];
+    int sibling = parentNode.child[parentNode.child[0] == leaf ? 1 : 0];
+    int grandParent = parentNode.parent;
+    ReplaceChild(parent, sibling);
+    FreeNode(parent);
+    mNodes[leaf].parent = -1;
+
+    Refit(grandParent);
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::Refit(int n)
+{
+    while (n != -1)
+    {
+        n = Balance(n);
+
+        Node& node = mNodes[n];
+        Node const& child0 = mNodes[node.child[0]];
+        Node const& child1 = mNodes[node.child[1]];
+        node.height = 1 + std::max(child0.height, child1.height);
+        SetUnion(child0.box, child1.box, node.box);
+        n = node.parent;
+    }
+}
+
+template <typename Real>
+int BoxTreeManager<Real>::Balance(int a)
+{
+    // The node a has children b and c.  If c is higher than b by 2 or more,
+    // c is rotated up to replace a, and a receives the lower child of c.
+    // The symmetric case is handled by swapping the roles of b and c.
+    Node& nodeA = mNodes[a];
+    int b = nodeA.child[0], c = nodeA.child[1];
+    int balance = mNodes[c].height - mNodes[b].height;
+    int cIndex;
+    if (balance > 1)
+    {
+        cIndex = 1;
+    }
+    else if (balance < -1)
+    {
+        std::swap(b, c);
+        cIndex = 0;
+    }
+    else
+    {
+        return a;
+    }
+
+    // Rotate c up.
+    Node& nodeC = mNodes[c];
+    int f = nodeC.child[0], g = nodeC.child[1];
+    ReplaceChild(a, c);
+    nodeC.child[0] = a;
+    nodeA.parent = c;
+
+    // The higher child of c stays with c and the other one replaces c as
+    // the child of a.
+    if (mNodes[f].height > mNodes[g].height)
+    {
+        std::swap(f, g);
+    }
+    nodeC.child[1] = g;
+    nodeA.child[cIndex] = f;
+    mNodes[f].parent = a;
+
+    Node const& nodeB = mNodes[b];
+    Node const& nodeF = mNodes[f];
+    Node const& nodeG = mNodes[g];
+    SetUnion(nodeB.box, nodeF.box, nodeA.box);
+    nodeA.height = 1 + std::max(nodeB.height, nodeF.height);
+    SetUnion(nodeA.box, nodeG.box, nodeC.box);
+    nodeC.height = 1 + std::max(nodeA.height, nodeG.height);
+    return c;
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::ReplaceChild(int oldChild, int newChild)
+{
+    int parent = mNodes[oldChild].parent;
+    mNodes[newChild].parent = parent;
+    if (parent != -1)
+    {
+        Node& parentNode = mNodes[parent];
+        parentNode.child[parentNode.child[0] == oldChild ? 0 : 1] = newChild;
+    }
+    else
+    {
+        mRoot = newChild;
+    }
+}
+
+template <typename Real>
+inline void BoxTreeManager<Real>::SetUnion(AlignedBox3<Real> const& box0,
+    AlignedBox3<Real> const& box1, AlignedBox3<Real>& result) const
+{
+    for (int d = 0; d < 3; ++d)
+    {
+        result.min[d] = std::min(box0.min[d], box1.min[d]);
+        result.max[d] = std::max(box0.max[d], box1.max[d]);
+    }
+}
+
+template <typename Real>
+inline Real BoxTreeManager<Real>::GetArea(AlignedBox3<Real> const& box) const
+{
+    // This is half the surface area of the box, which suffices for the
+    // comparisons of costs.
+    Real dx = box.max[0] - box.min[0];
+    Real dy = box.max[1] - box.min[1];
+    Real dz = box.max[2] - box.min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+template <typename Real>
+inline bool BoxTreeManager<Real>::Contains(AlignedBox3<Real> const& outer,
+    AlignedBox3<Real> const& inner) const
+{
+    for (int d = 0; d < 3; ++d)
+    {
+        if (inner.min[d] < outer.min[d] || inner.max[d] > outer.max[d])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Real>
+inline bool BoxTreeManager<Real>::Overlaps(AlignedBox3<Real> const& box0,
+    AlignedBox3<Real> const& box1) const
+{
+    for (int d = 0; d < 3; ++d)
+    {
+        if (box0.max[d] < box1.min[d] || box0.min[d] > box1.max[d])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Real>
+void BoxTreeManager<Real>::GetFatBox(AlignedBox3<Real> const& box,
+    AlignedBox3<Real>& fatBox) const
+{
+    for (int d = 0; d < 3; ++d)
+    {
+        fatBox.min[d] = box.min[d] - mMargin;
+        fatBox.max[d] = box.max[d] + mMargin;
+    }
+}
+
+}
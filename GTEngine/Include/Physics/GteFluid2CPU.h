@@ -0,0 +1,145 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteComputeModel.h>
+#include <Mathematics/GteMultigridPoisson.h>
+#include <Physics/GteFluid2Parameters.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// The Poisson solver processes several cells of a row at a time using SIMD
+// instructions when the compiler targets AVX-512 (16 cells), AVX (8 cells)
+// or SSE2 (4 cells).  Otherwise, or when GTE_NO_FLUID_SIMD is defined, the
+// cells are processed one at a time.
+//#define GTE_NO_FLUID_SIMD
+
+namespace gte
+{
+
+// A CPU implementation of the simulation of Fluid2.  The stages are those
+// of the compute shaders of Fluid2 and the state is the same, so the class
+// may be used when no graphics engine is available, for example,
+//
+//  if (cmodel->engine)
+//  {
+//      fluid = std::make_shared<Fluid2>(cmodel->engine, cmodel->factory, ...);
+//  }
+//  else
+//  {
+//      fluidCPU = std::make_shared<Fluid2CPU>(cmodel, ...);
+//  }
+//
+// The rows of the grid are processed concurrently when the compute model
+// has a thread pool.  Each cell is computed by the same operations
+// regardless of the number of threads, so the results do not depend on it.
+// The results differ from those of the GPU only by floating-point rounding
+// and by the precision of the texture sampler used for advection.
+
+class GTE_IMPEXP Fluid2CPU
+{
+public:
+    // Construction.  The (x,y) grid covers [0,1]^2.  The grid sizes must be
+    // at least 3.  The compute model may be null, in which case the
+    // simulation is single-threaded.
+    Fluid2CPU(std::shared_ptr<ComputeModel> const& cmodel,
+        int xSize, int ySize, float dt, float densityViscosity,
+        float velocityViscosity);
+
+    void Initialize();
+    void DoSimulationStep();
+
+    // Member access.  The state has xSize*ySize elements, stored in
+    // row-major order (index = x + xSize*y).  The elements are
+    // (velocity.x, velocity.y, 0, density), as are those of the texture
+    // returned by Fluid2::GetState().
+    inline int GetXSize() const;
+    inline int GetYSize() const;
+    inline std::vector<Vector4<float>> const& GetState() const;
+
+    // The pressure is the solution of a Poisson equation.  By default, it
+    // is approximated by NUM_POISSON_ITERATIONS Jacobi iterations starting
+    // from zero, as in Fluid2.  When multigrid is enabled, the equation is
+    // solved by MultigridPoisson starting from the pressure of the previous
+    // step, which reduces the divergence of the velocity much more for a
+    // similar cost on large grids.  The tolerance and the maximum number of
+    // V-cycles are set through GetMultigridSolver().
+    inline void SetMultigrid(bool multigrid);
+    inline bool IsMultigrid() const;
+    inline MultigridPoisson<2, float>& GetMultigridSolver();
+
+private:
+    // The stages of the simulation.  Each corresponds to the compute shader
+    // of the Fluid2 class with the same name.
+    void InitializeSource();
+    void InitializeState();
+    void EnforceStateBoundary(std::vector<Vector4<float>>& state);
+    void UpdateState();
+    void ComputeDivergence();
+    void SolvePoisson();
+    void AdjustVelocity();
+
+    // Call function(ymin,ymax) for subranges of the rows, concurrently when
+    // a thread pool is available.
+    void ParallelFor(std::function<void(int, int)> const& function);
+
+    // Constructor inputs.
+    std::shared_ptr<ThreadPool> mThreadPool;
+    int mXSize, mYSize;
+    float mDt;
+
+    // Current simulation time.
+    float mTime;
+
+    // The number of Jacobi iterations of the Poisson solver.
+    enum { NUM_POISSON_ITERATIONS = 32 };
+
+    Fluid2Parameters mParameters;
+    std::vector<Vector4<float>> mSource;
+    std::vector<Vector4<float>> mStateTm1;
+    std::vector<Vector4<float>> mStateT;
+    std::vector<Vector4<float>> mStateTp1;
+    std::vector<float> mDivergence;
+    std::vector<float> mPoisson0, mPoisson1;
+
+    bool mMultigrid;
+    MultigridPoisson<2, float> mMultigridSolver;
+};
+
+inline int Fluid2CPU::GetXSize() const
+{
+    return mXSize;
+}
+
+inline int Fluid2CPU::GetYSize() const
+{
+    return mYSize;
+}
+
+inline std::vector<Vector4<float>> const& Fluid2CPU::GetState() const
+{
+    return mStateT;
+}
+
+inline void Fluid2CPU::SetMultigrid(bool multigrid)
+{
+    mMultigrid = multigrid;
+}
+
+inline bool Fluid2CPU::IsMultigrid() const
+{
+    return mMultigrid;
+}
+
+inline MultigridPoisson<2, float>& Fluid2CPU::GetMultigridSolver()
+{
+    return mMultigridSolver;
+}
+
+}
@@ -0,0 +1,132 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.0 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteComputeModel.h>
+#include <Mathematics/GteMultigridPoisson.h>
+#include <Physics/GteFluid3Parameters.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// As in Fluid2CPU, the Poisson solver uses SIMD instructions unless
+// GTE_NO_FLUID_SIMD is defined.
+//#define GTE_NO_FLUID_SIMD
+
+namespace gte
+{
+
+// A CPU implementation of the simulation of Fluid3, the counterpart of
+// Fluid2CPU for 3D grids.  The stages and the state are those of Fluid3.
+// The rows of the grid, which are indexed by (y,z), are processed
+// concurrently when the compute model has a thread pool, and the results do
+// not depend on the number of threads.
+
+class GTE_IMPEXP Fluid3CPU
+{
+public:
+    // Construction.  The (x,y,z) grid covers [0,1]^3.  The grid sizes must
+    // be at least 3.  The compute model may be null, in which case the
+    // simulation is single-threaded.
+    Fluid3CPU(std::shared_ptr<ComputeModel> const& cmodel,
+        int xSize, int ySize, int zSize, float dt);
+
+    void Initialize();
+    void DoSimulationStep();
+
+    // Member access.  The state has xSize*ySize*zSize elements, stored in
+    // lexicographical order (index = x + xSize*(y + ySize*z)).  The elements
+    // are (velocity.x, velocity.y, velocity.z, density), as are those of the
+    // texture returned by Fluid3::GetState().
+    inline int GetXSize() const;
+    inline int GetYSize() const;
+    inline int GetZSize() const;
+    inline std::vector<Vector4<float>> const& GetState() const;
+
+    // The Poisson equation for the pressure is solved by Jacobi iterations
+    // as in Fluid3 or, when multigrid is enabled, by MultigridPoisson; see
+    // the comments in Fluid2CPU.
+    inline void SetMultigrid(bool multigrid);
+    inline bool IsMultigrid() const;
+    inline MultigridPoisson<3, float>& GetMultigridSolver();
+
+private:
+    // The stages of the simulation.  Each corresponds to the compute shader
+    // of the Fluid3 class with the same name.
+    void InitializeSource();
+    void InitializeState();
+    void EnforceStateBoundary(std::vector<Vector4<float>>& state);
+    void UpdateState();
+    void ComputeDivergence();
+    void SolvePoisson();
+    void AdjustVelocity();
+
+    // Call function(rmin,rmax) for subranges of the rows, concurrently when
+    // a thread pool is available.  Row r has y = r % ySize and
+    // z = r / ySize.
+    void ParallelFor(std::function<void(int, int)> const& function);
+
+    // Constructor inputs.
+    std::shared_ptr<ThreadPool> mThreadPool;
+    int mXSize, mYSize, mZSize;
+    float mDt;
+
+    // Current simulation time.
+    float mTime;
+
+    // The number of Jacobi iterations of the Poisson solver.
+    enum { NUM_POISSON_ITERATIONS = 32 };
+
+    Fluid3Parameters mParameters;
+    std::vector<Vector4<float>> mSource;
+    std::vector<Vector4<float>> mStateTm1;
+    std::vector<Vector4<float>> mStateT;
+    std::vector<Vector4<float>> mStateTp1;
+    std::vector<float> mDivergence;
+    std::vector<float> mPoisson0, mPoisson1;
+
+    bool mMultigrid;
+    MultigridPoisson<3, float> mMultigridSolver;
+};
+
+inline int Fluid3CPU::GetXSize() const
+{
+    return mXSize;
+}
+
+inline int Fluid3CPU::GetYSize() const
+{
+    return mYSize;
+}
+
+inline int Fluid3CPU::GetZSize() const
+{
+    return mZSize;
+}
+
+inline std::vector<Vector4<float>> const& Fluid3CPU::GetState() const
+{
+    return mStateT;
+}
+
+inline void Fluid3CPU::SetMultigrid(bool multigrid)
+{
+    mMultigrid = multigrid;
+}
+
+inline bool Fluid3CPU::IsMultigrid() const
+{
+    return mMultigrid;
+}
+
+inline MultigridPoisson<3, float>& Fluid3CPU::GetMultigridSolver()
+{
+    return mMultigridSolver;
+}
+
+}
@@ -3,13 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.2.1 (2026/10/18)
 
 #pragma once
 
+#include <Physics/GteMassSpringImplicitSolver.h>
 #include <Physics/GteParticleSystem.h>
 #include <cstring>
-#include <set>
 
 namespace gte
 {
@@ -25,17 +25,27 @@ public:
     virtual ~MassSpringArbitrary();
     MassSpringArbitrary(int numParticles, int numSprings, Real step);
 
-    struct Spring
-    {
-        int particle0, particle1;
-        Real constant, length;
-    };
+    typedef typename MassSpringImplicitSolver<N, Real>::Spring Spring;
 
     // Member access.
     inline int GetNumSprings() const;
     void SetSpring(int index, Spring const& spring);
     inline Spring const& GetSpring(int index) const;
 
+    // The system is updated by the Runge-Kutta solver of ParticleSystem
+    // unless the implicit solver is enabled, in which case each update is a
+    // backward Euler step.  The implicit solver is stable for much larger
+    // steps when the springs are stiff; see MassSpringImplicitSolver.  Its
+    // parameters are set through GetImplicitSolver().
+    inline void SetImplicit(bool implicit);
+    inline bool IsImplicit() const;
+    inline MassSpringImplicitSolver<N, Real>& GetImplicitSolver();
+
+    // The spring adjacency of the particles, or the structure of the system
+    // of the implicit solver, is created from the springs on the first
+    // update after SetSpring(...) is called.
+    virtual void Update(Real time);
+
     // The default external force is zero.  Derive a class from this one to
     // provide nonzero external forces such as gravity, wind, friction,
     // and so on.  This function is called by Acceleration(...) to compute
@@ -53,12 +63,26 @@ protected:
         std::vector<Vector<N, Real>> const& position,
         std::vector<Vector<N, Real>> const& velocity);
 
+    // Create the compressed adjacency arrays from the springs.
+    void CreateAdjacency();
+
+    // The backward Euler step of Update(...) when the system is implicit.
+    void UpdateImplicit(Real time);
+
     std::vector<Spring> mSpring;
 
     // Each particle has an associated array of spring indices for those
-    // springs adjacent to the particle.  The set elements are spring
-    // indices, not indices of adjacent particles.
-    std::vector<std::set<int>> mAdjacent;
+    // springs adjacent to the particle, stored in compressed sparse row
+    // form.  The springs adjacent to particle i are mAdjacent[k] for
+    // mAdjacentOffset[i] <= k < mAdjacentOffset[i+1], in increasing order,
+    // and mAdjacentParticle[k] is the other particle of spring mAdjacent[k].
+    std::vector<int> mAdjacentOffset, mAdjacent, mAdjacentParticle;
+    bool mAdjacencyValid;
+
+    // Support for the implicit solver.
+    bool mImplicit, mImplicitStructureValid;
+    MassSpringImplicitSolver<N, Real> mImplicitSolver;
+    std::vector<Vector<N, Real>> mExternalAcceleration;
 };
 
 
@@ -73,7 +97,9 @@ MassSpringArbitrary<N, Real>::MassSpringArbitrary(int numParticles,
     :
     ParticleSystem<N, Real>(numParticles, step),
     mSpring(numSprings),
-    mAdjacent(numParticles)
+    mAdjacencyValid(false),
+    mImplicit(false),
+    mImplicitStructureValid(false)
 {
     memset(&mSpring[0], 0, numSprings * sizeof(Spring));
 }
@@ -88,8 +114,8 @@ template <int N, typename Real>
 void MassSpringArbitrary<N, Real>::SetSpring(int index, Spring const& spring)
 {
     mSpring[index] = spring;
-    mAdjacent[spring.particle0].insert(index);
-    mAdjacent[spring.particle1].insert(index);
+    mAdjacencyValid = false;
+    mImplicitStructureValid = false;
 }
 
 template <int N, typename Real> inline
@@ -99,6 +125,40 @@ MassSpringArbitrary<N, Real>::GetSpring(int index) const
     return mSpring[index];
 }
 
+template <int N, typename Real> inline
+void MassSpringArbitrary<N, Real>::SetImplicit(bool implicit)
+{
+    mImplicit = implicit;
+}
+
+template <int N, typename Real> inline
+bool MassSpringArbitrary<N, Real>::IsImplicit() const
+{
+    return mImplicit;
+}
+
+template <int N, typename Real> inline
+MassSpringImplicitSolver<N, Real>& MassSpringArbitrary<N, Real>::GetImplicitSolver()
+{
+    return mImplicitSolver;
+}
+
+template <int N, typename Real>
+void MassSpringArbitrary<N, Real>::Update(Real time)
+{
+    if (mImplicit)
+    {
+        UpdateImplicit(time);
+        return;
+    }
+
+    if (!mAdjacencyValid)
+    {
+        CreateAdjacency();
+    }
+    ParticleSystem<N, Real>::Update(time);
+}
+
 template <int N, typename Real>
 Vector<N, Real> MassSpringArbitrary<N, Real>::ExternalAcceleration(int, Real,
     std::vector<Vector<N, Real>> const&, std::vector<Vector<N, Real>> const&)
@@ -118,20 +178,11 @@ Vector<N, Real> MassSpringArbitrary<N, Real>::Acceleration(int i, Real time,
     Vector<N, Real> acceleration = ExternalAcceleration(i, time, position,
         velocity);
 
-    for (auto adj : mAdjacent[i])
+    for (int k = mAdjacentOffset[i]; k < mAdjacentOffset[i + 1]; ++k)
     {
         // Process a spring connected to particle i.
-        Spring const& spring = mSpring[adj];
-        Vector<N, Real> diff;
-        if (i != spring.particle0)
-        {
-            diff = position[spring.particle0] - position[i];
-        }
-        else
-        {
-            diff = position[spring.particle1] - position[i];
-        }
-
+        Spring const& spring = mSpring[mAdjacent[k]];
+        Vector<N, Real> diff = position[mAdjacentParticle[k]] - position[i];
         Real ratio = spring.length / Length(diff);
         Vector<N, Real> force = spring.constant * ((Real)1 - ratio) * diff;
         acceleration += this->mInvMass[i] * force;
@@ -140,5 +191,68 @@ Vector<N, Real> MassSpringArbitrary<N, Real>::Acceleration(int i, Real time,
     return acceleration;
 }
 
+template <int N, typename Real>
+void MassSpringArbitrary<N, Real>::CreateAdjacency()
+{
+    // Count the springs of each particle, compute the offsets by a prefix
+    // sum, and then distribute the springs in increasing order.
+    int const numParticles = this->mNumParticles;
+    int const numSprings = static_cast<int>(mSpring.size());
+    mAdjacentOffset.assign(numParticles + 1, 0);
+    for (auto const& spring : mSpring)
+    {
+        ++mAdjacentOffset[spring.particle0 + 1];
+        if (spring.particle1 != spring.particle0)
+        {
+            ++mAdjacentOffset[spring.particle1 + 1];
+        }
+    }
+    for (int i = 0; i < numParticles; ++i)
+    {
+        mAdjacentOffset[i + 1] += mAdjacentOffset[i];
+    }
+
+    mAdjacent.resize(mAdjacentOffset[numParticles]);
+    mAdjacentParticle.resize(mAdjacentOffset[numParticles]);
+    std::vector<int> current(mAdjacentOffset.begin(), mAdjacentOffset.end() - 1);
+    for (int s = 0; s < numSprings; ++s)
+    {
+        Spring const& spring = mSpring[s];
+        int k = current[spring.particle0]++;
+        mAdjacent[k] = s;
+        mAdjacentParticle[k] = spring.particle1;
+        if (spring.particle1 != spring.particle0)
+        {
+            k = current[spring.particle1]++;
+            mAdjacent[k] = s;
+            mAdjacentParticle[k] = spring.particle0;
+        }
+    }
+    mAdjacencyValid = true;
+}
+
+template <int N, typename Real>
+void MassSpringArbitrary<N, Real>::UpdateImplicit(Real time)
+{
+    if (!mImplicitStructureValid)
+    {
+        mImplicitSolver.CreateStructure(this->mNumParticles, mSpring);
+        mExternalAcceleration.resize(this->mNumParticles);
+        mImplicitStructureValid = true;
+    }
+
+    this->ParallelFor([this, time](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            mExternalAcceleration[i] = ExternalAcceleration(i, time,
+                this->mPosition, this->mVelocity);
+        }
+    });
+
+    mImplicitSolver.Update(this->mStep, mSpring, this->mMass,
+        this->mInvMass, mExternalAcceleration, this->mPosition,
+        this->mVelocity, this->mComputeModel);
+}
 
 }
@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.1.1 (2026/10/18)
 
 #pragma once
 
+#include <Physics/GteMassSpringImplicitSolver.h>
 #include <Physics/GteParticleSystem.h>
 
 namespace gte
@@ -29,6 +30,16 @@ public:
     inline Real const& GetConstant(int i) const;
     inline Real const& GetLength(int i) const;
 
+    // The system is updated by the Runge-Kutta solver of ParticleSystem
+    // unless the implicit solver is enabled, in which case each update is a
+    // backward Euler step.  The implicit solver is stable for much larger
+    // steps when the springs are stiff; see MassSpringImplicitSolver.  Its
+    // parameters are set through GetImplicitSolver().
+    inline void SetImplicit(bool implicit);
+    inline bool IsImplicit() const;
+    inline MassSpringImplicitSolver<N, Real>& GetImplicitSolver();
+    virtual void Update(Real time);
+
     // The default external force is zero.  Derive a class from this one to
     // provide nonzero external forces such as gravity, wind, friction,
     // and so on.  This function is called by Acceleration(...) to compute
@@ -46,7 +57,17 @@ protected:
         std::vector<Vector<N, Real>> const& position,
         std::vector<Vector<N, Real>> const& velocity);
 
+    // The backward Euler step of Update(...) when the system is implicit.
+    void UpdateImplicit(Real time);
+
     std::vector<Real> mConstant, mLength;
+
+    // Support for the implicit solver.  The springs are copied to
+    // mImplicitSpring for each step.
+    bool mImplicit, mImplicitStructureValid;
+    MassSpringImplicitSolver<N, Real> mImplicitSolver;
+    std::vector<typename MassSpringImplicitSolver<N, Real>::Spring> mImplicitSpring;
+    std::vector<Vector<N, Real>> mExternalAcceleration;
 };
 
 
@@ -60,7 +81,9 @@ MassSpringCurve<N, Real>::MassSpringCurve(int numParticles, Real step)
     :
     ParticleSystem<N, Real>(numParticles, step),
     mConstant(numParticles - 1),
-    mLength(numParticles - 1)
+    mLength(numParticles - 1),
+    mImplicit(false),
+    mImplicitStructureValid(false)
 {
     std::fill(mConstant.begin(), mConstant.end(), (Real)0);
     std::fill(mLength.begin(), mLength.end(), (Real)0);
@@ -96,6 +119,37 @@ Real const& MassSpringCurve<N, Real>::GetLength(int i) const
     return mLength[i];
 }
 
+template <int N, typename Real> inline
+void MassSpringCurve<N, Real>::SetImplicit(bool implicit)
+{
+    mImplicit = implicit;
+}
+
+template <int N, typename Real> inline
+bool MassSpringCurve<N, Real>::IsImplicit() const
+{
+    return mImplicit;
+}
+
+template <int N, typename Real> inline
+MassSpringImplicitSolver<N, Real>& MassSpringCurve<N, Real>::GetImplicitSolver()
+{
+    return mImplicitSolver;
+}
+
+template <int N, typename Real>
+void MassSpringCurve<N, Real>::Update(Real time)
+{
+    if (mImplicit)
+    {
+        UpdateImplicit(time);
+    }
+    else
+    {
+        ParticleSystem<N, Real>::Update(time);
+    }
+}
+
 template <int N, typename Real>
 Vector<N, Real> MassSpringCurve<N, Real>::ExternalAcceleration(int, Real,
     std::vector<Vector<N, Real>> const&, std::vector<Vector<N, Real>> const&)
@@ -141,5 +195,42 @@ Vector<N, Real> MassSpringCurve<N, Real>::Acceleration(int i, Real time,
     return acceleration;
 }
 
+template <int N, typename Real>
+void MassSpringCurve<N, Real>::UpdateImplicit(Real time)
+{
+    int const numSprings = GetNumSprings();
+    if (!mImplicitStructureValid)
+    {
+        mImplicitSpring.resize(numSprings);
+        for (int i = 0; i < numSprings; ++i)
+        {
+            mImplicitSpring[i].particle0 = i;
+            mImplicitSpring[i].particle1 = i + 1;
+        }
+        mImplicitSolver.CreateStructure(this->mNumParticles, mImplicitSpring);
+        mExternalAcceleration.resize(this->mNumParticles);
+        mImplicitStructureValid = true;
+    }
+
+    for (int i = 0; i < numSprings; ++i)
+    {
+        mImplicitSpring[i].constant = mConstant[i];
+        mImplicitSpring[i].length = mLength[i];
+    }
+
+    this->ParallelFor([this, time](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            mExternalAcceleration[i] = ExternalAcceleration(i, time,
+                this->mPosition, this->mVelocity);
+        }
+    });
+
+    mImplicitSolver.Update(this->mStep, mImplicitSpring, this->mMass,
+        this->mInvMass, mExternalAcceleration, this->mPosition,
+        this->mVelocity, this->mComputeModel);
+}
+
 
 }
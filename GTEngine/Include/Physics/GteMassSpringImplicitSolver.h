@@ -0,0 +1,396 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.1 (2026/10/18)
+
+#pragma once
+
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteLinearSystem.h>
+#include <Mathematics/GteVector.h>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+// The implicit (backward Euler) integrator of the mass-spring systems.  The
+// explicit Runge-Kutta solver of ParticleSystem is unstable when the step
+// is large relative to the period of the stiffest spring.  The backward
+// Euler step linearizes the spring forces f(x) about the current positions
+// x and solves
+//   (M - h^2*K)*dv = h*(f(x) + m*a + h*K*v)
+// for the change dv in the velocities, where h is the step, M is the
+// diagonal mass matrix, K = df/dx is the Jacobian of the spring forces and
+// a is the external acceleration.  The velocities and positions are then
+//   v' = v + dv, x' = x + h*v'.
+// The method is unconditionally stable, so the step can be many times
+// larger than that of the explicit solver, but it damps the oscillations of
+// the springs.  See "Large Steps in Cloth Simulation" by D. Baraff and
+// A. Witkin, SIGGRAPH 1998.
+//
+// The system is sparse, symmetric and, because the Jacobian of a spring is
+// modified so that it is negative semidefinite when the spring is
+// compressed, positive definite.  It is stored in compressed sparse row
+// form, the structure of which is created once for the spring topology,
+// and it is solved by LinearSystem::SolveSymmetricCG.  The default
+// preconditioner is JACOBI; INCOMPLETE_CHOLESKY requires fewer iterations
+// for stiff springs and large steps.  The external forces are treated
+// explicitly.
+
+namespace gte
+{
+
+template <int N, typename Real>
+class MassSpringImplicitSolver
+{
+public:
+    struct Spring
+    {
+        int particle0, particle1;
+        Real constant, length;
+    };
+
+    typedef typename LinearSystem<Real>::Preconditioner Preconditioner;
+
+    // Construction.  The default solver parameters are 64 iterations, a
+    // relative tolerance of 1e-06f for 'float' or 1e-08 for 'double', and
+    // the JACOBI preconditioner.
+    MassSpringImplicitSolver();
+
+    // Member access for the parameters of the conjugate gradient solver.
+    inline void SetMaxIterations(unsigned int maxIterations);
+    inline unsigned int GetMaxIterations() const;
+    inline void SetTolerance(Real tolerance);
+    inline Real GetTolerance() const;
+    inline void SetPreconditioner(Preconditioner preconditioner);
+    inline Preconditioner GetPreconditioner() const;
+
+    // The number of iterations of the conjugate gradient solver in the
+    // last call to Update(...).  It is GetMaxIterations()+1 when the solver
+    // did not meet the tolerance.
+    inline unsigned int GetNumIterations() const;
+
+    // Create the structure of the sparse system for the particles and the
+    // springs.  This must be called before Update(...) and again whenever
+    // the topology of the springs changes.  Changes to the spring constants
+    // and lengths do not require a call.
+    void CreateStructure(int numParticles, std::vector<Spring> const& springs);
+
+    // Advance the particles by one backward Euler step.  The springs must
+    // have the topology passed to CreateStructure(...).  The immovable
+    // particles are those for which invMass[i] is zero; their positions
+    // and velocities are not modified.  When cmodel has a thread pool, the
+    // conjugate gradient solver uses it.
+    void Update(Real step, std::vector<Spring> const& springs,
+        std::vector<Real> const& mass, std::vector<Real> const& invMass,
+        std::vector<Vector<N, Real>> const& externalAcceleration,
+        std::vector<Vector<N, Real>>& position,
+        std::vector<Vector<N, Real>>& velocity,
+        std::shared_ptr<ComputeModel> const& cmodel = nullptr);
+
+private:
+    // Compute the Jacobian block of the force on particle0 with respect to
+    // the position of particle1, which is symmetric.
+    static void GetJacobian(Spring const& spring,
+        Vector<N, Real> const& diff, Real jacobian[N][N]);
+
+    // Add the block 'scale'*jacobian to the block (i,j) of mSystem, where
+    // 'position' is the position of j in the column blocks of row block i.
+    void AddBlock(int i, int position, Real scale, Real const jacobian[N][N]);
+
+    unsigned int mMaxIterations;
+    Real mTolerance;
+    Preconditioner mPreconditioner;
+    unsigned int mNumIterations;
+
+    // The system matrix has NxN blocks.  The row block of particle i has
+    // the column blocks of i and of the particles connected to i by
+    // springs, in increasing order.  For each spring, mSpringBlock stores
+    // the positions of the blocks (p0,p0), (p0,p1), (p1,p0) and (p1,p1)
+    // within their row blocks.
+    int mNumParticles;
+    CSRMatrix<Real> mSystem;
+    std::vector<std::array<int, 4>> mSpringBlock;
+
+    // The right-hand side and the solution of the system.
+    std::vector<Real> mB, mX;
+};
+
+
+template <int N, typename Real>
+MassSpringImplicitSolver<N, Real>::MassSpringImplicitSolver()
+    :
+    mMaxIterations(64),
+    mTolerance(sizeof(Real) == sizeof(float) ? (Real)1e-06 : (Real)1e-08),
+    mPreconditioner(Preconditioner::JACOBI),
+    mNumIterations(0),
+    mNumParticles(0)
+{
+}
+
+template <int N, typename Real> inline
+void MassSpringImplicitSolver<N, Real>::SetMaxIterations(
+    unsigned int maxIterations)
+{
+    mMaxIterations = maxIterations;
+}
+
+template <int N, typename Real> inline
+unsigned int MassSpringImplicitSolver<N, Real>::GetMaxIterations() const
+{
+    return mMaxIterations;
+}
+
+template <int N, typename Real> inline
+void MassSpringImplicitSolver<N, Real>::SetTolerance(Real tolerance)
+{
+    mTolerance = tolerance;
+}
+
+template <int N, typename Real> inline
+Real MassSpringImplicitSolver<N, Real>::GetTolerance() const
+{
+    return mTolerance;
+}
+
+template <int N, typename Real> inline
+void MassSpringImplicitSolver<N, Real>::SetPreconditioner(
+    Preconditioner preconditioner)
+{
+    mPreconditioner = preconditioner;
+}
+
+template <int N, typename Real> inline
+typename MassSpringImplicitSolver<N, Real>::Preconditioner
+MassSpringImplicitSolver<N, Real>::GetPreconditioner() const
+{
+    return mPreconditioner;
+}
+
+template <int N, typename Real> inline
+unsigned int MassSpringImplicitSolver<N, Real>::GetNumIterations() const
+{
+    return mNumIterations;
+}
+
+template <int N, typename Real>
+void MassSpringImplicitSolver<N, Real>::CreateStructure(int numParticles,
+    std::vector<Spring> const& springs)
+{
+    // Create the sorted column blocks of each row block.
+    std::vector<std::vector<int>> blocks(numParticles);
+    for (int i = 0; i < numParticles; ++i)
+    {
+        blocks[i].push_back(i);
+    }
+    for (auto const& spring : springs)
+    {
+        blocks[spring.particle0].push_back(spring.particle1);
+        blocks[spring.particle1].push_back(spring.particle0);
+    }
+    for (auto& columnBlocks : blocks)
+    {
+        std::sort(columnBlocks.begin(), columnBlocks.end());
+        columnBlocks.erase(std::unique(columnBlocks.begin(),
+            columnBlocks.end()), columnBlocks.end());
+    }
+
+    // Each row of row block i has the N columns of each column block.
+    std::vector<int> rowOffsets(N * numParticles + 1), columns;
+    rowOffsets[0] = 0;
+    for (int i = 0, row = 0; i < numParticles; ++i)
+    {
+        for (int r = 0; r < N; ++r, ++row)
+        {
+            for (auto j : blocks[i])
+            {
+                for (int c = 0; c < N; ++c)
+                {
+                    columns.push_back(N * j + c);
+                }
+            }
+            rowOffsets[row + 1] = static_cast<int>(columns.size());
+        }
+    }
+
+    mNumParticles = numParticles;
+    mSystem = CSRMatrix<Real>(N * numParticles, N * numParticles, rowOffsets,
+        columns);
+    mB.resize(N * numParticles);
+    mX.resize(N * numParticles);
+
+    auto GetPosition = [&blocks](int i, int j)
+    {
+        return static_cast<int>(std::lower_bound(blocks[i].begin(),
+            blocks[i].end(), j) - blocks[i].begin());
+    };
+
+    mSpringBlock.resize(springs.size());
+    for (size_t s = 0; s < springs.size(); ++s)
+    {
+        int i0 = springs[s].particle0, i1 = springs[s].particle1;
+        mSpringBlock[s][0] = GetPosition(i0, i0);
+        mSpringBlock[s][1] = GetPosition(i0, i1);
+        mSpringBlock[s][2] = GetPosition(i1, i0);
+        mSpringBlock[s][3] = GetPosition(i1, i1);
+    }
+}
+
+template <int N, typename Real>
+void MassSpringImplicitSolver<N, Real>::Update(Real step,
+    std::vector<Spring> const& springs, std::vector<Real> const& mass,
+    std::vector<Real> const& invMass,
+    std::vector<Vector<N, Real>> const& externalAcceleration,
+    std::vector<Vector<N, Real>>& position,
+    std::vector<Vector<N, Real>>& velocity,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    LogAssert(springs.size() == mSpringBlock.size()
+        && static_cast<int>(position.size()) == mNumParticles,
+        "CreateStructure must be called for the springs.");
+
+    // The diagonal blocks of the system are M and the right-hand side is
+    // h*m*a.  The spring terms are accumulated next.  The rows and columns
+    // of the immovable particles are those of the identity matrix with a
+    // zero right-hand side, so their velocity changes are zero; the
+    // velocities of the immovable particles are treated as zero.
+    mSystem.MakeZero();
+    int const* offsets = mSystem.GetRowOffsets().data();
+    int const* columns = mSystem.GetColumns().data();
+    Real* values = mSystem.GetValues().data();
+    for (int i = 0; i < mNumParticles; ++i)
+    {
+        bool movable = (invMass[i] > (Real)0);
+        for (int r = 0; r < N; ++r)
+        {
+            int row = N * i + r;
+            int k = offsets[row];
+            while (columns[k] != row)
+            {
+                ++k;
+            }
+            values[k] = (movable ? mass[i] : (Real)1);
+            mB[row] = (movable ? step * mass[i] * externalAcceleration[i][r]
+                : (Real)0);
+        }
+    }
+
+    Real const step2 = step * step;
+    Real jacobian[N][N];
+    for (size_t s = 0; s < springs.size(); ++s)
+    {
+        Spring const& spring = springs[s];
+        int i0 = spring.particle0, i1 = spring.particle1;
+        bool movable0 = (invMass[i0] > (Real)0);
+        bool movable1 = (invMass[i1] > (Real)0);
+        if (i0 == i1 || (!movable0 && !movable1))
+        {
+            continue;
+        }
+
+        // The force on particle0 is f0 = c*(1-L/|d|)*d for d = x1 - x0, and
+        // the force on particle1 is f1 = -f0.  The Jacobian blocks are
+        // df0/dx1 = df1/dx0 = J and df0/dx0 = df1/dx1 = -J.
+        Vector<N, Real> diff = position[i1] - position[i0];
+        Real length = Length(diff);
+        if (length == (Real)0)
+        {
+            continue;
+        }
+        Vector<N, Real> force = spring.constant *
+            ((Real)1 - spring.length / length) * diff;
+        GetJacobian(spring, diff, jacobian);
+
+        // The right-hand side terms h*f + h^2*K*v.
+        Vector<N, Real> v0 = (movable0 ? velocity[i0] : Vector<N, Real>::Zero());
+        Vector<N, Real> v1 = (movable1 ? velocity[i1] : Vector<N, Real>::Zero());
+        for (int r = 0; r < N; ++r)
+        {
+            Real kv = (Real)0;
+            for (int c = 0; c < N; ++c)
+            {
+                kv += jacobian[r][c] * (v1[c] - v0[c]);
+            }
+            if (movable0)
+            {
+                mB[N * i0 + r] += step * force[r] + step2 * kv;
+            }
+            if (movable1)
+            {
+                mB[N * i1 + r] -= step * force[r] + step2 * kv;
+            }
+        }
+
+        // The matrix terms -h^2*K.  The blocks that couple a movable
+        // particle to an immovable one are zero.
+        if (movable0)
+        {
+            AddBlock(i0, mSpringBlock[s][0], step2, jacobian);
+        }
+        if (movable1)
+        {
+            AddBlock(i1, mSpringBlock[s][3], step2, jacobian);
+        }
+        if (movable0 && movable1)
+        {
+            AddBlock(i0, mSpringBlock[s][1], -step2, jacobian);
+            AddBlock(i1, mSpringBlock[s][2], -step2, jacobian);
+        }
+    }
+
+    mNumIterations = LinearSystem<Real>::SolveSymmetricCG(mSystem, mB.data(),
+        mX.data(), mMaxIterations, mTolerance, mPreconditioner, cmodel);
+
+    for (int i = 0; i < mNumParticles; ++i)
+    {
+        if (invMass[i] > (Real)0)
+        {
+            for (int r = 0; r < N; ++r)
+            {
+                velocity[i][r] += mX[N * i + r];
+            }
+            position[i] += step * velocity[i];
+        }
+    }
+}
+
+template <int N, typename Real>
+void MassSpringImplicitSolver<N, Real>::GetJacobian(Spring const& spring,
+    Vector<N, Real> const& diff, Real jacobian[N][N])
+{
+    // J = c*((1-L/|d|)*I + (L/|d|)*U*U^T) for U = d/|d|.  The first term is
+    // negative when the spring is compressed, in which case it is clamped
+    // to zero so that the system is positive definite.
+    Real length = Length(diff);
+    Real ratio = spring.length / length;
+    Real identityTerm = spring.constant * std::max((Real)1 - ratio, (Real)0);
+    Real outerTerm = spring.constant * ratio / (length * length);
+    for (int r = 0; r < N; ++r)
+    {
+        for (int c = 0; c < N; ++c)
+        {
+            jacobian[r][c] = outerTerm * diff[r] * diff[c];
+        }
+        jacobian[r][r] += identityTerm;
+    }
+}
+
+template <int N, typename Real>
+void MassSpringImplicitSolver<N, Real>::AddBlock(int i, int position,
+    Real scale, Real const jacobian[N][N])
+{
+    int const* offsets = mSystem.GetRowOffsets().data();
+    Real* values = mSystem.GetValues().data();
+    for (int r = 0; r < N; ++r)
+    {
+        Real* rowValues = values + offsets[N * i + r] + N * position;
+        for (int c = 0; c < N; ++c)
+        {
+            rowValues[c] += scale * jacobian[r][c];
+        }
+    }
+}
+
+}
@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.1.1 (2026/10/18)
 
 #pragma once
 
+#include <Physics/GteMassSpringImplicitSolver.h>
 #include <Physics/GteParticleSystem.h>
 
 namespace gte
@@ -53,6 +54,16 @@ public:
     inline Real const& GetConstantC(int r, int c) const;
     inline Real const& GetLengthC(int r, int c) const;
 
+    // The system is updated by the Runge-Kutta solver of ParticleSystem
+    // unless the implicit solver is enabled, in which case each update is a
+    // backward Euler step.  The implicit solver is stable for much larger
+    // steps when the springs are stiff; see MassSpringImplicitSolver.  Its
+    // parameters are set through GetImplicitSolver().
+    inline void SetImplicit(bool implicit);
+    inline bool IsImplicit() const;
+    inline MassSpringImplicitSolver<N, Real>& GetImplicitSolver();
+    virtual void Update(Real time);
+
     // The default external force is zero.  Derive a class from this one to
     // provide nonzero external forces such as gravity, wind, friction,
     // and so on.  This function is called by Acceleration(...) to compute
@@ -73,9 +84,19 @@ protected:
     inline int GetIndex(int r, int c) const;
     void GetCoordinates(int i, int& r, int& c) const;
 
+    // The backward Euler step of Update(...) when the system is implicit.
+    void UpdateImplicit(Real time);
+
     int mNumRows, mNumCols;
     std::vector<Real> mConstantR, mLengthR;
     std::vector<Real> mConstantC, mLengthC;
+
+    // Support for the implicit solver.  The springs are copied to
+    // mImplicitSpring for each step.
+    bool mImplicit, mImplicitStructureValid;
+    MassSpringImplicitSolver<N, Real> mImplicitSolver;
+    std::vector<typename MassSpringImplicitSolver<N, Real>::Spring> mImplicitSpring;
+    std::vector<Vector<N, Real>> mExternalAcceleration;
 };
 
 
@@ -94,7 +115,9 @@ MassSpringSurface<N, Real>::MassSpringSurface(int numRows, int numCols,
     mConstantR(numRows * numCols),
     mLengthR(numRows * numCols),
     mConstantC(numRows * numCols),
-    mLengthC(numRows * numCols)
+    mLengthC(numRows * numCols),
+    mImplicit(false),
+    mImplicitStructureValid(false)
 {
     std::fill(mConstantR.begin(), mConstantR.end(), (Real)0);
     std::fill(mLengthR.begin(), mLengthR.end(), (Real)0);
@@ -202,6 +225,37 @@ Real const& MassSpringSurface<N, Real>::GetLengthC(int r, int c) const
     return mLengthC[GetIndex(r, c)];
 }
 
+template <int N, typename Real> inline
+void MassSpringSurface<N, Real>::SetImplicit(bool implicit)
+{
+    mImplicit = implicit;
+}
+
+template <int N, typename Real> inline
+bool MassSpringSurface<N, Real>::IsImplicit() const
+{
+    return mImplicit;
+}
+
+template <int N, typename Real> inline
+MassSpringImplicitSolver<N, Real>& MassSpringSurface<N, Real>::GetImplicitSolver()
+{
+    return mImplicitSolver;
+}
+
+template <int N, typename Real>
+void MassSpringSurface<N, Real>::Update(Real time)
+{
+    if (mImplicit)
+    {
+        UpdateImplicit(time);
+    }
+    else
+    {
+        ParticleSystem<N, Real>::Update(time);
+    }
+}
+
 template <int N, typename Real>
 Vector<N, Real> MassSpringSurface<N, Real>::ExternalAcceleration(int, Real,
     std::vector<Vector<N, Real>> const&, std::vector<Vector<N, Real>> const&)
@@ -281,5 +335,49 @@ void MassSpringSurface<N, Real>::GetCoordinates(int i, int& r, int& c) const
     r = i / mNumCols;
 }
 
+template <int N, typename Real>
+void MassSpringSurface<N, Real>::UpdateImplicit(Real time)
+{
+    // The spring to (r+1,c) precedes the spring to (r,c+1) for each (r,c).
+    mImplicitSpring.clear();
+    for (int r = 0; r < mNumRows; ++r)
+    {
+        for (int c = 0; c < mNumCols; ++c)
+        {
+            int i = GetIndex(r, c);
+            if (r < mNumRows - 1)
+            {
+                mImplicitSpring.push_back({ i, i + mNumCols, mConstantR[i],
+                    mLengthR[i] });
+            }
+            if (c < mNumCols - 1)
+            {
+                mImplicitSpring.push_back({ i, i + 1, mConstantC[i],
+                    mLengthC[i] });
+            }
+        }
+    }
+
+    if (!mImplicitStructureValid)
+    {
+        mImplicitSolver.CreateStructure(this->mNumParticles, mImplicitSpring);
+        mExternalAcceleration.resize(this->mNumParticles);
+        mImplicitStructureValid = true;
+    }
+
+    this->ParallelFor([this, time](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            mExternalAcceleration[i] = ExternalAcceleration(i, time,
+                this->mPosition, this->mVelocity);
+        }
+    });
+
+    mImplicitSolver.Update(this->mStep, mImplicitSpring, this->mMass,
+        this->mInvMass, mExternalAcceleration, this->mPosition,
+        this->mVelocity, this->mComputeModel);
+}
+
 
 }
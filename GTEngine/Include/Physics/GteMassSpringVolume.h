@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.1.1 (2026/10/18)
 
 #pragma once
 
+#include <Physics/GteMassSpringImplicitSolver.h>
 #include <Physics/GteParticleSystem.h>
 
 namespace gte
@@ -69,6 +70,16 @@ public:
     inline Real const& GetConstantC(int s, int r, int c) const;
     inline Real const& GetLengthC(int s, int r, int c) const;
 
+    // The system is updated by the Runge-Kutta solver of ParticleSystem
+    // unless the implicit solver is enabled, in which case each update is a
+    // backward Euler step.  The implicit solver is stable for much larger
+    // steps when the springs are stiff; see MassSpringImplicitSolver.  Its
+    // parameters are set through GetImplicitSolver().
+    inline void SetImplicit(bool implicit);
+    inline bool IsImplicit() const;
+    inline MassSpringImplicitSolver<N, Real>& GetImplicitSolver();
+    virtual void Update(Real time);
+
     // The default external force is zero.  Derive a class from this one to
     // provide nonzero external forces such as gravity, wind, friction,
     // and so on.  This function is called by Acceleration(...) to compute
@@ -89,10 +100,20 @@ protected:
     inline int GetIndex(int s, int r, int c) const;
     void GetCoordinates(int i, int& s, int& r, int& c) const;
 
+    // The backward Euler step of Update(...) when the system is implicit.
+    void UpdateImplicit(Real time);
+
     int mNumSlices, mNumRows, mNumCols;
     std::vector<Real> mConstantS, mLengthS;
     std::vector<Real> mConstantR, mLengthR;
     std::vector<Real> mConstantC, mLengthC;
+
+    // Support for the implicit solver.  The springs are copied to
+    // mImplicitSpring for each step.
+    bool mImplicit, mImplicitStructureValid;
+    MassSpringImplicitSolver<N, Real> mImplicitSolver;
+    std::vector<typename MassSpringImplicitSolver<N, Real>::Spring> mImplicitSpring;
+    std::vector<Vector<N, Real>> mExternalAcceleration;
 };
 
 
@@ -114,7 +135,9 @@ MassSpringVolume<N, Real>::MassSpringVolume(int numSlices, int numRows,
     mConstantR(numSlices * numRows * numCols),
     mLengthR(numSlices * numRows * numCols),
     mConstantC(numSlices * numRows * numCols),
-    mLengthC(numSlices * numRows * numCols)
+    mLengthC(numSlices * numRows * numCols),
+    mImplicit(false),
+    mImplicitStructureValid(false)
 {
     std::fill(mConstantS.begin(), mConstantS.end(), (Real)0);
     std::fill(mLengthS.begin(), mLengthS.end(), (Real)0);
@@ -257,6 +280,37 @@ Real const& MassSpringVolume<N, Real>::GetLengthC(int s, int r, int c) const
     return mLengthC[GetIndex(s, r, c)];
 }
 
+template <int N, typename Real> inline
+void MassSpringVolume<N, Real>::SetImplicit(bool implicit)
+{
+    mImplicit = implicit;
+}
+
+template <int N, typename Real> inline
+bool MassSpringVolume<N, Real>::IsImplicit() const
+{
+    return mImplicit;
+}
+
+template <int N, typename Real> inline
+MassSpringImplicitSolver<N, Real>& MassSpringVolume<N, Real>::GetImplicitSolver()
+{
+    return mImplicitSolver;
+}
+
+template <int N, typename Real>
+void MassSpringVolume<N, Real>::Update(Real time)
+{
+    if (mImplicit)
+    {
+        UpdateImplicit(time);
+    }
+    else
+    {
+        ParticleSystem<N, Real>::Update(time);
+    }
+}
+
 template <int N, typename Real>
 Vector<N, Real> MassSpringVolume<N, Real>::ExternalAcceleration(int, Real,
     std::vector<Vector<N, Real>> const&, std::vector<Vector<N, Real>> const&)
@@ -357,5 +411,59 @@ const
     s = i / mNumRows;
 }
 
+template <int N, typename Real>
+void MassSpringVolume<N, Real>::UpdateImplicit(Real time)
+{
+    // The springs to (s+1,r,c), (s,r+1,c) and (s,r,c+1) are stored in that
+    // order for each (s,r,c).
+    int const sliceSize = mNumRows * mNumCols;
+    mImplicitSpring.clear();
+    for (int s = 0; s < mNumSlices; ++s)
+    {
+        for (int r = 0; r < mNumRows; ++r)
+        {
+            for (int c = 0; c < mNumCols; ++c)
+            {
+                int i = GetIndex(s, r, c);
+                if (s < mNumSlices - 1)
+                {
+                    mImplicitSpring.push_back({ i, i + sliceSize,
+                        mConstantS[i], mLengthS[i] });
+                }
+                if (r < mNumRows - 1)
+                {
+                    mImplicitSpring.push_back({ i, i + mNumCols,
+                        mConstantR[i], mLengthR[i] });
+                }
+                if (c < mNumCols - 1)
+                {
+                    mImplicitSpring.push_back({ i, i + 1, mConstantC[i],
+                        mLengthC[i] });
+                }
+            }
+        }
+    }
+
+    if (!mImplicitStructureValid)
+    {
+        mImplicitSolver.CreateStructure(this->mNumParticles, mImplicitSpring);
+        mExternalAcceleration.resize(this->mNumParticles);
+        mImplicitStructureValid = true;
+    }
+
+    this->ParallelFor([this, time](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            mExternalAcceleration[i] = ExternalAcceleration(i, time,
+                this->mPosition, this->mVelocity);
+        }
+    });
+
+    mImplicitSolver.Update(this->mStep, mImplicitSpring, this->mMass,
+        this->mInvMass, mExternalAcceleration, this->mPosition,
+        this->mVelocity, this->mComputeModel);
+}
+
 
 }
@@ -0,0 +1,161 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#pragma once
+
+#include <GTEngineDEF.h>
+#include <Mathematics/GteEdgeKey.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// The set of overlapping pairs (i,j) of a broad-phase collision culler such
+// as BoxManager or RectangleManager.  The pairs are stored in a contiguous
+// array for iteration and are located by an open-addressing hash table, so
+// insertion and removal are constant-time operations.  The array is not
+// sorted.  Removal moves the last pair of the array into the hole.
+//
+// Changes are recorded between calls to BeginUpdate and EndUpdate.  When
+// EndUpdate returns, GetAdded() contains the pairs that were not in the set
+// at BeginUpdate but are in it now, and GetRemoved() contains the pairs that
+// were in the set at BeginUpdate but are not in it now.  A pair that is
+// inserted and removed during the same update is in neither array.
+
+namespace gte
+{
+
+class GTE_IMPEXP OverlapSet
+{
+public:
+    // Construction.  The set is empty.
+    OverlapSet();
+
+    // Remove all pairs.  The added and removed arrays are also cleared.
+    void Clear();
+
+    // Member access.  The pairs (i,j) are stored with i < j.
+    inline int GetNumPairs() const;
+    inline std::vector<EdgeKey<false>> const& GetPairs() const;
+    inline std::vector<EdgeKey<false>> const& GetAdded() const;
+    inline std::vector<EdgeKey<false>> const& GetRemoved() const;
+    bool Contains(int i, int j) const;
+
+    // The order of i and j is irrelevant.  The return value is 'true' when
+    // the set is modified.
+    bool Insert(int i, int j);
+    bool Remove(int i, int j);
+
+    // Support for reporting the changes to the set.
+    void BeginUpdate();
+    void EndUpdate();
+
+private:
+    // An open-addressing hash table with linear probing that maps the pair
+    // (i,j), packed into 64 bits, to an integer.  Removal shifts keys
+    // backward to keep the probe sequences short.
+    class Table
+    {
+    public:
+        Table();
+
+        void Clear();
+        inline size_t GetCapacity() const;
+        int* Find(uint64_t key);
+        int const* Find(uint64_t key) const;
+        void Insert(uint64_t key, int value);
+        void Remove(uint64_t key);
+
+    private:
+        static uint64_t const EMPTY_KEY = 0xFFFFFFFFFFFFFFFFull;
+        static inline uint64_t Hash(uint64_t key);
+        size_t GetSlot(uint64_t key) const;
+        void Rehash(size_t capacity);
+
+        std::vector<uint64_t> mKeys;
+        std::vector<int> mValues;
+        size_t mMask;
+        int mNumKeys;
+    };
+
+    static inline uint64_t GetKey(int i, int j);
+    static inline EdgeKey<false> GetPair(uint64_t key);
+
+    // Remove the keys of mTouchedTable and clear mTouched.
+    void ClearTouched();
+
+    // Record that the pair is about to change.  The first change in an
+    // update stores whether the pair was in the set at BeginUpdate.
+    void Touch(uint64_t key, bool contained);
+
+    // The values of mTable are the indices into mPairs.
+    std::vector<EdgeKey<false>> mPairs;
+    Table mTable;
+
+    // The pairs changed during the current update.  The values of
+    // mTouchedTable are 1 when the pair was in the set at BeginUpdate or 0
+    // otherwise.
+    bool mUpdating;
+    std::vector<uint64_t> mTouched;
+    Table mTouchedTable;
+    std::vector<EdgeKey<false>> mAdded, mRemoved;
+};
+
+
+inline int OverlapSet::GetNumPairs() const
+{
+    return static_cast<int>(mPairs.size());
+}
+
+inline std::vector<EdgeKey<false>> const& OverlapSet::GetPairs() const
+{
+    return mPairs;
+}
+
+inline std::vector<EdgeKey<false>> const& OverlapSet::GetAdded() const
+{
+    return mAdded;
+}
+
+inline std::vector<EdgeKey<false>> const& OverlapSet::GetRemoved() const
+{
+    return mRemoved;
+}
+
+inline uint64_t OverlapSet::GetKey(int i, int j)
+{
+    if (i > j)
+    {
+        std::swap(i, j);
+    }
+    return (static_cast<uint64_t>(static_cast<uint32_t>(i)) << 32)
+        | static_cast<uint64_t>(static_cast<uint32_t>(j));
+}
+
+inline EdgeKey<false> OverlapSet::GetPair(uint64_t key)
+{
+    return EdgeKey<false>(static_cast<int>(key >> 32),
+        static_cast<int>(key & 0xFFFFFFFFull));
+}
+
+inline size_t OverlapSet::Table::GetCapacity() const
+{
+    return mKeys.size();
+}
+
+inline uint64_t OverlapSet::Table::Hash(uint64_t key)
+{
+    // The finalizer of the SplitMix64 generator.
+    key ^= (key >> 30);
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= (key >> 27);
+    key *= 0x94D049BB133111EBull;
+    key ^= (key >> 31);
+    return key;
+}
+
+}
@@ -3,14 +3,38 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.3.0 (2026/10/18)
 
 #pragma once
 
+#include <LowLevel/GteComputeModel.h>
+#include <LowLevel/GteLogger.h>
 #include <Mathematics/GteVector.h>
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <vector>
 
+// The Runge-Kutta solver has two forms.  The default form calls
+// Acceleration(i,...) for each particle at each stage of the solver.  The
+// batched form, selected by passing 'true' for 'batched' to the constructor,
+// calls BatchAcceleration(...) once per stage to compute the accelerations
+// of all the particles.  The batched form stores the particle states in
+// structure-of-arrays form: component d of the position of particle i is
+// element i of array d.  The stages of the solver are then loops over
+// contiguous arrays of Real that the compiler vectorizes, and a derived
+// class may vectorize or multithread its acceleration computations.  Both
+// forms produce the same results when the accelerations are the same.
+//
+// When a compute model with a thread pool is set, the particles are
+// partitioned into ranges that are processed concurrently at each stage of
+// the solver, so Acceleration(i,...) is called concurrently for different
+// particles and must not modify shared state.  The state of a particle is
+// computed by the same operations regardless of the partition, so the
+// results do not depend on the number of threads.
+
 namespace gte
 {
 
@@ -21,33 +45,57 @@ public:
     // Construction and destruction.  If a particle is to be immovable, set
     // its mass to std::numeric_limits<Real>::max().
     virtual ~ParticleSystem();
-    ParticleSystem(int numParticles, Real step);
+    ParticleSystem(int numParticles, Real step, bool batched = false);
 
     // Member access.
     inline int GetNumParticles() const;
     void SetMass(int i, Real mass);
-    inline void SetPosition(int i, Vector<N, Real> const& position);
-    inline void SetVelocity(int i, Vector<N, Real> const& velocity);
+    void SetPosition(int i, Vector<N, Real> const& position);
+    void SetVelocity(int i, Vector<N, Real> const& velocity);
     void SetStep(Real step);
     inline Real const& GetMass(int i) const;
     inline Vector<N, Real> const& GetPosition(int i) const;
     inline Vector<N, Real> const& GetVelocity(int i) const;
     inline Real GetStep() const;
+    inline bool IsBatched() const;
+
+    // Set the compute model for multithreading the updates.  The system is
+    // updated by the calling thread when cmodel is null or has no thread
+    // pool.
+    void SetComputeModel(std::shared_ptr<ComputeModel> const& cmodel);
 
     // Update the particle positions based on current time and particle state.
     // The Acceleration(...) function is called in this update for each
-    // particle.  This function is virtual so that derived classes can perform
-    // pre-update and/or post-update semantics.
+    // particle, or the BatchAcceleration(...) function is called for all
+    // particles when the system is batched.  This function is virtual so
+    // that derived classes can perform pre-update and/or post-update
+    // semantics.
     virtual void Update(Real time);
 
 protected:
     // Callback for acceleration (ODE solver uses x" = F/m) applied to
     // particle i.  The positions and velocities are not necessarily
     // mPosition and mVelocity, because the ODE solver evaluates the
-    // impulse function at intermediate positions.
+    // impulse function at intermediate positions.  A batched system need
+    // not implement this function.
     virtual Vector<N, Real> Acceleration(int i, Real time,
         std::vector<Vector<N, Real>> const& position,
-        std::vector<Vector<N, Real>> const& velocity) = 0;
+        std::vector<Vector<N, Real>> const& velocity);
+
+    // Callback for the accelerations of all particles of a batched system.
+    // The inputs position[d], velocity[d] and the output acceleration[d]
+    // are arrays of mNumParticles elements that store component d of the
+    // vectors.  The accelerations of the immovable particles are ignored.
+    virtual void BatchAcceleration(Real time, Real const* const* position,
+        Real const* const* velocity, Real* const* acceleration);
+
+    // The Runge-Kutta solver for batched systems.
+    void UpdateBatched(Real time);
+
+    // Partition the particles into ranges and call function(imin,imax) for
+    // each range [imin,imax), concurrently when the system has a thread
+    // pool.
+    void ParallelFor(std::function<void(int, int)> const& function);
 
     int mNumParticles;
     std::vector<Real> mMass, mInvMass;
@@ -61,6 +109,21 @@ protected:
     };
     std::vector<Vector<N, Real>> mPTmp, mVTmp;
     std::vector<Temporary> mPAllTmp, mVAllTmp;
+
+    // The particle states of a batched system in structure-of-arrays form.
+    // These are the states used by the solver; mPosition and mVelocity are
+    // copies that are updated by SetPosition, SetVelocity and Update.
+    bool mBatched;
+    std::array<std::vector<Real>, N> mBatchPosition, mBatchVelocity;
+
+    // Temporary storage for the batched solver.  The d1 terms of the
+    // position and velocity are the velocity and mBatchVD1, and the sums of
+    // the d2 and d3 terms are accumulated in mBatchPD23 and mBatchVD23.
+    std::array<std::vector<Real>, N> mBatchPTmp, mBatchVTmp, mBatchAcceleration;
+    std::array<std::vector<Real>, N> mBatchVD1, mBatchPD23, mBatchVD23;
+
+    std::shared_ptr<ComputeModel> mComputeModel;
+    std::shared_ptr<ThreadPool> mThreadPool;
 };
 
 
@@ -70,7 +133,8 @@ ParticleSystem<N, Real>::~ParticleSystem()
 }
 
 template <int N, typename Real> inline
-ParticleSystem<N, Real>::ParticleSystem(int numParticles, Real step)
+ParticleSystem<N, Real>::ParticleSystem(int numParticles, Real step,
+    bool batched)
 :
 mNumParticles(numParticles),
 mMass(numParticles),
@@ -80,15 +144,31 @@ mVelocity(numParticles),
 mStep(step),
 mHalfStep(step / (Real)2),
 mSixthStep(step / (Real)6),
-mPTmp(numParticles),
-mVTmp(numParticles),
-mPAllTmp(numParticles),
-mVAllTmp(numParticles)
+mPTmp(batched ? 0 : numParticles),
+mVTmp(batched ? 0 : numParticles),
+mPAllTmp(batched ? 0 : numParticles),
+mVAllTmp(batched ? 0 : numParticles),
+mBatched(batched)
 {
     std::fill(mMass.begin(), mMass.end(), (Real)0);
     std::fill(mInvMass.begin(), mInvMass.end(), (Real)0);
     std::fill(mPosition.begin(), mPosition.end(), Vector<N, Real>::Zero());
     std::fill(mVelocity.begin(), mVelocity.end(), Vector<N, Real>::Zero());
+
+    if (mBatched)
+    {
+        for (int d = 0; d < N; ++d)
+        {
+            mBatchPosition[d].resize(numParticles, (Real)0);
+            mBatchVelocity[d].resize(numParticles, (Real)0);
+            mBatchPTmp[d].resize(numParticles);
+            mBatchVTmp[d].resize(numParticles);
+            mBatchAcceleration[d].resize(numParticles);
+            mBatchVD1[d].resize(numParticles);
+            mBatchPD23[d].resize(numParticles);
+            mBatchVD23[d].resize(numParticles);
+        }
+    }
 }
 
 template <int N, typename Real> inline
@@ -112,18 +192,32 @@ void ParticleSystem<N, Real>::SetMass(int i, Real mass)
     }
 }
 
-template <int N, typename Real> inline
+template <int N, typename Real>
 void ParticleSystem<N, Real>::SetPosition(int i,
 Vector<N, Real> const& position)
 {
     mPosition[i] = position;
+    if (mBatched)
+    {
+        for (int d = 0; d < N; ++d)
+        {
+            mBatchPosition[d][i] = position[d];
+        }
+    }
 }
 
-template <int N, typename Real> inline
+template <int N, typename Real>
 void ParticleSystem<N, Real>::SetVelocity(int i,
 Vector<N, Real> const& velocity)
 {
     mVelocity[i] = velocity;
+    if (mBatched)
+    {
+        for (int d = 0; d < N; ++d)
+        {
+            mBatchVelocity[d][i] = velocity[d];
+        }
+    }
 }
 
 template <int N, typename Real>
@@ -158,106 +252,314 @@ Real ParticleSystem<N, Real>::GetStep() const
     return mStep;
 }
 
+template <int N, typename Real> inline
+bool ParticleSystem<N, Real>::IsBatched() const
+{
+    return mBatched;
+}
+
+template <int N, typename Real>
+void ParticleSystem<N, Real>::SetComputeModel(
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    mComputeModel = cmodel;
+    mThreadPool = (cmodel ? cmodel->threadPool : nullptr);
+}
+
 template <int N, typename Real>
 void ParticleSystem<N, Real>::Update(Real time)
 {
+    if (mBatched)
+    {
+        UpdateBatched(time);
+        return;
+    }
+
     // Runge-Kutta fourth-order solver.
     Real halfTime = time + mHalfStep;
     Real fullTime = time + mStep;
 
     // Compute the first step.
-    int i;
-    for (i = 0; i < mNumParticles; ++i)
+    ParallelFor([this, time](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int i = imin; i < imax; ++i)
         {
-            mPAllTmp[i].d1 = mVelocity[i];
-            mVAllTmp[i].d1 = Acceleration(i, time, mPosition, mVelocity);
+            if (mInvMass[i] >(Real)0)
+            {
+                mPAllTmp[i].d1 = mVelocity[i];
+                mVAllTmp[i].d1 = Acceleration(i, time, mPosition, mVelocity);
+            }
         }
-    }
-    for (i = 0; i < mNumParticles; ++i)
+    });
+    ParallelFor([this](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
-        {
-            mPTmp[i] = mPosition[i] + mHalfStep * mPAllTmp[i].d1;
-            mVTmp[i] = mVelocity[i] + mHalfStep * mVAllTmp[i].d1;
-        }
-        else
+        for (int i = imin; i < imax; ++i)
         {
-            mPTmp[i] = mPosition[i];
-            mVTmp[i].MakeZero();
+            if (mInvMass[i] >(Real)0)
+            {
+                mPTmp[i] = mPosition[i] + mHalfStep * mPAllTmp[i].d1;
+                mVTmp[i] = mVelocity[i] + mHalfStep * mVAllTmp[i].d1;
+            }
+            else
+            {
+                mPTmp[i] = mPosition[i];
+                mVTmp[i].MakeZero();
+            }
         }
-    }
+    });
 
     // Compute the second step.
-    for (i = 0; i < mNumParticles; ++i)
+    ParallelFor([this, halfTime](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int i = imin; i < imax; ++i)
         {
-            mPAllTmp[i].d2 = mVTmp[i];
-            mVAllTmp[i].d2 = Acceleration(i, halfTime, mPTmp, mVTmp);
+            if (mInvMass[i] >(Real)0)
+            {
+                mPAllTmp[i].d2 = mVTmp[i];
+                mVAllTmp[i].d2 = Acceleration(i, halfTime, mPTmp, mVTmp);
+            }
         }
-    }
-    for (i = 0; i < mNumParticles; ++i)
+    });
+    ParallelFor([this](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int i = imin; i < imax; ++i)
         {
-            mPTmp[i] = mPosition[i] + mHalfStep * mPAllTmp[i].d2;
-            mVTmp[i] = mVelocity[i] + mHalfStep * mVAllTmp[i].d2;
+            if (mInvMass[i] >(Real)0)
+            {
+                mPTmp[i] = mPosition[i] + mHalfStep * mPAllTmp[i].d2;
+                mVTmp[i] = mVelocity[i] + mHalfStep * mVAllTmp[i].d2;
+            }
+            else
+            {
+                mPTmp[i] = mPosition[i];
+                mVTmp[i].MakeZero();
+            }
         }
-        else
+    });
+
+    // Compute the third step.
+    ParallelFor([this, halfTime](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
         {
-            mPTmp[i] = mPosition[i];
-            mVTmp[i].MakeZero();
+            if (mInvMass[i] >(Real)0)
+            {
+                mPAllTmp[i].d3 = mVTmp[i];
+                mVAllTmp[i].d3 = Acceleration(i, halfTime, mPTmp, mVTmp);
+            }
         }
-    }
+    });
+    ParallelFor([this](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            if (mInvMass[i] >(Real)0)
+            {
+                mPTmp[i] = mPosition[i] + mStep * mPAllTmp[i].d3;
+                mVTmp[i] = mVelocity[i] + mStep * mVAllTmp[i].d3;
+            }
+            else
+            {
+                mPTmp[i] = mPosition[i];
+                mVTmp[i].MakeZero();
+            }
+        }
+    });
 
-    // Compute the third step.
-    for (i = 0; i < mNumParticles; ++i)
+    // Compute the fourth step.
+    ParallelFor([this, fullTime](int imin, int imax)
+    {
+        for (int i = imin; i < imax; ++i)
+        {
+            if (mInvMass[i] >(Real)0)
+            {
+                mPAllTmp[i].d4 = mVTmp[i];
+                mVAllTmp[i].d4 = Acceleration(i, fullTime, mPTmp, mVTmp);
+            }
+        }
+    });
+    ParallelFor([this](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int i = imin; i < imax; ++i)
         {
-            mPAllTmp[i].d3 = mVTmp[i];
-            mVAllTmp[i].d3 = Acceleration(i, halfTime, mPTmp, mVTmp);
+            if (mInvMass[i] >(Real)0)
+            {
+                mPosition[i] += mSixthStep * (mPAllTmp[i].d1 +
+                    ((Real)2) * (mPAllTmp[i].d2 + mPAllTmp[i].d3) +
+                    mPAllTmp[i].d4);
+
+                mVelocity[i] += mSixthStep * (mVAllTmp[i].d1 +
+                    ((Real)2) * (mVAllTmp[i].d2 + mVAllTmp[i].d3) +
+                    mVAllTmp[i].d4);
+            }
         }
+    });
+}
+
+template <int N, typename Real>
+Vector<N, Real> ParticleSystem<N, Real>::Acceleration(int, Real,
+    std::vector<Vector<N, Real>> const&, std::vector<Vector<N, Real>> const&)
+{
+    LogError("Acceleration must be implemented by the derived class.");
+    return Vector<N, Real>::Zero();
+}
+
+template <int N, typename Real>
+void ParticleSystem<N, Real>::BatchAcceleration(Real, Real const* const*,
+    Real const* const*, Real* const*)
+{
+    LogError("BatchAcceleration must be implemented by the derived class.");
+}
+
+template <int N, typename Real>
+void ParticleSystem<N, Real>::UpdateBatched(Real time)
+{
+    // Runge-Kutta fourth-order solver.  The loops have no branches so that
+    // they are vectorized; the immovable particles are handled by selecting
+    // zero for their velocities and increments.  The arithmetic operations
+    // are those of the unbatched solver.
+    Real halfTime = time + mHalfStep;
+    Real fullTime = time + mStep;
+    Real const* invMass = mInvMass.data();
+
+    Real const* position[N];
+    Real const* velocity[N];
+    Real const* pTmp[N];
+    Real const* vTmp[N];
+    Real* acceleration[N];
+    for (int d = 0; d < N; ++d)
+    {
+        position[d] = mBatchPosition[d].data();
+        velocity[d] = mBatchVelocity[d].data();
+        pTmp[d] = mBatchPTmp[d].data();
+        vTmp[d] = mBatchVTmp[d].data();
+        acceleration[d] = mBatchAcceleration[d].data();
     }
-    for (i = 0; i < mNumParticles; ++i)
+
+    // Compute the first step.
+    BatchAcceleration(time, position, velocity, acceleration);
+    ParallelFor([this, invMass](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int d = 0; d < N; ++d)
         {
-            mPTmp[i] = mPosition[i] + mStep * mPAllTmp[i].d3;
-            mVTmp[i] = mVelocity[i] + mStep * mVAllTmp[i].d3;
+            Real const* x = mBatchPosition[d].data();
+            Real const* v = mBatchVelocity[d].data();
+            Real const* a = mBatchAcceleration[d].data();
+            Real* vd1 = mBatchVD1[d].data();
+            Real* xt = mBatchPTmp[d].data();
+            Real* vt = mBatchVTmp[d].data();
+            for (int i = imin; i < imax; ++i)
+            {
+                bool movable = (invMass[i] > (Real)0);
+                vd1[i] = a[i];
+                xt[i] = (movable ? x[i] + mHalfStep * v[i] : x[i]);
+                vt[i] = (movable ? v[i] + mHalfStep * a[i] : (Real)0);
+            }
         }
-        else
+    });
+
+    // Compute the second step.
+    BatchAcceleration(halfTime, pTmp, vTmp, acceleration);
+    ParallelFor([this, invMass](int imin, int imax)
+    {
+        for (int d = 0; d < N; ++d)
         {
-            mPTmp[i] = mPosition[i];
-            mVTmp[i].MakeZero();
+            Real const* x = mBatchPosition[d].data();
+            Real const* v = mBatchVelocity[d].data();
+            Real const* a = mBatchAcceleration[d].data();
+            Real* pd23 = mBatchPD23[d].data();
+            Real* vd23 = mBatchVD23[d].data();
+            Real* xt = mBatchPTmp[d].data();
+            Real* vt = mBatchVTmp[d].data();
+            for (int i = imin; i < imax; ++i)
+            {
+                bool movable = (invMass[i] > (Real)0);
+                Real pd2 = vt[i];
+                pd23[i] = pd2;
+                vd23[i] = a[i];
+                xt[i] = (movable ? x[i] + mHalfStep * pd2 : x[i]);
+                vt[i] = (movable ? v[i] + mHalfStep * a[i] : (Real)0);
+            }
         }
-    }
+    });
 
-    // Compute the fourth step.
-    for (i = 0; i < mNumParticles; ++i)
+    // Compute the third step.
+    BatchAcceleration(halfTime, pTmp, vTmp, acceleration);
+    ParallelFor([this, invMass](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int d = 0; d < N; ++d)
         {
-            mPAllTmp[i].d4 = mVTmp[i];
-            mVAllTmp[i].d4 = Acceleration(i, fullTime, mPTmp, mVTmp);
+            Real const* x = mBatchPosition[d].data();
+            Real const* v = mBatchVelocity[d].data();
+            Real const* a = mBatchAcceleration[d].data();
+            Real* pd23 = mBatchPD23[d].data();
+            Real* vd23 = mBatchVD23[d].data();
+            Real* xt = mBatchPTmp[d].data();
+            Real* vt = mBatchVTmp[d].data();
+            for (int i = imin; i < imax; ++i)
+            {
+                bool movable = (invMass[i] > (Real)0);
+                Real pd3 = vt[i];
+                pd23[i] += pd3;
+                vd23[i] += a[i];
+                xt[i] = (movable ? x[i] + mStep * pd3 : x[i]);
+                vt[i] = (movable ? v[i] + mStep * a[i] : (Real)0);
+            }
         }
-    }
-    for (i = 0; i < mNumParticles; ++i)
+    });
+
+    // Compute the fourth step and copy the states to the arrays of vectors.
+    BatchAcceleration(fullTime, pTmp, vTmp, acceleration);
+    ParallelFor([this, invMass](int imin, int imax)
     {
-        if (mInvMass[i] >(Real)0)
+        for (int d = 0; d < N; ++d)
         {
-            mPosition[i] += mSixthStep * (mPAllTmp[i].d1 +
-                ((Real)2) * (mPAllTmp[i].d2 + mPAllTmp[i].d3) +
-                mPAllTmp[i].d4);
+            Real* x = mBatchPosition[d].data();
+            Real* v = mBatchVelocity[d].data();
+            Real const* a = mBatchAcceleration[d].data();
+            Real const* vd1 = mBatchVD1[d].data();
+            Real const* pd23 = mBatchPD23[d].data();
+            Real const* vd23 = mBatchVD23[d].data();
+            Real const* vt = mBatchVTmp[d].data();
+            for (int i = imin; i < imax; ++i)
+            {
+                bool movable = (invMass[i] > (Real)0);
+                Real dx = mSixthStep * (v[i] + ((Real)2) * pd23[i] + vt[i]);
+                Real dv = mSixthStep * (vd1[i] + ((Real)2) * vd23[i] + a[i]);
+                x[i] += (movable ? dx : (Real)0);
+                v[i] += (movable ? dv : (Real)0);
+            }
+        }
 
-            mVelocity[i] += mSixthStep * (mVAllTmp[i].d1 +
-                ((Real)2) * (mVAllTmp[i].d2 + mVAllTmp[i].d3) +
-                mVAllTmp[i].d4);
+        for (int i = imin; i < imax; ++i)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                mPosition[i][d] = mBatchPosition[d][i];
+                mVelocity[i][d] = mBatchVelocity[d][i];
+            }
         }
-    }
+    });
 }
 
+template <int N, typename Real>
+void ParticleSystem<N, Real>::ParallelFor(
+    std::function<void(int, int)> const& function)
+{
+    // The ranges have at least minRangeSize particles so that the cost of
+    // scheduling is small compared to the work.
+    int const minRangeSize = 1024;
+    if (mThreadPool && mNumParticles >= 2 * minRangeSize)
+    {
+        int numRanges = std::min(4 * static_cast<int>(mThreadPool->GetNumThreads()),
+            mNumParticles / minRangeSize);
+        int grainSize = (mNumParticles + numRanges - 1) / numRanges;
+        mThreadPool->ParallelFor(0, mNumParticles, grainSize, function);
+    }
+    else
+    {
+        function(0, mNumParticles);
+    }
+}
 
 }
@@ -3,16 +3,38 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.1.0 (2026/10/18)
 
 #pragma once
 
+#include <LowLevel/GteComputeModel.h>
 #include <Mathematics/GteIntrAlignedBox2AlignedBox2.h>
-#include <Mathematics/GteEdgeKey.h>
+#include <Physics/GteActiveList.h>
+#include <Physics/GteOverlapSet.h>
 #include <algorithm>
-#include <set>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+// The sweep of Initialize() is along the axis for which the rectangle
+// centers have the largest variance, which minimizes the number of
+// rectangles that overlap on the sweep axis but not on the other axis.  When
+// the manager is constructed with a compute model that has a thread pool,
+// the work is partitioned among the threads.
+//   1. Initialize() sorts the endpoints of the two axes concurrently.  The
+//      sorted endpoints of the sweep axis are partitioned into contiguous
+//      ranges that are swept concurrently.  The sweep of a range starts with
+//      the rectangles whose intervals contain the first endpoint of the
+//      range.  Each pair is found in exactly one range, namely, the one
+//      containing the 'begin' endpoint that is larger, so the pairs of the
+//      ranges are merged without locks or duplicate removal.
+//   2. Update() applies the insertion sorts of the two axes concurrently.
+//      Each sort records the changes to the overlap set; the changes are
+//      applied in the order of the single-threaded algorithm.
+// The overlapping pairs and the added and removed pairs are identical to
+// those of the single-threaded manager, including their order in the arrays.
+
 namespace gte
 {
 
@@ -20,8 +42,11 @@ template <typename Real>
 class RectangleManager
 {
 public:
-    // Construction.
+    // Construction.  The second constructor uses the thread pool of the
+    // compute model, if it has one.
     RectangleManager(std::vector<AlignedBox2<Real>>& rectangles);
+    RectangleManager(std::vector<AlignedBox2<Real>>& rectangles,
+        std::shared_ptr<ComputeModel> const& cmodel);
 
     // No default construction, copy construction, or assignment are allowed.
     RectangleManager() = delete;
@@ -32,7 +57,8 @@ public:
     // to initialize the update system.  However, if you add or remove items
     // from the array of rectangles after the constructor call, you will need
     // to call this function once before you start the multiple calls of the
-    // update function.
+    // update function.  All the overlapping pairs are reported by GetAdded()
+    // and none by GetRemoved().
     void Initialize();
 
     // After the system is initialized, you can move the rectangles using this
@@ -47,10 +73,15 @@ public:
     // to determine the new set of overlapping rectangles.
     void Update();
 
-    // If (i,j) is in the overlap set, then rectangle i and rectangle j are
+    // If (i,j) is in the overlap array, then rectangle i and rectangle j are
     // overlapping.  The indices are those for the the input array.  The
-    // set elements (i,j) are stored so that i < j.
-    std::set<EdgeKey<false>> const& GetOverlap() const;
+    // elements (i,j) are stored so that i < j, but the array is not sorted.
+    inline std::vector<EdgeKey<false>> const& GetOverlap() const;
+
+    // The pairs that started overlapping and the pairs that stopped
+    // overlapping during the last call to Initialize() or Update().
+    inline std::vector<EdgeKey<false>> const& GetAdded() const;
+    inline std::vector<EdgeKey<false>> const& GetRemoved() const;
 
 private:
     class Endpoint
@@ -64,11 +95,45 @@ private:
         bool operator<(Endpoint const& endpoint) const;
     };
 
-    void InsertionSort (std::vector<Endpoint>& endpoint, std::vector<int>& lookup);
+    // A change of the overlap status of the pair (i0,i1) detected by the
+    // insertion sort of an axis.
+    struct Change
+    {
+        int i0, i1;
+        bool insert;
+    };
+
+    // The state of the sweep of a range of endpoints.  The active rectangles
+    // store their intervals on the axis other than the sweep axis.
+    struct Sweep
+    {
+        ActiveList<1, Real> active;
+        std::vector<int> overlaps;
+        std::vector<EdgeKey<false>> pairs;
+    };
+
+    // Create the sorted endpoints and the lookup table of axis d.
+    void InitializeAxis(int d);
+
+    // Find the pairs whose larger 'begin' endpoint on the sweep axis is one
+    // of mEndpoints[mSweepAxis][jmin..jmax-1].
+    void SweepRange(int jmin, int jmax, Sweep& sweep);
+
+    void InsertionSort(std::vector<Endpoint>& endPoint, std::vector<int>& lookup,
+        std::vector<Change>& changes);
+
+    // The rectangles i and j overlap when their intervals overlap on both
+    // axes.
+    inline bool Overlaps(int i, int j) const;
 
     std::vector<AlignedBox2<Real>>& mRectangles;
-    std::vector<Endpoint> mXEndpoints, mYEndpoints;
-    std::set<EdgeKey<false>> mOverlap;
+    std::shared_ptr<ThreadPool> mThreadPool;
+    std::array<std::vector<Endpoint>, 2> mEndpoints;
+    OverlapSet mOverlap;
+
+    // The rectangle extents in structure-of-arrays form: the interval of
+    // rectangle i on axis d is [mMin[d][i],mMax[d][i]].
+    std::array<std::vector<Real>, 2> mMin, mMax;
 
     // The intervals are indexed 0 <= i < n.  The endpoint array has 2*n
     // entries.  The original 2*n interval values are ordered as b[0], e[0],
@@ -79,13 +144,34 @@ private:
     // table of 2*n entries.  The value mLookup[2*i] is the index of b[i]
     // in the endpoint array.  The value mLookup[2*i+1] is the index of
     // e[i] in the endpoint array.
-    std::vector<int> mXLookup, mYLookup;
+    std::array<std::vector<int>, 2> mLookup;
+
+    // Support for the sweep.  mVariance[d] is the variance of the rectangle
+    // centers on axis d (times 4n).
+    std::array<Real, 2> mVariance;
+    int mSweepAxis;
+    std::vector<Sweep> mSweeps;
+
+    // Support for the update.
+    std::array<std::vector<Change>, 2> mChanges;
 };
 
 template <typename Real>
 RectangleManager<Real>::RectangleManager(std::vector<AlignedBox2<Real>>& rectangles)
     :
-    mRectangles(rectangles)
+    mRectangles(rectangles),
+    mSweepAxis(0)
+{
+    Initialize();
+}
+
+template <typename Real>
+RectangleManager<Real>::RectangleManager(std::vector<AlignedBox2<Real>>& rectangles,
+    std::shared_ptr<ComputeModel> const& cmodel)
+    :
+    mRectangles(rectangles),
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mSweepAxis(0)
 {
     Initialize();
 }
@@ -93,108 +179,266 @@ RectangleManager<Real>::RectangleManager(std::vector<AlignedBox2<Real>>& rectang
 template <typename Real>
 void RectangleManager<Real>::Initialize()
 {
-    // Get the rectangle endpoints.
+    if (mThreadPool)
+    {
+        ThreadPool::TaskGroup group(*mThreadPool);
+        group.Run([this]() { InitializeAxis(1); });
+        InitializeAxis(0);
+        group.Wait();
+    }
+    else
+    {
+        for (int d = 0; d < 2; ++d)
+        {
+            InitializeAxis(d);
+        }
+    }
+
+    mSweepAxis = (mVariance[1] > mVariance[0] ? 1 : 0);
+
+    // Partition the endpoints of the sweep axis into ranges of at least
+    // minRangeSize endpoints.
+    int const minRangeSize = 4096;
+    int endpSize = 2 * static_cast<int>(mRectangles.size());
+    int numRanges = 1;
+    if (mThreadPool)
+    {
+        numRanges = 4 * static_cast<int>(mThreadPool->GetNumThreads());
+        numRanges = std::max(std::min(numRanges, endpSize / minRangeSize), 1);
+    }
+    mSweeps.resize(numRanges);
+
+    auto sweepRange = [this, endpSize, numRanges](int r)
+    {
+        int jmin = static_cast<int>(static_cast<int64_t>(endpSize) * r / numRanges);
+        int jmax = static_cast<int>(static_cast<int64_t>(endpSize) * (r + 1) / numRanges);
+        SweepRange(jmin, jmax, mSweeps[r]);
+    };
+
+    if (numRanges > 1)
+    {
+        mThreadPool->ParallelFor(0, numRanges, 1, [&sweepRange](int rmin, int rmax)
+        {
+            for (int r = rmin; r < rmax; ++r)
+            {
+                sweepRange(r);
+            }
+        });
+    }
+    else
+    {
+        sweepRange(0);
+    }
+
+    // The pairs of the ranges are disjoint.
+    mOverlap.Clear();
+    mOverlap.BeginUpdate();
+    for (auto const& sweep : mSweeps)
+    {
+        for (auto const& pair : sweep.pairs)
+        {
+            mOverlap.Insert(pair.V[0], pair.V[1]);
+        }
+    }
+    mOverlap.EndUpdate();
+}
+
+template <typename Real>
+void RectangleManager<Real>::SetRectangle(int i, AlignedBox2<Real> const& rectangle)
+{
+    mRectangles[i] = rectangle;
+    for (int d = 0; d < 2; ++d)
+    {
+        mMin[d][i] = rectangle.min[d];
+        mMax[d][i] = rectangle.max[d];
+        mEndpoints[d][mLookup[d][2 * i]].value = rectangle.min[d];
+        mEndpoints[d][mLookup[d][2 * i + 1]].value = rectangle.max[d];
+    }
+}
+
+template <typename Real>
+void RectangleManager<Real>::GetRectangle(int i, AlignedBox2<Real>& rectangle) const
+{
+    rectangle = mRectangles[i];
+}
+
+template <typename Real>
+void RectangleManager<Real>::Update()
+{
+    if (mThreadPool)
+    {
+        ThreadPool::TaskGroup group(*mThreadPool);
+        group.Run([this]()
+        {
+            InsertionSort(mEndpoints[1], mLookup[1], mChanges[1]);
+        });
+        InsertionSort(mEndpoints[0], mLookup[0], mChanges[0]);
+        group.Wait();
+    }
+    else
+    {
+        for (int d = 0; d < 2; ++d)
+        {
+            InsertionSort(mEndpoints[d], mLookup[d], mChanges[d]);
+        }
+    }
+
+    mOverlap.BeginUpdate();
+    for (int d = 0; d < 2; ++d)
+    {
+        for (auto const& change : mChanges[d])
+        {
+            if (change.insert)
+            {
+                mOverlap.Insert(change.i0, change.i1);
+            }
+            else
+            {
+                mOverlap.Remove(change.i0, change.i1);
+            }
+        }
+    }
+    mOverlap.EndUpdate();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& RectangleManager<Real>::GetOverlap() const
+{
+    return mOverlap.GetPairs();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& RectangleManager<Real>::GetAdded() const
+{
+    return mOverlap.GetAdded();
+}
+
+template <typename Real>
+inline std::vector<EdgeKey<false>> const& RectangleManager<Real>::GetRemoved() const
+{
+    return mOverlap.GetRemoved();
+}
+
+template <typename Real>
+void RectangleManager<Real>::InitializeAxis(int d)
+{
+    // Get the rectangle extents and endpoints.
     int intrSize = static_cast<int>(mRectangles.size()), endpSize = 2 * intrSize;
-    mXEndpoints.resize(endpSize);
-    mYEndpoints.resize(endpSize);
+    std::vector<Real>& min = mMin[d];
+    std::vector<Real>& max = mMax[d];
+    std::vector<Endpoint>& endpoints = mEndpoints[d];
+    min.resize(intrSize);
+    max.resize(intrSize);
+    endpoints.resize(endpSize);
     for (int i = 0, j = 0; i < intrSize; ++i)
     {
-        mXEndpoints[j].type = 0;
-        mXEndpoints[j].value = mRectangles[i].min[0];
-        mXEndpoints[j].index = i;
-        mYEndpoints[j].type = 0;
-        mYEndpoints[j].value = mRectangles[i].min[1];
-        mYEndpoints[j].index = i;
+        min[i] = mRectangles[i].min[d];
+        max[i] = mRectangles[i].max[d];
+
+        endpoints[j].type = 0;
+        endpoints[j].value = min[i];
+        endpoints[j].index = i;
         ++j;
 
-        mXEndpoints[j].type = 1;
-        mXEndpoints[j].value = mRectangles[i].max[0];
-        mXEndpoints[j].index = i;
-        mYEndpoints[j].type = 1;
-        mYEndpoints[j].value = mRectangles[i].max[1];
-        mYEndpoints[j].index = i;
+        endpoints[j].type = 1;
+        endpoints[j].value = max[i];
+        endpoints[j].index = i;
         ++j;
     }
 
     // Sort the rectangle endpoints.
-    std::sort(mXEndpoints.begin(), mXEndpoints.end());
-    std::sort(mYEndpoints.begin(), mYEndpoints.end());
+    std::sort(endpoints.begin(), endpoints.end());
 
-    // Create the interval-to-endpoint lookup tables.
-    mXLookup.resize(endpSize);
-    mYLookup.resize(endpSize);
+    // Create the interval-to-endpoint lookup table.
+    std::vector<int>& lookup = mLookup[d];
+    lookup.resize(endpSize);
     for (int j = 0; j < endpSize; ++j)
     {
-        mXLookup[2 * mXEndpoints[j].index + mXEndpoints[j].type] = j;
-        mYLookup[2 * mYEndpoints[j].index + mYEndpoints[j].type] = j;
+        lookup[2 * endpoints[j].index + endpoints[j].type] = j;
     }
 
-    // Active set of rectangles (stored by index in array).
-    std::set<int> active;
+    // Compute the variance of the centers (times 4n) without overflow in
+    // the sums.  The centers are min[i]+max[i], which is twice the actual
+    // center; the scaling does not affect the choice of sweep axis.
+    Real mean = (Real)0, variance = (Real)0;
+    if (intrSize > 0)
+    {
+        for (int i = 0; i < intrSize; ++i)
+        {
+            mean += min[i] + max[i];
+        }
+        mean /= (Real)intrSize;
+        for (int i = 0; i < intrSize; ++i)
+        {
+            Real diff = min[i] + max[i] - mean;
+            variance += diff * diff;
+        }
+    }
+    mVariance[d] = variance;
+}
 
-    // Set of overlapping rectangles (stored by pairs of indices in array).
-    mOverlap.clear();
+template <typename Real>
+void RectangleManager<Real>::SweepRange(int jmin, int jmax, Sweep& sweep)
+{
+    int const d0 = mSweepAxis, d1 = 1 - d0;
+    std::vector<Endpoint> const& endpoints = mEndpoints[d0];
+    std::vector<int> const& lookup = mLookup[d0];
+    int intrSize = static_cast<int>(mRectangles.size());
 
-    // Sweep through the endpoints to determine overlapping x-intervals.
-    for (int i = 0; i < endpSize; ++i)
+    sweep.active.Reset(intrSize);
+    sweep.pairs.clear();
+
+    // The rectangles whose intervals on the sweep axis contain endpoint jmin
+    // are active at the start of the range.
+    if (jmin > 0)
     {
-        Endpoint& endpoint = mXEndpoints[i];
+        for (int i = 0; i < intrSize; ++i)
+        {
+            if (lookup[2 * i] < jmin && lookup[2 * i + 1] >= jmin)
+            {
+                sweep.active.Insert(i, &mMin[d1][i], &mMax[d1][i]);
+            }
+        }
+    }
+
+    for (int j = jmin; j < jmax; ++j)
+    {
+        Endpoint const& endpoint = endpoints[j];
         int index = endpoint.index;
         if (endpoint.type == 0)  // an interval 'begin' value
         {
             // In the 1D problem, the current interval overlaps with all the
-            // active intervals.  In 2D we also need to check for y-overlap.
-            for (auto activeIndex : active)
+            // active intervals.  In 2D we also need to check for overlap on
+            // the other axis.  The order of the active rectangles depends on
+            // the range, so the overlapping rectangles are sorted to obtain
+            // pairs in an order that does not depend on the partition.
+            Real const* min = &mMin[d1][index];
+            Real const* max = &mMax[d1][index];
+            sweep.overlaps.clear();
+            sweep.active.FindOverlaps(min, max, sweep.overlaps);
+            std::sort(sweep.overlaps.begin(), sweep.overlaps.end());
+            for (auto activeIndex : sweep.overlaps)
             {
-                // Rectangles activeIndex and index overlap in the
-                // x-dimension.  Test for overlap in the y-dimension.
-                AlignedBox2<Real> const& r0 = mRectangles[activeIndex];
-                AlignedBox2<Real> const& r1 = mRectangles[index];
-                if (r0.max[1] >= r1.min[1] && r0.min[1] <= r1.max[1])
-                {
-                    if (activeIndex < index)
-                    {
-                        mOverlap.insert(EdgeKey<false>(activeIndex, index));
-                    }
-                    else
-                    {
-                        mOverlap.insert(EdgeKey<false>(index, activeIndex));
-                    }
-                }
+                sweep.pairs.push_back(EdgeKey<false>(activeIndex, index));
             }
-            active.insert(index);
+            sweep.active.Insert(index, min, max);
         }
         else  // an interval 'end' value
         {
-            active.erase(index);
+            sweep.active.Remove(index);
         }
     }
 }
 
 template <typename Real>
-void RectangleManager<Real>::SetRectangle(int i, AlignedBox2<Real> const& rectangle)
-{
-    mRectangles[i] = rectangle;
-    mXEndpoints[mXLookup[2 * i]].value = rectangle.min[0];
-    mXEndpoints[mXLookup[2 * i + 1]].value = rectangle.max[0];
-    mYEndpoints[mYLookup[2 * i]].value = rectangle.min[1];
-    mYEndpoints[mYLookup[2 * i + 1]].value = rectangle.max[1];
-}
-
-template <typename Real>
-void RectangleManager<Real>::GetRectangle(int i, AlignedBox2<Real>& rectangle) const
-{
-    rectangle = mRectangles[i];
-}
-
-template <typename Real>
-void RectangleManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std::vector<int>& lookup)
+void RectangleManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint,
+    std::vector<int>& lookup, std::vector<Change>& changes)
 {
     // Apply an insertion sort.  Under the assumption that the rectangles
     // have not changed much since the last call, the endpoints are nearly
     // sorted.  The insertion sort should be very fast in this case.
 
-    TIQuery<Real, AlignedBox2<Real>, AlignedBox2<Real>> query;
+    changes.clear();
     int endpSize = static_cast<int>(endpoint.size());
     for (int j = 1; j < endpSize; ++j)
     {
@@ -210,16 +454,12 @@ void RectangleManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std:
             {
                 if (e1.type == 1)
                 {
-                    // The 'b' of interval E0.index was smaller than the 'e'
-                    // of interval E1.index, and the intervals *might have
+                    // The 'b' of interval E0.mIndex was smaller than the 'e'
+                    // of interval E1.mIndex, and the intervals *might have
                     // been* overlapping.  Now 'b' and 'e' are swapped, and
                     // the intervals cannot overlap.  Remove the pair from
-                    // the overlap set.  The removal operation needs to find
-                    // the pair and erase it if it exists.  Finding the pair
-                    // is the expensive part of the operation, so there is no
-                    // real time savings in testing for existence first, then
-                    // deleting if it does.
-                    mOverlap.erase(EdgeKey<false>(e0.index, e1.index));
+                    // the overlap set if it is there.
+                    changes.push_back({ e0.index, e1.index, false });
                 }
             }
             else
@@ -231,9 +471,9 @@ void RectangleManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std:
                     // overlapping.  Now 'b' and 'e' are swapped, and the
                     // intervals *might be* overlapping.  Determine if they
                     // are overlapping and then insert.
-                    if (query(mRectangles[e0.index], mRectangles[e1.index]).intersect)
+                    if (Overlaps(e0.index, e1.index))
                     {
-                        mOverlap.insert(EdgeKey<false>(e0.index, e1.index));
+                        changes.push_back({ e0.index, e1.index, true });
                     }
                 }
             }
@@ -251,20 +491,20 @@ void RectangleManager<Real>::InsertionSort(std::vector<Endpoint>& endpoint, std:
 }
 
 template <typename Real>
-void RectangleManager<Real>::Update()
+inline bool RectangleManager<Real>::Overlaps(int i, int j) const
 {
-    InsertionSort(mXEndpoints, mXLookup);
-    InsertionSort(mYEndpoints, mYLookup);
-}
-
-template <typename Real>
-std::set<EdgeKey<false>> const& RectangleManager<Real>::GetOverlap() const
-{
-    return mOverlap;
+    for (int d = 0; d < 2; ++d)
+    {
+        if (mMax[d][i] < mMin[d][j] || mMin[d][i] > mMax[d][j])
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 template <typename Real>
-bool RectangleManager<Real>::Endpoint::operator<(Endpoint const& endpoint) const
+bool RectangleManager<Real>::Endpoint::operator<(const Endpoint& endpoint) const
 {
     if (value < endpoint.value)
     {
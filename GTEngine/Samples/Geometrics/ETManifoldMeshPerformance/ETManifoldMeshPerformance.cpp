@@ -0,0 +1,170 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.1 (2026/10/18)
+
+#include <GTEngine.h>
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <random>
+using namespace gte;
+
+// Compare the performance of ETManifoldMesh and ETCompactManifoldMesh on a
+// triangulated grid.  The triangles are inserted in random order, the
+// connected components are computed, half the triangles are removed and
+// reinserted, and then all triangles are removed.  The application is a
+// console program; the results are written to standard output.
+
+namespace
+{
+    void Report(char const* operation, double seconds0, double seconds1)
+    {
+        std::cout << std::left << std::setw(16) << operation << std::right
+            << std::fixed << std::setprecision(4)
+            << std::setw(12) << seconds0 << " s"
+            << std::setw(12) << seconds1 << " s";
+
+        // The timer has a resolution of 1 millisecond, so a time of 0 means
+        // the operation was too fast to measure and there is no speedup.
+        if (seconds0 > 0.0 && seconds1 > 0.0)
+        {
+            std::cout << std::setw(10) << std::setprecision(2)
+                << seconds0 / seconds1 << "x";
+        }
+        else
+        {
+            std::cout << std::setw(11) << "n/a";
+        }
+        std::cout << std::endl;
+    }
+
+    template <typename Mesh>
+    void Insert(Mesh& mesh, std::vector<std::array<int, 3>> const& triangles,
+        size_t imin, size_t imax)
+    {
+        for (size_t i = imin; i < imax; ++i)
+        {
+            auto const& tri = triangles[i];
+            mesh.Insert(tri[0], tri[1], tri[2]);
+        }
+    }
+
+    template <typename Mesh>
+    void Remove(Mesh& mesh, std::vector<std::array<int, 3>> const& triangles,
+        size_t imin, size_t imax)
+    {
+        for (size_t i = imin; i < imax; ++i)
+        {
+            auto const& tri = triangles[i];
+            mesh.Remove(tri[0], tri[1], tri[2]);
+        }
+    }
+}
+
+void TestETManifoldMeshPerformance(int bound)
+{
+    // Generate the triangles of a bound-by-bound grid of squares, each
+    // square split into two triangles.
+    std::vector<std::array<int, 3>> triangles;
+    triangles.reserve(2 * static_cast<size_t>(bound) * bound);
+    for (int y = 0; y < bound; ++y)
+    {
+        for (int x = 0; x < bound; ++x)
+        {
+            int v00 = x + (bound + 1) * y;
+            int v10 = v00 + 1;
+            int v01 = v00 + bound + 1;
+            int v11 = v01 + 1;
+            triangles.push_back({ { v00, v10, v11 } });
+            triangles.push_back({ { v00, v11, v01 } });
+        }
+    }
+    std::mt19937 mte;
+    std::shuffle(triangles.begin(), triangles.end(), mte);
+    size_t const numTriangles = triangles.size();
+    size_t const half = numTriangles / 2;
+
+    std::cout << "triangles = " << numTriangles << std::endl;
+    std::cout << std::setw(16) << " " << std::setw(14) << "ETManifold"
+        << std::setw(14) << "ETCompact" << std::setw(11) << "speedup"
+        << std::endl;
+
+    ETManifoldMesh mesh0;
+    ETCompactManifoldMesh mesh1;
+    double seconds0, seconds1;
+
+    Timer timer;
+    Insert(mesh0, triangles, 0, numTriangles);
+    seconds0 = timer.GetSeconds();
+    timer.Reset();
+    Insert(mesh1, triangles, 0, numTriangles);
+    seconds1 = timer.GetSeconds();
+    Report("Insert", seconds0, seconds1);
+
+    std::vector<std::vector<TriangleKey<true>>> components0, components1;
+    timer.Reset();
+    mesh0.GetComponents(components0);
+    seconds0 = timer.GetSeconds();
+    timer.Reset();
+    mesh1.GetComponents(components1);
+    seconds1 = timer.GetSeconds();
+    Report("GetComponents", seconds0, seconds1);
+
+    timer.Reset();
+    bool closed0 = mesh0.IsClosed(), oriented0 = mesh0.IsOriented();
+    seconds0 = timer.GetSeconds();
+    timer.Reset();
+    bool closed1 = mesh1.IsClosed(), oriented1 = mesh1.IsOriented();
+    seconds1 = timer.GetSeconds();
+    Report("IsClosed/Or.", seconds0, seconds1);
+
+    timer.Reset();
+    Remove(mesh0, triangles, 0, half);
+    Insert(mesh0, triangles, 0, half);
+    seconds0 = timer.GetSeconds();
+    timer.Reset();
+    Remove(mesh1, triangles, 0, half);
+    Insert(mesh1, triangles, 0, half);
+    seconds1 = timer.GetSeconds();
+    Report("Remove/Insert", seconds0, seconds1);
+
+    size_t numEdges0 = mesh0.GetEdges().size();
+    int numEdges1 = mesh1.GetNumEdges();
+
+    timer.Reset();
+    Remove(mesh0, triangles, 0, numTriangles);
+    seconds0 = timer.GetSeconds();
+    timer.Reset();
+    Remove(mesh1, triangles, 0, numTriangles);
+    seconds1 = timer.GetSeconds();
+    Report("Remove", seconds0, seconds1);
+
+    bool consistent =
+        components0.size() == components1.size() &&
+        closed0 == closed1 && oriented0 == oriented1 &&
+        numEdges0 == static_cast<size_t>(numEdges1) &&
+        mesh0.GetTriangles().size() == 0 && mesh1.GetNumTriangles() == 0;
+    std::cout << "consistent = " << (consistent ? "true" : "false")
+        << std::endl << std::endl;
+}
+
+int main(int, char const*[])
+{
+#if defined(_DEBUG)
+    LogReporter reporter(
+        "LogReport.txt",
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL);
+#endif
+
+    // The largest grid has 2*708*708 = 1002528 triangles.
+    TestETManifoldMeshPerformance(100);
+    TestETManifoldMeshPerformance(708);
+    return 0;
+}
@@ -0,0 +1,185 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#include <GTEngine.h>
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+using namespace gte;
+
+// Measure the throughput of the leaf kernel of NearestNeighborQuery for a
+// 3D float point cloud.  The scalar kernel is compared to the kernel that
+// the query uses, which is vectorized when the compiler targets SSE2, AVX
+// or AVX-512 (see GTE_NO_NEARESTNEIGHBOR_SIMD).  The queries per second of
+// radius and k-nearest searches are also reported; rebuild with
+// GTE_NO_NEARESTNEIGHBOR_SIMD defined to obtain the scalar numbers.  The
+// application is a console program; the results are written to standard
+// output.
+
+namespace
+{
+    struct Site
+    {
+        Vector3<float> position;
+
+        Vector3<float> GetPosition() const
+        {
+            return position;
+        }
+    };
+
+    void Report(char const* operation, double count, double seconds0,
+        double seconds1)
+    {
+        double rate0 = (seconds0 > 0.0 ? count / seconds0 : 0.0);
+        double rate1 = (seconds1 > 0.0 ? count / seconds1 : 0.0);
+        std::cout << std::left << std::setw(16) << operation << std::right
+            << std::scientific << std::setprecision(3)
+            << std::setw(14) << rate0 << std::setw(14) << rate1
+            << std::fixed << std::setw(10) << std::setprecision(2)
+            << (rate0 > 0.0 ? rate1 / rate0 : 0.0) << "x" << std::endl;
+    }
+
+    void Report(char const* operation, double count, double seconds)
+    {
+        std::cout << std::left << std::setw(16) << operation << std::right
+            << std::scientific << std::setprecision(3)
+            << std::setw(14) << (seconds > 0.0 ? count / seconds : 0.0)
+            << " queries/s" << std::endl;
+    }
+}
+
+void TestKernel(int numSites, int leafSize)
+{
+    typedef NearestNeighborScalarKernel<3, float> ScalarKernel;
+    typedef NearestNeighborKernel<3, float> Kernel;
+
+    std::mt19937 mte;
+    std::uniform_real_distribution<float> rnd(-1.0f, 1.0f);
+    std::array<std::vector<float>, 3> coordinates;
+    std::array<float const*, 3> pointers;
+    for (int d = 0; d < 3; ++d)
+    {
+        coordinates[d].resize(numSites);
+        for (auto& c : coordinates[d])
+        {
+            c = rnd(mte);
+        }
+        pointers[d] = coordinates[d].data();
+    }
+    std::vector<float> sqrDistances0(leafSize), sqrDistances1(leafSize);
+
+    // Evaluate the sites in leaf-sized blocks for a sequence of points, as
+    // FindNearest does.
+    int const numPoints = 256;
+    std::vector<Vector3<float>> points(numPoints);
+    for (auto& point : points)
+    {
+        point = { rnd(mte), rnd(mte), rnd(mte) };
+    }
+
+    float sum0 = 0.0f, sum1 = 0.0f;
+    Timer timer;
+    for (auto const& point : points)
+    {
+        for (int i = 0; i + leafSize <= numSites; i += leafSize)
+        {
+            ScalarKernel::GetSqrDistances(pointers.data(), i, i + leafSize,
+                &point[0], sqrDistances0.data());
+            sum0 += sqrDistances0[0];
+        }
+    }
+    double seconds0 = timer.GetSeconds();
+    timer.Reset();
+    for (auto const& point : points)
+    {
+        for (int i = 0; i + leafSize <= numSites; i += leafSize)
+        {
+            Kernel::GetSqrDistances(pointers.data(), i, i + leafSize,
+                &point[0], sqrDistances1.data());
+            sum1 += sqrDistances1[0];
+        }
+    }
+    double seconds1 = timer.GetSeconds();
+
+    double count = static_cast<double>(numPoints) *
+        static_cast<double>(numSites - numSites % leafSize);
+    std::cout << "leaf size = " << leafSize << std::endl;
+    Report("sites/s", count, seconds0, seconds1);
+    std::cout << "consistent = " << (sum0 == sum1 ? "true" : "false")
+        << std::endl << std::endl;
+}
+
+void TestQuery(int numSites, int maxLeafSize)
+{
+    std::mt19937 mte;
+    std::uniform_real_distribution<float> rnd(-1.0f, 1.0f);
+    std::vector<Site> sites(numSites);
+    for (auto& site : sites)
+    {
+        site.position = { rnd(mte), rnd(mte), rnd(mte) };
+    }
+
+    int const numQueries = 200000;
+    std::vector<Vector3<float>> points(numQueries);
+    for (auto& point : points)
+    {
+        point = { rnd(mte), rnd(mte), rnd(mte) };
+    }
+
+    NearestNeighborQuery<3, float, Site> query(sites, maxLeafSize, 30);
+    int const maxNeighbors = 8;
+    std::array<int, maxNeighbors> neighbors;
+    std::array<float, maxNeighbors> sqrDistances;
+    int total = 0;
+
+    std::cout << "sites = " << numSites << ", max leaf size = "
+        << maxLeafSize << std::endl;
+
+    Timer timer;
+    for (auto const& point : points)
+    {
+        total += query.FindNearest(point, 0.05f, maxNeighbors,
+            neighbors.data(), sqrDistances.data());
+    }
+    Report("radius 0.05", numQueries, timer.GetSeconds());
+
+    timer.Reset();
+    for (auto const& point : points)
+    {
+        total += query.FindNearest(point, std::numeric_limits<float>::max(),
+            maxNeighbors, neighbors.data(), sqrDistances.data());
+    }
+    Report("k = 8", numQueries, timer.GetSeconds());
+    std::cout << "neighbors found = " << total << std::endl << std::endl;
+}
+
+int main(int, char const*[])
+{
+#if defined(_DEBUG)
+    LogReporter reporter(
+        "LogReport.txt",
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL);
+#endif
+
+    std::cout << "kernel width = " << NearestNeighborKernel<3, float>::WIDTH
+        << std::endl << std::endl;
+    std::cout << std::setw(16) << " " << std::setw(14) << "scalar"
+        << std::setw(14) << "kernel" << std::setw(11) << "speedup"
+        << std::endl;
+    TestKernel(1 << 16, 16);
+    TestKernel(1 << 16, 64);
+
+    TestQuery(1000000, 8);
+    TestQuery(1000000, 32);
+    return 0;
+}
@@ -3,28 +3,33 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.1 (2018/10/05)
+// File Version: 3.2.0 (2026/10/18)
 
 #include <GTEnginePCH.h>
 #include <Imagics/GteImageUtility2.h>
+#include <Imagics/GteMorphologyLines.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 using namespace gte;
 
 void ImageUtility2::GetComponents4(Image2<int>& image,
-    std::vector<std::vector<size_t>>& components)
+    std::vector<std::vector<size_t>>& components,
+    std::shared_ptr<ComputeModel> const& cmodel)
 {
     std::array<int, 4> neighbors;
     image.GetNeighborhood(neighbors);
-    GetComponents(4, &neighbors[0], image, components);
+    GetComponents(4, &neighbors[0], cmodel, image, components);
 }
 
 void ImageUtility2::GetComponents8(Image2<int>& image,
-    std::vector<std::vector<size_t>>& components)
+    std::vector<std::vector<size_t>>& components,
+    std::shared_ptr<ComputeModel> const& cmodel)
 {
     std::array<int, 8> neighbors;
     image.GetNeighborhood(neighbors);
-    GetComponents(8, &neighbors[0], image, components);
+    GetComponents(8, &neighbors[0], cmodel, image, components);
 }
 
 void ImageUtility2::Dilate4(Image2<int> const& input, Image2<int>& output)
@@ -185,6 +190,78 @@ void ImageUtility2::Close(Image2<int> const& input, bool zeroExterior,
     Erode(temp, zeroExterior, numNeighbors, neighbors, output);
 }
 
+void ImageUtility2::DilateRectangle(Image2<int> const& input, int radius0,
+    int radius1, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    LogAssert(radius0 >= 0 && radius1 >= 0, "Invalid radius.");
+    if (&output != &input)
+    {
+        output = input;
+    }
+    MorphologyLine(true, 0, 1, 0, radius0, cmodel, output);
+    MorphologyLine(true, 0, 0, 1, radius1, cmodel, output);
+}
+
+void ImageUtility2::ErodeRectangle(Image2<int> const& input,
+    bool zeroExterior, int radius0, int radius1, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    LogAssert(radius0 >= 0 && radius1 >= 0, "Invalid radius.");
+    if (&output != &input)
+    {
+        output = input;
+    }
+    int const pad = (zeroExterior ? 0 : 1);
+    MorphologyLine(false, pad, 1, 0, radius0, cmodel, output);
+    MorphologyLine(false, pad, 0, 1, radius1, cmodel, output);
+}
+
+void ImageUtility2::OpenRectangle(Image2<int> const& input,
+    bool zeroExterior, int radius0, int radius1, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    ErodeRectangle(input, zeroExterior, radius0, radius1, output, cmodel);
+    DilateRectangle(output, radius0, radius1, output, cmodel);
+}
+
+void ImageUtility2::CloseRectangle(Image2<int> const& input,
+    bool zeroExterior, int radius0, int radius1, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    DilateRectangle(input, radius0, radius1, output, cmodel);
+    ErodeRectangle(output, zeroExterior, radius0, radius1, output, cmodel);
+}
+
+void ImageUtility2::DilateDisk(Image2<int> const& input, int radius,
+    Image2<int>& output, std::shared_ptr<ComputeModel> const& cmodel)
+{
+    MorphologyDisk(true, 0, radius, input, output, cmodel);
+}
+
+void ImageUtility2::ErodeDisk(Image2<int> const& input, bool zeroExterior,
+    int radius, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    MorphologyDisk(false, (zeroExterior ? 0 : 1), radius, input, output, cmodel);
+}
+
+void ImageUtility2::OpenDisk(Image2<int> const& input, bool zeroExterior,
+    int radius, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    ErodeDisk(input, zeroExterior, radius, output, cmodel);
+    DilateDisk(output, radius, output, cmodel);
+}
+
+void ImageUtility2::CloseDisk(Image2<int> const& input, bool zeroExterior,
+    int radius, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    DilateDisk(input, radius, output, cmodel);
+    ErodeDisk(output, zeroExterior, radius, output, cmodel);
+}
+
 bool ImageUtility2::ExtractBoundary(int x, int y, Image2<int>& image,
     std::vector<size_t>& boundary)
 {
@@ -923,73 +1000,452 @@ void ImageUtility2::DrawEllipse(int xCenter, int yCenter, int xExtent, int yExte
 }
 
 void ImageUtility2::GetComponents(int numNeighbors, int const* delta,
-    Image2<int>& image, std::vector<std::vector<size_t>>& components)
+    std::shared_ptr<ComputeModel> const& cmodel, Image2<int>& image,
+    std::vector<std::vector<size_t>>& components)
 {
+    // The image is partitioned into ranges of rows (chunks) that are
+    // labeled concurrently.
     size_t const numPixels = image.GetNumPixels();
-    std::vector<int> numElements(numPixels);
-    std::vector<size_t> vstack(numPixels);
-    size_t i, numComponents = 0;
-    int label = 2;
-    for (i = 0; i < numPixels; ++i)
+    int const dim0 = image.GetDimension(0);
+    int const dim1 = image.GetDimension(1);
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    size_t const minChunkSize = 4096;
+    int numChunks = 1;
+    if (threadPool && numPixels >= 2 * minChunkSize)
     {
-        if (image[i] == 1)
+        numChunks = static_cast<int>(std::min(numPixels / minChunkSize, static_cast<size_t>(dim1)));
+        numChunks = std::min(4 * static_cast<int>(threadPool->GetNumThreads()), numChunks);
+    }
+    std::vector<size_t> chunkStart(numChunks + 1);
+    for (int c = 0; c <= numChunks; ++c)
+    {
+        chunkStart[c] = static_cast<size_t>(dim0) * (static_cast<size_t>(dim1) * c / numChunks);
+    }
+
+    // The union-find forest uses 32-bit indices when possible to reduce
+    // the memory traffic.
+    if (numPixels <= static_cast<size_t>(std::numeric_limits<uint32_t>::max()))
+    {
+        LabelComponents<uint32_t>(numNeighbors, delta, threadPool, chunkStart, image, components);
+    }
+    else
+    {
+        LabelComponents<size_t>(numNeighbors, delta, threadPool, chunkStart, image, components);
+    }
+}
+
+template <typename Index>
+void ImageUtility2::LabelComponents(int numNeighbors, int const* delta,
+    std::shared_ptr<ThreadPool> const& threadPool,
+    std::vector<size_t> const& chunkStart, Image2<int>& image,
+    std::vector<std::vector<size_t>>& components)
+{
+    // Each foreground pixel is linked to its foreground neighbors that
+    // precede it in the lexicographical order.  A tree of the union-find
+    // forest is always linked to the root of smaller index, so the root of a
+    // component is its first pixel and the components are numbered in the
+    // order of their first pixels, which is the order of the depth-first
+    // search that this function used previously.  The parents of the
+    // background pixels are not used.
+    size_t const numPixels = image.GetNumPixels();
+    std::vector<Index> parent(numPixels);
+
+    auto find = [&parent](Index i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // Link the trees of i0 and i1 and return the root that is no longer a
+    // root, or return 'invalid' when the pixels are in the same tree.  The
+    // number of pixels is at most the maximum Index, so 'invalid' is not a
+    // pixel index.
+    Index const invalid = std::numeric_limits<Index>::max();
+    auto link = [&find, &parent, invalid](Index i0, Index i1)
+    {
+        Index r0 = find(i0), r1 = find(i1);
+        if (r0 < r1)
+        {
+            parent[r1] = r0;
+            return r1;
+        }
+        if (r1 < r0)
+        {
+            parent[r0] = r1;
+            return r0;
+        }
+        return invalid;
+    };
+
+    // The neighbors that precede a pixel.  The left neighbor is handled
+    // separately, because a run of foreground pixels in a row is in one
+    // component, so the pixels of a run after the first one are given the
+    // parent of the first one without searching the forest.
+    std::vector<Index> offsets;
+    bool hasLeft = false;
+    Index maxOffset = 0;
+    for (int j = 0; j < numNeighbors; ++j)
+    {
+        if (delta[j] < 0)
         {
-            int top = -1;
-            vstack[++top] = i;
+            Index offset = static_cast<Index>(-delta[j]);
+            if (offset == 1)
+            {
+                hasLeft = true;
+            }
+            else
+            {
+                offsets.push_back(offset);
+            }
+            maxOffset = std::max(maxOffset, offset);
+        }
+    }
 
-            int& count = numElements[numComponents + 1];
-            count = 0;
-            while (top >= 0)
+    int const numChunks = static_cast<int>(chunkStart.size()) - 1;
+    auto parallelFor = [&threadPool, numChunks](std::function<void(int, int)> const& function)
+    {
+        if (threadPool && numChunks > 1)
+        {
+            threadPool->ParallelFor(0, numChunks, 1, function);
+        }
+        else
+        {
+            function(0, numChunks);
+        }
+    };
+
+    // Link the pixels of each chunk to their neighbors in the chunk, and
+    // then link each pixel directly to the root of its tree.  The trees of
+    // the chunks are disjoint, so the chunks are processed concurrently.
+    // Pixel values other than 1 are background and are set to 0.
+    std::vector<int> numRoots(numChunks + 1, 0);
+    parallelFor([&](int cmin, int cmax)
+    {
+        for (int c = cmin; c < cmax; ++c)
+        {
+            Index const imin = static_cast<Index>(chunkStart[c]);
+            Index const imax = static_cast<Index>(chunkStart[c + 1]);
+            for (Index i = imin; i < imax; ++i)
             {
-                size_t v = vstack[top];
-                image[v] = -1;
-                int j;
-                for (j = 0; j < numNeighbors; ++j)
+                if (image[i] != 1)
+                {
+                    image[i] = 0;
+                    continue;
+                }
+
+                parent[i] = (hasLeft && i > imin && image[i - 1] == 1 ? parent[i - 1] : i);
+                for (auto offset : offsets)
                 {
-                    size_t adj = v + delta[j];
-                    if (image[adj] == 1)
+                    if (i - imin >= offset && image[i - offset] == 1
+                        && parent[i - offset] != parent[i])
                     {
-                        vstack[++top] = adj;
-                        break;
+                        link(i, i - offset);
                     }
                 }
-                if (j == numNeighbors)
+            }
+
+            for (Index i = imin; i < imax; ++i)
+            {
+                if (image[i] == 1)
                 {
-                    image[v] = label;
-                    ++count;
-                    --top;
+                    parent[i] = parent[parent[i]];
+                    if (parent[i] == i)
+                    {
+                        ++numRoots[c + 1];
+                    }
                 }
             }
+        }
+    });
+
+    // Link the pixels at the start of each chunk to their neighbors in the
+    // previous chunks.  The roots that are linked to other trees are then
+    // linked directly to the roots of their components, so the root of any
+    // pixel i is parent[parent[i]].
+    std::vector<Index> linked;
+    for (int c = 1; c < numChunks; ++c)
+    {
+        Index const imin = static_cast<Index>(chunkStart[c]);
+        Index const imax = static_cast<Index>(std::min(chunkStart[c] + maxOffset, numPixels));
+        for (Index i = imin; i < imax; ++i)
+        {
+            if (image[i] == 0)
+            {
+                continue;
+            }
 
-            ++numComponents;
-            ++label;
+            for (int j = 0; j < numNeighbors; ++j)
+            {
+                if (delta[j] < 0)
+                {
+                    Index offset = static_cast<Index>(-delta[j]);
+                    if (i - imin < offset && i >= offset && image[i - offset] != 0)
+                    {
+                        Index root = link(i, i - offset);
+                        if (root != invalid)
+                        {
+                            linked.push_back(root);
+                        }
+                    }
+                }
+            }
         }
     }
+    for (auto root : linked)
+    {
+        parent[root] = find(root);
+        int c = static_cast<int>(std::upper_bound(chunkStart.begin(), chunkStart.end(),
+            static_cast<size_t>(root)) - chunkStart.begin()) - 1;
+        --numRoots[c + 1];
+    }
+    for (int c = 0; c < numChunks; ++c)
+    {
+        numRoots[c + 1] += numRoots[c];
+    }
+
+    // Label the roots with the numbers of their components, and then label
+    // the other pixels with the labels of their roots.
+    parallelFor([&](int cmin, int cmax)
+    {
+        for (int c = cmin; c < cmax; ++c)
+        {
+            int label = numRoots[c];
+            Index const imax = static_cast<Index>(chunkStart[c + 1]);
+            for (Index i = static_cast<Index>(chunkStart[c]); i < imax; ++i)
+            {
+                if (image[i] != 0 && parent[i] == i)
+                {
+                    image[i] = ++label;
+                }
+            }
+        }
+    });
 
+    parallelFor([&](int cmin, int cmax)
+    {
+        for (int c = cmin; c < cmax; ++c)
+        {
+            Index const imax = static_cast<Index>(chunkStart[c + 1]);
+            for (Index i = static_cast<Index>(chunkStart[c]); i < imax; ++i)
+            {
+                if (image[i] != 0 && parent[i] != i)
+                {
+                    image[i] = image[parent[parent[i]]];
+                }
+            }
+        }
+    });
+
+    int const numComponents = numRoots[numChunks];
     if (numComponents > 0)
     {
+        std::vector<size_t> numElements(numComponents + 1, 0);
+        for (size_t i = 0; i < numPixels; ++i)
+        {
+            ++numElements[image[i]];
+        }
+
         components.resize(numComponents + 1);
-        for (i = 1; i <= numComponents; ++i)
+        for (int k = 1; k <= numComponents; ++k)
         {
-            components[i].resize(numElements[i]);
-            numElements[i] = 0;
+            components[k].resize(numElements[k]);
+            numElements[k] = 0;
         }
 
-        for (i = 0; i < numPixels; ++i)
+        for (size_t i = 0; i < numPixels; ++i)
         {
-            int value = image[i];
-            if (value != 0)
+            int label = image[i];
+            if (label != 0)
             {
-                // Labels started at 2 to support the depth-first search,
-                // so they need to be decremented for the correct labels.
-                image[i] = --value;
-                components[value][numElements[value]] = i;
-                ++numElements[value];
+                components[label][numElements[label]++] = i;
             }
         }
     }
 }
 
+void ImageUtility2::MorphologyLine(bool dilate, int pad, int dx, int dy,
+    int radius, std::shared_ptr<ComputeModel> const& cmodel,
+    Image2<int>& image)
+{
+    int const dim0 = image.GetDimension(0);
+    int const dim1 = image.GetDimension(1);
+    if (radius == 0 || dim0 == 0 || dim1 == 0)
+    {
+        return;
+    }
+
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    int* pixels = image.GetPixels().data();
+    if (dy == 0)
+    {
+        // Each row is a line.  Blocks of rows are processed together, so
+        // the lanes are the rows of a block.
+        int const blockSize = 16;
+        int const numBlocks = (dim1 + blockSize - 1) / blockSize;
+        auto filterRows = [dilate, pad, radius, dim0, dim1, pixels, blockSize](int bmin, int bmax)
+        {
+            MorphologyLines<int> lines(dilate, radius, pad);
+            for (int b = bmin; b < bmax; ++b)
+            {
+                int* first = pixels + static_cast<size_t>(dim0) * blockSize * b;
+                int const numLanes = std::min(blockSize, dim1 - blockSize * b);
+                lines.Execute(dim0, numLanes,
+                    [=](int x, int* lanes)
+                    {
+                        for (int lane = 0; lane < numLanes; ++lane)
+                        {
+                            lanes[lane] = first[static_cast<size_t>(dim0) * lane + x];
+                        }
+                    },
+                    [=](int x, int const* lanes)
+                    {
+                        for (int lane = 0; lane < numLanes; ++lane)
+                        {
+                            first[static_cast<size_t>(dim0) * lane + x] = lanes[lane];
+                        }
+                    });
+            }
+        };
+
+        if (threadPool)
+        {
+            threadPool->ParallelFor(0, numBlocks, 1, filterRows);
+        }
+        else
+        {
+            filterRows(0, numBlocks);
+        }
+        return;
+    }
+
+    // Line u consists of the pixels (u+shear*y,y), so the lines are the
+    // columns for dx = 0 and the diagonals otherwise.  The lines are
+    // processed in ranges of consecutive u, which are contiguous in each
+    // row.  A diagonal line has pad values for the rows in which it is
+    // outside the image.
+    int const shear = dx * dy;
+    int const umin = (shear > 0 ? 1 - dim1 : 0);
+    int const umax = (shear < 0 ? dim0 + dim1 - 1 : dim0);
+    int const rangeSize = 256;
+    int const numRanges = (umax - umin + rangeSize - 1) / rangeSize;
+    auto filterRanges = [dilate, pad, radius, dim0, dim1, pixels, shear, umin, umax,
+        rangeSize](int rmin, int rmax)
+    {
+        MorphologyLines<int> lines(dilate, radius, pad);
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const u0 = umin + r * rangeSize;
+            int const numLanes = std::min(rangeSize, umax - u0);
+
+            // The lanes [xmin-x0,xmax-x0) of row y are in the image.
+            auto load = [=](int y, int* lanes)
+            {
+                int const x0 = u0 + shear * y;
+                int const xmin = std::min(std::max(x0, 0), x0 + numLanes);
+                int const xmax = std::max(std::min(x0 + numLanes, dim0), xmin);
+                int const* row = pixels + static_cast<size_t>(dim0) * y;
+                std::fill(lanes, lanes + (xmin - x0), pad);
+                std::copy(row + xmin, row + xmax, lanes + (xmin - x0));
+                std::fill(lanes + (xmax - x0), lanes + numLanes, pad);
+            };
+
+            auto store = [=](int y, int const* lanes)
+            {
+                int const x0 = u0 + shear * y;
+                int const xmin = std::min(std::max(x0, 0), x0 + numLanes);
+                int const xmax = std::max(std::min(x0 + numLanes, dim0), xmin);
+                int* row = pixels + static_cast<size_t>(dim0) * y;
+                std::copy(lanes + (xmin - x0), lanes + (xmax - x0), row + xmin);
+            };
+
+            lines.Execute(dim1, numLanes, load, store);
+        }
+    };
+
+    if (threadPool)
+    {
+        threadPool->ParallelFor(0, numRanges, 1, filterRanges);
+    }
+    else
+    {
+        filterRanges(0, numRanges);
+    }
+}
+
+void ImageUtility2::MorphologyDisk(bool dilate, int pad, int radius,
+    Image2<int> const& input, Image2<int>& output,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    int squareRadius, diagonalRadius;
+    GetDiskRadii(radius, squareRadius, diagonalRadius);
+    if (diagonalRadius == 0)
+    {
+        if (&output != &input)
+        {
+            output = input;
+        }
+        MorphologyLine(dilate, pad, 1, 0, squareRadius, cmodel, output);
+        MorphologyLine(dilate, pad, 0, 1, squareRadius, cmodel, output);
+        return;
+    }
+
+    // A diagonal segment can move a value of the square stage from outside
+    // the image back into the image, so the stages are applied to the image
+    // with a margin of pad values that contains the pixels on which the
+    // output depends, those within 2*diagonalRadius of the image.
+    int const dim0 = input.GetDimension(0);
+    int const dim1 = input.GetDimension(1);
+    int const margin = 2 * diagonalRadius;
+    Image2<int> temp(dim0 + 2 * margin, dim1 + 2 * margin);
+    std::fill(temp.GetPixels().begin(), temp.GetPixels().end(), pad);
+    for (int y = 0; y < dim1; ++y)
+    {
+        for (int x = 0; x < dim0; ++x)
+        {
+            temp(x + margin, y + margin) = input(x, y);
+        }
+    }
+
+    MorphologyLine(dilate, pad, 1, 0, squareRadius, cmodel, temp);
+    MorphologyLine(dilate, pad, 0, 1, squareRadius, cmodel, temp);
+    MorphologyLine(dilate, pad, 1, 1, diagonalRadius, cmodel, temp);
+    MorphologyLine(dilate, pad, 1, -1, diagonalRadius, cmodel, temp);
+
+    if (&output != &input)
+    {
+        output = input;
+    }
+    for (int y = 0; y < dim1; ++y)
+    {
+        for (int x = 0; x < dim0; ++x)
+        {
+            output(x, y) = temp(x + margin, y + margin);
+        }
+    }
+}
+
+void ImageUtility2::GetDiskRadii(int radius, int& squareRadius,
+    int& diagonalRadius)
+{
+    LogAssert(radius >= 0, "Invalid radius.");
+
+    // The octagon has extent squareRadius + 2*diagonalRadius along the
+    // axes and (squareRadius + diagonalRadius)*sqrt(2) along the diagonals,
+    // so both are approximately the radius when diagonalRadius is
+    // radius*(1 - 1/sqrt(2)).  The Minkowski sum of the diagonal segments
+    // contains only the pixels (x,y) with x+y even, so the square must have
+    // a positive radius to fill the other pixels.
+    double const fraction = 1.0 - 1.0 / std::sqrt(2.0);
+    diagonalRadius = std::min(static_cast<int>(std::floor(fraction * radius + 0.5)),
+        (radius - 1) / 2);
+    diagonalRadius = std::max(diagonalRadius, 0);
+    squareRadius = radius - 2 * diagonalRadius;
+}
+
 void ImageUtility2::L2Check(int x, int y, int dx, int dy, Image2<int>& xNear,
     Image2<int>& yNear, Image2<int>& dist)
 {
@@ -3,34 +3,41 @@
 // Distributed under the Boost Software License, Version 1.0.
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 3.0.0 (2016/06/19)
+// File Version: 3.2.0 (2026/10/18)
 
 #include <GTEnginePCH.h>
 #include <Imagics/GteImageUtility3.h>
+#include <Imagics/GteMorphologyLines.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 using namespace gte;
 
 void ImageUtility3::GetComponents6(Image3<int>& image,
-    std::vector<std::vector<size_t>>& components)
+    std::vector<std::vector<size_t>>& components,
+    std::shared_ptr<ComputeModel> const& cmodel)
 {
     std::array<int, 6> neighbors;
     image.GetNeighborhood(neighbors);
-    GetComponents(6, &neighbors[0], image, components);
+    GetComponents(6, &neighbors[0], cmodel, image, components);
 }
 
 void ImageUtility3::GetComponents18(Image3<int>& image,
-    std::vector<std::vector<size_t>>& components)
+    std::vector<std::vector<size_t>>& components,
+    std::shared_ptr<ComputeModel> const& cmodel)
 {
     std::array<int, 18> neighbors;
     image.GetNeighborhood(neighbors);
-    GetComponents(18, &neighbors[0], image, components);
+    GetComponents(18, &neighbors[0], cmodel, image, components);
 }
 
 void ImageUtility3::GetComponents26(Image3<int>& image,
-    std::vector<std::vector<size_t>>& components)
+    std::vector<std::vector<size_t>>& components,
+    std::shared_ptr<ComputeModel> const& cmodel)
 {
     std::array<int, 26> neighbors;
     image.GetNeighborhood(neighbors);
-    GetComponents(26, &neighbors[0], image, components);
+    GetComponents(26, &neighbors[0], cmodel, image, components);
 }
 
 void ImageUtility3::Dilate6(Image3<int> const& inImage, Image3<int>& outImage)
@@ -56,6 +63,51 @@ void ImageUtility3::Dilate26(Image3<int> const& inImage,
     Dilate(26, &neighbors[0], inImage, outImage);
 }
 
+void ImageUtility3::DilateBox(Image3<int> const& inImage, int radius0,
+    int radius1, int radius2, Image3<int>& outImage,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    LogAssert(radius0 >= 0 && radius1 >= 0 && radius2 >= 0, "Invalid radius.");
+    if (&outImage != &inImage)
+    {
+        outImage = inImage;
+    }
+    MorphologyLine(true, 0, 0, radius0, cmodel, outImage);
+    MorphologyLine(true, 0, 1, radius1, cmodel, outImage);
+    MorphologyLine(true, 0, 2, radius2, cmodel, outImage);
+}
+
+void ImageUtility3::ErodeBox(Image3<int> const& inImage, bool zeroExterior,
+    int radius0, int radius1, int radius2, Image3<int>& outImage,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    LogAssert(radius0 >= 0 && radius1 >= 0 && radius2 >= 0, "Invalid radius.");
+    if (&outImage != &inImage)
+    {
+        outImage = inImage;
+    }
+    int const pad = (zeroExterior ? 0 : 1);
+    MorphologyLine(false, pad, 0, radius0, cmodel, outImage);
+    MorphologyLine(false, pad, 1, radius1, cmodel, outImage);
+    MorphologyLine(false, pad, 2, radius2, cmodel, outImage);
+}
+
+void ImageUtility3::OpenBox(Image3<int> const& inImage, bool zeroExterior,
+    int radius0, int radius1, int radius2, Image3<int>& outImage,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    ErodeBox(inImage, zeroExterior, radius0, radius1, radius2, outImage, cmodel);
+    DilateBox(outImage, radius0, radius1, radius2, outImage, cmodel);
+}
+
+void ImageUtility3::CloseBox(Image3<int> const& inImage, bool zeroExterior,
+    int radius0, int radius1, int radius2, Image3<int>& outImage,
+    std::shared_ptr<ComputeModel> const& cmodel)
+{
+    DilateBox(inImage, radius0, radius1, radius2, outImage, cmodel);
+    ErodeBox(outImage, zeroExterior, radius0, radius1, radius2, outImage, cmodel);
+}
+
 void ImageUtility3::ComputeCDConvex(Image3<int>& image)
 {
     int const dim0 = image.GetDimension(0);
@@ -330,69 +382,351 @@ void ImageUtility3::Dilate(int numNeighbors, std::array<int, 3> const* delta,
     }
 }
 
+void ImageUtility3::MorphologyLine(bool dilate, int pad, int axis,
+    int radius, std::shared_ptr<ComputeModel> const& cmodel,
+    Image3<int>& image)
+{
+    int const dim0 = image.GetDimension(0);
+    int const dim1 = image.GetDimension(1);
+    int const dim2 = image.GetDimension(2);
+    if (radius == 0 || image.GetNumPixels() == 0)
+    {
+        return;
+    }
+
+    // The lines along the x-axis are processed in blocks of rows, so the
+    // lanes are the rows of a block.  The lines along the y-axis or z-axis
+    // are processed for each slice or for each row, respectively, and the
+    // lanes are the x-values, which are contiguous in memory.
+    int* pixels = image.GetPixels().data();
+    size_t const sliceSize = static_cast<size_t>(dim0) * dim1;
+    int const blockSize = 16;
+    int numGroups, numSamples, numLanes;
+    size_t groupStride, sampleStride, laneStride;
+    if (axis == 0)
+    {
+        int const numRows = dim1 * dim2;
+        numGroups = (numRows + blockSize - 1) / blockSize;
+        groupStride = static_cast<size_t>(dim0) * blockSize;
+        numSamples = dim0;
+        sampleStride = 1;
+        numLanes = blockSize;
+        laneStride = dim0;
+    }
+    else if (axis == 1)
+    {
+        numGroups = dim2;
+        groupStride = sliceSize;
+        numSamples = dim1;
+        sampleStride = dim0;
+        numLanes = dim0;
+        laneStride = 1;
+    }
+    else
+    {
+        numGroups = dim1;
+        groupStride = dim0;
+        numSamples = dim2;
+        sampleStride = sliceSize;
+        numLanes = dim0;
+        laneStride = 1;
+    }
+
+    auto filterGroups = [=](int gmin, int gmax)
+    {
+        MorphologyLines<int> lines(dilate, radius, pad);
+        for (int group = gmin; group < gmax; ++group)
+        {
+            int* first = pixels + groupStride * group;
+            int const groupLanes = (axis == 0 ?
+                std::min(blockSize, dim1 * dim2 - blockSize * group) : numLanes);
+            lines.Execute(numSamples, groupLanes,
+                [=](int i, int* lanes)
+                {
+                    int const* sample = first + sampleStride * i;
+                    for (int lane = 0; lane < groupLanes; ++lane)
+                    {
+                        lanes[lane] = sample[laneStride * lane];
+                    }
+                },
+                [=](int i, int const* lanes)
+                {
+                    int* sample = first + sampleStride * i;
+                    for (int lane = 0; lane < groupLanes; ++lane)
+                    {
+                        sample[laneStride * lane] = lanes[lane];
+                    }
+                });
+        }
+    };
+
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    if (threadPool)
+    {
+        threadPool->ParallelFor(0, numGroups, 1, filterGroups);
+    }
+    else
+    {
+        filterGroups(0, numGroups);
+    }
+}
+
 void ImageUtility3::GetComponents(int numNeighbors, int const* delta,
-    Image3<int>& image, std::vector<std::vector<size_t>>& components)
+    std::shared_ptr<ComputeModel> const& cmodel, Image3<int>& image,
+    std::vector<std::vector<size_t>>& components)
+{
+    // The image is partitioned into ranges of slices (chunks) that are
+    // labeled concurrently.
+    size_t const numVoxels = image.GetNumPixels();
+    size_t const sliceSize = static_cast<size_t>(image.GetDimension(0)) * image.GetDimension(1);
+    int const dim2 = image.GetDimension(2);
+    std::shared_ptr<ThreadPool> threadPool = (cmodel ? cmodel->threadPool : nullptr);
+    size_t const minChunkSize = 4096;
+    int numChunks = 1;
+    if (threadPool && numVoxels >= 2 * minChunkSize)
+    {
+        numChunks = static_cast<int>(std::min(numVoxels / minChunkSize, static_cast<size_t>(dim2)));
+        numChunks = std::min(4 * static_cast<int>(threadPool->GetNumThreads()), numChunks);
+    }
+    std::vector<size_t> chunkStart(numChunks + 1);
+    for (int c = 0; c <= numChunks; ++c)
+    {
+        chunkStart[c] = sliceSize * (static_cast<size_t>(dim2) * c / numChunks);
+    }
+
+    // The parent indices of the union-find forest are 32-bit when the
+    // number of voxels allows it, which halves the memory they use.
+    if (numVoxels <= static_cast<size_t>(std::numeric_limits<uint32_t>::max()))
+    {
+        LabelComponents<uint32_t>(numNeighbors, delta, threadPool, chunkStart, image, components);
+    }
+    else
+    {
+        LabelComponents<size_t>(numNeighbors, delta, threadPool, chunkStart, image, components);
+    }
+}
+
+template <typename Index>
+void ImageUtility3::LabelComponents(int numNeighbors, int const* delta,
+    std::shared_ptr<ThreadPool> const& threadPool,
+    std::vector<size_t> const& chunkStart, Image3<int>& image,
+    std::vector<std::vector<size_t>>& components)
 {
+    // The labeling is that of ImageUtility2::LabelComponents applied to the
+    // voxels in lexicographical order: each foreground voxel is linked to
+    // its preceding foreground neighbors, and the root of a tree is the
+    // voxel of smallest index, so the components are numbered in the order
+    // of their first voxels, as by the depth-first search that this
+    // function used previously.
     size_t const numVoxels = image.GetNumPixels();
-    std::vector<int> numElements(numVoxels);
-    std::vector<size_t> vstack(numVoxels);
-    size_t i, numComponents = 0;
-    int label = 2;
-    for (i = 0; i < numVoxels; ++i)
+    std::vector<Index> parent(numVoxels);
+
+    auto find = [&parent](Index i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // Link the trees of i0 and i1 and return the root that is no longer a
+    // root, or return 'invalid' (not a voxel index) when the voxels are in
+    // the same tree.
+    Index const invalid = std::numeric_limits<Index>::max();
+    auto link = [&find, &parent, invalid](Index i0, Index i1)
+    {
+        Index r0 = find(i0), r1 = find(i1);
+        if (r0 < r1)
+        {
+            parent[r1] = r0;
+            return r1;
+        }
+        if (r1 < r0)
+        {
+            parent[r0] = r1;
+            return r0;
+        }
+        return invalid;
+    };
+
+    // The neighbors that precede a voxel, except for the neighbor at offset
+    // 1, which is handled by giving the voxels of a run of foreground voxels
+    // along the x-axis the parent of the first voxel of the run.
+    std::vector<Index> offsets;
+    bool hasLeft = false;
+    Index maxOffset = 0;
+    for (int j = 0; j < numNeighbors; ++j)
+    {
+        if (delta[j] < 0)
+        {
+            Index offset = static_cast<Index>(-delta[j]);
+            if (offset == 1)
+            {
+                hasLeft = true;
+            }
+            else
+            {
+                offsets.push_back(offset);
+            }
+            maxOffset = std::max(maxOffset, offset);
+        }
+    }
+
+    int const numChunks = static_cast<int>(chunkStart.size()) - 1;
+    auto parallelFor = [&threadPool, numChunks](std::function<void(int, int)> const& function)
     {
-        if (image[i] == 1)
+        if (threadPool && numChunks > 1)
         {
-            int top = -1;
-            vstack[++top] = i;
+            threadPool->ParallelFor(0, numChunks, 1, function);
+        }
+        else
+        {
+            function(0, numChunks);
+        }
+    };
 
-            int& count = numElements[numComponents + 1];
-            count = 0;
-            while (top >= 0)
+    // Build the trees of the chunks concurrently and link each voxel
+    // directly to its root.  Voxel values other than 1 are background and
+    // are set to 0.
+    std::vector<int> numRoots(numChunks + 1, 0);
+    parallelFor([&](int cmin, int cmax)
+    {
+        for (int c = cmin; c < cmax; ++c)
+        {
+            Index const imin = static_cast<Index>(chunkStart[c]);
+            Index const imax = static_cast<Index>(chunkStart[c + 1]);
+            for (Index i = imin; i < imax; ++i)
             {
-                size_t v = vstack[top];
-                image[v] = -1;
-                int j;
-                for (j = 0; j < numNeighbors; ++j)
+                if (image[i] != 1)
                 {
-                    size_t adj = v + delta[j];
-                    if (image[adj] == 1)
+                    image[i] = 0;
+                    continue;
+                }
+
+                parent[i] = (hasLeft && i > imin && image[i - 1] == 1 ? parent[i - 1] : i);
+                for (auto offset : offsets)
+                {
+                    if (i - imin >= offset && image[i - offset] == 1
+                        && parent[i - offset] != parent[i])
                     {
-                        vstack[++top] = adj;
-                        break;
+                        link(i, i - offset);
                     }
                 }
-                if (j == numNeighbors)
+            }
+
+            for (Index i = imin; i < imax; ++i)
+            {
+                if (image[i] == 1)
                 {
-                    image[v] = label;
-                    ++count;
-                    --top;
+                    parent[i] = parent[parent[i]];
+                    if (parent[i] == i)
+                    {
+                        ++numRoots[c + 1];
+                    }
                 }
             }
+        }
+    });
+
+    // Merge the trees across the chunk boundaries.  Afterwards, the root of
+    // the component of voxel i is parent[parent[i]].
+    std::vector<Index> linked;
+    for (int c = 1; c < numChunks; ++c)
+    {
+        Index const imin = static_cast<Index>(chunkStart[c]);
+        Index const imax = static_cast<Index>(std::min(chunkStart[c] + maxOffset, numVoxels));
+        for (Index i = imin; i < imax; ++i)
+        {
+            if (image[i] == 0)
+            {
+                continue;
+            }
 
-            ++numComponents;
-            ++label;
+            for (int j = 0; j < numNeighbors; ++j)
+            {
+                if (delta[j] < 0)
+                {
+                    Index offset = static_cast<Index>(-delta[j]);
+                    if (i - imin < offset && i >= offset && image[i - offset] != 0)
+                    {
+                        Index root = link(i, i - offset);
+                        if (root != invalid)
+                        {
+                            linked.push_back(root);
+                        }
+                    }
+                }
+            }
         }
     }
+    for (auto root : linked)
+    {
+        parent[root] = find(root);
+        int c = static_cast<int>(std::upper_bound(chunkStart.begin(), chunkStart.end(),
+            static_cast<size_t>(root)) - chunkStart.begin()) - 1;
+        --numRoots[c + 1];
+    }
+    for (int c = 0; c < numChunks; ++c)
+    {
+        numRoots[c + 1] += numRoots[c];
+    }
+
+    // The labels of the roots are consecutive in each chunk.
+    parallelFor([&](int cmin, int cmax)
+    {
+        for (int c = cmin; c < cmax; ++c)
+        {
+            int label = numRoots[c];
+            Index const imax = static_cast<Index>(chunkStart[c + 1]);
+            for (Index i = static_cast<Index>(chunkStart[c]); i < imax; ++i)
+            {
+                if (image[i] != 0 && parent[i] == i)
+                {
+                    image[i] = ++label;
+                }
+            }
+        }
+    });
 
+    parallelFor([&](int cmin, int cmax)
+    {
+        for (int c = cmin; c < cmax; ++c)
+        {
+            Index const imax = static_cast<Index>(chunkStart[c + 1]);
+            for (Index i = static_cast<Index>(chunkStart[c]); i < imax; ++i)
+            {
+                if (image[i] != 0 && parent[i] != i)
+                {
+                    image[i] = image[parent[parent[i]]];
+                }
+            }
+        }
+    });
+
+    int const numComponents = numRoots[numChunks];
     if (numComponents > 0)
     {
+        std::vector<size_t> numElements(numComponents + 1, 0);
+        for (size_t i = 0; i < numVoxels; ++i)
+        {
+            ++numElements[image[i]];
+        }
+
         components.resize(numComponents + 1);
-        for (i = 1; i <= numComponents; ++i)
+        for (int k = 1; k <= numComponents; ++k)
         {
-            components[i].resize(numElements[i]);
-            numElements[i] = 0;
+            components[k].resize(numElements[k]);
+            numElements[k] = 0;
         }
 
-        for (i = 0; i < numVoxels; ++i)
+        for (size_t i = 0; i < numVoxels; ++i)
         {
-            int value = image[i];
-            if (value != 0)
+            int label = image[i];
+            if (label != 0)
             {
-                // Labels started at 2 to support the depth-first search,
-                // so they need to be decremented for the correct labels.
-                image[i] = --value;
-                components[value][numElements[value]] = i;
-                ++numElements[value];
+                components[label][numElements[label]++] = i;
             }
         }
     }
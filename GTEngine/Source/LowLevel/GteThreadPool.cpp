@@ -0,0 +1,252 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#include <GTEnginePCH.h>
+#include <LowLevel/GteThreadPool.h>
+#include <algorithm>
+#include <cstdint>
+using namespace gte;
+
+namespace
+{
+    // The pool and the queue index of the calling thread when it is a
+    // worker of a pool.
+    thread_local ThreadPool const* gsWorkerPool = nullptr;
+    thread_local unsigned int gsWorkerIndex = 0;
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop = true;
+    }
+    mSleepCondition.notify_all();
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+    :
+    mNumQueued(0),
+    mNextQueue(0),
+    mStop(false)
+{
+    numThreads = std::max(numThreads, 1u);
+    mQueues.resize(numThreads);
+    for (auto& queue : mQueues)
+    {
+        queue = std::make_unique<Queue>();
+    }
+
+    // Queue 0 is owned by the threads that are not workers.
+    for (unsigned int t = 1; t < numThreads; ++t)
+    {
+        mWorkers.push_back(std::thread(&ThreadPool::Work, this, t));
+    }
+}
+
+void ThreadPool::ParallelFor(int begin, int end, int grainSize,
+    std::function<void(int, int)> const& function)
+{
+    int const numItems = end - begin;
+    if (numItems <= 0)
+    {
+        return;
+    }
+
+    int numRanges;
+    if (grainSize > 0)
+    {
+        numRanges = (numItems + grainSize - 1) / grainSize;
+    }
+    else
+    {
+        numRanges = std::min(numItems, 4 * static_cast<int>(GetNumThreads()));
+    }
+
+    if (numRanges == 1 || mWorkers.size() == 0)
+    {
+        if (grainSize > 0)
+        {
+            for (int imin = begin; imin < end; imin += grainSize)
+            {
+                function(imin, std::min(imin + grainSize, end));
+            }
+        }
+        else
+        {
+            function(begin, end);
+        }
+        return;
+    }
+
+    auto GetRange = [begin, end, numItems, numRanges, grainSize](int r,
+        int& imin, int& imax)
+    {
+        if (grainSize > 0)
+        {
+            imin = begin + r * grainSize;
+            imax = std::min(imin + grainSize, end);
+        }
+        else
+        {
+            imin = begin + static_cast<int>(static_cast<int64_t>(numItems) * r / numRanges);
+            imax = begin + static_cast<int>(static_cast<int64_t>(numItems) * (r + 1) / numRanges);
+        }
+    };
+
+    // The calling thread processes the first range and then helps with the
+    // others.
+    TaskGroup group(*this);
+    for (int r = 1; r < numRanges; ++r)
+    {
+        group.Run([&GetRange, &function, r]()
+        {
+            int imin, imax;
+            GetRange(r, imin, imax);
+            function(imin, imax);
+        });
+    }
+
+    int imin, imax;
+    GetRange(0, imin, imax);
+    function(imin, imax);
+    group.Wait();
+}
+
+void ThreadPool::Push(Task&& task)
+{
+    if (mWorkers.size() == 0)
+    {
+        task();
+        return;
+    }
+
+    unsigned int index;
+    if (gsWorkerPool == this)
+    {
+        index = gsWorkerIndex;
+    }
+    else
+    {
+        index = mNextQueue++ % GetNumThreads();
+    }
+
+    ++mNumQueued;
+    {
+        std::lock_guard<std::mutex> lock(mQueues[index]->mutex);
+        mQueues[index]->tasks.push_back(std::move(task));
+    }
+
+    // The lock ensures that a worker that is about to sleep either sees the
+    // new count or receives the notification.
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    mSleepCondition.notify_one();
+}
+
+bool ThreadPool::RunPendingTask()
+{
+    unsigned int const numQueues = GetNumThreads();
+    bool const isWorker = (gsWorkerPool == this);
+    unsigned int const index = (isWorker ? gsWorkerIndex : 0);
+
+    Task task;
+    if (isWorker)
+    {
+        // Pop the most recently created task of the worker.
+        Queue& queue = *mQueues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.size() > 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    for (unsigned int k = (isWorker ? 1 : 0); !task && k < numQueues; ++k)
+    {
+        // Steal the oldest task of another queue.
+        Queue& queue = *mQueues[(index + k) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.size() > 0)
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (task)
+    {
+        --mNumQueued;
+        task();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::Work(unsigned int index)
+{
+    gsWorkerPool = this;
+    gsWorkerIndex = index;
+    for (;;)
+    {
+        if (RunPendingTask())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepCondition.wait(lock, [this]()
+        {
+            return mStop || mNumQueued > 0;
+        });
+        if (mStop)
+        {
+            return;
+        }
+    }
+}
+
+ThreadPool::TaskGroup::~TaskGroup()
+{
+    Wait();
+}
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool)
+    :
+    mPool(pool),
+    mNumPending(0)
+{
+}
+
+void ThreadPool::TaskGroup::Run(std::function<void()> const& task)
+{
+    ++mNumPending;
+    mPool.Push([this, task]()
+    {
+        task();
+        --mNumPending;
+    });
+}
+
+void ThreadPool::TaskGroup::Wait()
+{
+    // Execute pending tasks, of this group or of others, until all the tasks
+    // of this group have finished.
+    while (mNumPending > 0)
+    {
+        if (!mPool.RunPendingTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
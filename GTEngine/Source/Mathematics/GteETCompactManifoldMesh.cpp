@@ -0,0 +1,530 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#include <GTEnginePCH.h>
+#include <LowLevel/GteLogger.h>
+#include <Mathematics/GteETCompactManifoldMesh.h>
+#include <algorithm>
+using namespace gte;
+
+uint64_t const ETCompactManifoldMesh::EMPTY_KEY;
+
+ETCompactManifoldMesh::~ETCompactManifoldMesh()
+{
+}
+
+ETCompactManifoldMesh::ETCompactManifoldMesh()
+    :
+    mNumEdges(0),
+    mNumTriangles(0),
+    mHashMask(0),
+    mHashUsed(0),
+    mAssertOnNonmanifoldInsertion(true)
+{
+    Rehash(16);
+}
+
+void ETCompactManifoldMesh::Reserve(int numTriangles)
+{
+    if (numTriangles > 0)
+    {
+        mTriangles.reserve(numTriangles);
+        mEdges.reserve(3 * static_cast<size_t>(numTriangles) / 2 + 1);
+
+        // Keep the load factor of the edge table at most 1/2.
+        size_t capacity = mHashKeys.size();
+        while (capacity < 3 * static_cast<size_t>(numTriangles))
+        {
+            capacity *= 2;
+        }
+        if (capacity > mHashKeys.size())
+        {
+            Rehash(capacity);
+        }
+    }
+}
+
+int ETCompactManifoldMesh::GetEdge(int v0, int v1) const
+{
+    return FindEdge(GetKey(v0, v1));
+}
+
+int ETCompactManifoldMesh::GetTriangle(int v0, int v1, int v2) const
+{
+    // A triangle is in the mesh only when its edge <v0,v1> is in the mesh,
+    // in which case it is one of the (at most two) triangles sharing the
+    // edge.
+    int e = FindEdge(GetKey(v0, v1));
+    if (e >= 0)
+    {
+        for (int k = 0; k < 2; ++k)
+        {
+            int t = mEdges[e].T[k];
+            if (t >= 0)
+            {
+                int const* V = mTriangles[t].V;
+                for (int j = 0; j < 3; ++j)
+                {
+                    if (V[j] == v0)
+                    {
+                        if (V[(j + 1) % 3] == v1 && V[(j + 2) % 3] == v2)
+                        {
+                            return t;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+bool ETCompactManifoldMesh::AssertOnNonmanifoldInsertion(bool doAssert)
+{
+    std::swap(doAssert, mAssertOnNonmanifoldInsertion);
+    return doAssert;  // return the previous state
+}
+
+int ETCompactManifoldMesh::Insert(int v0, int v1, int v2)
+{
+    if (GetTriangle(v0, v1, v2) >= 0)
+    {
+        // The triangle already exists.  Return -1 as a signal to the caller
+        // that the insertion failed.
+        return -1;
+    }
+
+    // Look up the edges and verify that the insertion does not lead to a
+    // nonmanifold mesh before the mesh is modified.
+    int const V[3] = { v0, v1, v2 };
+    uint64_t keys[3];
+    int edges[3];
+    for (int i0 = 0, i1 = 1; i0 < 3; ++i0, i1 = (i1 + 1) % 3)
+    {
+        keys[i0] = GetKey(V[i0], V[i1]);
+        edges[i0] = FindEdge(keys[i0]);
+        if (edges[i0] >= 0 && mEdges[edges[i0]].T[1] >= 0)
+        {
+            if (mAssertOnNonmanifoldInsertion)
+            {
+                LogInformation("The mesh must be manifold.");
+            }
+            return -1;
+        }
+    }
+
+    int t = CreateTriangle(v0, v1, v2);
+    for (int i = 0; i < 3; ++i)
+    {
+        int e = edges[i];
+        if (e < 0)
+        {
+            // This is the first time the edge is encountered.
+            e = CreateEdge(V[i], V[(i + 1) % 3]);
+            InsertEdge(keys[i], e);
+            mEdges[e].T[0] = t;
+            mTriangles[t].E[i] = e;
+        }
+        else
+        {
+            // This is the second time the edge is encountered.
+            Edge& edge = mEdges[e];
+            edge.T[1] = t;
+
+            // Update the adjacent triangle.
+            int adjacent = edge.T[0];
+            Triangle& adjTri = mTriangles[adjacent];
+            for (int j = 0; j < 3; ++j)
+            {
+                if (adjTri.E[j] == e)
+                {
+                    adjTri.T[j] = t;
+                    break;
+                }
+            }
+
+            // Update the triangle.
+            mTriangles[t].E[i] = e;
+            mTriangles[t].T[i] = adjacent;
+        }
+    }
+    return t;
+}
+
+bool ETCompactManifoldMesh::Remove(int v0, int v1, int v2)
+{
+    int t = GetTriangle(v0, v1, v2);
+    return t >= 0 ? Remove(t) : false;
+}
+
+bool ETCompactManifoldMesh::Remove(int t)
+{
+    if (!IsValidTriangle(t))
+    {
+        return false;
+    }
+
+    Triangle& tri = mTriangles[t];
+    for (int i = 0; i < 3; ++i)
+    {
+        // Inform the edges the triangle is being deleted.
+        int e = tri.E[i];
+        Edge& edge = mEdges[e];
+        if (edge.T[0] == t)
+        {
+            // One-triangle edges always have their handle at index zero.
+            edge.T[0] = edge.T[1];
+            edge.T[1] = -1;
+        }
+        else if (edge.T[1] == t)
+        {
+            edge.T[1] = -1;
+        }
+        else
+        {
+            LogError("Unexpected condition.");
+            return false;
+        }
+
+        // Remove the edge if the triangle was its last reference.
+        if (edge.T[0] < 0)
+        {
+            RemoveEdge(GetKey(edge.V[0], edge.V[1]));
+            edge.V[0] = -1;
+            edge.V[1] = -1;
+            mFreeEdges.push_back(e);
+            --mNumEdges;
+        }
+
+        // Inform the adjacent triangle the triangle is being deleted.
+        int adjacent = tri.T[i];
+        if (adjacent >= 0)
+        {
+            Triangle& adjTri = mTriangles[adjacent];
+            for (int j = 0; j < 3; ++j)
+            {
+                if (adjTri.T[j] == t)
+                {
+                    adjTri.T[j] = -1;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        tri.V[i] = -1;
+        tri.E[i] = -1;
+        tri.T[i] = -1;
+    }
+    mFreeTriangles.push_back(t);
+    --mNumTriangles;
+    return true;
+}
+
+void ETCompactManifoldMesh::Clear()
+{
+    mEdges.clear();
+    mTriangles.clear();
+    mFreeEdges.clear();
+    mFreeTriangles.clear();
+    mNumEdges = 0;
+    mNumTriangles = 0;
+    std::fill(mHashKeys.begin(), mHashKeys.end(), EMPTY_KEY);
+    mHashUsed = 0;
+}
+
+bool ETCompactManifoldMesh::IsClosed() const
+{
+    for (auto const& edge : mEdges)
+    {
+        if (edge.V[0] >= 0 && edge.T[1] < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ETCompactManifoldMesh::IsOriented() const
+{
+    for (auto const& edge : mEdges)
+    {
+        if (edge.V[0] >= 0 && edge.T[1] >= 0)
+        {
+            // In each triangle, find the ordered edge that corresponds to the
+            // unordered edge.  Also find the vertex opposite that edge.
+            bool edgePositive[2] = { false, false };
+            int vOpposite[2] = { -1, -1 };
+            for (int j = 0; j < 2; ++j)
+            {
+                int const* V = mTriangles[edge.T[j]].V;
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (V[i] == edge.V[0])
+                    {
+                        int vNext = V[(i + 1) % 3];
+                        if (vNext == edge.V[1])
+                        {
+                            edgePositive[j] = true;
+                            vOpposite[j] = V[(i + 2) % 3];
+                        }
+                        else
+                        {
+                            edgePositive[j] = false;
+                            vOpposite[j] = vNext;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            // To be oriented consistently, the edges must have reversed
+            // ordering and the oppositive vertices cannot match.
+            if (edgePositive[0] == edgePositive[1] || vOpposite[0] == vOpposite[1])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ETCompactManifoldMesh::GetComponents(
+    std::vector<std::vector<int>>& components) const
+{
+    // visited: 0 (unvisited), 1 (discovered), 2 (finished)
+    int const numSlots = static_cast<int>(mTriangles.size());
+    std::vector<int> visited(numSlots, 0);
+    std::vector<int> stack(numSlots);
+    for (int t = 0; t < numSlots; ++t)
+    {
+        if (mTriangles[t].V[0] >= 0 && visited[t] == 0)
+        {
+            std::vector<int> component;
+            DepthFirstSearch(t, visited, stack, component);
+            components.push_back(std::move(component));
+        }
+    }
+}
+
+void ETCompactManifoldMesh::GetComponents(
+    std::vector<std::vector<TriangleKey<true>>>& components) const
+{
+    int const numSlots = static_cast<int>(mTriangles.size());
+    std::vector<int> visited(numSlots, 0);
+    std::vector<int> stack(numSlots);
+    std::vector<int> component;
+    for (int t = 0; t < numSlots; ++t)
+    {
+        if (mTriangles[t].V[0] >= 0 && visited[t] == 0)
+        {
+            component.clear();
+            DepthFirstSearch(t, visited, stack, component);
+
+            std::vector<TriangleKey<true>> keyComponent;
+            keyComponent.reserve(component.size());
+            for (auto c : component)
+            {
+                int const* V = mTriangles[c].V;
+                keyComponent.push_back(TriangleKey<true>(V[0], V[1], V[2]));
+            }
+            components.push_back(std::move(keyComponent));
+        }
+    }
+}
+
+int ETCompactManifoldMesh::FindEdge(uint64_t key) const
+{
+    size_t slot = static_cast<size_t>(Hash(key)) & mHashMask;
+    for (;;)
+    {
+        uint64_t current = mHashKeys[slot];
+        if (current == key)
+        {
+            return mHashValues[slot];
+        }
+        if (current == EMPTY_KEY)
+        {
+            return -1;
+        }
+        slot = (slot + 1) & mHashMask;
+    }
+}
+
+void ETCompactManifoldMesh::InsertEdge(uint64_t key, int e)
+{
+    // Keep the load factor at most 1/2.
+    if (2 * (mHashUsed + 1) > mHashKeys.size())
+    {
+        Rehash(2 * mHashKeys.size());
+    }
+
+    size_t slot = static_cast<size_t>(Hash(key)) & mHashMask;
+    while (mHashKeys[slot] != EMPTY_KEY)
+    {
+        slot = (slot + 1) & mHashMask;
+    }
+    mHashKeys[slot] = key;
+    mHashValues[slot] = e;
+    ++mHashUsed;
+}
+
+void ETCompactManifoldMesh::RemoveEdge(uint64_t key)
+{
+    size_t slot = static_cast<size_t>(Hash(key)) & mHashMask;
+    for (;;)
+    {
+        uint64_t current = mHashKeys[slot];
+        if (current == key)
+        {
+            break;
+        }
+        if (current == EMPTY_KEY)
+        {
+            return;
+        }
+        slot = (slot + 1) & mHashMask;
+    }
+
+    // Shift the subsequent keys of the probe sequence backward so that no
+    // markers for removed keys are required.
+    size_t next = slot;
+    for (;;)
+    {
+        next = (next + 1) & mHashMask;
+        uint64_t current = mHashKeys[next];
+        if (current == EMPTY_KEY)
+        {
+            break;
+        }
+
+        // The key at 'next' may move to 'slot' only when its home slot is
+        // not cyclically in (slot,next].
+        size_t home = static_cast<size_t>(Hash(current)) & mHashMask;
+        bool inRange = (slot <= next ?
+            (slot < home && home <= next) : (slot < home || home <= next));
+        if (!inRange)
+        {
+            mHashKeys[slot] = current;
+            mHashValues[slot] = mHashValues[next];
+            slot = next;
+        }
+    }
+    mHashKeys[slot] = EMPTY_KEY;
+    mHashValues[slot] = -1;
+    --mHashUsed;
+}
+
+void ETCompactManifoldMesh::Rehash(size_t capacity)
+{
+    std::vector<uint64_t> oldKeys(capacity, EMPTY_KEY);
+    std::vector<int> oldValues(capacity, -1);
+    std::swap(oldKeys, mHashKeys);
+    std::swap(oldValues, mHashValues);
+    mHashMask = capacity - 1;
+    mHashUsed = 0;
+
+    for (size_t i = 0; i < oldKeys.size(); ++i)
+    {
+        uint64_t key = oldKeys[i];
+        if (key != EMPTY_KEY)
+        {
+            size_t slot = static_cast<size_t>(Hash(key)) & mHashMask;
+            while (mHashKeys[slot] != EMPTY_KEY)
+            {
+                slot = (slot + 1) & mHashMask;
+            }
+            mHashKeys[slot] = key;
+            mHashValues[slot] = oldValues[i];
+            ++mHashUsed;
+        }
+    }
+}
+
+int ETCompactManifoldMesh::CreateEdge(int v0, int v1)
+{
+    int e;
+    if (mFreeEdges.size() > 0)
+    {
+        e = mFreeEdges.back();
+        mFreeEdges.pop_back();
+    }
+    else
+    {
+        e = static_cast<int>(mEdges.size());
+        mEdges.push_back(Edge());
+    }
+
+    Edge& edge = mEdges[e];
+    edge.V[0] = std::min(v0, v1);
+    edge.V[1] = std::max(v0, v1);
+    edge.T[0] = -1;
+    edge.T[1] = -1;
+    ++mNumEdges;
+    return e;
+}
+
+int ETCompactManifoldMesh::CreateTriangle(int v0, int v1, int v2)
+{
+    int t;
+    if (mFreeTriangles.size() > 0)
+    {
+        t = mFreeTriangles.back();
+        mFreeTriangles.pop_back();
+    }
+    else
+    {
+        t = static_cast<int>(mTriangles.size());
+        mTriangles.push_back(Triangle());
+    }
+
+    Triangle& tri = mTriangles[t];
+    tri.V[0] = v0;
+    tri.V[1] = v1;
+    tri.V[2] = v2;
+    for (int i = 0; i < 3; ++i)
+    {
+        tri.E[i] = -1;
+        tri.T[i] = -1;
+    }
+    ++mNumTriangles;
+    return t;
+}
+
+void ETCompactManifoldMesh::DepthFirstSearch(int tInitial,
+    std::vector<int>& visited, std::vector<int>& stack,
+    std::vector<int>& component) const
+{
+    // The stack is empty when the index top is -1.
+    int top = -1;
+    stack[++top] = tInitial;
+    visited[tInitial] = 1;
+    while (top >= 0)
+    {
+        int t = stack[top];
+        int i;
+        for (i = 0; i < 3; ++i)
+        {
+            int adj = mTriangles[t].T[i];
+            if (adj >= 0 && visited[adj] == 0)
+            {
+                visited[adj] = 1;
+                stack[++top] = adj;
+                break;
+            }
+        }
+        if (i == 3)
+        {
+            visited[t] = 2;
+            component.push_back(t);
+            --top;
+        }
+    }
+}
@@ -0,0 +1,447 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.0 (2026/10/18)
+
+#include <GTEnginePCH.h>
+#include <LowLevel/GteLogger.h>
+#include <Physics/GteFluid2CPU.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#if !defined(GTE_NO_FLUID_SIMD)
+#if defined(__AVX512F__)
+#define GTE_FLUID_AVX512
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define GTE_FLUID_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GTE_FLUID_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+using namespace gte;
+
+namespace
+{
+    // Compute one Jacobi iteration of the Poisson solver for the cells
+    // xmin <= x < xmax of a row, where 'poisson' is the row and 'poissonM'
+    // and 'poissonP' are the rows below and above it.  The cells are not on
+    // the boundary of the grid, so the neighbors are not clamped.
+    void SolvePoissonRow(int xmin, int xmax, float epsilonX, float epsilonY,
+        float epsilon0, float const* poisson, float const* poissonM,
+        float const* poissonP, float const* divergence, float* outPoisson)
+    {
+        int x = xmin;
+#if defined(GTE_FLUID_AVX512)
+        __m512 epsX = _mm512_set1_ps(epsilonX);
+        __m512 epsY = _mm512_set1_ps(epsilonY);
+        __m512 eps0 = _mm512_set1_ps(epsilon0);
+        for (; x + 16 <= xmax; x += 16)
+        {
+            __m512 sumX = _mm512_add_ps(_mm512_loadu_ps(poisson + x + 1), _mm512_loadu_ps(poisson + x - 1));
+            __m512 sumY = _mm512_add_ps(_mm512_loadu_ps(poissonP + x), _mm512_loadu_ps(poissonM + x));
+            __m512 result = _mm512_add_ps(_mm512_mul_ps(epsX, sumX), _mm512_mul_ps(epsY, sumY));
+            result = _mm512_add_ps(result, _mm512_mul_ps(eps0, _mm512_loadu_ps(divergence + x)));
+            _mm512_storeu_ps(outPoisson + x, result);
+        }
+#elif defined(GTE_FLUID_AVX)
+        __m256 epsX = _mm256_set1_ps(epsilonX);
+        __m256 epsY = _mm256_set1_ps(epsilonY);
+        __m256 eps0 = _mm256_set1_ps(epsilon0);
+        for (; x + 8 <= xmax; x += 8)
+        {
+            __m256 sumX = _mm256_add_ps(_mm256_loadu_ps(poisson + x + 1), _mm256_loadu_ps(poisson + x - 1));
+            __m256 sumY = _mm256_add_ps(_mm256_loadu_ps(poissonP + x), _mm256_loadu_ps(poissonM + x));
+            __m256 result = _mm256_add_ps(_mm256_mul_ps(epsX, sumX), _mm256_mul_ps(epsY, sumY));
+            result = _mm256_add_ps(result, _mm256_mul_ps(eps0, _mm256_loadu_ps(divergence + x)));
+            _mm256_storeu_ps(outPoisson + x, result);
+        }
+#elif defined(GTE_FLUID_SSE2)
+        __m128 epsX = _mm_set1_ps(epsilonX);
+        __m128 epsY = _mm_set1_ps(epsilonY);
+        __m128 eps0 = _mm_set1_ps(epsilon0);
+        for (; x + 4 <= xmax; x += 4)
+        {
+            __m128 sumX = _mm_add_ps(_mm_loadu_ps(poisson + x + 1), _mm_loadu_ps(poisson + x - 1));
+            __m128 sumY = _mm_add_ps(_mm_loadu_ps(poissonP + x), _mm_loadu_ps(poissonM + x));
+            __m128 result = _mm_add_ps(_mm_mul_ps(epsX, sumX), _mm_mul_ps(epsY, sumY));
+            result = _mm_add_ps(result, _mm_mul_ps(eps0, _mm_loadu_ps(divergence + x)));
+            _mm_storeu_ps(outPoisson + x, result);
+        }
+#endif
+
+        // Process the remaining cells one at a time.
+        for (; x < xmax; ++x)
+        {
+            float sumX = poisson[x + 1] + poisson[x - 1];
+            float sumY = poissonP[x] + poissonM[x];
+            outPoisson[x] = epsilonX * sumX + epsilonY * sumY + epsilon0 * divergence[x];
+        }
+    }
+}
+
+Fluid2CPU::Fluid2CPU(std::shared_ptr<ComputeModel> const& cmodel,
+    int xSize, int ySize, float dt, float densityViscosity,
+    float velocityViscosity)
+    :
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mXSize(xSize),
+    mYSize(ySize),
+    mDt(dt),
+    mTime(0.0f),
+    mMultigrid(false),
+    mMultigridSolver({ xSize, ySize }, { 1.0f / static_cast<float>(xSize),
+        1.0f / static_cast<float>(ySize) }, cmodel)
+{
+    LogAssert(xSize >= 3 && ySize >= 3, "Invalid grid size.");
+
+    // Create the shared parameters for the simulation stages.  These are
+    // the parameters of the Fluid2 shaders.
+    float dx = 1.0f/static_cast<float>(mXSize);
+    float dy = 1.0f/static_cast<float>(mYSize);
+    float dtDivDxDx = (dt/dx)/dx;
+    float dtDivDyDy = (dt/dy)/dy;
+    float ratio = dx/dy;
+    float ratioSqr = ratio*ratio;
+    float factor = 0.5f/(1.0f + ratioSqr);
+    float epsilonX = factor;
+    float epsilonY = ratioSqr*factor;
+    float epsilon0 = dx*dx*factor;
+    float denVX = densityViscosity*dtDivDxDx;
+    float denVY = densityViscosity*dtDivDyDy;
+    float velVX = velocityViscosity*dtDivDxDx;
+    float velVY = velocityViscosity*dtDivDyDy;
+
+    Fluid2Parameters& p = mParameters;
+    p.spaceDelta = { dx, dy, 0.0f, 0.0f };
+    p.halfDivDelta = { 0.5f / dx, 0.5f / dy, 0.0f, 0.0f };
+    p.timeDelta = { dt / dx, dt / dy, 0.0f, dt };
+    p.viscosityX = { velVX, velVX, 0.0f, denVX };
+    p.viscosityY = { velVY, velVY, 0.0f, denVY };
+    p.epsilon = { epsilonX, epsilonY, 0.0f, epsilon0 };
+
+    size_t const numCells = static_cast<size_t>(mXSize) * mYSize;
+    mSource.resize(numCells);
+    mStateTm1.resize(numCells);
+    mStateT.resize(numCells);
+    mStateTp1.resize(numCells);
+    mDivergence.resize(numCells);
+    mPoisson0.resize(numCells);
+    mPoisson1.resize(numCells);
+}
+
+void Fluid2CPU::Initialize()
+{
+    InitializeSource();
+    InitializeState();
+    EnforceStateBoundary(mStateTm1);
+    EnforceStateBoundary(mStateT);
+
+    // The multigrid solver starts from the previous pressure.
+    std::fill(mPoisson0.begin(), mPoisson0.end(), 0.0f);
+}
+
+void Fluid2CPU::DoSimulationStep()
+{
+    UpdateState();
+    EnforceStateBoundary(mStateTp1);
+    ComputeDivergence();
+    SolvePoisson();
+    AdjustVelocity();
+    EnforceStateBoundary(mStateTm1);
+    std::swap(mStateTm1, mStateT);
+
+    mTime += mDt;
+}
+
+void Fluid2CPU::InitializeSource()
+{
+    // Use a Mersenne twister engine for random numbers.  The vortices are
+    // those generated by Fluid2InitializeSource; each is (x, y, variance,
+    // amplitude).
+    int const numVortices = 1024;
+    std::mt19937 mte;
+    std::uniform_real_distribution<float> unirnd(0.0f, 1.0f);
+    std::uniform_real_distribution<float> symrnd(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> posrnd0(0.001f, 0.01f);
+    std::uniform_real_distribution<float> posrnd1(128.0f, 256.0f);
+    std::vector<Vector4<float>> vortices(numVortices);
+    for (auto& data : vortices)
+    {
+        data[0] = unirnd(mte);
+        data[1] = unirnd(mte);
+        data[2] = posrnd0(mte);
+        data[3] = posrnd1(mte);
+        if (symrnd(mte) < 0.0f)
+        {
+            data[3] = -data[3];
+        }
+    }
+
+    // The density producer and consumer are (x, y, variance, amplitude).
+    // The wind is (*, y, variance, amplitude).
+    Vector4<float> const densityProducer{ 0.25f, 0.75f, 0.01f, 2.0f };
+    Vector4<float> const densityConsumer{ 0.75f, 0.25f, 0.01f, 2.0f };
+    Vector4<float> const gravity{ 0.0f, 0.0f, 0.0f, 0.0f };
+    Vector4<float> const wind{ 0.0f, 0.5f, 0.001f, 32.0f };
+
+    // The vortex velocities are accumulated in the order of generation, as
+    // they are by the repeated execution of the vortex shader.
+    Vector4<float> const& spaceDelta = mParameters.spaceDelta;
+    ParallelFor([this, &vortices, &densityProducer, &densityConsumer,
+        &gravity, &wind, &spaceDelta](int ymin, int ymax)
+    {
+        for (int y = ymin; y < ymax; ++y)
+        {
+            for (int x = 0, i = mXSize * y; x < mXSize; ++x, ++i)
+            {
+                // Compute the location of the pixel (x,y) in [0,1]^2.
+                float locX = spaceDelta[0] * (static_cast<float>(x) + 0.5f);
+                float locY = spaceDelta[1] * (static_cast<float>(y) + 0.5f);
+
+                float vortexX = 0.0f, vortexY = 0.0f;
+                for (auto const& data : vortices)
+                {
+                    float diffX = locX - data[0];
+                    float diffY = locY - data[1];
+                    float arg = -(diffX * diffX + diffY * diffY) / data[2];
+                    float magnitude = data[3] * std::exp(arg);
+                    vortexX += magnitude * diffY;
+                    vortexY -= magnitude * diffX;
+                }
+
+                // Compute the density producer and consumer.
+                float diffX = locX - densityProducer[0];
+                float diffY = locY - densityProducer[1];
+                float arg = -(diffX * diffX + diffY * diffY) / densityProducer[2];
+                float density = densityProducer[3] * std::exp(arg);
+                diffX = locX - densityConsumer[0];
+                diffY = locY - densityConsumer[1];
+                arg = -(diffX * diffX + diffY * diffY) / densityConsumer[2];
+                density -= densityConsumer[3] * std::exp(arg);
+
+                // Compute the velocity from gravity, wind and the vortices.
+                float windDiff = locY - wind[1];
+                float windArg = -windDiff * windDiff / wind[2];
+                float windVelocity = wind[3] * std::exp(windArg);
+                mSource[i] = { gravity[0] + windVelocity + vortexX,
+                    gravity[1] + vortexY, 0.0f, density };
+            }
+        }
+    });
+}
+
+void Fluid2CPU::InitializeState()
+{
+    // The initial density values are randomly generated and the initial
+    // velocity values are zero, as in Fluid2InitializeState.
+    std::mt19937 mte;
+    std::uniform_real_distribution<float> unirnd(0.0f, 1.0f);
+    for (size_t i = 0; i < mStateT.size(); ++i)
+    {
+        mStateT[i] = { 0.0f, 0.0f, 0.0f, unirnd(mte) };
+        mStateTm1[i] = mStateT[i];
+    }
+}
+
+void Fluid2CPU::EnforceStateBoundary(std::vector<Vector4<float>>& state)
+{
+    // The x-boundary is processed before the y-boundary.  Because the sizes
+    // are at least 3, the values copied from the rows and columns adjacent
+    // to the boundary are not modified by the writes to the boundary, so
+    // the shaders' copy to temporary images is not needed.
+    for (int y = 0, i = 0; y < mYSize; ++y, i += mXSize)
+    {
+        float xMin = state[i + 1][1];
+        float xMax = state[i + mXSize - 2][1];
+        state[i] = { 0.0f, xMin, 0.0f, 0.0f };
+        state[i + mXSize - 1] = { 0.0f, xMax, 0.0f, 0.0f };
+    }
+
+    int const yMaxOffset = mXSize * (mYSize - 1);
+    for (int x = 0; x < mXSize; ++x)
+    {
+        float yMin = state[x + mXSize][0];
+        float yMax = state[x + yMaxOffset - mXSize][0];
+        state[x] = { yMin, 0.0f, 0.0f, 0.0f };
+        state[x + yMaxOffset] = { yMax, 0.0f, 0.0f, 0.0f };
+    }
+}
+
+void Fluid2CPU::UpdateState()
+{
+    ParallelFor([this](int ymin, int ymax)
+    {
+        Fluid2Parameters const& p = mParameters;
+        float const xMaxSample = static_cast<float>(mXSize);
+        float const yMaxSample = static_cast<float>(mYSize);
+        for (int y = ymin; y < ymax; ++y)
+        {
+            int const ym = std::max(y - 1, 0);
+            int const yp = std::min(y + 1, mYSize - 1);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                int const xm = std::max(x - 1, 0);
+                int const xp = std::min(x + 1, mXSize - 1);
+                int const i = x + mXSize * y;
+
+                // Sample states at (x,y), (x+dx,y), (x-dx,y), (x,y+dy),
+                // (x,y-dy).
+                Vector4<float> const& stateZZ = mStateT[i];
+                Vector4<float> const& statePZ = mStateT[xp + mXSize * y];
+                Vector4<float> const& stateMZ = mStateT[xm + mXSize * y];
+                Vector4<float> const& stateZP = mStateT[x + mXSize * yp];
+                Vector4<float> const& stateZM = mStateT[x + mXSize * ym];
+
+                // Compute advection.  The shader samples the state at
+                // normalized texture coordinates spaceDelta*(c -
+                // timeDelta*velocity + 0.5) with a bilinear sampler and clamp
+                // addressing.  The corresponding texel coordinates are
+                // c - timeDelta*velocity.  These are clamped to the range
+                // that produces the same samples in order to avoid integer
+                // overflow for large velocities.
+                float u = static_cast<float>(x) - p.timeDelta[0] * stateZZ[0];
+                float v = static_cast<float>(y) - p.timeDelta[1] * stateZZ[1];
+                u = std::min(std::max(u, -1.0f), xMaxSample);
+                v = std::min(std::max(v, -1.0f), yMaxSample);
+                float uFloor = std::floor(u), vFloor = std::floor(v);
+                float a1 = u - uFloor, a0 = 1.0f - a1;
+                float b1 = v - vFloor, b0 = 1.0f - b1;
+                int x0 = static_cast<int>(uFloor), y0 = static_cast<int>(vFloor);
+                int x1 = std::min(std::max(x0 + 1, 0), mXSize - 1);
+                int y1 = std::min(std::max(y0 + 1, 0), mYSize - 1);
+                x0 = std::min(std::max(x0, 0), mXSize - 1);
+                y0 = std::min(std::max(y0, 0), mYSize - 1);
+                Vector4<float> const& s00 = mStateTm1[x0 + mXSize * y0];
+                Vector4<float> const& s10 = mStateTm1[x1 + mXSize * y0];
+                Vector4<float> const& s01 = mStateTm1[x0 + mXSize * y1];
+                Vector4<float> const& s11 = mStateTm1[x1 + mXSize * y1];
+
+                // Update the state using the estimates of the second-order
+                // derivatives of the state at (x,y).
+                Vector4<float> const& src = mSource[i];
+                Vector4<float>& update = mStateTp1[i];
+                for (int j = 0; j < 4; ++j)
+                {
+                    float advection = b0 * (a0 * s00[j] + a1 * s10[j]) +
+                        b1 * (a0 * s01[j] + a1 * s11[j]);
+                    float stateDXX = statePZ[j] - 2.0f * stateZZ[j] + stateMZ[j];
+                    float stateDYY = stateZP[j] - 2.0f * stateZZ[j] + stateZM[j];
+                    update[j] = advection + (p.viscosityX[j] * stateDXX +
+                        p.viscosityY[j] * stateDYY + p.timeDelta[3] * src[j]);
+                }
+            }
+        }
+    });
+}
+
+void Fluid2CPU::ComputeDivergence()
+{
+    ParallelFor([this](int ymin, int ymax)
+    {
+        float const halfDivDeltaX = mParameters.halfDivDelta[0];
+        float const halfDivDeltaY = mParameters.halfDivDelta[1];
+        for (int y = ymin; y < ymax; ++y)
+        {
+            int const ym = std::max(y - 1, 0);
+            int const yp = std::min(y + 1, mYSize - 1);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                int const xm = std::max(x - 1, 0);
+                int const xp = std::min(x + 1, mXSize - 1);
+                float gradientX = mStateTp1[xp + mXSize * y][0] - mStateTp1[xm + mXSize * y][0];
+                float gradientY = mStateTp1[x + mXSize * yp][1] - mStateTp1[x + mXSize * ym][1];
+                mDivergence[x + mXSize * y] = halfDivDeltaX * gradientX + halfDivDeltaY * gradientY;
+            }
+        }
+    });
+}
+
+void Fluid2CPU::SolvePoisson()
+{
+    if (mMultigrid)
+    {
+        // The Jacobi iterations are those of -Laplacian(poisson) =
+        // divergence, so the divergence is the right-hand side of the
+        // multigrid solver.  The pressure changes little between steps, so
+        // the previous solution is the initial guess.
+        mMultigridSolver.Solve(mDivergence.data(), mPoisson0.data());
+        return;
+    }
+
+    // The shaders compute all the cells and then set the boundary to zero.
+    // The values on the boundary are zero at the start of each iteration,
+    // so only the interior cells are computed and the clamping of the
+    // neighbors is not needed.
+    std::fill(mPoisson0.begin(), mPoisson0.end(), 0.0f);
+    std::fill(mPoisson1.begin(), mPoisson1.end(), 0.0f);
+    for (int iteration = 0; iteration < NUM_POISSON_ITERATIONS; ++iteration)
+    {
+        ParallelFor([this](int ymin, int ymax)
+        {
+            float const epsilonX = mParameters.epsilon[0];
+            float const epsilonY = mParameters.epsilon[1];
+            float const epsilon0 = mParameters.epsilon[3];
+            ymin = std::max(ymin, 1);
+            ymax = std::min(ymax, mYSize - 1);
+            for (int y = ymin; y < ymax; ++y)
+            {
+                int const i = mXSize * y;
+                SolvePoissonRow(1, mXSize - 1, epsilonX, epsilonY, epsilon0,
+                    &mPoisson0[i], &mPoisson0[i - mXSize], &mPoisson0[i + mXSize],
+                    &mDivergence[i], &mPoisson1[i]);
+            }
+        });
+        std::swap(mPoisson0, mPoisson1);
+    }
+}
+
+void Fluid2CPU::AdjustVelocity()
+{
+    ParallelFor([this](int ymin, int ymax)
+    {
+        float const halfDivDeltaX = mParameters.halfDivDelta[0];
+        float const halfDivDeltaY = mParameters.halfDivDelta[1];
+        for (int y = ymin; y < ymax; ++y)
+        {
+            int const ym = std::max(y - 1, 0);
+            int const yp = std::min(y + 1, mYSize - 1);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                int const xm = std::max(x - 1, 0);
+                int const xp = std::min(x + 1, mXSize - 1);
+                int const i = x + mXSize * y;
+                float diffX = mPoisson0[xp + mXSize * y] - mPoisson0[xm + mXSize * y];
+                float diffY = mPoisson0[x + mXSize * yp] - mPoisson0[x + mXSize * ym];
+                Vector4<float> const& state = mStateTp1[i];
+                mStateTm1[i] = { state[0] + halfDivDeltaX * diffX,
+                    state[1] + halfDivDeltaY * diffY, state[2], state[3] };
+            }
+        }
+    });
+}
+
+void Fluid2CPU::ParallelFor(std::function<void(int, int)> const& function)
+{
+    // The ranges have at least minRangeSize cells so that the cost of
+    // scheduling is small compared to the work.
+    int const minRangeSize = 4096;
+    int const numCells = mXSize * mYSize;
+    if (mThreadPool && numCells >= 2 * minRangeSize)
+    {
+        int numRanges = std::min(4 * static_cast<int>(mThreadPool->GetNumThreads()),
+            numCells / minRangeSize);
+        int grainSize = (mYSize + numRanges - 1) / numRanges;
+        mThreadPool->ParallelFor(0, mYSize, grainSize, function);
+    }
+    else
+    {
+        function(0, mYSize);
+    }
+}
@@ -0,0 +1,539 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.1.0 (2026/10/18)
+
+#include <GTEnginePCH.h>
+#include <LowLevel/GteLogger.h>
+#include <Physics/GteFluid3CPU.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#if !defined(GTE_NO_FLUID_SIMD)
+#if defined(__AVX512F__)
+#define GTE_FLUID_AVX512
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define GTE_FLUID_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GTE_FLUID_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+using namespace gte;
+
+namespace
+{
+    // Compute one Jacobi iteration of the Poisson solver for the cells
+    // xmin <= x < xmax of a row, where 'poisson' is the row, 'poissonYM' and
+    // 'poissonYP' are its neighbors in y and 'poissonZM' and 'poissonZP' are
+    // its neighbors in z.  The cells are not on the boundary of the grid.
+    void SolvePoissonRow(int xmin, int xmax, Vector4<float> const& epsilon,
+        float const* poisson, float const* poissonYM, float const* poissonYP,
+        float const* poissonZM, float const* poissonZP,
+        float const* divergence, float* outPoisson)
+    {
+        int x = xmin;
+#if defined(GTE_FLUID_AVX512)
+        __m512 epsX = _mm512_set1_ps(epsilon[0]);
+        __m512 epsY = _mm512_set1_ps(epsilon[1]);
+        __m512 epsZ = _mm512_set1_ps(epsilon[2]);
+        __m512 eps0 = _mm512_set1_ps(epsilon[3]);
+        for (; x + 16 <= xmax; x += 16)
+        {
+            __m512 sumX = _mm512_add_ps(_mm512_loadu_ps(poisson + x + 1), _mm512_loadu_ps(poisson + x - 1));
+            __m512 sumY = _mm512_add_ps(_mm512_loadu_ps(poissonYP + x), _mm512_loadu_ps(poissonYM + x));
+            __m512 sumZ = _mm512_add_ps(_mm512_loadu_ps(poissonZP + x), _mm512_loadu_ps(poissonZM + x));
+            __m512 result = _mm512_add_ps(_mm512_mul_ps(epsX, sumX), _mm512_mul_ps(epsY, sumY));
+            result = _mm512_add_ps(result, _mm512_mul_ps(epsZ, sumZ));
+            result = _mm512_add_ps(result, _mm512_mul_ps(eps0, _mm512_loadu_ps(divergence + x)));
+            _mm512_storeu_ps(outPoisson + x, result);
+        }
+#elif defined(GTE_FLUID_AVX)
+        __m256 epsX = _mm256_set1_ps(epsilon[0]);
+        __m256 epsY = _mm256_set1_ps(epsilon[1]);
+        __m256 epsZ = _mm256_set1_ps(epsilon[2]);
+        __m256 eps0 = _mm256_set1_ps(epsilon[3]);
+        for (; x + 8 <= xmax; x += 8)
+        {
+            __m256 sumX = _mm256_add_ps(_mm256_loadu_ps(poisson + x + 1), _mm256_loadu_ps(poisson + x - 1));
+            __m256 sumY = _mm256_add_ps(_mm256_loadu_ps(poissonYP + x), _mm256_loadu_ps(poissonYM + x));
+            __m256 sumZ = _mm256_add_ps(_mm256_loadu_ps(poissonZP + x), _mm256_loadu_ps(poissonZM + x));
+            __m256 result = _mm256_add_ps(_mm256_mul_ps(epsX, sumX), _mm256_mul_ps(epsY, sumY));
+            result = _mm256_add_ps(result, _mm256_mul_ps(epsZ, sumZ));
+            result = _mm256_add_ps(result, _mm256_mul_ps(eps0, _mm256_loadu_ps(divergence + x)));
+            _mm256_storeu_ps(outPoisson + x, result);
+        }
+#elif defined(GTE_FLUID_SSE2)
+        __m128 epsX = _mm_set1_ps(epsilon[0]);
+        __m128 epsY = _mm_set1_ps(epsilon[1]);
+        __m128 epsZ = _mm_set1_ps(epsilon[2]);
+        __m128 eps0 = _mm_set1_ps(epsilon[3]);
+        for (; x + 4 <= xmax; x += 4)
+        {
+            __m128 sumX = _mm_add_ps(_mm_loadu_ps(poisson + x + 1), _mm_loadu_ps(poisson + x - 1));
+            __m128 sumY = _mm_add_ps(_mm_loadu_ps(poissonYP + x), _mm_loadu_ps(poissonYM + x));
+            __m128 sumZ = _mm_add_ps(_mm_loadu_ps(poissonZP + x), _mm_loadu_ps(poissonZM + x));
+            __m128 result = _mm_add_ps(_mm_mul_ps(epsX, sumX), _mm_mul_ps(epsY, sumY));
+            result = _mm_add_ps(result, _mm_mul_ps(epsZ, sumZ));
+            result = _mm_add_ps(result, _mm_mul_ps(eps0, _mm_loadu_ps(divergence + x)));
+            _mm_storeu_ps(outPoisson + x, result);
+        }
+#endif
+
+        // Process the remaining cells one at a time.
+        for (; x < xmax; ++x)
+        {
+            float sumX = poisson[x + 1] + poisson[x - 1];
+            float sumY = poissonYP[x] + poissonYM[x];
+            float sumZ = poissonZP[x] + poissonZM[x];
+            outPoisson[x] = epsilon[0] * sumX + epsilon[1] * sumY +
+                epsilon[2] * sumZ + epsilon[3] * divergence[x];
+        }
+    }
+}
+
+Fluid3CPU::Fluid3CPU(std::shared_ptr<ComputeModel> const& cmodel,
+    int xSize, int ySize, int zSize, float dt)
+    :
+    mThreadPool(cmodel ? cmodel->threadPool : nullptr),
+    mXSize(xSize),
+    mYSize(ySize),
+    mZSize(zSize),
+    mDt(dt),
+    mTime(0.0f),
+    mMultigrid(false),
+    mMultigridSolver({ xSize, ySize, zSize }, { 1.0f / static_cast<float>(xSize),
+        1.0f / static_cast<float>(ySize), 1.0f / static_cast<float>(zSize) }, cmodel)
+{
+    LogAssert(xSize >= 3 && ySize >= 3 && zSize >= 3, "Invalid grid size.");
+
+    // Create the shared parameters for the simulation stages.  These are
+    // the parameters of the Fluid3 shaders.
+    float dx = 1.0f/static_cast<float>(mXSize);
+    float dy = 1.0f/static_cast<float>(mYSize);
+    float dz = 1.0f/static_cast<float>(mZSize);
+    float dtDivDxDx = (dt/dx)/dx;
+    float dtDivDyDy = (dt/dy)/dy;
+    float dtDivDzDz = (dt/dz)/dz;
+    float ratio0 = dx/dy;
+    float ratio1 = dx/dz;
+    float ratio0Sqr = ratio0*ratio0;
+    float ratio1Sqr = ratio1*ratio1;
+    float factor = 0.5f/(1.0f + ratio0Sqr + ratio1Sqr);
+    float epsilonX = factor;
+    float epsilonY = ratio0Sqr*factor;
+    float epsilonZ = ratio1Sqr*factor;
+    float epsilon0 = dx*dx*factor;
+    float const denViscosity = 0.0001f;
+    float const velViscosity = 0.0001f;
+    float denVX = denViscosity*dtDivDxDx;
+    float denVY = denViscosity*dtDivDyDy;
+    float denVZ = denViscosity*dtDivDzDz;
+    float velVX = velViscosity*dtDivDxDx;
+    float velVY = velViscosity*dtDivDyDy;
+    float velVZ = velViscosity*dtDivDzDz;
+
+    Fluid3Parameters& p = mParameters;
+    p.spaceDelta = { dx, dy, dz, 0.0f };
+    p.halfDivDelta = { 0.5f / dx, 0.5f / dy, 0.5f / dz, 0.0f };
+    p.timeDelta = { dt / dx, dt / dy, dt / dz, dt };
+    p.viscosityX = { velVX, velVX, velVX, denVX };
+    p.viscosityY = { velVY, velVY, velVY, denVY };
+    p.viscosityZ = { velVZ, velVZ, velVZ, denVZ };
+    p.epsilon = { epsilonX, epsilonY, epsilonZ, epsilon0 };
+
+    size_t const numCells = static_cast<size_t>(mXSize) * mYSize * mZSize;
+    mSource.resize(numCells);
+    mStateTm1.resize(numCells);
+    mStateT.resize(numCells);
+    mStateTp1.resize(numCells);
+    mDivergence.resize(numCells);
+    mPoisson0.resize(numCells);
+    mPoisson1.resize(numCells);
+}
+
+void Fluid3CPU::Initialize()
+{
+    InitializeSource();
+    InitializeState();
+    EnforceStateBoundary(mStateTm1);
+    EnforceStateBoundary(mStateT);
+
+    // The multigrid solver starts from the previous pressure.
+    std::fill(mPoisson0.begin(), mPoisson0.end(), 0.0f);
+}
+
+void Fluid3CPU::DoSimulationStep()
+{
+    UpdateState();
+    EnforceStateBoundary(mStateTp1);
+    ComputeDivergence();
+    SolvePoisson();
+    AdjustVelocity();
+    EnforceStateBoundary(mStateTm1);
+    std::swap(mStateTm1, mStateT);
+
+    mTime += mDt;
+}
+
+void Fluid3CPU::InitializeSource()
+{
+    // Use a Mersenne twister engine for random numbers.  The vortices are
+    // those generated by Fluid3InitializeSource.
+    struct Vortex
+    {
+        Vector4<float> position;
+        Vector4<float> normal;
+        Vector4<float> data;  // (variance, amplitude, *, *)
+    };
+
+    int const numVortices = 1024;
+    std::mt19937 mte;
+    std::uniform_real_distribution<float> unirnd(0.0f, 1.0f);
+    std::uniform_real_distribution<float> symrnd(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> posrnd0(0.001f, 0.01f);
+    std::uniform_real_distribution<float> posrnd1(64.0f, 128.0f);
+    std::vector<Vortex> vortices(numVortices);
+    for (auto& v : vortices)
+    {
+        v.position[0] = unirnd(mte);
+        v.position[1] = unirnd(mte);
+        v.position[2] = unirnd(mte);
+        v.position[3] = 0.0f;
+        v.normal[0] = symrnd(mte);
+        v.normal[1] = symrnd(mte);
+        v.normal[2] = symrnd(mte);
+        v.normal[3] = 0.0f;
+        Normalize(v.normal);
+        v.data[0] = posrnd0(mte);
+        v.data[1] = posrnd1(mte);
+        v.data[2] = 0.0f;
+        v.data[3] = 0.0f;
+    }
+
+    // The density producer and consumer are (x, y, z, *) with data
+    // (variance, amplitude, *, *).  The wind data is (variance, amplitude,
+    // *, *).
+    Vector4<float> const densityProducer{ 0.5f, 0.5f, 0.5f, 0.0f };
+    Vector4<float> const densityPData{ 0.01f, 16.0f, 0.0f, 0.0f };
+    Vector4<float> const densityConsumer{ 0.75f, 0.75f, 0.75f, 0.0f };
+    Vector4<float> const densityCData{ 0.01f, 0.0f, 0.0f, 0.0f };
+    Vector4<float> const gravity{ 0.0f, 0.0f, 0.0f, 0.0f };
+    Vector4<float> const windData{ 0.001f, 0.0f, 0.0f, 0.0f };
+
+    // The vortex velocities are accumulated in the order of generation, as
+    // they are by the repeated execution of the vortex shader.
+    Vector4<float> const& spaceDelta = mParameters.spaceDelta;
+    ParallelFor([&](int rmin, int rmax)
+    {
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % mYSize, z = r / mYSize;
+            for (int x = 0, i = mXSize * r; x < mXSize; ++x, ++i)
+            {
+                // Compute the location of the voxel (x,y,z) in [0,1]^3.
+                Vector4<float> location{
+                    spaceDelta[0] * (static_cast<float>(x) + 0.5f),
+                    spaceDelta[1] * (static_cast<float>(y) + 0.5f),
+                    spaceDelta[2] * (static_cast<float>(z) + 0.5f),
+                    0.0f };
+
+                Vector4<float> vortexVelocity{ 0.0f, 0.0f, 0.0f, 0.0f };
+                for (auto const& v : vortices)
+                {
+                    Vector4<float> diff = location - v.position;
+                    float arg = -Dot(diff, diff) / v.data[0];
+                    float magnitude = v.data[1] * std::exp(arg);
+                    Vector4<float> const& n = v.normal;
+                    vortexVelocity[0] += magnitude * (n[1] * diff[2] - n[2] * diff[1]);
+                    vortexVelocity[1] += magnitude * (n[2] * diff[0] - n[0] * diff[2]);
+                    vortexVelocity[2] += magnitude * (n[0] * diff[1] - n[1] * diff[0]);
+                }
+
+                // Compute the density producer and consumer.
+                Vector4<float> diff = location - densityProducer;
+                float arg = -Dot(diff, diff) / densityPData[0];
+                float density = densityPData[1] * std::exp(arg);
+                diff = location - densityConsumer;
+                arg = -Dot(diff, diff) / densityCData[0];
+                density -= densityCData[1] * std::exp(arg);
+
+                // Compute the velocity from gravity, wind and the vortices.
+                float windArg = -(location[0] * location[0] +
+                    location[2] * location[2]) / windData[0];
+                float windVelocity = windData[1] * std::exp(windArg);
+                mSource[i] = {
+                    gravity[0] + vortexVelocity[0],
+                    gravity[1] + windVelocity + vortexVelocity[1],
+                    gravity[2] + vortexVelocity[2],
+                    density };
+            }
+        }
+    });
+}
+
+void Fluid3CPU::InitializeState()
+{
+    // The initial density values are randomly generated and the initial
+    // velocity values are zero, as in Fluid3InitializeState.
+    std::mt19937 mte;
+    std::uniform_real_distribution<float> unirnd(0.0f, 1.0f);
+    for (size_t i = 0; i < mStateT.size(); ++i)
+    {
+        mStateT[i] = { 0.0f, 0.0f, 0.0f, unirnd(mte) };
+        mStateTm1[i] = mStateT[i];
+    }
+}
+
+void Fluid3CPU::EnforceStateBoundary(std::vector<Vector4<float>>& state)
+{
+    // The faces are processed in the order x, y, z.  As in Fluid2CPU, the
+    // values are copied directly from the adjacent slices.
+    int const xStride = 1, yStride = mXSize, zStride = mXSize * mYSize;
+    for (int z = 0; z < mZSize; ++z)
+    {
+        for (int y = 0; y < mYSize; ++y)
+        {
+            int const i = yStride * y + zStride * z;
+            int const j = i + xStride * (mXSize - 1);
+            Vector4<float> const xMin = state[i + xStride];
+            Vector4<float> const xMax = state[j - xStride];
+            state[i] = { 0.0f, xMin[1], xMin[2], 0.0f };
+            state[j] = { 0.0f, xMax[1], xMax[2], 0.0f };
+        }
+    }
+
+    for (int z = 0; z < mZSize; ++z)
+    {
+        for (int x = 0; x < mXSize; ++x)
+        {
+            int const i = xStride * x + zStride * z;
+            int const j = i + yStride * (mYSize - 1);
+            Vector4<float> const yMin = state[i + yStride];
+            Vector4<float> const yMax = state[j - yStride];
+            state[i] = { yMin[0], 0.0f, yMin[2], 0.0f };
+            state[j] = { yMax[0], 0.0f, yMax[2], 0.0f };
+        }
+    }
+
+    for (int y = 0; y < mYSize; ++y)
+    {
+        for (int x = 0; x < mXSize; ++x)
+        {
+            int const i = xStride * x + yStride * y;
+            int const j = i + zStride * (mZSize - 1);
+            Vector4<float> const zMin = state[i + zStride];
+            Vector4<float> const zMax = state[j - zStride];
+            state[i] = { zMin[0], zMin[1], 0.0f, 0.0f };
+            state[j] = { zMax[0], zMax[1], 0.0f, 0.0f };
+        }
+    }
+}
+
+void Fluid3CPU::UpdateState()
+{
+    ParallelFor([this](int rmin, int rmax)
+    {
+        Fluid3Parameters const& p = mParameters;
+        int const yStride = mXSize, zStride = mXSize * mYSize;
+        float const xMaxSample = static_cast<float>(mXSize);
+        float const yMaxSample = static_cast<float>(mYSize);
+        float const zMaxSample = static_cast<float>(mZSize);
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % mYSize, z = r / mYSize;
+            int const dym = (y > 0 ? -yStride : 0);
+            int const dyp = (y < mYSize - 1 ? yStride : 0);
+            int const dzm = (z > 0 ? -zStride : 0);
+            int const dzp = (z < mZSize - 1 ? zStride : 0);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                int const i = x + mXSize * r;
+                int const dxm = (x > 0 ? -1 : 0);
+                int const dxp = (x < mXSize - 1 ? 1 : 0);
+
+                // Sample states at (x,y,z) and immediate neighbors.
+                Vector4<float> const& stateZZZ = mStateT[i];
+                Vector4<float> const& statePZZ = mStateT[i + dxp];
+                Vector4<float> const& stateMZZ = mStateT[i + dxm];
+                Vector4<float> const& stateZPZ = mStateT[i + dyp];
+                Vector4<float> const& stateZMZ = mStateT[i + dym];
+                Vector4<float> const& stateZZP = mStateT[i + dzp];
+                Vector4<float> const& stateZZM = mStateT[i + dzm];
+
+                // Compute advection.  The texel coordinates of the trilinear
+                // sample are c - timeDelta*velocity; see the comments in
+                // Fluid2CPU::UpdateState.
+                float u = static_cast<float>(x) - p.timeDelta[0] * stateZZZ[0];
+                float v = static_cast<float>(y) - p.timeDelta[1] * stateZZZ[1];
+                float w = static_cast<float>(z) - p.timeDelta[2] * stateZZZ[2];
+                u = std::min(std::max(u, -1.0f), xMaxSample);
+                v = std::min(std::max(v, -1.0f), yMaxSample);
+                w = std::min(std::max(w, -1.0f), zMaxSample);
+                float uFloor = std::floor(u), vFloor = std::floor(v), wFloor = std::floor(w);
+                float a1 = u - uFloor, a0 = 1.0f - a1;
+                float b1 = v - vFloor, b0 = 1.0f - b1;
+                float c1 = w - wFloor, c0 = 1.0f - c1;
+                int x0 = static_cast<int>(uFloor);
+                int y0 = static_cast<int>(vFloor);
+                int z0 = static_cast<int>(wFloor);
+                int x1 = std::min(std::max(x0 + 1, 0), mXSize - 1);
+                int y1 = std::min(std::max(y0 + 1, 0), mYSize - 1);
+                int z1 = std::min(std::max(z0 + 1, 0), mZSize - 1);
+                x0 = std::min(std::max(x0, 0), mXSize - 1);
+                y0 = std::min(std::max(y0, 0), mYSize - 1);
+                z0 = std::min(std::max(z0, 0), mZSize - 1);
+                int const k00 = yStride * y0 + zStride * z0;
+                int const k10 = yStride * y1 + zStride * z0;
+                int const k01 = yStride * y0 + zStride * z1;
+                int const k11 = yStride * y1 + zStride * z1;
+                Vector4<float> const& s000 = mStateTm1[x0 + k00];
+                Vector4<float> const& s100 = mStateTm1[x1 + k00];
+                Vector4<float> const& s010 = mStateTm1[x0 + k10];
+                Vector4<float> const& s110 = mStateTm1[x1 + k10];
+                Vector4<float> const& s001 = mStateTm1[x0 + k01];
+                Vector4<float> const& s101 = mStateTm1[x1 + k01];
+                Vector4<float> const& s011 = mStateTm1[x0 + k11];
+                Vector4<float> const& s111 = mStateTm1[x1 + k11];
+
+                // Update the state using the estimates of the second-order
+                // derivatives of the state at (x,y,z).
+                Vector4<float> const& src = mSource[i];
+                Vector4<float>& update = mStateTp1[i];
+                for (int j = 0; j < 4; ++j)
+                {
+                    float advection =
+                        c0 * (b0 * (a0 * s000[j] + a1 * s100[j]) + b1 * (a0 * s010[j] + a1 * s110[j])) +
+                        c1 * (b0 * (a0 * s001[j] + a1 * s101[j]) + b1 * (a0 * s011[j] + a1 * s111[j]));
+                    float stateDXX = statePZZ[j] - 2.0f * stateZZZ[j] + stateMZZ[j];
+                    float stateDYY = stateZPZ[j] - 2.0f * stateZZZ[j] + stateZMZ[j];
+                    float stateDZZ = stateZZP[j] - 2.0f * stateZZZ[j] + stateZZM[j];
+                    update[j] = advection + (p.viscosityX[j] * stateDXX +
+                        p.viscosityY[j] * stateDYY + p.viscosityZ[j] * stateDZZ +
+                        p.timeDelta[3] * src[j]);
+                }
+            }
+        }
+    });
+}
+
+void Fluid3CPU::ComputeDivergence()
+{
+    ParallelFor([this](int rmin, int rmax)
+    {
+        Vector4<float> const& halfDivDelta = mParameters.halfDivDelta;
+        int const yStride = mXSize, zStride = mXSize * mYSize;
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % mYSize, z = r / mYSize;
+            int const dym = (y > 0 ? -yStride : 0);
+            int const dyp = (y < mYSize - 1 ? yStride : 0);
+            int const dzm = (z > 0 ? -zStride : 0);
+            int const dzp = (z < mZSize - 1 ? zStride : 0);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                int const i = x + mXSize * r;
+                int const dxm = (x > 0 ? -1 : 0);
+                int const dxp = (x < mXSize - 1 ? 1 : 0);
+                float gradientX = mStateTp1[i + dxp][0] - mStateTp1[i + dxm][0];
+                float gradientY = mStateTp1[i + dyp][1] - mStateTp1[i + dym][1];
+                float gradientZ = mStateTp1[i + dzp][2] - mStateTp1[i + dzm][2];
+                mDivergence[i] = halfDivDelta[0] * gradientX +
+                    halfDivDelta[1] * gradientY + halfDivDelta[2] * gradientZ;
+            }
+        }
+    });
+}
+
+void Fluid3CPU::SolvePoisson()
+{
+    if (mMultigrid)
+    {
+        mMultigridSolver.Solve(mDivergence.data(), mPoisson0.data());
+        return;
+    }
+
+    // Only the interior cells are computed; see the comments in
+    // Fluid2CPU::SolvePoisson.
+    std::fill(mPoisson0.begin(), mPoisson0.end(), 0.0f);
+    std::fill(mPoisson1.begin(), mPoisson1.end(), 0.0f);
+    for (int iteration = 0; iteration < NUM_POISSON_ITERATIONS; ++iteration)
+    {
+        ParallelFor([this](int rmin, int rmax)
+        {
+            int const yStride = mXSize, zStride = mXSize * mYSize;
+            for (int r = rmin; r < rmax; ++r)
+            {
+                int const y = r % mYSize, z = r / mYSize;
+                if (0 < y && y < mYSize - 1 && 0 < z && z < mZSize - 1)
+                {
+                    int const i = mXSize * r;
+                    float const* poisson = &mPoisson0[i];
+                    SolvePoissonRow(1, mXSize - 1, mParameters.epsilon,
+                        poisson, poisson - yStride, poisson + yStride,
+                        poisson - zStride, poisson + zStride,
+                        &mDivergence[i], &mPoisson1[i]);
+                }
+            }
+        });
+        std::swap(mPoisson0, mPoisson1);
+    }
+}
+
+void Fluid3CPU::AdjustVelocity()
+{
+    ParallelFor([this](int rmin, int rmax)
+    {
+        Vector4<float> const& halfDivDelta = mParameters.halfDivDelta;
+        int const yStride = mXSize, zStride = mXSize * mYSize;
+        for (int r = rmin; r < rmax; ++r)
+        {
+            int const y = r % mYSize, z = r / mYSize;
+            int const dym = (y > 0 ? -yStride : 0);
+            int const dyp = (y < mYSize - 1 ? yStride : 0);
+            int const dzm = (z > 0 ? -zStride : 0);
+            int const dzp = (z < mZSize - 1 ? zStride : 0);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                int const i = x + mXSize * r;
+                int const dxm = (x > 0 ? -1 : 0);
+                int const dxp = (x < mXSize - 1 ? 1 : 0);
+                float diffX = mPoisson0[i + dxp] - mPoisson0[i + dxm];
+                float diffY = mPoisson0[i + dyp] - mPoisson0[i + dym];
+                float diffZ = mPoisson0[i + dzp] - mPoisson0[i + dzm];
+                Vector4<float> const& state = mStateTp1[i];
+                mStateTm1[i] = {
+                    state[0] + halfDivDelta[0] * diffX,
+                    state[1] + halfDivDelta[1] * diffY,
+                    state[2] + halfDivDelta[2] * diffZ,
+                    state[3] };
+            }
+        }
+    });
+}
+
+void Fluid3CPU::ParallelFor(std::function<void(int, int)> const& function)
+{
+    // The ranges have at least minRangeSize cells so that the cost of
+    // scheduling is small compared to the work.
+    int const minRangeSize = 4096;
+    int const numRows = mYSize * mZSize;
+    int const numCells = mXSize * numRows;
+    if (mThreadPool && numCells >= 2 * minRangeSize)
+    {
+        int numRanges = std::min(4 * static_cast<int>(mThreadPool->GetNumThreads()),
+            numCells / minRangeSize);
+        int grainSize = (numRows + numRanges - 1) / numRanges;
+        mThreadPool->ParallelFor(0, numRows, grainSize, function);
+    }
+    else
+    {
+        function(0, numRows);
+    }
+}
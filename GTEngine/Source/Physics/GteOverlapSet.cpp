@@ -0,0 +1,245 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2018
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 3.0.0 (2026/10/18)
+
+#include <GTEnginePCH.h>
+#include <Physics/GteOverlapSet.h>
+#include <algorithm>
+using namespace gte;
+
+uint64_t const OverlapSet::Table::EMPTY_KEY;
+
+OverlapSet::OverlapSet()
+    :
+    mUpdating(false)
+{
+}
+
+void OverlapSet::Clear()
+{
+    mPairs.clear();
+    mTable.Clear();
+    mUpdating = false;
+    mTouched.clear();
+    mTouchedTable.Clear();
+    mAdded.clear();
+    mRemoved.clear();
+}
+
+bool OverlapSet::Contains(int i, int j) const
+{
+    return mTable.Find(GetKey(i, j)) != nullptr;
+}
+
+bool OverlapSet::Insert(int i, int j)
+{
+    uint64_t key = GetKey(i, j);
+    if (mTable.Find(key))
+    {
+        return false;
+    }
+
+    Touch(key, false);
+    mTable.Insert(key, static_cast<int>(mPairs.size()));
+    mPairs.push_back(GetPair(key));
+    return true;
+}
+
+bool OverlapSet::Remove(int i, int j)
+{
+    uint64_t key = GetKey(i, j);
+    int* value = mTable.Find(key);
+    if (!value)
+    {
+        return false;
+    }
+
+    // Move the last pair into the hole.
+    int index = *value;
+    int last = static_cast<int>(mPairs.size()) - 1;
+    if (index < last)
+    {
+        EdgeKey<false> const& pair = mPairs[last];
+        *mTable.Find(GetKey(pair.V[0], pair.V[1])) = index;
+        mPairs[index] = pair;
+    }
+    mPairs.pop_back();
+    mTable.Remove(key);
+
+    Touch(key, true);
+    return true;
+}
+
+void OverlapSet::BeginUpdate()
+{
+    mUpdating = true;
+    ClearTouched();
+    mAdded.clear();
+    mRemoved.clear();
+}
+
+void OverlapSet::EndUpdate()
+{
+    for (auto key : mTouched)
+    {
+        bool wasContained = (*mTouchedTable.Find(key) != 0);
+        bool isContained = (mTable.Find(key) != nullptr);
+        if (isContained && !wasContained)
+        {
+            mAdded.push_back(GetPair(key));
+        }
+        else if (!isContained && wasContained)
+        {
+            mRemoved.push_back(GetPair(key));
+        }
+    }
+    mUpdating = false;
+    ClearTouched();
+}
+
+void OverlapSet::ClearTouched()
+{
+    // Remove the touched keys individually unless they occupy a large part
+    // of the table, in which case resetting all the slots is cheaper.
+    if (8 * mTouched.size() < mTouchedTable.GetCapacity())
+    {
+        for (auto key : mTouched)
+        {
+            mTouchedTable.Remove(key);
+        }
+    }
+    else
+    {
+        mTouchedTable.Clear();
+    }
+    mTouched.clear();
+}
+
+void OverlapSet::Touch(uint64_t key, bool contained)
+{
+    if (mUpdating && !mTouchedTable.Find(key))
+    {
+        mTouchedTable.Insert(key, contained ? 1 : 0);
+        mTouched.push_back(key);
+    }
+}
+
+OverlapSet::Table::Table()
+    :
+    mKeys(16, EMPTY_KEY),
+    mValues(16, -1),
+    mMask(15),
+    mNumKeys(0)
+{
+}
+
+void OverlapSet::Table::Clear()
+{
+    if (mNumKeys > 0)
+    {
+        std::fill(mKeys.begin(), mKeys.end(), EMPTY_KEY);
+        mNumKeys = 0;
+    }
+}
+
+size_t OverlapSet::Table::GetSlot(uint64_t key) const
+{
+    // The return value is the slot of the key when it is in the table or
+    // the slot of the empty key that ends its probe sequence.
+    size_t slot = static_cast<size_t>(Hash(key)) & mMask;
+    for (;;)
+    {
+        uint64_t current = mKeys[slot];
+        if (current == key || current == EMPTY_KEY)
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mMask;
+    }
+}
+
+int* OverlapSet::Table::Find(uint64_t key)
+{
+    size_t slot = GetSlot(key);
+    return (mKeys[slot] == key ? &mValues[slot] : nullptr);
+}
+
+int const* OverlapSet::Table::Find(uint64_t key) const
+{
+    size_t slot = GetSlot(key);
+    return (mKeys[slot] == key ? &mValues[slot] : nullptr);
+}
+
+void OverlapSet::Table::Insert(uint64_t key, int value)
+{
+    // Keep the load factor at most 1/2.  The key is not in the table.
+    if (2 * static_cast<size_t>(mNumKeys + 1) > mKeys.size())
+    {
+        Rehash(2 * mKeys.size());
+    }
+
+    size_t slot = GetSlot(key);
+    mKeys[slot] = key;
+    mValues[slot] = value;
+    ++mNumKeys;
+}
+
+void OverlapSet::Table::Remove(uint64_t key)
+{
+    size_t slot = GetSlot(key);
+    if (mKeys[slot] != key)
+    {
+        return;
+    }
+
+    // Shift the subsequent keys of the probe sequence backward so that no
+    // markers for removed keys are required.
+    size_t next = slot;
+    for (;;)
+    {
+        next = (next + 1) & mMask;
+        uint64_t current = mKeys[next];
+        if (current == EMPTY_KEY)
+        {
+            break;
+        }
+
+        // The key at 'next' may move to 'slot' only when its home slot is
+        // not cyclically in (slot,next].
+        size_t home = static_cast<size_t>(Hash(current)) & mMask;
+        bool inRange = (slot <= next ?
+            (slot < home && home <= next) : (slot < home || home <= next));
+        if (!inRange)
+        {
+            mKeys[slot] = current;
+            mValues[slot] = mValues[next];
+            slot = next;
+        }
+    }
+    mKeys[slot] = EMPTY_KEY;
+    mValues[slot] = -1;
+    --mNumKeys;
+}
+
+void OverlapSet::Table::Rehash(size_t capacity)
+{
+    std::vector<uint64_t> oldKeys(capacity, EMPTY_KEY);
+    std::vector<int> oldValues(capacity, -1);
+    std::swap(oldKeys, mKeys);
+    std::swap(oldValues, mValues);
+    mMask = capacity - 1;
+
+    for (size_t i = 0; i < oldKeys.size(); ++i)
+    {
+        uint64_t key = oldKeys[i];
+        if (key != EMPTY_KEY)
+        {
+            size_t slot = GetSlot(key);
+            mKeys[slot] = key;
+            mValues[slot] = oldValues[i];
+        }
+    }
+}